@@ -42,6 +42,8 @@
 #define	OPT_VERBOSE		"verbose"
 #define	OPT_IPV6		"ipv6"
 
+#define	ALG_ALL			"all"
+
 #define	TRACE_DEFAULT_NUM	0x10000
 #define	TRACE_STEP_MAX		0x1000
 #define	TRACE_STEP_DEF		0x100
@@ -81,6 +83,14 @@ static const struct acl_alg acl_alg[] = {
 		.name = "altivec",
 		.alg = RTE_ACL_CLASSIFY_ALTIVEC,
 	},
+	{
+		.name = "avx512x16",
+		.alg = RTE_ACL_CLASSIFY_AVX512X16,
+	},
+	{
+		.name = "avx512x32",
+		.alg = RTE_ACL_CLASSIFY_AVX512X32,
+	},
 };
 
 static struct {
@@ -98,6 +108,7 @@ static struct {
 	uint32_t            verbose;
 	uint32_t            ipv6;
 	struct acl_alg      alg;
+	uint32_t            all_algs;
 	uint32_t            used_traces;
 	void               *traces;
 	struct rte_acl_ctx *acx;
@@ -782,7 +793,8 @@ acx_init(void)
 		rte_exit(rte_errno, "failed to create ACL context\n");
 
 	/* set default classify method for this context. */
-	if (config.alg.alg != RTE_ACL_CLASSIFY_DEFAULT) {
+	if (config.all_algs == 0 &&
+			config.alg.alg != RTE_ACL_CLASSIFY_DEFAULT) {
 		ret = rte_acl_set_ctx_classify(config.acx, config.alg.alg);
 		if (ret != 0)
 			rte_exit(ret, "failed to setup %s method "
@@ -882,6 +894,47 @@ search_ip5tuples(__rte_unused void *arg)
 	return 0;
 }
 
+static void
+run_search(void)
+{
+	uint32_t lcore;
+
+	RTE_LCORE_FOREACH_SLAVE(lcore)
+		 rte_eal_remote_launch(search_ip5tuples, NULL, lcore);
+
+	search_ip5tuples(NULL);
+
+	rte_eal_mp_wait_lcore();
+}
+
+/*
+ * Run the same search with each classify method supported
+ * by the cpu, to compare them side by side.
+ */
+static void
+run_search_all_algs(void)
+{
+	int ret;
+	uint32_t i;
+
+	for (i = 0; i != RTE_DIM(acl_alg); i++) {
+
+		ret = rte_acl_set_ctx_classify(config.acx, acl_alg[i].alg);
+		if (ret != 0) {
+			dump_verbose(DUMP_NONE, stdout,
+				"classify method %s is not supported, "
+				"skipping\n", acl_alg[i].name);
+			continue;
+		}
+
+		config.alg = acl_alg[i];
+		dump_verbose(DUMP_NONE, stdout,
+			"running search with %s classify method:\n",
+			config.alg.name);
+		run_search();
+	}
+}
+
 static unsigned long
 get_ulong_opt(const char *opt, const char *name, size_t min, size_t max)
 {
@@ -901,6 +954,12 @@ get_alg_opt(const char *opt, const char *name)
 {
 	uint32_t i;
 
+	if (strcmp(opt, ALG_ALL) == 0) {
+		config.alg.name = ALG_ALL;
+		config.all_algs = 1;
+		return;
+	}
+
 	for (i = 0; i != RTE_DIM(acl_alg); i++) {
 		if (strcmp(opt, acl_alg[i].name) == 0) {
 			config.alg = acl_alg[i];
@@ -921,7 +980,7 @@ print_usage(const char *prgname)
 	n = 0;
 	buf[0] = 0;
 
-	for (i = 0; i < RTE_DIM(acl_alg) - 1; i++) {
+	for (i = 0; i < RTE_DIM(acl_alg); i++) {
 		rc = snprintf(buf + n, sizeof(buf) - n, "%s|",
 			acl_alg[i].name);
 		if (rc > sizeof(buf) - n)
@@ -929,7 +988,7 @@ print_usage(const char *prgname)
 		n += rc;
 	}
 
-	strlcpy(buf + n, acl_alg[i].name, sizeof(buf) - n);
+	strlcpy(buf + n, ALG_ALL, sizeof(buf) - n);
 
 	fprintf(stdout,
 		PRINT_USAGE_START
@@ -952,7 +1011,9 @@ print_usage(const char *prgname)
 			"leave 0 for default behaviour]\n"
 		"[--" OPT_ITER_NUM "=<number of iterations to perform>]\n"
 		"[--" OPT_VERBOSE "=<verbose level>]\n"
-		"[--" OPT_SEARCH_ALG "=%s]\n"
+		"[--" OPT_SEARCH_ALG "=%s] "
+			"(" ALG_ALL " runs every method supported "
+			"by the cpu one after another)\n"
 		"[--" OPT_IPV6 "=<IPv6 rules and trace files>]\n",
 		prgname, RTE_ACL_RESULTS_MULTIPLIER,
 		(uint32_t)RTE_ACL_MAX_CATEGORIES,
@@ -1065,7 +1126,6 @@ int
 main(int argc, char **argv)
 {
 	int ret;
-	uint32_t lcore;
 
 	ret = rte_eal_init(argc, argv);
 	if (ret < 0)
@@ -1085,12 +1145,10 @@ main(int argc, char **argv)
 	if (config.trace_file != NULL)
 		tracef_init();
 
-	RTE_LCORE_FOREACH_SLAVE(lcore)
-		 rte_eal_remote_launch(search_ip5tuples, NULL, lcore);
-
-	search_ip5tuples(NULL);
-
-	rte_eal_mp_wait_lcore();
+	if (config.all_algs == 0)
+		run_search();
+	else
+		run_search_all_algs();
 
 	rte_acl_free(config.acx);
 	return 0;
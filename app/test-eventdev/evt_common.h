@@ -33,6 +33,7 @@
 #define EVT_MAX_STAGES           64
 #define EVT_MAX_PORTS            256
 #define EVT_MAX_QUEUES           256
+#define EVT_MAX_SCHED_SHARDS     8
 
 enum evt_prod_type {
 	EVT_PROD_TYPE_NONE,
@@ -71,6 +72,7 @@ struct evt_options {
 	uint64_t timer_tick_nsec;
 	uint64_t optm_timer_tick_nsec;
 	enum evt_prod_type prod_type;
+	uint8_t sched_shards;
 };
 
 static inline bool
@@ -138,6 +140,43 @@ evt_service_setup(uint32_t service_id)
 	return 0;
 }
 
+/*
+ * Map the event device service along with any additional scheduler services
+ * the PMD registered as "<service name>_<n>", such as the sharded sw scheduler.
+ */
+static inline int
+evt_dev_service_setup(uint8_t dev_id)
+{
+	char name[RTE_SERVICE_NAME_MAX];
+	uint32_t service_id;
+	unsigned int i;
+	int ret;
+
+	if (rte_event_dev_service_id_get(dev_id, &service_id))
+		return -ENOENT;
+
+	ret = evt_service_setup(service_id);
+	if (ret)
+		return ret;
+	/* the device may have been created after EAL started its services */
+	rte_service_runstate_set(service_id, 1);
+
+	for (i = 1; ; i++) {
+		uint32_t extra_id;
+
+		snprintf(name, sizeof(name), "%s_%u",
+				rte_service_get_name(service_id), i);
+		if (rte_service_get_by_name(name, &extra_id))
+			break;
+		ret = evt_service_setup(extra_id);
+		if (ret)
+			return ret;
+		rte_service_runstate_set(extra_id, 1);
+	}
+
+	return 0;
+}
+
 static inline int
 evt_configure_eventdev(struct evt_options *opt, uint8_t nb_queues,
 		uint8_t nb_ports)
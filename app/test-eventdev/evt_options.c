@@ -201,6 +201,16 @@ evt_parse_nb_timer_adptrs(struct evt_options *opt, const char *arg)
 	return ret;
 }
 
+static int
+evt_parse_sched_shards(struct evt_options *opt, const char *arg)
+{
+	int ret;
+
+	ret = parser_read_uint8(&(opt->sched_shards), arg);
+
+	return ret;
+}
+
 static int
 evt_parse_pool_sz(struct evt_options *opt, const char *arg)
 {
@@ -285,6 +295,9 @@ usage(char *program)
 		"\t--expiry_nsec      : event timer expiry ns.\n"
 		"\t--mbuf_sz          : packet mbuf size.\n"
 		"\t--max_pkt_sz       : max packet size.\n"
+		"\t--sched_shards     : run the test with the sw event device\n"
+		"\t                     scheduler split in 1 to N shards, and\n"
+		"\t                     report the throughput of each run.\n"
 		);
 	printf("available tests:\n");
 	evt_test_dump_names();
@@ -356,6 +369,7 @@ static struct option lgopts[] = {
 	{ EVT_EXPIRY_NSEC,         1, 0, 0 },
 	{ EVT_MBUF_SZ,             1, 0, 0 },
 	{ EVT_MAX_PKT_SZ,          1, 0, 0 },
+	{ EVT_SCHED_SHARDS,        1, 0, 0 },
 	{ EVT_HELP,                0, 0, 0 },
 	{ NULL,                    0, 0, 0 }
 };
@@ -390,6 +404,7 @@ evt_opts_parse_long(int opt_idx, struct evt_options *opt)
 		{ EVT_EXPIRY_NSEC, evt_parse_expiry_nsec},
 		{ EVT_MBUF_SZ, evt_parse_mbuf_sz},
 		{ EVT_MAX_PKT_SZ, evt_parse_max_pkt_sz},
+		{ EVT_SCHED_SHARDS, evt_parse_sched_shards},
 	};
 
 	for (i = 0; i < RTE_DIM(parsermap); i++) {
@@ -42,6 +42,7 @@
 #define EVT_EXPIRY_NSEC          ("expiry_nsec")
 #define EVT_MBUF_SZ              ("mbuf_sz")
 #define EVT_MAX_PKT_SZ           ("max_pkt_sz")
+#define EVT_SCHED_SHARDS         ("sched_shards")
 #define EVT_HELP                 ("help")
 
 void evt_options_default(struct evt_options *opt);
@@ -291,8 +291,8 @@ perf_launch_lcores(struct evt_test *test, struct evt_options *opt,
 	int64_t perf_remaining  = total_pkts;
 	const uint64_t perf_sample = rte_get_timer_hz();
 
-	static float total_mpps;
-	static uint64_t samples;
+	float total_mpps = 0;
+	uint64_t samples = 0;
 
 	const uint64_t freq_mhz = rte_get_timer_hz() / 1000000;
 	int64_t remaining = t->outstand_pkts - processed_pkts(t);
@@ -349,6 +349,7 @@ perf_launch_lcores(struct evt_test *test, struct evt_options *opt,
 		}
 	}
 	printf("\n");
+	t->avg_mpps = samples ? total_mpps / samples : 0;
 	return 0;
 }
 
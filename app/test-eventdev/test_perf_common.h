@@ -51,6 +51,7 @@ struct test_perf {
 	enum evt_test_result result;
 	uint32_t nb_flows;
 	uint64_t nb_pkts;
+	float avg_mpps; /* average throughput of the last run */
 	struct rte_mempool *pool;
 	struct prod_data prod[EVT_MAX_PORTS];
 	struct worker_data worker[EVT_MAX_PORTS];
@@ -2,6 +2,10 @@
  * Copyright(c) 2017 Cavium, Inc
  */
 
+#include <rte_bus_vdev.h>
+#include <rte_devargs.h>
+#include <rte_string_fns.h>
+
 #include "test_perf_common.h"
 
 /* See http://doc.dpdk.org/guides/tools/testeventdev.html for test details */
@@ -144,12 +148,6 @@ worker_wrapper(void *arg)
 	rte_panic("invalid worker\n");
 }
 
-static int
-perf_queue_launch_lcores(struct evt_test *test, struct evt_options *opt)
-{
-	return perf_launch_lcores(test, opt, worker_wrapper);
-}
-
 static int
 perf_queue_eventdev_setup(struct evt_test *test, struct evt_options *opt)
 {
@@ -227,9 +225,7 @@ perf_queue_eventdev_setup(struct evt_test *test, struct evt_options *opt)
 		return ret;
 
 	if (!evt_has_distributed_sched(opt->dev_id)) {
-		uint32_t service_id;
-		rte_event_dev_service_id_get(opt->dev_id, &service_id);
-		ret = evt_service_setup(service_id);
+		ret = evt_dev_service_setup(opt->dev_id);
 		if (ret) {
 			evt_err("No service lcore found to run event dev.");
 			return ret;
@@ -274,16 +270,156 @@ perf_queue_eventdev_setup(struct evt_test *test, struct evt_options *opt)
 	return 0;
 }
 
+/*
+ * Re-create the sw event device with its scheduler split in nb_shards
+ * shards, keeping the other device arguments.
+ */
+static int
+perf_queue_sched_shards_set(struct evt_options *opt, const char *name,
+		const char *args, uint8_t nb_shards)
+{
+	char dev_args[256];
+	int ret;
+
+	ret = snprintf(dev_args, sizeof(dev_args), "%s%ssched_shards=%u",
+			args, args[0] != '\0' ? "," : "", nb_shards);
+	if (ret < 0 || ret >= (int)sizeof(dev_args))
+		return -ENAMETOOLONG;
+
+	ret = rte_vdev_uninit(name);
+	if (ret)
+		return ret;
+	ret = rte_vdev_init(name, dev_args);
+	if (ret)
+		return ret;
+
+	ret = rte_event_dev_get_dev_id(name);
+	if (ret < 0)
+		return ret;
+	opt->dev_id = ret;
+
+	return 0;
+}
+
+/*
+ * Run the test once per number of scheduler shards, from 1 to
+ * opt->sched_shards, each shard service being mapped to its own service
+ * lcore, and report the throughput of each run.
+ */
+static int
+perf_queue_sched_shards_launch(struct evt_test *test, struct evt_options *opt)
+{
+	struct test_perf *t = evt_test_priv(test);
+	float mpps[EVT_MAX_SCHED_SHARDS];
+	char name[RTE_DEV_NAME_MAX_LEN] = "";
+	char args[128] = "";
+	struct rte_devargs *da;
+	uint8_t nb_shards;
+	int ret;
+
+	RTE_EAL_DEVARGS_FOREACH("vdev", da) {
+		if (rte_event_dev_get_dev_id(da->name) != opt->dev_id)
+			continue;
+		strlcpy(name, da->name, sizeof(name));
+		if (da->args != NULL)
+			strlcpy(args, da->args, sizeof(args));
+		break;
+	}
+	if (name[0] == '\0') {
+		evt_err("event device %d is not a vdev", opt->dev_id);
+		return -ENODEV;
+	}
+
+	for (nb_shards = 1; nb_shards <= opt->sched_shards; nb_shards++) {
+		perf_eventdev_destroy(test, opt);
+		ret = perf_queue_sched_shards_set(opt, name, args, nb_shards);
+		if (ret) {
+			evt_err("failed to create %s with %u shards",
+					name, nb_shards);
+			return ret;
+		}
+
+		t->done = false;
+		t->result = EVT_TEST_FAILED;
+		ret = perf_queue_eventdev_setup(test, opt);
+		if (ret)
+			return ret;
+
+		printf("sched_shards %u:\n", nb_shards);
+		ret = perf_launch_lcores(test, opt, worker_wrapper);
+		if (ret)
+			return ret;
+		rte_eal_mp_wait_lcore();
+		if (t->result != EVT_TEST_SUCCESS)
+			return -1;
+
+		mpps[nb_shards - 1] = t->avg_mpps;
+	}
+
+	printf("Throughput per number of scheduler shards:\n");
+	for (nb_shards = 1; nb_shards <= opt->sched_shards; nb_shards++)
+		printf("\t%u shard(s): %.3f mpps\n", nb_shards,
+				mpps[nb_shards - 1]);
+
+	return 0;
+}
+
+static int
+perf_queue_launch_lcores(struct evt_test *test, struct evt_options *opt)
+{
+	if (opt->sched_shards)
+		return perf_queue_sched_shards_launch(test, opt);
+
+	return perf_launch_lcores(test, opt, worker_wrapper);
+}
+
 static void
 perf_queue_opt_dump(struct evt_options *opt)
 {
 	evt_dump_fwd_latency(opt);
 	perf_opt_dump(opt, perf_queue_nb_event_queues(opt));
+	if (opt->sched_shards)
+		evt_dump("sched_shards", "1 to %d", opt->sched_shards);
+}
+
+static int
+perf_queue_sched_shards_check(struct evt_options *opt)
+{
+	struct rte_event_dev_info dev_info;
+
+	if (opt->sched_shards > EVT_MAX_SCHED_SHARDS) {
+		evt_err("sched_shards %d exceeds %d", opt->sched_shards,
+				EVT_MAX_SCHED_SHARDS);
+		return -1;
+	}
+
+	rte_event_dev_info_get(opt->dev_id, &dev_info);
+	if (strcmp(dev_info.driver_name, "event_sw") != 0) {
+		evt_err("sched_shards needs the sw event device");
+		return -1;
+	}
+
+	/* Runs end when all the packets have gone through */
+	if (opt->prod_type != EVT_PROD_TYPE_SYNT || opt->nb_pkts == 0) {
+		evt_err("sched_shards needs synthetic producers and nb_pkts");
+		return -1;
+	}
+
+	if (rte_service_lcore_count() < opt->sched_shards) {
+		evt_err("sched_shards needs %d service lcores",
+				opt->sched_shards);
+		return -1;
+	}
+
+	return 0;
 }
 
 static int
 perf_queue_opt_check(struct evt_options *opt)
 {
+	if (opt->sched_shards && perf_queue_sched_shards_check(opt))
+		return -1;
+
 	return perf_opt_check(opt, perf_queue_nb_event_queues(opt));
 }
 
@@ -265,15 +265,61 @@ rte_acl_ipv4vlan_build(struct rte_acl_ctx *ctx,
 	return rte_acl_build(ctx, &cfg);
 }
 
+static const enum rte_acl_classify_alg classify_algs[] = {
+	RTE_ACL_CLASSIFY_SCALAR,
+	RTE_ACL_CLASSIFY_SSE,
+	RTE_ACL_CLASSIFY_AVX2,
+	RTE_ACL_CLASSIFY_NEON,
+	RTE_ACL_CLASSIFY_ALTIVEC,
+	RTE_ACL_CLASSIFY_AVX512X16,
+	RTE_ACL_CLASSIFY_AVX512X32,
+};
+
 /*
- * Test scalar and SSE ACL lookup.
+ * Check allow/deny results for first *count* elements of test data.
+ */
+static int
+test_classify_verify(const struct ipv4_7tuple test_data[],
+	const uint32_t results[], uint32_t count)
+{
+	uint32_t i, result;
+
+	/* check if we allow everything we should allow */
+	for (i = 0; i < count; i++) {
+		result = results[i * RTE_ACL_MAX_CATEGORIES + ACL_ALLOW];
+		if (result != test_data[i].allow) {
+			printf("Line %i: Error in allow results at %u "
+					"(expected %"PRIu32" got %"PRIu32")!\n",
+					__LINE__, i, test_data[i].allow,
+					result);
+			return -EINVAL;
+		}
+	}
+
+	/* check if we deny everything we should deny */
+	for (i = 0; i < count; i++) {
+		result = results[i * RTE_ACL_MAX_CATEGORIES + ACL_DENY];
+		if (result != test_data[i].deny) {
+			printf("Line %i: Error in deny results at %u "
+					"(expected %"PRIu32" got %"PRIu32")!\n",
+					__LINE__, i, test_data[i].deny,
+					result);
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Test ACL lookup with all classify methods available.
  */
 static int
 test_classify_run(struct rte_acl_ctx *acx, struct ipv4_7tuple test_data[],
 	size_t dim)
 {
 	int ret, i;
-	uint32_t result, count;
+	uint32_t count, j;
 	uint32_t results[dim * RTE_ACL_MAX_CATEGORIES];
 	const uint8_t *data[dim];
 	/* swap all bytes in the data to network order */
@@ -295,32 +341,9 @@ test_classify_run(struct rte_acl_ctx *acx, struct ipv4_7tuple test_data[],
 			goto err;
 		}
 
-		/* check if we allow everything we should allow */
-		for (i = 0; i < (int) count; i++) {
-			result =
-				results[i * RTE_ACL_MAX_CATEGORIES + ACL_ALLOW];
-			if (result != test_data[i].allow) {
-				printf("Line %i: Error in allow results at %i "
-					"(expected %"PRIu32" got %"PRIu32")!\n",
-					__LINE__, i, test_data[i].allow,
-					result);
-				ret = -EINVAL;
-				goto err;
-			}
-		}
-
-		/* check if we deny everything we should deny */
-		for (i = 0; i < (int) count; i++) {
-			result = results[i * RTE_ACL_MAX_CATEGORIES + ACL_DENY];
-			if (result != test_data[i].deny) {
-				printf("Line %i: Error in deny results at %i "
-					"(expected %"PRIu32" got %"PRIu32")!\n",
-					__LINE__, i, test_data[i].deny,
-					result);
-				ret = -EINVAL;
-				goto err;
-			}
-		}
+		ret = test_classify_verify(test_data, results, count);
+		if (ret != 0)
+			goto err;
 	}
 
 	/* make a quick check for scalar */
@@ -332,35 +355,46 @@ test_classify_run(struct rte_acl_ctx *acx, struct ipv4_7tuple test_data[],
 		goto err;
 	}
 
-	/* check if we allow everything we should allow */
-	for (i = 0; i < (int) dim; i++) {
-		result = results[i * RTE_ACL_MAX_CATEGORIES + ACL_ALLOW];
-		if (result != test_data[i].allow) {
-			printf("Line %i: Error in allow results at %i "
-					"(expected %"PRIu32" got %"PRIu32")!\n",
-					__LINE__, i, test_data[i].allow,
-					result);
-			ret = -EINVAL;
+	ret = test_classify_verify(test_data, results, dim);
+	if (ret != 0)
+		goto err;
+
+	/* repeat the checks for every method supported by this cpu */
+	for (j = 0; j != RTE_DIM(classify_algs); j++) {
+
+		ret = rte_acl_set_ctx_classify(acx, classify_algs[j]);
+		if (ret == -ENOTSUP)
+			continue;
+		if (ret != 0) {
+			printf("Line %i: failed to set classify method %d!\n",
+				__LINE__, classify_algs[j]);
 			goto err;
 		}
-	}
 
-	/* check if we deny everything we should deny */
-	for (i = 0; i < (int) dim; i++) {
-		result = results[i * RTE_ACL_MAX_CATEGORIES + ACL_DENY];
-		if (result != test_data[i].deny) {
-			printf("Line %i: Error in deny results at %i "
-					"(expected %"PRIu32" got %"PRIu32")!\n",
-					__LINE__, i, test_data[i].deny,
-					result);
-			ret = -EINVAL;
-			goto err;
+		for (count = 0; count <= dim; count++) {
+			ret = rte_acl_classify(acx, data, results,
+					count, RTE_ACL_MAX_CATEGORIES);
+			if (ret != 0) {
+				printf("Line %i: classify method %d failed!\n",
+					__LINE__, classify_algs[j]);
+				goto err;
+			}
+
+			ret = test_classify_verify(test_data, results, count);
+			if (ret != 0) {
+				printf("Line %i: classify method %d, "
+					"count %u failed!\n",
+					__LINE__, classify_algs[j], count);
+				goto err;
+			}
 		}
 	}
 
 	ret = 0;
 
 err:
+	/* restore default classify method */
+	rte_acl_set_ctx_classify(acx, RTE_ACL_CLASSIFY_DEFAULT);
 	/* swap data back to cpu order so that next time tests don't fail */
 	bswap_test_data(test_data, dim, 0);
 	return ret;
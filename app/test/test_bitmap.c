@@ -70,6 +70,36 @@ test_bitmap_scan_operations(struct rte_bitmap *bmp)
 		return TEST_FAILED;
 	}
 
+	/* Skip empty slabs within and across array2 cache lines. */
+	rte_bitmap_reset(bmp);
+	rte_bitmap_set_slab(bmp, 2 * RTE_BITMAP_SLAB_BIT_SIZE, slab1_magic);
+	rte_bitmap_set_slab(bmp, 6 * RTE_BITMAP_SLAB_BIT_SIZE, slab2_magic);
+	rte_bitmap_set_slab(bmp, 9 * RTE_BITMAP_SLAB_BIT_SIZE, slab1_magic);
+
+	if (!rte_bitmap_scan(bmp, &pos, &out_slab) ||
+	    pos != 2 * RTE_BITMAP_SLAB_BIT_SIZE || out_slab != slab1_magic) {
+		printf("Sparse scan operation failed.\n");
+		return TEST_FAILED;
+	}
+
+	if (!rte_bitmap_scan(bmp, &pos, &out_slab) ||
+	    pos != 6 * RTE_BITMAP_SLAB_BIT_SIZE || out_slab != slab2_magic) {
+		printf("Sparse scan operation failed.\n");
+		return TEST_FAILED;
+	}
+
+	if (!rte_bitmap_scan(bmp, &pos, &out_slab) ||
+	    pos != 9 * RTE_BITMAP_SLAB_BIT_SIZE || out_slab != slab1_magic) {
+		printf("Sparse scan operation failed.\n");
+		return TEST_FAILED;
+	}
+
+	if (!rte_bitmap_scan(bmp, &pos, &out_slab) ||
+	    pos != 2 * RTE_BITMAP_SLAB_BIT_SIZE) {
+		printf("Sparse scan wrap around failed.\n");
+		return TEST_FAILED;
+	}
+
 	return TEST_SUCCESS;
 }
 
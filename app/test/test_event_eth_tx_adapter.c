@@ -31,6 +31,7 @@
 #define TEST_ETHDEV_PAIR_ID	PORT(PAIR_PORT_INDEX(0))
 
 #define EDEV_RETRY		0xffff
+#define VECTOR_SIZE		16
 
 struct event_eth_tx_adapter_test_params {
 	struct rte_mempool *mp;
@@ -457,6 +458,68 @@ tx_adapter_single(uint16_t port, uint16_t tx_queue_id,
 	return -1;
 }
 
+static int
+tx_adapter_vector(uint16_t port, uint16_t tx_queue_id,
+		struct rte_mbuf **m, uint16_t n, uint8_t qid,
+		struct rte_mempool *vmp)
+{
+	struct rte_mbuf *r[VECTOR_SIZE];
+	struct rte_event_vector *vec;
+	struct rte_event event;
+	unsigned int l, nb_rx;
+	uint16_t i;
+	int ret;
+
+	ret = rte_mempool_get(vmp, (void **)&vec);
+	TEST_ASSERT(ret == 0, "Failed to get event vector");
+
+	vec->nb_elem = n;
+	vec->attr_valid = 1;
+	vec->port = port;
+	vec->queue = tx_queue_id;
+	for (i = 0; i < n; i++)
+		vec->mbufs[i] = m[i];
+
+	event.queue_id = qid;
+	event.op = RTE_EVENT_OP_NEW;
+	event.event_type = RTE_EVENT_TYPE_CPU_VECTOR;
+	event.sched_type = RTE_SCHED_TYPE_ATOMIC;
+	event.vec = vec;
+
+	l = 0;
+	while (rte_event_enqueue_burst(TEST_DEV_ID, 0, &event, 1) != 1) {
+		l++;
+		if (l > EDEV_RETRY)
+			break;
+	}
+
+	TEST_ASSERT(l < EDEV_RETRY, "Unable to enqueue to eventdev");
+	l = 0;
+	nb_rx = 0;
+	while (l++ < EDEV_RETRY && nb_rx < n) {
+
+		if (eid != ~0ULL) {
+			ret = rte_service_run_iter_on_app_lcore(eid, 0);
+			TEST_ASSERT(ret == 0, "failed to run service %d", ret);
+		}
+
+		ret = rte_service_run_iter_on_app_lcore(tid, 0);
+		TEST_ASSERT(ret == 0, "failed to run service %d", ret);
+
+		nb_rx += rte_eth_rx_burst(TEST_ETHDEV_PAIR_ID, tx_queue_id,
+				&r[nb_rx], n - nb_rx);
+	}
+
+	TEST_ASSERT_EQUAL(nb_rx, n, "Failed to receive vector packets");
+	for (i = 0; i < n; i++)
+		TEST_ASSERT_EQUAL(r[i], m[i], "mbuf comparison failed"
+				" expected %p received %p", m[i], r[i]);
+	TEST_ASSERT_EQUAL(rte_mempool_avail_count(vmp), 1,
+			"Event vector not returned to its mempool");
+
+	return 0;
+}
+
 static int
 tx_adapter_service(void)
 {
@@ -466,6 +529,7 @@ tx_adapter_service(void)
 	uint8_t ev_port, ev_qid;
 	struct rte_mbuf  bufs[RING_SIZE];
 	struct rte_mbuf *pbufs[RING_SIZE];
+	struct rte_mempool *vmp;
 	struct rte_event_dev_info dev_info;
 	struct rte_event_dev_config dev_conf;
 	struct rte_event_queue_conf qconf;
@@ -596,14 +660,23 @@ tx_adapter_service(void)
 		}
 	}
 
+	vmp = rte_event_vector_pool_create("tx_vector_pool", 1, 0,
+			VECTOR_SIZE, SOCKET0);
+	TEST_ASSERT(vmp != NULL, "Failed to create event vector pool");
+	err = tx_adapter_vector(TEST_ETHDEV_ID, 0, pbufs, VECTOR_SIZE, ev_qid,
+			vmp);
+	rte_mempool_free(vmp);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
 	err = rte_event_eth_tx_adapter_stats_get(TEST_INST_ID, NULL);
 	TEST_ASSERT(err == -EINVAL, "Expected -EINVAL got %d", err);
 
 	err = rte_event_eth_tx_adapter_stats_get(TEST_INST_ID, &stats);
 	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
-	TEST_ASSERT_EQUAL(stats.tx_packets, MAX_NUM_QUEUE * RING_SIZE,
+	TEST_ASSERT_EQUAL(stats.tx_packets,
+			MAX_NUM_QUEUE * RING_SIZE + VECTOR_SIZE,
 			"stats.tx_packets expected %u got %"PRIu64,
-			MAX_NUM_QUEUE * RING_SIZE,
+			MAX_NUM_QUEUE * RING_SIZE + VECTOR_SIZE,
 			stats.tx_packets);
 
 	err = rte_event_eth_tx_adapter_stats_reset(TEST_INST_ID);
@@ -11,6 +11,7 @@
 #include <rte_ethdev.h>
 #include <rte_eventdev.h>
 #include <rte_event_timer_adapter.h>
+#include <rte_malloc.h>
 #include <rte_mempool.h>
 #include <rte_launch.h>
 #include <rte_lcore.h>
@@ -281,7 +282,8 @@ test_port_conf_cb(uint16_t id, uint8_t event_dev_id, uint8_t *event_port_id,
 }
 
 static int
-_timdev_setup(uint64_t max_tmo_ns, uint64_t bkt_tck_ns)
+_timdev_setup_flags(uint64_t max_tmo_ns, uint64_t bkt_tck_ns,
+		    uint64_t flags, uint32_t nb_timers)
 {
 	struct rte_event_timer_adapter_info info;
 	struct rte_event_timer_adapter_conf config = {
@@ -289,8 +291,8 @@ _timdev_setup(uint64_t max_tmo_ns, uint64_t bkt_tck_ns)
 		.timer_adapter_id = TEST_ADAPTER_ID,
 		.timer_tick_ns = bkt_tck_ns,
 		.max_tmo_ns = max_tmo_ns,
-		.nb_timers = MAX_TIMERS * 10,
-		.flags = RTE_EVENT_TIMER_ADAPTER_F_ADJUST_RES,
+		.nb_timers = nb_timers,
+		.flags = RTE_EVENT_TIMER_ADAPTER_F_ADJUST_RES | flags,
 	};
 	uint32_t caps = 0;
 	const char *pool_name = "timdev_test_pool";
@@ -333,6 +335,13 @@ _timdev_setup(uint64_t max_tmo_ns, uint64_t bkt_tck_ns)
 	return TEST_SUCCESS;
 }
 
+static int
+_timdev_setup(uint64_t max_tmo_ns, uint64_t bkt_tck_ns)
+{
+	return _timdev_setup_flags(max_tmo_ns, bkt_tck_ns, 0,
+				   MAX_TIMERS * 10);
+}
+
 static int
 timdev_setup_usec(void)
 {
@@ -374,6 +383,38 @@ timdev_setup_sec_multicore(void)
 	return _timdev_setup(1E11, 1E9);
 }
 
+/* Same configurations as above, using the timer wheel based software
+ * implementation. Cancelled timers keep their wheel node until their original
+ * expiry, so leave room for the cancel tests arming a new timer every time.
+ */
+static int
+timdev_setup_usec_wheel(void)
+{
+	return using_services ?
+		_timdev_setup_flags(1E7, 1E5,
+				    RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL,
+				    MAX_TIMERS * 10) :
+		_timdev_setup_flags(1E5, 1E3,
+				    RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL,
+				    MAX_TIMERS * 10);
+}
+
+static int
+timdev_setup_msec_wheel(void)
+{
+	return _timdev_setup_flags(180 * NSECPERSEC, NSECPERSEC / 10,
+				   RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL,
+				   MAX_TIMERS * 10);
+}
+
+static int
+timdev_setup_sec_wheel(void)
+{
+	return _timdev_setup_flags(1E11, 1E9,
+				   RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL,
+				   MAX_TIMERS * 10);
+}
+
 static void
 timdev_teardown(void)
 {
@@ -1315,6 +1356,64 @@ event_timer_arm_expiry(void)
 	return TEST_SUCCESS;
 }
 
+/* Check that no timer expires before its timeout, whatever its tick count. */
+static int
+event_timer_arm_no_early_expiry(void)
+{
+#define NB_EARLY_TIMERS 8
+	struct rte_event_timer *evtims[NB_EARLY_TIMERS];
+	struct rte_event_timer *evtim;
+	struct rte_event evs[BATCH_SIZE];
+	const struct rte_event_timer init_tim = {
+		.ev.op = RTE_EVENT_OP_NEW,
+		.ev.queue_id = TEST_QUEUE_ID,
+		.ev.sched_type = RTE_SCHED_TYPE_ATOMIC,
+		.ev.priority = RTE_EVENT_DEV_PRIORITY_NORMAL,
+		.ev.event_type = RTE_EVENT_TYPE_TIMER,
+		.state = RTE_EVENT_TIMER_NOT_ARMED,
+	};
+	uint64_t armed, deadline, elapsed, timeout;
+	int ret, i, n, expired = 0;
+
+	ret = rte_mempool_get_bulk(eventdev_test_mempool, (void **)evtims,
+				   NB_EARLY_TIMERS);
+	TEST_ASSERT_EQUAL(ret, 0, "Failed to get event timers");
+
+	/* Expire in 0.1 to 0.8 sec */
+	for (i = 0; i < NB_EARLY_TIMERS; i++) {
+		*evtims[i] = init_tim;
+		evtims[i]->timeout_ticks = CALC_TICKS(i + 1);
+		evtims[i]->ev.event_ptr = evtims[i];
+	}
+
+	armed = rte_get_timer_cycles();
+	ret = rte_event_timer_arm_burst(timdev, evtims, NB_EARLY_TIMERS);
+	TEST_ASSERT_EQUAL(ret, NB_EARLY_TIMERS, "Failed to arm event timers: %s",
+			  rte_strerror(rte_errno));
+
+	deadline = armed + 2 * rte_get_timer_hz();
+	while (expired < NB_EARLY_TIMERS && rte_get_timer_cycles() < deadline) {
+		n = rte_event_dequeue_burst(evdev, TEST_PORT_ID, evs,
+					    RTE_DIM(evs), 0);
+		elapsed = rte_get_timer_cycles() - armed;
+		for (i = 0; i < n; i++) {
+			evtim = evs[i].event_ptr;
+			timeout = evtim->timeout_ticks * global_info_bkt_tck_ns *
+				  rte_get_timer_hz() / NSECPERSEC;
+			TEST_ASSERT(elapsed >= timeout, "Timer of %"PRIu64
+				    " ticks expired after %"PRIu64" cycles, "
+				    "before its timeout of %"PRIu64" cycles",
+				    evtim->timeout_ticks, elapsed, timeout);
+			rte_mempool_put(eventdev_test_mempool, evtim);
+		}
+		expired += n;
+	}
+	TEST_ASSERT_EQUAL(expired, NB_EARLY_TIMERS, "Dequeued incorrect number "
+			  "(%d) of timer expiry events", expired);
+
+	return TEST_SUCCESS;
+}
+
 /* Check that rearming a timer works as expected. */
 static int
 event_timer_arm_rearm(void)
@@ -1775,6 +1874,92 @@ adapter_create_max(void)
 	return TEST_SUCCESS;
 }
 
+#define PERF_TIMERS (1 << 18)
+#define PERF_BURST 32
+
+/* Arm and cancel a large number of long running timers in bursts */
+static int
+_arm_cancel_perf(const char *name, uint64_t flags)
+{
+	struct rte_event_timer *evtims, *burst[PERF_BURST];
+	uint64_t arm_cycles = 0, cancel_cycles = 0;
+	uint64_t start;
+	int ret = TEST_FAILED;
+	int i, j;
+	const struct rte_event_timer tim = {
+		.ev.op = RTE_EVENT_OP_NEW,
+		.ev.queue_id = 0,
+		.ev.sched_type = RTE_SCHED_TYPE_ATOMIC,
+		.ev.priority = RTE_EVENT_DEV_PRIORITY_NORMAL,
+		.ev.event_type =  RTE_EVENT_TYPE_TIMER,
+		.state = RTE_EVENT_TIMER_NOT_ARMED,
+	};
+
+	/* Max timeout is 100sec and bucket interval is 1sec */
+	if (_timdev_setup_flags(1E11, 1E9, flags, PERF_TIMERS * 2) !=
+			TEST_SUCCESS)
+		return TEST_FAILED;
+
+	evtims = rte_malloc(NULL, PERF_TIMERS * sizeof(*evtims), 0);
+	if (evtims == NULL) {
+		printf("Failed to allocate event timers\n");
+		goto out;
+	}
+
+	for (i = 0; i < PERF_TIMERS; i++) {
+		evtims[i] = tim;
+		evtims[i].ev.event_ptr = &evtims[i];
+	}
+
+	for (i = 0; i < PERF_TIMERS; i += PERF_BURST) {
+		for (j = 0; j < PERF_BURST; j++)
+			burst[j] = &evtims[i + j];
+
+		start = rte_rdtsc();
+		if (rte_event_timer_arm_tmo_tick_burst(timdev, burst,
+				CALC_TICKS(90), PERF_BURST) != PERF_BURST) {
+			printf("Failed to arm timers: %d\n", rte_errno);
+			goto out;
+		}
+		arm_cycles += rte_rdtsc() - start;
+	}
+
+	for (i = 0; i < PERF_TIMERS; i += PERF_BURST) {
+		for (j = 0; j < PERF_BURST; j++)
+			burst[j] = &evtims[i + j];
+
+		start = rte_rdtsc();
+		if (rte_event_timer_cancel_burst(timdev, burst, PERF_BURST) !=
+				PERF_BURST) {
+			printf("Failed to cancel timers: %d\n", rte_errno);
+			goto out;
+		}
+		cancel_cycles += rte_rdtsc() - start;
+	}
+
+	printf("%s: arm %.2f cycles/timer, cancel %.2f cycles/timer\n", name,
+	       (double)arm_cycles / PERF_TIMERS,
+	       (double)cancel_cycles / PERF_TIMERS);
+
+	ret = TEST_SUCCESS;
+out:
+	timdev_teardown();
+	rte_free(evtims);
+	return ret;
+}
+
+static int
+test_timer_arm_cancel_perf(void)
+{
+	TEST_ASSERT_SUCCESS(_arm_cancel_perf("skiplist", 0),
+			"Failed skiplist arm/cancel burst test");
+	TEST_ASSERT_SUCCESS(_arm_cancel_perf("timer wheel",
+				RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL),
+			"Failed timer wheel arm/cancel burst test");
+
+	return TEST_SUCCESS;
+}
+
 static struct unit_test_suite event_timer_adptr_functional_testsuite  = {
 	.suite_name = "event timer functional test suite",
 	.setup = testsuite_setup,
@@ -1798,6 +1983,19 @@ static struct unit_test_suite event_timer_adptr_functional_testsuite  = {
 				test_timer_cancel_multicore),
 		TEST_CASE_ST(timdev_setup_sec_multicore, timdev_teardown,
 				test_timer_cancel_burst_multicore),
+		TEST_CASE_ST(timdev_setup_usec_wheel, timdev_teardown,
+				test_timer_state),
+		TEST_CASE_ST(timdev_setup_usec_wheel, timdev_teardown,
+				test_timer_arm),
+		TEST_CASE_ST(timdev_setup_usec_wheel, timdev_teardown,
+				test_timer_arm_burst),
+		TEST_CASE_ST(timdev_setup_usec_wheel, timdev_teardown,
+				test_timer_arm_burst_multicore),
+		TEST_CASE_ST(timdev_setup_sec_wheel, timdev_teardown,
+				test_timer_cancel_random),
+		TEST_CASE_ST(timdev_setup_sec_wheel, timdev_teardown,
+				test_timer_cancel_burst_multicore),
+		TEST_CASE(test_timer_arm_cancel_perf),
 		TEST_CASE(adapter_create),
 		TEST_CASE_ST(timdev_setup_msec, NULL, adapter_free),
 		TEST_CASE_ST(timdev_setup_msec, timdev_teardown,
@@ -1830,6 +2028,20 @@ static struct unit_test_suite event_timer_adptr_functional_testsuite  = {
 				event_timer_cancel_double),
 		TEST_CASE_ST(timdev_setup_msec, timdev_teardown,
 				adapter_tick_resolution),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+				stat_inc_reset_ev_enq),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+			     event_timer_arm_expiry),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+			     event_timer_arm_no_early_expiry),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+				event_timer_arm_rearm),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+				event_timer_arm_invalid_timeout),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+				event_timer_cancel),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+				event_timer_cancel_double),
 		TEST_CASE(adapter_create_max),
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
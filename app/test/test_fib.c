@@ -311,6 +311,36 @@ check_fib(struct rte_fib *fib)
 	return TEST_SUCCESS;
 }
 
+/*
+ * Run check_fib() with every lookup implementation
+ * supported by the build and the CPU.
+ */
+static int
+check_fib_all_lookups(struct rte_fib *fib)
+{
+	static const enum rte_fib_lookup_type types[] = {
+		RTE_FIB_LOOKUP_DIR24_8_SCALAR_MACRO,
+		RTE_FIB_LOOKUP_DIR24_8_SCALAR_INLINE,
+		RTE_FIB_LOOKUP_DIR24_8_SCALAR_UNI,
+		RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512,
+	};
+	unsigned int i;
+	int ret;
+
+	for (i = 0; i < RTE_DIM(types); i++) {
+		ret = rte_fib_select_lookup(fib, types[i]);
+		if (ret == -ENOTSUP)
+			continue;
+		RTE_TEST_ASSERT(ret == 0, "Failed to select lookup type %d\n",
+			types[i]);
+		ret = check_fib(fib);
+		RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+			"Check_fib fails for lookup type %d\n", types[i]);
+	}
+
+	return TEST_SUCCESS;
+}
+
 int32_t
 test_lookup(void)
 {
@@ -336,7 +366,7 @@ test_lookup(void)
 	config.dir24_8.num_tbl8 = 127;
 	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
 	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
-	ret = check_fib(fib);
+	ret = check_fib_all_lookups(fib);
 	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
 		"Check_fib fails for DIR24_8_1B type\n");
 	rte_fib_free(fib);
@@ -345,7 +375,7 @@ test_lookup(void)
 	config.dir24_8.num_tbl8 = MAX_TBL8 - 1;
 	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
 	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
-	ret = check_fib(fib);
+	ret = check_fib_all_lookups(fib);
 	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
 		"Check_fib fails for DIR24_8_2B type\n");
 	rte_fib_free(fib);
@@ -354,7 +384,7 @@ test_lookup(void)
 	config.dir24_8.num_tbl8 = MAX_TBL8;
 	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
 	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
-	ret = check_fib(fib);
+	ret = check_fib_all_lookups(fib);
 	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
 		"Check_fib fails for DIR24_8_4B type\n");
 	rte_fib_free(fib);
@@ -363,7 +393,7 @@ test_lookup(void)
 	config.dir24_8.num_tbl8 = MAX_TBL8;
 	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
 	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
-	ret = check_fib(fib);
+	ret = check_fib_all_lookups(fib);
 	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
 		"Check_fib fails for DIR24_8_8B type\n");
 	rte_fib_free(fib);
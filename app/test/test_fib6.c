@@ -329,6 +329,34 @@ check_fib(struct rte_fib6 *fib)
 	return TEST_SUCCESS;
 }
 
+/*
+ * Run check_fib() with every lookup implementation
+ * supported by the build and the CPU.
+ */
+static int
+check_fib_all_lookups(struct rte_fib6 *fib)
+{
+	static const enum rte_fib6_lookup_type types[] = {
+		RTE_FIB6_LOOKUP_TRIE_SCALAR,
+		RTE_FIB6_LOOKUP_TRIE_VECTOR_AVX512,
+	};
+	unsigned int i;
+	int ret;
+
+	for (i = 0; i < RTE_DIM(types); i++) {
+		ret = rte_fib6_select_lookup(fib, types[i]);
+		if (ret == -ENOTSUP)
+			continue;
+		RTE_TEST_ASSERT(ret == 0, "Failed to select lookup type %d\n",
+			types[i]);
+		ret = check_fib(fib);
+		RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+			"Check_fib fails for lookup type %d\n", types[i]);
+	}
+
+	return TEST_SUCCESS;
+}
+
 int32_t
 test_lookup(void)
 {
@@ -354,7 +382,7 @@ test_lookup(void)
 	config.trie.num_tbl8 = MAX_TBL8 - 1;
 	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
 	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
-	ret = check_fib(fib);
+	ret = check_fib_all_lookups(fib);
 	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
 		"Check_fib fails for TRIE_2B type\n");
 	rte_fib6_free(fib);
@@ -363,7 +391,7 @@ test_lookup(void)
 	config.trie.num_tbl8 = MAX_TBL8;
 	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
 	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
-	ret = check_fib(fib);
+	ret = check_fib_all_lookups(fib);
 	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
 		"Check_fib fails for TRIE_4B type\n");
 	rte_fib6_free(fib);
@@ -372,7 +400,7 @@ test_lookup(void)
 	config.trie.num_tbl8 = MAX_TBL8;
 	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
 	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
-	ret = check_fib(fib);
+	ret = check_fib_all_lookups(fib);
 	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
 		"Check_fib fails for TRIE_8B type\n");
 	rte_fib6_free(fib);
@@ -65,10 +65,17 @@ get_max_nh(uint8_t nh_sz)
 static int
 test_fib6_perf(void)
 {
+	static const struct {
+		enum rte_fib6_lookup_type type;
+		const char *name;
+	} lookup_types[] = {
+		{ RTE_FIB6_LOOKUP_TRIE_SCALAR, "scalar" },
+		{ RTE_FIB6_LOOKUP_TRIE_VECTOR_AVX512, "avx512" },
+	};
 	struct rte_fib6 *fib = NULL;
 	struct rte_fib6_conf conf;
 	uint64_t begin, total_time;
-	unsigned int i, j;
+	unsigned int i, j, t;
 	uint64_t next_hop_add;
 	int status = 0;
 	int64_t count = 0;
@@ -112,27 +119,36 @@ test_fib6_perf(void)
 	printf("Average FIB Add: %g cycles\n",
 			(double)total_time / NUM_ROUTE_ENTRIES);
 
-	/* Measure bulk Lookup */
-	total_time = 0;
-	count = 0;
-
 	for (i = 0; i < NUM_IPS_ENTRIES; i++)
 		memcpy(ip_batch[i], large_ips_table[i].ip, 16);
 
-	for (i = 0; i < ITERATIONS; i++) {
-
-		/* Lookup per batch */
-		begin = rte_rdtsc();
-		rte_fib6_lookup_bulk(fib, ip_batch, next_hops, NUM_IPS_ENTRIES);
-		total_time += rte_rdtsc() - begin;
-
-		for (j = 0; j < NUM_IPS_ENTRIES; j++)
-			if (next_hops[j] == 0)
-				count++;
-	}
-	printf("BULK FIB Lookup: %.1f cycles (fails = %.1f%%)\n",
+	/* Measure bulk Lookup for each implementation */
+	for (t = 0; t < RTE_DIM(lookup_types); t++) {
+		if (rte_fib6_select_lookup(fib, lookup_types[t].type) != 0) {
+			printf("BULK FIB Lookup %s: not supported\n",
+				lookup_types[t].name);
+			continue;
+		}
+
+		total_time = 0;
+		count = 0;
+		for (i = 0; i < ITERATIONS; i++) {
+
+			/* Lookup per batch */
+			begin = rte_rdtsc();
+			rte_fib6_lookup_bulk(fib, ip_batch, next_hops,
+				NUM_IPS_ENTRIES);
+			total_time += rte_rdtsc() - begin;
+
+			for (j = 0; j < NUM_IPS_ENTRIES; j++)
+				if (next_hops[j] == 0)
+					count++;
+		}
+		printf("BULK FIB Lookup %s: %.1f cycles (fails = %.1f%%)\n",
+			lookup_types[t].name,
 			(double)total_time / ((double)ITERATIONS * BATCH_SIZE),
 			(count * 100.0) / (double)(ITERATIONS * BATCH_SIZE));
+	}
 
 	/* Delete */
 	status = 0;
@@ -319,6 +319,15 @@ print_route_distribution(const struct route_rule *table, uint32_t n)
 static int
 test_fib_perf(void)
 {
+	static const struct {
+		enum rte_fib_lookup_type type;
+		const char *name;
+	} lookup_types[] = {
+		{ RTE_FIB_LOOKUP_DIR24_8_SCALAR_MACRO, "scalar macro" },
+		{ RTE_FIB_LOOKUP_DIR24_8_SCALAR_INLINE, "scalar inline" },
+		{ RTE_FIB_LOOKUP_DIR24_8_SCALAR_UNI, "scalar uni" },
+		{ RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512, "avx512" },
+	};
 	struct rte_fib *fib = NULL;
 	struct rte_fib_conf config;
 
@@ -328,7 +337,7 @@ test_fib_perf(void)
 	config.dir24_8.nh_sz = RTE_FIB_DIR24_8_4B;
 	config.dir24_8.num_tbl8 = 65535;
 	uint64_t begin, total_time;
-	unsigned int i, j;
+	unsigned int i, j, t;
 	uint32_t next_hop_add = 0xAA;
 	int status = 0;
 	int64_t count = 0;
@@ -361,33 +370,42 @@ test_fib_perf(void)
 	printf("Average FIB Add: %g cycles\n",
 			(double)total_time / NUM_ROUTE_ENTRIES);
 
-	/* Measure bulk Lookup */
-	total_time = 0;
-	count = 0;
-	for (i = 0; i < ITERATIONS; i++) {
-		static uint32_t ip_batch[BATCH_SIZE];
-		uint64_t next_hops[BULK_SIZE];
-
-		/* Create array of random IP addresses */
-		for (j = 0; j < BATCH_SIZE; j++)
-			ip_batch[j] = rte_rand();
-
-		/* Lookup per batch */
-		begin = rte_rdtsc();
-		for (j = 0; j < BATCH_SIZE; j += BULK_SIZE) {
-			uint32_t k;
-			rte_fib_lookup_bulk(fib, &ip_batch[j], next_hops,
-				BULK_SIZE);
-			for (k = 0; k < BULK_SIZE; k++)
-				if (unlikely(!(next_hops[k] != 0)))
-					count++;
+	/* Measure bulk Lookup for each implementation */
+	for (t = 0; t < RTE_DIM(lookup_types); t++) {
+		if (rte_fib_select_lookup(fib, lookup_types[t].type) != 0) {
+			printf("BULK FIB Lookup %s: not supported\n",
+				lookup_types[t].name);
+			continue;
 		}
 
-		total_time += rte_rdtsc() - begin;
-	}
-	printf("BULK FIB Lookup: %.1f cycles (fails = %.1f%%)\n",
+		total_time = 0;
+		count = 0;
+		for (i = 0; i < ITERATIONS; i++) {
+			static uint32_t ip_batch[BATCH_SIZE];
+			uint64_t next_hops[BULK_SIZE];
+
+			/* Create array of random IP addresses */
+			for (j = 0; j < BATCH_SIZE; j++)
+				ip_batch[j] = rte_rand();
+
+			/* Lookup per batch */
+			begin = rte_rdtsc();
+			for (j = 0; j < BATCH_SIZE; j += BULK_SIZE) {
+				uint32_t k;
+				rte_fib_lookup_bulk(fib, &ip_batch[j],
+					next_hops, BULK_SIZE);
+				for (k = 0; k < BULK_SIZE; k++)
+					if (unlikely(!(next_hops[k] != 0)))
+						count++;
+			}
+
+			total_time += rte_rdtsc() - begin;
+		}
+		printf("BULK FIB Lookup %s: %.1f cycles (fails = %.1f%%)\n",
+			lookup_types[t].name,
 			(double)total_time / ((double)ITERATIONS * BATCH_SIZE),
 			(count * 100.0) / (double)(ITERATIONS * BATCH_SIZE));
+	}
 
 	/* Delete */
 	status = 0;
@@ -760,6 +760,98 @@ test_print_stats(void)
 	return 0;
 }
 
+static uint64_t source_hist_calls;
+
+static int
+graph_hist_stats_cb(bool is_first, bool is_last, void *cookie,
+		    const struct rte_graph_cluster_node_stats *st)
+{
+	uint64_t objs_calls = 0, cycles_calls = 0;
+	int i;
+
+	RTE_SET_USED(is_first);
+	RTE_SET_USED(is_last);
+	RTE_SET_USED(cookie);
+
+	for (i = 0; i < RTE_GRAPH_STATS_HIST_BINS; i++) {
+		objs_calls += st->objs_hist[i];
+		cycles_calls += st->cycles_hist[i];
+	}
+
+	if (objs_calls != cycles_calls || objs_calls > st->calls) {
+		printf("Histogram miss match for node = %s objs = %"PRId64", cycles = %"PRId64", calls = %"PRId64"\n",
+		       st->name, objs_calls, cycles_calls, st->calls);
+		return -1;
+	}
+
+	if (st->id == rte_node_from_name(node_patterns[0]))
+		source_hist_calls = objs_calls;
+
+	return 0;
+}
+
+static int
+test_stats_sampling(void)
+{
+	struct rte_graph_cluster_stats_param s_param;
+	struct rte_graph_cluster_stats *stats;
+	const char *pattern = "worker0";
+	struct rte_graph *graph;
+	int i, rc = 0;
+
+	if (!rte_graph_has_stats_feature())
+		return 0;
+
+	graph = rte_graph_lookup("worker0");
+	if (!graph) {
+		printf("Graph lookup failed\n");
+		return -1;
+	}
+
+	if (rte_graph_stats_sample_set(graph_id, 0) != -EINVAL) {
+		printf("Zero sample interval accepted\n");
+		return -1;
+	}
+
+	if (rte_graph_stats_sample_set(graph_id, 4) ||
+	    rte_graph_stats_hist_enable(graph_id, true)) {
+		printf("Unable to configure stats sampling\n");
+		return -1;
+	}
+
+	/* Source node runs once per walk, so two out of eight are sampled */
+	for (i = 0; i < 8; i++)
+		rte_graph_walk(graph);
+
+	memset(&s_param, 0, sizeof(s_param));
+	s_param.socket_id = SOCKET_ID_ANY;
+	s_param.graph_patterns = &pattern;
+	s_param.nb_graph_patterns = 1;
+	s_param.fn = graph_hist_stats_cb;
+
+	stats = rte_graph_cluster_stats_create(&s_param);
+	if (stats == NULL) {
+		printf("Unable to get stats\n");
+		rc = -1;
+		goto restore;
+	}
+	source_hist_calls = 0;
+	rte_graph_cluster_stats_get(stats, 0);
+	rte_graph_cluster_stats_destroy(stats);
+
+	if (source_hist_calls != 2) {
+		printf("Sampled source calls expected = 2, got = %"PRId64"\n",
+		       source_hist_calls);
+		rc = -1;
+	}
+
+restore:
+	rte_graph_stats_hist_enable(graph_id, false);
+	rte_graph_stats_sample_set(graph_id, 1);
+
+	return rc;
+}
+
 static int
 graph_setup(void)
 {
@@ -799,6 +891,7 @@ static struct unit_test_suite graph_testsuite = {
 		TEST_CASE(test_graph_lookup_functions),
 		TEST_CASE(test_graph_walk),
 		TEST_CASE(test_print_stats),
+		TEST_CASE(test_stats_sampling),
 		TEST_CASES_END(), /**< NULL terminate unit test array */
 	},
 };
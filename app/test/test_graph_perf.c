@@ -29,6 +29,7 @@
 #define SINKS(map)	     RTE_DIM(map[0])
 
 #define MAX_EDGES_PER_NODE 7
+#define MAX_DISPATCH_LCORES 4
 
 struct test_node_data {
 	uint8_t node_id;
@@ -40,6 +41,9 @@ struct test_node_data {
 struct test_graph_perf {
 	uint16_t nb_nodes;
 	rte_graph_t graph_id;
+	uint8_t nb_dispatch;
+	rte_graph_t dispatch_id[MAX_DISPATCH_LCORES];
+	unsigned int dispatch_lcore[MAX_DISPATCH_LCORES];
 	struct test_node_data *node_data;
 };
 
@@ -334,6 +338,7 @@ graph_init(const char *gname, uint8_t nb_srcs, uint8_t nb_sinks,
 
 	graph_data = mz->addr;
 	graph_data->nb_nodes = 0;
+	graph_data->nb_dispatch = 0;
 	graph_data->node_data =
 		malloc(sizeof(struct test_node_data) *
 		       (nb_srcs + nb_sinks + stages * nodes_per_stage));
@@ -615,21 +620,10 @@ _graph_perf_wrapper(void *args)
 }
 
 static int
-measure_perf_get(rte_graph_t graph_id)
+graph_perf_stats_collect(const char *pattern)
 {
-	const char *pattern = rte_graph_id_to_name(graph_id);
-	uint32_t lcore_id = rte_get_next_lcore(-1, 1, 0);
 	struct rte_graph_cluster_stats_param param;
 	struct rte_graph_cluster_stats *stats;
-	struct graph_lcore_data *data;
-
-	data = rte_zmalloc("Graph_perf", sizeof(struct graph_lcore_data),
-			   RTE_CACHE_LINE_SIZE);
-	data->graph_id = graph_id;
-	data->done = 0;
-
-	/* Run graph worker thread function */
-	rte_eal_remote_launch(_graph_perf_wrapper, data, lcore_id);
 
 	/* Collect stats for few msecs */
 	if (rte_graph_has_stats_feature()) {
@@ -653,10 +647,163 @@ measure_perf_get(rte_graph_t graph_id)
 	} else
 		rte_delay_ms(1E3);
 
+	return 0;
+}
+
+static int
+measure_perf_get(rte_graph_t graph_id)
+{
+	const char *pattern = rte_graph_id_to_name(graph_id);
+	uint32_t lcore_id = rte_get_next_lcore(-1, 1, 0);
+	struct graph_lcore_data *data;
+	int rc;
+
+	data = rte_zmalloc("Graph_perf", sizeof(struct graph_lcore_data),
+			   RTE_CACHE_LINE_SIZE);
+	data->graph_id = graph_id;
+	data->done = 0;
+
+	/* Run graph worker thread function */
+	rte_eal_remote_launch(_graph_perf_wrapper, data, lcore_id);
+
+	rc = graph_perf_stats_collect(pattern);
+
 	data->done = 1;
 	rte_eal_wait_lcore(lcore_id);
 
-	return 0;
+	return rc;
+}
+
+/* Pin the graph stages to lcores and create a dispatch graph per lcore */
+static int
+graph_dispatch_init(const uint8_t stage_lcore[], uint32_t stages)
+{
+	unsigned int lcores[MAX_DISPATCH_LCORES];
+	struct test_graph_perf *graph_data;
+	char gname[RTE_GRAPH_NAMESIZE];
+	struct rte_graph_param gconf;
+	const struct rte_memzone *mz;
+	unsigned int lcore_id = -1;
+	unsigned int stage, idx;
+	const char **node_names;
+	uint8_t nb_lcores = 0;
+	struct rte_graph *graph;
+	struct rte_node *node;
+	rte_graph_off_t off;
+	rte_node_t count;
+	uint32_t i;
+	int rc = 0;
+
+	mz = rte_memzone_lookup(TEST_GRAPH_PERF_MZ);
+	if (mz == NULL)
+		return -ENOMEM;
+	graph_data = mz->addr;
+	graph = rte_graph_lookup(rte_graph_id_to_name(graph_data->graph_id));
+
+	for (i = 0; i < stages; i++)
+		nb_lcores = RTE_MAX(nb_lcores, stage_lcore[i] + 1);
+
+	/* Leave nb_dispatch to zero to skip the test without enough lcores */
+	for (i = 0; i < nb_lcores; i++) {
+		lcore_id = rte_get_next_lcore(lcore_id, 1, 0);
+		if (lcore_id >= RTE_MAX_LCORE)
+			return 0;
+		lcores[i] = lcore_id;
+	}
+
+	node_names = malloc(sizeof(char *) * graph->nb_nodes);
+	if (node_names == NULL)
+		return -ENOMEM;
+
+	/* Sources run on the first lcore and sinks along the last stage */
+	rte_graph_foreach_node(count, off, graph, node) {
+		node_names[count] = node->name;
+		if (!strncmp(node->name, TEST_GRAPH_SRC_NAME,
+			     strlen(TEST_GRAPH_SRC_NAME)))
+			lcore_id = lcores[0];
+		else if (sscanf(node->name, TEST_GRAPH_WRK_NAME "-%u-%u",
+				&stage, &idx) == 2 && stage < stages)
+			lcore_id = lcores[stage_lcore[stage]];
+		else
+			lcore_id = lcores[stage_lcore[stages - 1]];
+		rte_graph_dispatch_node_lcore_set(node->name, lcore_id);
+	}
+
+	gconf.socket_id = SOCKET_ID_ANY;
+	gconf.nb_node_patterns = graph->nb_nodes;
+	gconf.node_patterns = node_names;
+
+	for (i = 0; i < nb_lcores; i++) {
+		snprintf(gname, sizeof(gname), "%s_dispatch_%u", graph->name,
+			 i);
+		graph_data->dispatch_id[i] = rte_graph_create(gname, &gconf);
+		if (graph_data->dispatch_id[i] == RTE_GRAPH_ID_INVALID) {
+			printf("Graph creation failed with error = %d\n",
+			       rte_errno);
+			rc = -rte_errno;
+			break;
+		}
+		graph_data->dispatch_lcore[i] = lcores[i];
+		graph_data->nb_dispatch++;
+
+		rc = rte_graph_dispatch_core_bind(graph_data->dispatch_id[i],
+						  lcores[i]);
+		if (rc) {
+			printf("Graph bind to lcore %u failed with error = %d\n",
+			       lcores[i], rc);
+			break;
+		}
+	}
+
+	free(node_names);
+	return rc;
+}
+
+static int
+measure_perf_dispatch(void)
+{
+	struct graph_lcore_data data[MAX_DISPATCH_LCORES];
+	struct test_graph_perf *graph_data;
+	char pattern[RTE_GRAPH_NAMESIZE];
+	const struct rte_memzone *mz;
+	const char *name;
+	uint8_t i;
+	int rc;
+
+	mz = rte_memzone_lookup(TEST_GRAPH_PERF_MZ);
+	if (mz == NULL)
+		return -ENOMEM;
+	graph_data = mz->addr;
+
+	if (graph_data->nb_dispatch == 0) {
+		printf("Not enough lcores to run the dispatch model\n");
+		return TEST_SKIPPED;
+	}
+
+	/* Run-to-completion on a single lcore as reference */
+	name = rte_graph_id_to_name(graph_data->graph_id);
+	printf("Run-to-completion model:\n");
+	rc = measure_perf_get(graph_data->graph_id);
+	if (rc)
+		return rc;
+
+	printf("Dispatch model on %u lcores:\n", graph_data->nb_dispatch);
+	for (i = 0; i < graph_data->nb_dispatch; i++) {
+		data[i].graph_id = graph_data->dispatch_id[i];
+		data[i].done = 0;
+		rte_eal_remote_launch(_graph_perf_wrapper, &data[i],
+				      graph_data->dispatch_lcore[i]);
+	}
+
+	snprintf(pattern, sizeof(pattern), "%s_dispatch_*", name);
+	rc = graph_perf_stats_collect(pattern);
+
+	for (i = 0; i < graph_data->nb_dispatch; i++)
+		data[i].done = 1;
+	for (i = 0; i < graph_data->nb_dispatch; i++)
+		rte_eal_wait_lcore(graph_data->dispatch_lcore[i]);
+
+	return rc;
 }
 
 static inline void
@@ -664,11 +811,25 @@ graph_fini(void)
 {
 	const struct rte_memzone *mz = rte_memzone_lookup(TEST_GRAPH_PERF_MZ);
 	struct test_graph_perf *graph_data;
+	struct rte_graph *graph;
+	struct rte_node *node;
+	rte_graph_off_t off;
+	rte_node_t count;
 
 	if (mz == NULL)
 		return;
 	graph_data = mz->addr;
 
+	/* Graph ids are recycled, destroy in the reverse creation order */
+	while (graph_data->nb_dispatch)
+		rte_graph_destroy(
+			graph_data->dispatch_id[--graph_data->nb_dispatch]);
+	graph = rte_graph_lookup(rte_graph_id_to_name(graph_data->graph_id));
+	if (graph != NULL)
+		rte_graph_foreach_node(count, off, graph, node)
+			rte_graph_dispatch_node_lcore_set(
+				node->name, RTE_GRAPH_DISPATCH_LCORE_ANY);
+
 	rte_graph_destroy(graph_data->graph_id);
 	free(graph_data->node_data);
 	rte_memzone_free(rte_memzone_lookup(TEST_GRAPH_PERF_MZ));
@@ -730,6 +891,24 @@ graph_parallel_tree_5s_4n_4src_4snk(void)
 	return measure_perf();
 }
 
+static inline int
+graph_hr_4s_1n_1src_1snk_dispatch_2lc(void)
+{
+	return measure_perf_dispatch();
+}
+
+static inline int
+graph_hr_4s_1n_1src_1snk_dispatch_4lc(void)
+{
+	return measure_perf_dispatch();
+}
+
+static inline int
+graph_parallel_tree_5s_4n_4src_4snk_dispatch_3lc(void)
+{
+	return measure_perf_dispatch();
+}
+
 /* Graph Topology
  * nodes per stage:	1
  * stages:		4
@@ -968,6 +1147,66 @@ graph_init_parallel_tree(void)
 			  snk_map, edge_map, 0);
 }
 
+/* Graph Topology
+ * nodes per stage:	1
+ * stages:		4
+ * src:			1
+ * sink:		1
+ * lcores:		2, stages 0-1 on first and 2-3 on second
+ */
+static inline int
+graph_init_hr_dispatch_2lc(void)
+{
+	uint8_t stage_lcore[] = {0, 0, 1, 1};
+	int rc;
+
+	rc = graph_init_hr();
+	if (rc)
+		return rc;
+
+	return graph_dispatch_init(stage_lcore, RTE_DIM(stage_lcore));
+}
+
+/* Graph Topology
+ * nodes per stage:	1
+ * stages:		4
+ * src:			1
+ * sink:		1
+ * lcores:		4, one stage per lcore
+ */
+static inline int
+graph_init_hr_dispatch_4lc(void)
+{
+	uint8_t stage_lcore[] = {0, 1, 2, 3};
+	int rc;
+
+	rc = graph_init_hr();
+	if (rc)
+		return rc;
+
+	return graph_dispatch_init(stage_lcore, RTE_DIM(stage_lcore));
+}
+
+/* Graph Topology
+ * nodes per stage:	4
+ * stages:		5
+ * src:			4
+ * sink:		4
+ * lcores:		3, stages 0-1 on first, 2-3 on second and 4 on third
+ */
+static inline int
+graph_init_parallel_tree_dispatch_3lc(void)
+{
+	uint8_t stage_lcore[] = {0, 0, 1, 1, 2};
+	int rc;
+
+	rc = graph_init_parallel_tree();
+	if (rc)
+		return rc;
+
+	return graph_dispatch_init(stage_lcore, RTE_DIM(stage_lcore));
+}
+
 /** Graph Creation cheat sheet
  *  edge_map -> dictates graph flow from worker stage 0 to worker stage n-1.
  *  src_map  -> dictates source nodes enqueue percentage to worker stage 0.
@@ -1050,6 +1289,12 @@ static struct unit_test_suite graph_perf_testsuite = {
 			     graph_reverse_tree_3s_4n_1src_1snk),
 		TEST_CASE_ST(graph_init_parallel_tree, graph_fini,
 			     graph_parallel_tree_5s_4n_4src_4snk),
+		TEST_CASE_ST(graph_init_hr_dispatch_2lc, graph_fini,
+			     graph_hr_4s_1n_1src_1snk_dispatch_2lc),
+		TEST_CASE_ST(graph_init_hr_dispatch_4lc, graph_fini,
+			     graph_hr_4s_1n_1src_1snk_dispatch_4lc),
+		TEST_CASE_ST(graph_init_parallel_tree_dispatch_3lc, graph_fini,
+			     graph_parallel_tree_5s_4n_4src_4snk_dispatch_3lc),
 		TEST_CASES_END(), /**< NULL terminate unit test array */
 	},
 };
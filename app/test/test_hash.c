@@ -1579,6 +1579,355 @@ static int test_hash_iteration(uint32_t ext_table)
 	return -1;
 }
 
+/* Last resize at 4096 keys, so that deletes run while keys are moved */
+#define RESIZABLE_KEYS (4096 + 64)
+#define RESIZABLE_BULK 32
+
+/* Check that keys [0, num) are found with the expected data */
+static int
+test_resizable_check(const struct rte_hash *h, uint32_t num, uint32_t step)
+{
+	uint32_t keys[RESIZABLE_BULK];
+	const void *key_ptrs[RESIZABLE_BULK];
+	void *data[RESIZABLE_BULK];
+	int32_t positions[RESIZABLE_BULK];
+	uint64_t hit_mask;
+	uint32_t i, j, n;
+	void *d;
+
+	for (i = 0; i < num; i += step) {
+		if (rte_hash_lookup_data(h, &i, &d) < 0 ||
+				(uintptr_t)d != i + 1) {
+			printf("key %u not found\n", i);
+			return -1;
+		}
+	}
+
+	for (i = 0; i < num; i += n) {
+		n = RTE_MIN((num - i + step - 1) / step,
+				(uint32_t)RESIZABLE_BULK);
+		for (j = 0; j < n; j++) {
+			keys[j] = i + j * step;
+			key_ptrs[j] = &keys[j];
+		}
+		if (rte_hash_lookup_bulk_data(h, key_ptrs, n, &hit_mask,
+				data) != (int)n) {
+			printf("bulk lookup from key %u failed\n", i);
+			return -1;
+		}
+		for (j = 0; j < n; j++) {
+			if ((uintptr_t)data[j] != keys[j] + 1) {
+				printf("bulk lookup of key %u: bad data\n",
+					keys[j]);
+				return -1;
+			}
+		}
+		rte_hash_lookup_bulk(h, key_ptrs, n, positions);
+		for (j = 0; j < n; j++) {
+			if (positions[j] < 0) {
+				printf("bulk lookup of key %u failed\n",
+					keys[j]);
+				return -1;
+			}
+		}
+		n *= step;
+	}
+
+	return 0;
+}
+
+/*
+ * Add keys to a resizable table created much smaller than needed,
+ * checking all of them are found while the table grows.
+ */
+static int
+test_resizable(int rcu_mode)
+{
+	struct rte_hash_parameters params = {
+		.name = "test_resizable",
+		.entries = 64,
+		.key_len = sizeof(uint32_t),
+		.hash_func = rte_jhash,
+		.socket_id = 0,
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_RESIZABLE,
+	};
+	struct rte_hash_rcu_config rcu_cfg = {0};
+	struct rte_rcu_qsbr *qsv = NULL;
+	struct rte_hash *handle;
+	const void *next_key;
+	void *next_data;
+	uint32_t i, iter = 0;
+	int ret;
+
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+	if (rcu_mode >= 0) {
+		qsv = rte_zmalloc(NULL, rte_rcu_qsbr_get_memsize(1),
+				RTE_CACHE_LINE_SIZE);
+		RETURN_IF_ERROR(qsv == NULL, "RCU QSBR allocation failed");
+		rte_rcu_qsbr_init(qsv, 1);
+		rcu_cfg.v = qsv;
+		rcu_cfg.mode = rcu_mode;
+		ret = rte_hash_rcu_qsbr_add(handle, &rcu_cfg);
+		RETURN_IF_ERROR(ret != 0, "RCU QSBR add failed");
+	}
+
+	for (i = 0; i < RESIZABLE_KEYS; i++) {
+		ret = rte_hash_add_key_data(handle, &i,
+				(void *)(uintptr_t)(i + 1));
+		RETURN_IF_ERROR(ret != 0, "failed to add key %u (%d)", i, ret);
+		/* Check while keys are being moved to a larger table */
+		if ((i & (i + 1)) == 0 || i % 1000 == 0)
+			RETURN_IF_ERROR(test_resizable_check(handle, i + 1, 1),
+				"lookup failed after %u keys", i + 1);
+	}
+	RETURN_IF_ERROR(rte_hash_max_key_id(handle) < RESIZABLE_KEYS,
+			"table did not grow");
+
+	/* Delete odd keys, before and after the move is complete */
+	for (i = 1; i < RESIZABLE_KEYS; i += 2) {
+		ret = rte_hash_del_key(handle, &i);
+		RETURN_IF_ERROR(ret < 0, "failed to delete key %u", i);
+	}
+	for (i = 1; i < RESIZABLE_KEYS; i += 2) {
+		ret = rte_hash_lookup(handle, &i);
+		RETURN_IF_ERROR(ret != -ENOENT, "deleted key %u found", i);
+	}
+	RETURN_IF_ERROR(test_resizable_check(handle, RESIZABLE_KEYS, 2),
+			"lookup failed after delete");
+
+	while ((ret = rte_hash_resize_step(handle, 16)) > 0)
+		;
+	RETURN_IF_ERROR(ret != 0, "resize step failed");
+	/* Deleted keys waiting in the defer queue are still counted */
+	ret = rte_hash_count(handle);
+	RETURN_IF_ERROR(ret < RESIZABLE_KEYS / 2 ||
+			(rcu_mode < 0 && ret != RESIZABLE_KEYS / 2),
+			"bad count %d", ret);
+
+	for (i = 0; rte_hash_iterate(handle, &next_key, &next_data,
+			&iter) >= 0; i++)
+		RETURN_IF_ERROR((uintptr_t)next_data !=
+				*(const uint32_t *)next_key + 1,
+				"iterate returned bad data");
+	RETURN_IF_ERROR(i != RESIZABLE_KEYS / 2, "iterated %u keys", i);
+
+	/* Deleted key indexes are reused */
+	for (i = 1; i < RESIZABLE_KEYS; i += 2) {
+		ret = rte_hash_add_key_data(handle, &i,
+				(void *)(uintptr_t)(i + 1));
+		RETURN_IF_ERROR(ret != 0, "failed to add key %u again", i);
+	}
+	RETURN_IF_ERROR(test_resizable_check(handle, RESIZABLE_KEYS, 1),
+			"lookup failed after add");
+
+	rte_hash_reset(handle);
+	RETURN_IF_ERROR(rte_hash_count(handle) != 0, "reset failed");
+
+	rte_hash_free(handle);
+	rte_free(qsv);
+	return 0;
+}
+
+#define BULK_ADD_KEYS		1024
+
+/*
+ * Add keys in bursts to a table too small for all of them, with a
+ * duplicate key in each burst, then update their data in bursts.
+ */
+static int
+test_add_bulk(uint8_t extra_flag)
+{
+	struct rte_hash_parameters params = {
+		.name = "test_add_bulk",
+		.entries = 256,
+		.key_len = sizeof(uint32_t),
+		.hash_func = rte_jhash,
+		.socket_id = 0,
+		.extra_flag = extra_flag,
+	};
+	uint32_t keys[RTE_HASH_LOOKUP_BULK_MAX];
+	const void *key_ptrs[RTE_HASH_LOOKUP_BULK_MAX];
+	hash_sig_t sigs[RTE_HASH_LOOKUP_BULK_MAX];
+	void *data[RTE_HASH_LOOKUP_BULK_MAX];
+	int32_t positions[RTE_HASH_LOOKUP_BULK_MAX];
+	struct rte_hash *handle;
+	uint32_t i, j, added = 0;
+	void *found;
+	int ret, ret_lookup;
+
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+	for (i = 0; i < BULK_ADD_KEYS; i += RTE_HASH_LOOKUP_BULK_MAX) {
+		for (j = 0; j < RTE_HASH_LOOKUP_BULK_MAX; j++) {
+			keys[j] = i + j;
+			key_ptrs[j] = &keys[j];
+		}
+		keys[RTE_HASH_LOOKUP_BULK_MAX - 1] = i;
+
+		ret = rte_hash_add_key_bulk(handle, key_ptrs,
+				RTE_HASH_LOOKUP_BULK_MAX, positions);
+		RETURN_IF_ERROR(ret < 0, "bulk add failed (%d)", ret);
+
+		for (j = 0; j < RTE_HASH_LOOKUP_BULK_MAX; j++) {
+			if (positions[j] < 0) {
+				RETURN_IF_ERROR(positions[j] != -ENOSPC,
+					"failed to add key %u (%d)", keys[j],
+					positions[j]);
+				ret++;
+				continue;
+			}
+			/* Keys move to another position when a table grows */
+			ret_lookup = rte_hash_lookup(handle, &keys[j]);
+			RETURN_IF_ERROR(ret_lookup < 0 ||
+					(ret_lookup != positions[j] &&
+					!(extra_flag &
+					RTE_HASH_EXTRA_FLAGS_RESIZABLE)),
+					"key %u not at its position", keys[j]);
+		}
+		RETURN_IF_ERROR(ret != RTE_HASH_LOOKUP_BULK_MAX,
+				"bad number of keys added");
+		RETURN_IF_ERROR(positions[0] >= 0 &&
+				!(extra_flag & RTE_HASH_EXTRA_FLAGS_RESIZABLE) &&
+				positions[RTE_HASH_LOOKUP_BULK_MAX - 1] !=
+				positions[0], "duplicate key added twice");
+		if (positions[0] >= 0)
+			added--;
+		for (j = 0; j < RTE_HASH_LOOKUP_BULK_MAX; j++)
+			added += positions[j] >= 0;
+	}
+
+	ret = rte_hash_count(handle);
+	RETURN_IF_ERROR(ret != (int)added, "bad count %d, expected %u",
+			ret, added);
+	/* The last key of each burst was replaced by a duplicate */
+	RETURN_IF_ERROR((extra_flag & RTE_HASH_EXTRA_FLAGS_RESIZABLE) &&
+			added != BULK_ADD_KEYS - BULK_ADD_KEYS /
+			RTE_HASH_LOOKUP_BULK_MAX, "resizable table is full");
+	RETURN_IF_ERROR(added == BULK_ADD_KEYS - BULK_ADD_KEYS /
+			RTE_HASH_LOOKUP_BULK_MAX &&
+			!(extra_flag & RTE_HASH_EXTRA_FLAGS_RESIZABLE),
+			"table did not fill up");
+
+	/* Update the data of the keys in the table */
+	for (i = 0; i < BULK_ADD_KEYS; i += RTE_HASH_LOOKUP_BULK_MAX) {
+		for (j = 0; j < RTE_HASH_LOOKUP_BULK_MAX; j++) {
+			keys[j] = i + j;
+			key_ptrs[j] = &keys[j];
+			sigs[j] = rte_hash_hash(handle, &keys[j]);
+			data[j] = (void *)(uintptr_t)(i + j + 1);
+		}
+		ret = rte_hash_add_key_with_hash_bulk_data(handle, key_ptrs,
+				sigs, data, RTE_HASH_LOOKUP_BULK_MAX, NULL);
+		RETURN_IF_ERROR(ret < 0, "bulk add with data failed (%d)",
+				ret);
+	}
+
+	ret = rte_hash_count(handle);
+	RETURN_IF_ERROR(ret < (int)added, "keys lost by update");
+	for (i = 0; i < BULK_ADD_KEYS; i++) {
+		if (rte_hash_lookup_data(handle, &i, &found) < 0)
+			continue;
+		RETURN_IF_ERROR((uintptr_t)found != i + 1,
+				"bad data for key %u", i);
+	}
+
+	rte_hash_free(handle);
+	return 0;
+}
+
+/* Grows from 64 to 128 and then 256 entries, and 512 with twice as many */
+#define RESIZABLE_NAME_KEYS 200
+
+/*
+ * Grow tables with names of the maximum length, and one character shorter,
+ * twice, checking that the tables they are made of do not clash and are
+ * not listed, and that count and iterate are right while keys are moved.
+ */
+static int
+test_resizable_name(void)
+{
+	char name[RTE_HASH_NAMESIZE];
+	char other_name[RTE_HASH_NAMESIZE];
+	struct rte_hash_parameters params = {
+		.name = name,
+		.entries = 64,
+		.key_len = sizeof(uint32_t),
+		.hash_func = rte_jhash,
+		.socket_id = 0,
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_RESIZABLE,
+	};
+	struct rte_hash *handle, *other;
+	const void *next_key;
+	void *next_data;
+	uint32_t i, n, iter;
+	int ret;
+
+	memset(name, 'r', sizeof(name) - 1);
+	name[sizeof(name) - 1] = '\0';
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+	strlcpy(other_name, name, sizeof(other_name));
+	other_name[sizeof(other_name) - 2] = '\0';
+	params.name = other_name;
+	other = rte_hash_create(&params);
+	RETURN_IF_ERROR(other == NULL, "hash creation with shorter name failed");
+
+	for (i = 0; i < RESIZABLE_NAME_KEYS; i++) {
+		ret = rte_hash_add_key_data(handle, &i,
+				(void *)(uintptr_t)(i + 1));
+		RETURN_IF_ERROR(ret != 0, "failed to add key %u (%d)", i, ret);
+		ret = rte_hash_add_key_data(other, &i,
+				(void *)(uintptr_t)(i + 1));
+		RETURN_IF_ERROR(ret != 0, "failed to add key %u to other (%d)",
+				i, ret);
+
+		ret = rte_hash_count(handle);
+		RETURN_IF_ERROR(ret != (int)i + 1, "bad count %d after %u keys",
+				ret, i + 1);
+		iter = 0;
+		for (n = 0; rte_hash_iterate(handle, &next_key, &next_data,
+				&iter) >= 0; n++)
+			RETURN_IF_ERROR((uintptr_t)next_data !=
+					*(const uint32_t *)next_key + 1,
+					"iterate returned bad data");
+		RETURN_IF_ERROR(n != i + 1, "iterated %u keys out of %u",
+				n, i + 1);
+	}
+	RETURN_IF_ERROR(rte_hash_max_key_id(handle) < 256,
+			"table did not grow twice");
+	RETURN_IF_ERROR(test_resizable_check(handle, RESIZABLE_NAME_KEYS, 1),
+			"lookup failed after growing");
+
+	/* The table is more than three quarters full, the step creates the
+	 * next table ahead, which the following adds grow into.
+	 */
+	while ((ret = rte_hash_resize_step(handle, 16)) > 0)
+		;
+	RETURN_IF_ERROR(ret != 0, "resize step failed");
+	for (i = RESIZABLE_NAME_KEYS; i < 2 * RESIZABLE_NAME_KEYS; i++) {
+		ret = rte_hash_add_key_data(handle, &i,
+				(void *)(uintptr_t)(i + 1));
+		RETURN_IF_ERROR(ret != 0, "failed to add key %u (%d)", i, ret);
+	}
+	RETURN_IF_ERROR(rte_hash_max_key_id(handle) < 512,
+			"table did not grow into the next table");
+	RETURN_IF_ERROR(test_resizable_check(handle, 2 * RESIZABLE_NAME_KEYS,
+			1), "lookup failed after growing again");
+
+	RETURN_IF_ERROR(rte_hash_find_existing(name) != handle,
+			"table not found by name");
+	RETURN_IF_ERROR(rte_hash_find_existing(other_name) != other,
+			"other table not found by name");
+
+	rte_hash_free(other);
+	rte_hash_free(handle);
+	return 0;
+}
+
 static uint8_t key[16] = {0x00, 0x01, 0x02, 0x03,
 			0x04, 0x05, 0x06, 0x07,
 			0x08, 0x09, 0x0a, 0x0b,
@@ -1857,6 +2206,27 @@ test_hash(void)
 	if (test_hash_iteration(1) < 0)
 		return -1;
 
+	/* resizable table, without and with RCU QSBR */
+	if (test_resizable(-1) < 0)
+		return -1;
+	if (test_resizable(RTE_HASH_QSBR_MODE_DQ) < 0)
+		return -1;
+	if (test_resizable(RTE_HASH_QSBR_MODE_SYNC) < 0)
+		return -1;
+	if (test_resizable_name() < 0)
+		return -1;
+
+	/* bulk insertion */
+	if (test_add_bulk(0) < 0)
+		return -1;
+	if (test_add_bulk(RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD) < 0)
+		return -1;
+	if (test_add_bulk(RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF |
+			RTE_HASH_EXTRA_FLAGS_EXT_TABLE) < 0)
+		return -1;
+	if (test_add_bulk(RTE_HASH_EXTRA_FLAGS_RESIZABLE) < 0)
+		return -1;
+
 	run_hash_func_tests();
 
 	if (test_crc32_hash_alg_equiv() < 0)
@@ -636,6 +636,227 @@ run_all_tbl_perf_tests(unsigned int with_pushes, unsigned int with_locks,
 	return 0;
 }
 
+/* Control operation of bulk lookup performance testing per key size. */
+#define BULK_ENTRIES (1 << 20)	/* How many entries. */
+#define BULK_KEYS (BULK_ENTRIES / 4 * 3)	/* 75% table utilization */
+#define BULK_ITERATIONS 4	/* How many times to look up all keys. */
+
+static const uint32_t bulk_key_lens[] = {8, 16, 32, 64};
+
+static uint64_t
+timed_bulk_lookups(struct rte_hash *hs, const uint8_t *bkeys,
+		uint32_t key_len, uint32_t num_keys, uint32_t expect_hits)
+{
+	uint32_t i, j, k, n;
+	int32_t ret;
+	uint64_t hit_mask, start, tm;
+	const void *keys_burst[RTE_HASH_LOOKUP_BULK_MAX];
+	void *ret_data[RTE_HASH_LOOKUP_BULK_MAX];
+
+	start = rte_rdtsc();
+
+	for (i = 0; i != BULK_ITERATIONS; i++) {
+		for (j = 0; j < num_keys; j += n) {
+			n = RTE_MIN(num_keys - j,
+				(uint32_t)RTE_HASH_LOOKUP_BULK_MAX);
+			for (k = 0; k != n; k++)
+				keys_burst[k] = bkeys + (j + k) * key_len;
+
+			ret = rte_hash_lookup_bulk_data(hs, keys_burst, n,
+				&hit_mask, ret_data);
+			if (expect_hits && ret != (int32_t)n) {
+				printf("Expect to find %u keys, but found %d\n",
+					n, ret);
+				return 0;
+			}
+		}
+	}
+
+	tm = rte_rdtsc() - start;
+	return tm / ((uint64_t)num_keys * BULK_ITERATIONS);
+}
+
+/*
+ * Measure rte_hash_lookup_bulk_data() for a big table with the key sizes
+ * that have a dedicated compare function, for bursts of keys which
+ * are all in the table and for bursts of keys which are all missing.
+ */
+static int
+bulk_lookup_perf_test(void)
+{
+	struct rte_hash_parameters params = {
+		.entries = BULK_ENTRIES,
+		.hash_func = rte_hash_crc,
+		.hash_func_init_val = 0,
+		.socket_id = rte_socket_id(),
+	};
+	char name[RTE_HASH_NAMESIZE];
+	uint64_t hit_cycles[RTE_DIM(bulk_key_lens)];
+	uint64_t miss_cycles[RTE_DIM(bulk_key_lens)];
+	struct rte_hash *hs;
+	uint8_t *bkeys;
+	uint32_t i, j, k, key_len, num_keys;
+
+	bkeys = rte_malloc(NULL, (size_t)BULK_KEYS * MAX_KEYSIZE, 0);
+	if (bkeys == NULL) {
+		printf("bulk lookup: memory allocation for keys failed\n");
+		return -1;
+	}
+
+	for (i = 0; i != RTE_DIM(bulk_key_lens); i++) {
+
+		key_len = bulk_key_lens[i];
+		snprintf(name, sizeof(name), "bulk_lookup%u", key_len);
+		params.name = name;
+		params.key_len = key_len;
+
+		hs = rte_hash_create(&params);
+		if (hs == NULL) {
+			printf("Error creating table\n");
+			rte_free(bkeys);
+			return -1;
+		}
+
+		/* Generate and add random keys. */
+		for (j = 0, num_keys = 0; j != BULK_KEYS; j++) {
+			uint8_t *key = bkeys + num_keys * key_len;
+
+			for (k = 0; k != key_len; k++)
+				key[k] = (uint8_t)rte_rand();
+
+			if (rte_hash_add_key_data(hs, key,
+					(void *)(uintptr_t)num_keys) == 0)
+				num_keys++;
+		}
+
+		hit_cycles[i] = timed_bulk_lookups(hs, bkeys, key_len,
+			num_keys, 1);
+
+		/* Change the last byte of each key to make lookups miss. */
+		for (j = 0; j != num_keys; j++)
+			bkeys[(j + 1) * key_len - 1] ^= UINT8_MAX;
+
+		miss_cycles[i] = timed_bulk_lookups(hs, bkeys, key_len,
+			num_keys, 0);
+
+		rte_hash_free(hs);
+
+		if (hit_cycles[i] == 0) {
+			rte_free(bkeys);
+			return -1;
+		}
+	}
+
+	rte_free(bkeys);
+
+	printf("\n\n *** Bulk lookup performance per key size ***\n");
+	printf("%u entries, %u keys added, %u keys per burst\n",
+		BULK_ENTRIES, BULK_KEYS, RTE_HASH_LOOKUP_BULK_MAX);
+	printf("Results (in CPU cycles/key)\n");
+	printf("\n%-18s%-18s%-18s\n", "Keysize", "Lookup_bulk_hit",
+		"Lookup_bulk_miss");
+	for (i = 0; i != RTE_DIM(bulk_key_lens); i++)
+		printf("%-18u%-18"PRIu64"%-18"PRIu64"\n", bulk_key_lens[i],
+			hit_cycles[i], miss_cycles[i]);
+
+	return 0;
+}
+
+#define BULK_ADD_KEY_LEN 16
+
+static const struct {
+	const char *name;
+	uint8_t extra_flag;
+} bulk_add_modes[] = {
+	{ "Single writer", 0 },
+	{ "Multi writer", RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD },
+	{ "RW concurrency", RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY },
+};
+
+static uint64_t
+timed_adds_burst(const uint8_t *bkeys, uint8_t extra_flag, int bulk)
+{
+	struct rte_hash_parameters params = {
+		.name = "bulk_add",
+		.entries = BULK_ENTRIES,
+		.key_len = BULK_ADD_KEY_LEN,
+		.hash_func = rte_hash_crc,
+		.hash_func_init_val = 0,
+		.socket_id = rte_socket_id(),
+		.extra_flag = extra_flag,
+	};
+	const void *keys_burst[RTE_HASH_LOOKUP_BULK_MAX];
+	int32_t pos[RTE_HASH_LOOKUP_BULK_MAX];
+	struct rte_hash *hs;
+	uint64_t start, tm;
+	uint32_t j, k, n;
+
+	hs = rte_hash_create(&params);
+	if (hs == NULL) {
+		printf("Error creating table\n");
+		return 0;
+	}
+
+	start = rte_rdtsc();
+
+	for (j = 0; j < BULK_KEYS; j += n) {
+		n = RTE_MIN(BULK_KEYS - j, (uint32_t)RTE_HASH_LOOKUP_BULK_MAX);
+		for (k = 0; k != n; k++)
+			keys_burst[k] = bkeys + (j + k) * BULK_ADD_KEY_LEN;
+
+		if (bulk)
+			rte_hash_add_key_bulk(hs, keys_burst, n, pos);
+		else
+			for (k = 0; k != n; k++)
+				pos[k] = rte_hash_add_key(hs, keys_burst[k]);
+	}
+
+	tm = rte_rdtsc() - start;
+	rte_hash_free(hs);
+	return tm / BULK_KEYS;
+}
+
+/*
+ * Measure the insertion of keys one at a time with rte_hash_add_key()
+ * and in bursts with rte_hash_add_key_bulk().
+ */
+static int
+bulk_add_perf_test(void)
+{
+	uint64_t single_cycles, bulk_cycles;
+	uint8_t *bkeys;
+	uint32_t i;
+
+	bkeys = rte_malloc(NULL, (size_t)BULK_KEYS * BULK_ADD_KEY_LEN, 0);
+	if (bkeys == NULL) {
+		printf("bulk add: memory allocation for keys failed\n");
+		return -1;
+	}
+	for (i = 0; i != BULK_KEYS * BULK_ADD_KEY_LEN; i++)
+		bkeys[i] = (uint8_t)rte_rand();
+
+	printf("\n\n *** Bulk add performance ***\n");
+	printf("%u entries, %u keys added, %u keys per burst\n",
+		BULK_ENTRIES, BULK_KEYS, RTE_HASH_LOOKUP_BULK_MAX);
+	printf("Results (in CPU cycles/key)\n");
+	printf("\n%-18s%-18s%-18s\n", "Mode", "Add", "Add_bulk");
+	for (i = 0; i != RTE_DIM(bulk_add_modes); i++) {
+		single_cycles = timed_adds_burst(bkeys,
+			bulk_add_modes[i].extra_flag, 0);
+		bulk_cycles = timed_adds_burst(bkeys,
+			bulk_add_modes[i].extra_flag, 1);
+		if (single_cycles == 0 || bulk_cycles == 0) {
+			rte_free(bkeys);
+			return -1;
+		}
+		printf("%-18s%-18"PRIu64"%-18"PRIu64"\n",
+			bulk_add_modes[i].name, single_cycles, bulk_cycles);
+	}
+
+	rte_free(bkeys);
+	return 0;
+}
+
 /* Control operation of performance testing of fbk hash. */
 #define LOAD_FACTOR 0.667	/* How full to make the hash table. */
 #define TEST_SIZE 1000000	/* How many operations to time. */
@@ -743,6 +964,12 @@ test_hash_perf(void)
 	if (run_all_tbl_perf_tests(1, 0, 1) < 0)
 		return -1;
 
+	if (bulk_lookup_perf_test() < 0)
+		return -1;
+
+	if (bulk_add_perf_test() < 0)
+		return -1;
+
 	if (fbk_hash_perf_test() < 0)
 		return -1;
 
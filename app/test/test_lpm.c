@@ -44,6 +44,7 @@ static int32_t test18(void);
 static int32_t test19(void);
 static int32_t test20(void);
 static int32_t test21(void);
+static int32_t test22(void);
 
 rte_lpm_test tests[] = {
 /* Test Cases */
@@ -68,7 +69,8 @@ rte_lpm_test tests[] = {
 	test18,
 	test19,
 	test20,
-	test21
+	test21,
+	test22
 };
 
 #define MAX_DEPTH 32
@@ -1554,6 +1556,89 @@ test21(void)
 	return (status == 0) ? PASS : -1;
 }
 
+/*
+ * Check that rte_lpm_lookupx16() and rte_lpm_lookup_bulk_vec() return the
+ * same next hops as rte_lpm_lookup() for every supported lookup type,
+ * with hits in tbl24, hits in tbl8 and misses mixed in one burst.
+ */
+int32_t
+test22(void)
+{
+	static const enum rte_lpm_lookup_type types[] = {
+		RTE_LPM_LOOKUP_SCALAR,
+		RTE_LPM_LOOKUP_VECTOR_AVX512,
+	};
+	struct rte_lpm *lpm = NULL;
+	struct rte_lpm_config config;
+	uint32_t ips[RTE_LPM_LOOKUPX16_NUM * 2 + 3];
+	uint32_t hop[RTE_DIM(ips)];
+	uint32_t next_hop, expected;
+	unsigned int i, t;
+	int32_t status;
+
+	config.max_rules = MAX_RULES;
+	config.number_tbl8s = NUMBER_TBL8S;
+	config.flags = 0;
+
+	lpm = rte_lpm_create(__func__, SOCKET_ID_ANY, &config);
+	TEST_LPM_ASSERT(lpm != NULL);
+
+	status = rte_lpm_add(lpm, RTE_IPV4(10, 0, 0, 0), 8, 100);
+	TEST_LPM_ASSERT(status == 0);
+	status = rte_lpm_add(lpm, RTE_IPV4(10, 1, 1, 0), 24, 200);
+	TEST_LPM_ASSERT(status == 0);
+	status = rte_lpm_add(lpm, RTE_IPV4(10, 1, 1, 128), 25, 300);
+	TEST_LPM_ASSERT(status == 0);
+	status = rte_lpm_add(lpm, RTE_IPV4(192, 168, 0, 64), 30, 400);
+	TEST_LPM_ASSERT(status == 0);
+
+	for (i = 0; i < RTE_DIM(ips); i++) {
+		switch (i % 4) {
+		case 0:
+			ips[i] = RTE_IPV4(10, 1, 1, i);
+			break;
+		case 1:
+			ips[i] = RTE_IPV4(10, 1, 1, 128 + i);
+			break;
+		case 2:
+			ips[i] = RTE_IPV4(192, 168, 0, 64 + i % 8);
+			break;
+		default:
+			ips[i] = RTE_IPV4(172, 16, i, 1);
+			break;
+		}
+	}
+
+	for (t = 0; t < RTE_DIM(types); t++) {
+		status = rte_lpm_set_lookup_type(lpm, types[t]);
+		if (status == -ENOTSUP)
+			continue;
+		TEST_LPM_ASSERT(status == 0);
+
+		rte_lpm_lookupx16(lpm, ips, hop, UINT32_MAX);
+		for (i = 0; i < RTE_LPM_LOOKUPX16_NUM; i++) {
+			expected = rte_lpm_lookup(lpm, ips[i], &next_hop) == 0 ?
+				next_hop : UINT32_MAX;
+			TEST_LPM_ASSERT(hop[i] == expected);
+		}
+
+		rte_lpm_lookup_bulk_vec(lpm, ips, hop, RTE_DIM(ips),
+			UINT32_MAX);
+		for (i = 0; i < RTE_DIM(ips); i++) {
+			expected = rte_lpm_lookup(lpm, ips[i], &next_hop) == 0 ?
+				next_hop : UINT32_MAX;
+			TEST_LPM_ASSERT(hop[i] == expected);
+		}
+	}
+
+	status = rte_lpm_set_lookup_type(lpm, RTE_LPM_LOOKUP_DEFAULT);
+	TEST_LPM_ASSERT(status == 0);
+
+	rte_lpm_free(lpm);
+
+	return PASS;
+}
+
 /*
  * Do all unit tests.
  */
@@ -802,13 +802,20 @@ test_lpm_rcu_perf(void)
 static int
 test_lpm_perf(void)
 {
+	static const struct {
+		enum rte_lpm_lookup_type type;
+		const char *name;
+	} lookup_types[] = {
+		{ RTE_LPM_LOOKUP_SCALAR, "scalar" },
+		{ RTE_LPM_LOOKUP_VECTOR_AVX512, "avx512" },
+	};
 	struct rte_lpm_config config;
 
 	config.max_rules = 2000000;
 	config.number_tbl8s = 2048;
 	config.flags = 0;
 	uint64_t begin, total_time, lpm_used_entries = 0;
-	unsigned i, j;
+	unsigned i, j, t;
 	uint32_t next_hop_add = 0xAA, next_hop_return = 0;
 	int status = 0;
 	uint64_t cache_line_counter = 0;
@@ -942,6 +949,79 @@ test_lpm_perf(void)
 			(double)total_time / ((double)ITERATIONS * BATCH_SIZE),
 			(count * 100.0) / (double)(ITERATIONS * BATCH_SIZE));
 
+	/* Measure LookupX16 and vector bulk Lookup for each implementation */
+	for (t = 0; t < RTE_DIM(lookup_types); t++) {
+		if (rte_lpm_set_lookup_type(lpm, lookup_types[t].type) != 0) {
+			printf("LPM LookupX16 %s: not supported\n",
+					lookup_types[t].name);
+			continue;
+		}
+
+		total_time = 0;
+		count = 0;
+		for (i = 0; i < ITERATIONS; i++) {
+			static uint32_t ip_batch[BATCH_SIZE];
+			uint32_t next_hops[RTE_LPM_LOOKUPX16_NUM];
+
+			/* Create array of random IP addresses */
+			for (j = 0; j < BATCH_SIZE; j++)
+				ip_batch[j] = rte_rand();
+
+			/* Lookup per batch */
+			begin = rte_rdtsc();
+			for (j = 0; j < BATCH_SIZE; j += RTE_DIM(next_hops)) {
+				unsigned k;
+
+				rte_lpm_lookupx16(lpm, ip_batch + j, next_hops,
+						UINT32_MAX);
+				for (k = 0; k < RTE_DIM(next_hops); k++)
+					if (unlikely(next_hops[k] == UINT32_MAX))
+						count++;
+			}
+
+			total_time += rte_rdtsc() - begin;
+		}
+		printf("LPM LookupX16 %s: %.1f cycles (fails = %.1f%%)\n",
+				lookup_types[t].name,
+				(double)total_time /
+				((double)ITERATIONS * BATCH_SIZE),
+				(count * 100.0) /
+				(double)(ITERATIONS * BATCH_SIZE));
+
+		total_time = 0;
+		count = 0;
+		for (i = 0; i < ITERATIONS; i++) {
+			static uint32_t ip_batch[BATCH_SIZE];
+			uint32_t next_hops[BULK_SIZE];
+
+			/* Create array of random IP addresses */
+			for (j = 0; j < BATCH_SIZE; j++)
+				ip_batch[j] = rte_rand();
+
+			/* Lookup per batch */
+			begin = rte_rdtsc();
+			for (j = 0; j < BATCH_SIZE; j += BULK_SIZE) {
+				unsigned k;
+
+				rte_lpm_lookup_bulk_vec(lpm, ip_batch + j,
+						next_hops, BULK_SIZE,
+						UINT32_MAX);
+				for (k = 0; k < BULK_SIZE; k++)
+					if (unlikely(next_hops[k] == UINT32_MAX))
+						count++;
+			}
+
+			total_time += rte_rdtsc() - begin;
+		}
+		printf("BULK VEC LPM Lookup %s: %.1f cycles (fails = %.1f%%)\n",
+				lookup_types[t].name,
+				(double)total_time /
+				((double)ITERATIONS * BATCH_SIZE),
+				(count * 100.0) /
+				(double)(ITERATIONS * BATCH_SIZE));
+	}
+	rte_lpm_set_lookup_type(lpm, RTE_LPM_LOOKUP_DEFAULT);
+
 	/* Measure Delete */
 	status = 0;
 	begin = rte_rdtsc();
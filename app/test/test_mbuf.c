@@ -899,6 +899,151 @@ test_pktmbuf_pool_bulk(void)
 	return ret;
 }
 
+/* number of bursts in fast free benchmark */
+#define FAST_FREE_PERF_ITER 4096
+#define FAST_FREE_PERF_BURST 32
+
+/*
+ * measure the cycles spent in a bulk free function, per mbuf
+ * return -1 if the mbufs cannot be allocated
+ */
+static int
+test_pktmbuf_free_perf(struct rte_mempool *pool, struct rte_mempool *pool2,
+	void (*free_fn)(struct rte_mbuf **, unsigned int), double *cycles_per_mbuf)
+{
+	struct rte_mbuf *mbufs[FAST_FREE_PERF_BURST];
+	uint64_t cycles = 0, start;
+	unsigned int i, j;
+
+	for (i = 0; i < FAST_FREE_PERF_ITER; i++) {
+		for (j = 0; j < FAST_FREE_PERF_BURST; j += 8) {
+			if (rte_pktmbuf_alloc_bulk(
+					(pool2 != NULL && (j & 8)) ? pool2 : pool,
+					&mbufs[j], 8) != 0) {
+				printf("rte_pktmbuf_alloc_bulk() failed\n");
+				rte_pktmbuf_free_bulk(mbufs, j);
+				return -1;
+			}
+		}
+		start = rte_rdtsc();
+		free_fn(mbufs, FAST_FREE_PERF_BURST);
+		cycles += rte_rdtsc() - start;
+	}
+
+	*cycles_per_mbuf = (double)cycles /
+		(FAST_FREE_PERF_ITER * FAST_FREE_PERF_BURST);
+	return 0;
+}
+
+/*
+ * test bulk free of trivially freeable mbufs, and compare it to the
+ * generic bulk free
+ */
+static int
+test_pktmbuf_free_bulk_fast(void)
+{
+	struct rte_mempool *pool = NULL;
+	struct rte_mempool *pool2 = NULL;
+	struct rte_mbuf *mbufs[NB_MBUF];
+	double generic, fast, mixed;
+	unsigned int i;
+	int ret = 0;
+
+	/* pools without cache, so that the avail count is exact */
+	pool = rte_pktmbuf_pool_create("test_pktmbuf_fast",
+			NB_MBUF, 0, 0, MBUF_DATA_SIZE, SOCKET_ID_ANY);
+	pool2 = rte_pktmbuf_pool_create("test_pktmbuf_fast2",
+			NB_MBUF, 0, 0, MBUF_DATA_SIZE, SOCKET_ID_ANY);
+	if (pool == NULL || pool2 == NULL) {
+		printf("rte_pktmbuf_pool_create() failed. rte_errno %d\n",
+		       rte_errno);
+		goto err;
+	}
+
+	printf("Test fast bulk free of a single pool.\n");
+	if (rte_pktmbuf_alloc_bulk(pool, mbufs, NB_MBUF) != 0) {
+		printf("rte_pktmbuf_alloc_bulk() failed\n");
+		goto err;
+	}
+	rte_pktmbuf_free_bulk_fast(mbufs, 0);
+	if (!rte_mempool_empty(pool)) {
+		printf("mempool not empty\n");
+		goto err;
+	}
+	rte_pktmbuf_free_bulk_fast(mbufs, NB_MBUF / 2);
+	rte_pktmbuf_free_bulk_fast(&mbufs[NB_MBUF / 2], NB_MBUF / 2);
+	if (!rte_mempool_full(pool)) {
+		printf("mempool not full\n");
+		goto err;
+	}
+
+	printf("Test fast bulk free of mixed pools.\n");
+	/* runs of various lengths, straddling vector boundaries */
+	for (i = 0; i < NB_MBUF; i++) {
+		mbufs[i] = rte_pktmbuf_alloc(
+			((i % 7) == 3 || (i % 11) > 7) ? pool2 : pool);
+		if (mbufs[i] == NULL) {
+			printf("rte_pktmbuf_alloc() failed (%u)\n", i);
+			goto err;
+		}
+	}
+	rte_pktmbuf_free_bulk_fast_mixed(mbufs, 1);
+	rte_pktmbuf_free_bulk_fast_mixed(&mbufs[1], NB_MBUF - 1);
+	if (rte_mempool_avail_count(pool) != NB_MBUF ||
+			rte_mempool_avail_count(pool2) != NB_MBUF) {
+		printf("mempools not full: %u, %u\n",
+		       rte_mempool_avail_count(pool),
+		       rte_mempool_avail_count(pool2));
+		goto err;
+	}
+
+	rte_mempool_free(pool);
+	rte_mempool_free(pool2);
+
+	/* benchmark with cached pools, as on a Tx completion path */
+	pool = rte_pktmbuf_pool_create("test_pktmbuf_fast",
+			NB_MBUF * 4, MEMPOOL_CACHE_SIZE, 0, MBUF_DATA_SIZE,
+			SOCKET_ID_ANY);
+	pool2 = rte_pktmbuf_pool_create("test_pktmbuf_fast2",
+			NB_MBUF * 4, MEMPOOL_CACHE_SIZE, 0, MBUF_DATA_SIZE,
+			SOCKET_ID_ANY);
+	if (pool == NULL || pool2 == NULL) {
+		printf("rte_pktmbuf_pool_create() failed. rte_errno %d\n",
+		       rte_errno);
+		goto err;
+	}
+
+	if (test_pktmbuf_free_perf(pool, NULL, rte_pktmbuf_free_bulk,
+			&generic) < 0 ||
+			test_pktmbuf_free_perf(pool, NULL,
+				rte_pktmbuf_free_bulk_fast, &fast) < 0 ||
+			test_pktmbuf_free_perf(pool, NULL,
+				rte_pktmbuf_free_bulk_fast_mixed, &mixed) < 0)
+		goto err;
+	printf("Bulk free cycles per mbuf, bursts of %u:\n",
+	       FAST_FREE_PERF_BURST);
+	printf("  single pool: generic %.2f, fast %.2f, fast mixed %.2f\n",
+	       generic, fast, mixed);
+
+	if (test_pktmbuf_free_perf(pool, pool2, rte_pktmbuf_free_bulk,
+			&generic) < 0 ||
+			test_pktmbuf_free_perf(pool, pool2,
+				rte_pktmbuf_free_bulk_fast_mixed, &mixed) < 0)
+		goto err;
+	printf("  two pools: generic %.2f, fast mixed %.2f\n",
+	       generic, mixed);
+
+	goto done;
+
+err:
+	ret = -1;
+
+done:
+	rte_mempool_free(pool);
+	rte_mempool_free(pool2);
+	return ret;
+}
+
 /*
  * test that the pointer to the data on a packet mbuf is set properly
  */
@@ -2730,6 +2875,12 @@ test_mbuf(void)
 		goto err;
 	}
 
+	/* test fast bulk free */
+	if (test_pktmbuf_free_bulk_fast() < 0) {
+		printf("test_pktmbuf_free_bulk_fast() failed\n");
+		goto err;
+	}
+
 	/* test that the pointer to the data on a packet mbuf is set properly */
 	if (test_pktmbuf_pool_ptr(pktmbuf_pool) < 0) {
 		printf("test_pktmbuf_pool_ptr() failed\n");
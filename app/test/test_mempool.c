@@ -208,6 +208,93 @@ static int test_mempool_creation_with_exceeded_cache_size(void)
 	return 0;
 }
 
+/* check that adaptive caches grow on misses and shrink when idle */
+static int
+test_mempool_adaptive_cache(struct rte_mempool *mp, struct rte_mempool *mp_c)
+{
+	struct rte_mempool_cache *cache, *lcore_cache;
+	void *objs[32];
+	unsigned int i;
+	uint32_t size;
+	int ret = -1;
+
+	cache = rte_mempool_cache_create(32, SOCKET_ID_ANY);
+	if (cache == NULL)
+		RET_ERR();
+
+	/* invalid bounds */
+	if (rte_mempool_cache_set_adaptive(cache, 0, 64) != -EINVAL)
+		GOTO_ERR(ret, out);
+	if (rte_mempool_cache_set_adaptive(cache, 64, 32) != -EINVAL)
+		GOTO_ERR(ret, out);
+	if (rte_mempool_cache_set_adaptive(cache, 16,
+			RTE_MEMPOOL_CACHE_MAX_SIZE + 1) != -EINVAL)
+		GOTO_ERR(ret, out);
+	if (rte_mempool_set_adaptive_cache(mp, 16, 64) != -EINVAL)
+		GOTO_ERR(ret, out);
+
+	if (rte_mempool_cache_set_adaptive(cache, 16, 256) < 0)
+		GOTO_ERR(ret, out);
+
+	/*
+	 * bursts as large as the cache always miss: the cache must grow at the
+	 * end of the first window, a get and a put per iteration
+	 */
+	for (i = 0; i < RTE_MEMPOOL_CACHE_ADAPT_PERIOD / 2; i++) {
+		if (rte_mempool_generic_get(mp, objs, RTE_DIM(objs),
+				cache) < 0)
+			GOTO_ERR(ret, out);
+		rte_mempool_generic_put(mp, objs, RTE_DIM(objs), cache);
+	}
+	if (cache->size <= 32 || cache->size > 256)
+		GOTO_ERR(ret, out);
+	if (cache->get_miss == 0)
+		GOTO_ERR(ret, out);
+
+	/*
+	 * single object gets and puts never miss once the cache is filled:
+	 * the cache must shrink without any further backend access
+	 */
+	size = cache->size;
+	if (rte_mempool_generic_get(mp, objs, 1, cache) < 0)
+		GOTO_ERR(ret, out);
+	rte_mempool_generic_put(mp, objs, 1, cache);
+	for (i = 0; i < RTE_MEMPOOL_CACHE_ADAPT_PERIOD; i++) {
+		if (rte_mempool_generic_get(mp, objs, 1, cache) < 0)
+			GOTO_ERR(ret, out);
+		rte_mempool_generic_put(mp, objs, 1, cache);
+	}
+	if (cache->size >= size || cache->size < 16)
+		GOTO_ERR(ret, out);
+
+	/* revert to a fixed size */
+	size = cache->size;
+	if (rte_mempool_cache_set_adaptive(cache, 0, 0) < 0)
+		GOTO_ERR(ret, out);
+	if (cache->size != size || cache->max_size != 0)
+		GOTO_ERR(ret, out);
+
+	/* default caches are clamped to the bounds */
+	lcore_cache = rte_mempool_default_cache(mp_c, rte_lcore_id());
+	if (rte_mempool_set_adaptive_cache(mp_c, 16, 64) < 0)
+		GOTO_ERR(ret, out);
+	if (lcore_cache->size != 64 || lcore_cache->max_size != 64 ||
+			lcore_cache->min_size != 16)
+		GOTO_ERR(ret, out);
+	if (rte_mempool_set_adaptive_cache(mp_c, 16, mp_c->size) != -EINVAL)
+		GOTO_ERR(ret, out);
+
+	rte_mempool_dump(stdout, mp_c);
+	ret = 0;
+
+out:
+	rte_mempool_cache_flush(cache, mp);
+	rte_mempool_cache_free(cache);
+	if (ret == 0 && rte_mempool_avail_count(mp) != mp->size)
+		RET_ERR();
+	return ret;
+}
+
 static struct rte_mempool *mp_spsc;
 static rte_spinlock_t scsp_spinlock;
 static void *scsp_obj_table[MAX_KEEP];
@@ -485,6 +572,7 @@ test_mempool(void)
 	struct rte_mempool *mp_stack_anon = NULL;
 	struct rte_mempool *mp_stack_mempool_iter = NULL;
 	struct rte_mempool *mp_stack = NULL;
+	struct rte_mempool *mp_numa = NULL;
 	struct rte_mempool *default_pool = NULL;
 	struct mp_data cb_arg = {
 		.ret = -1
@@ -583,6 +671,27 @@ test_mempool(void)
 	}
 	rte_mempool_obj_iter(mp_stack, my_obj_init, NULL);
 
+	/* create a mempool with the NUMA handler */
+	mp_numa = rte_mempool_create_empty("test_numa",
+		MEMPOOL_SIZE,
+		MEMPOOL_ELT_SIZE,
+		RTE_MEMPOOL_CACHE_MAX_SIZE, 0,
+		SOCKET_ID_ANY, 0);
+
+	if (mp_numa == NULL) {
+		printf("cannot allocate mp_numa mempool\n");
+		GOTO_ERR(ret, err);
+	}
+	if (rte_mempool_set_ops_byname(mp_numa, "numa", NULL) < 0) {
+		printf("cannot set numa handler\n");
+		GOTO_ERR(ret, err);
+	}
+	if (rte_mempool_populate_default(mp_numa) < 0) {
+		printf("cannot populate mp_numa mempool\n");
+		GOTO_ERR(ret, err);
+	}
+	rte_mempool_obj_iter(mp_numa, my_obj_init, NULL);
+
 	/* Create a mempool based on Default handler */
 	printf("Testing %s mempool handler\n", default_pool_ops);
 	default_pool = rte_mempool_create_empty("default_pool",
@@ -643,10 +752,18 @@ test_mempool(void)
 	if (test_mempool_same_name_twice_creation() < 0)
 		GOTO_ERR(ret, err);
 
+	/* adaptive cache tests */
+	if (test_mempool_adaptive_cache(mp_nocache, mp_cache) < 0)
+		GOTO_ERR(ret, err);
+
 	/* test the stack handler */
 	if (test_mempool_basic(mp_stack, 1) < 0)
 		GOTO_ERR(ret, err);
 
+	/* test the numa handler */
+	if (test_mempool_basic(mp_numa, 0) < 0)
+		GOTO_ERR(ret, err);
+
 	if (test_mempool_basic(default_pool, 1) < 0)
 		GOTO_ERR(ret, err);
 
@@ -660,6 +777,7 @@ test_mempool(void)
 	rte_mempool_free(mp_stack_anon);
 	rte_mempool_free(mp_stack_mempool_iter);
 	rte_mempool_free(mp_stack);
+	rte_mempool_free(mp_numa);
 	rte_mempool_free(default_pool);
 
 	return ret;
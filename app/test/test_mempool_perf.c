@@ -23,6 +23,8 @@
 #include <rte_atomic.h>
 #include <rte_branch_prediction.h>
 #include <rte_mempool.h>
+#include <rte_memzone.h>
+#include <rte_ring.h>
 #include <rte_spinlock.h>
 #include <rte_malloc.h>
 #include <rte_mbuf_pool_ops.h>
@@ -61,6 +63,12 @@
  *
  *      - 32
  *      - 128
+ *
+ *    A cross-socket scenario is also run: the master core gets objects
+ *    from a mempool whose memory is split between its socket and the one
+ *    of another core, and hands them over through a ring to this core,
+ *    which puts them back in the mempool. It is done with the default
+ *    ring handler and with the numa handler.
  */
 
 #define N 65536
@@ -279,6 +287,159 @@ do_one_mempool_test(struct rte_mempool *mp, unsigned int cores)
 	return 0;
 }
 
+#define XSOCKET_POOL_SIZE 8192
+#define XSOCKET_CACHE_SIZE 256
+#define XSOCKET_BULK 32
+#define XSOCKET_RING_SIZE 1024
+
+static struct rte_ring *xsocket_ring;
+static rte_atomic32_t xsocket_stop;
+
+/* put back the objects handed over by the producer until it stops */
+static int
+xsocket_consumer(void *arg)
+{
+	struct rte_mempool *mp = arg;
+	void *objs[XSOCKET_BULK];
+	unsigned int n;
+	int stop;
+
+	do {
+		stop = rte_atomic32_read(&xsocket_stop);
+		do {
+			n = rte_ring_sc_dequeue_burst(xsocket_ring, objs,
+						      XSOCKET_BULK, NULL);
+			rte_mempool_put_bulk(mp, objs, n);
+		} while (n != 0);
+	} while (!stop);
+
+	return 0;
+}
+
+static uint64_t
+xsocket_producer(struct rte_mempool *mp)
+{
+	void *objs[XSOCKET_BULK];
+	uint64_t start_cycles, time_diff = 0, hz = rte_get_timer_hz();
+	uint64_t count = 0;
+
+	start_cycles = rte_get_timer_cycles();
+
+	while (time_diff / hz < TIME_S) {
+		if (rte_mempool_get_bulk(mp, objs, XSOCKET_BULK) == 0) {
+			while (rte_ring_sp_enqueue_bulk(xsocket_ring, objs,
+					XSOCKET_BULK, NULL) == 0)
+				rte_pause();
+			count += XSOCKET_BULK;
+		}
+		time_diff = rte_get_timer_cycles() - start_cycles;
+	}
+
+	return count;
+}
+
+static void
+xsocket_mz_free(__rte_unused struct rte_mempool_memhdr *memhdr,
+		void *opaque)
+{
+	rte_memzone_free(opaque);
+}
+
+/* create a mempool with half of its objects on each socket */
+static struct rte_mempool *
+xsocket_pool_create(const char *ops, const int *sockets)
+{
+	char name[RTE_MEMZONE_NAMESIZE];
+	const struct rte_memzone *mz;
+	struct rte_mempool *mp;
+	size_t len;
+	int i;
+
+	snprintf(name, sizeof(name), "xsocket_%s", ops);
+	mp = rte_mempool_create_empty(name, XSOCKET_POOL_SIZE,
+				      MEMPOOL_ELT_SIZE, XSOCKET_CACHE_SIZE, 0,
+				      SOCKET_ID_ANY, MEMPOOL_F_NO_IOVA_CONTIG);
+	if (mp == NULL)
+		return NULL;
+	if (rte_mempool_set_ops_byname(mp, ops, NULL) < 0)
+		goto err;
+
+	len = (size_t)XSOCKET_POOL_SIZE / 2 *
+		(mp->header_size + mp->elt_size + mp->trailer_size);
+	for (i = 0; i < 2; i++) {
+		snprintf(name, sizeof(name), "xsocket_%s_%d", ops, i);
+		mz = rte_memzone_reserve(name, len, sockets[i], 0);
+		if (mz == NULL)
+			mz = rte_memzone_reserve(name, len, SOCKET_ID_ANY, 0);
+		if (mz == NULL)
+			goto err;
+		if (rte_mempool_populate_iova(mp, mz->addr, RTE_BAD_IOVA,
+				mz->len, xsocket_mz_free, (void *)(uintptr_t)mz)
+				< 0) {
+			rte_memzone_free(mz);
+			goto err;
+		}
+	}
+
+	return mp;
+
+err:
+	rte_mempool_free(mp);
+	return NULL;
+}
+
+static int
+xsocket_mempool_test(const char *ops)
+{
+	unsigned int consumer = RTE_MAX_LCORE, lcore_id;
+	struct rte_mempool *mp;
+	uint64_t count;
+	int sockets[2];
+
+	/* prefer a consumer on another socket than the master */
+	sockets[0] = rte_socket_id();
+	RTE_LCORE_FOREACH_SLAVE(lcore_id) {
+		if (consumer == RTE_MAX_LCORE)
+			consumer = lcore_id;
+		if ((int)rte_lcore_to_socket_id(lcore_id) != sockets[0]) {
+			consumer = lcore_id;
+			break;
+		}
+	}
+	if (consumer == RTE_MAX_LCORE) {
+		printf("cross-socket test needs 2 lcores, skipped\n");
+		return 0;
+	}
+	sockets[1] = rte_lcore_to_socket_id(consumer);
+
+	mp = xsocket_pool_create(ops, sockets);
+	if (mp == NULL) {
+		printf("cannot create %s mempool\n", ops);
+		return -1;
+	}
+
+	xsocket_ring = rte_ring_create("xsocket_ring", XSOCKET_RING_SIZE,
+				       sockets[1], RING_F_SP_ENQ | RING_F_SC_DEQ);
+	if (xsocket_ring == NULL) {
+		rte_mempool_free(mp);
+		return -1;
+	}
+
+	rte_atomic32_set(&xsocket_stop, 0);
+	rte_eal_remote_launch(xsocket_consumer, mp, consumer);
+	count = xsocket_producer(mp);
+	rte_atomic32_set(&xsocket_stop, 1);
+	rte_eal_wait_lcore(consumer);
+
+	printf("mempool_autotest cross-socket ops=%s producer_socket=%d "
+	       "consumer_socket=%d rate_persec=%" PRIu64 "\n",
+	       ops, sockets[0], sockets[1], count / TIME_S);
+
+	rte_ring_free(xsocket_ring);
+	rte_mempool_free(mp);
+	return 0;
+}
+
 static int
 test_mempool_perf(void)
 {
@@ -385,6 +546,16 @@ test_mempool_perf(void)
 	if (do_one_mempool_test(mp_nocache, rte_lcore_count()) < 0)
 		goto err;
 
+	/* cross-socket producer/consumer */
+	printf("start cross-socket performance test\n");
+	use_external_cache = 0;
+
+	if (xsocket_mempool_test("ring_mp_mc") < 0)
+		goto err;
+
+	if (xsocket_mempool_test("numa") < 0)
+		goto err;
+
 	rte_mempool_list_dump(stdout);
 
 	ret = 0;
@@ -0,0 +1,251 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2020 Marvell International Ltd.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_ethdev.h>
+#include <rte_eth_ring.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip.h>
+#include <rte_lpm6.h>
+#include <rte_mbuf.h>
+#include <rte_node_eth_api.h>
+#include <rte_node_ip6_api.h>
+#include <rte_ring.h>
+
+#include "test.h"
+
+/*
+ * Run IPv6 packets through the ip6_lookup and ip6_rewrite nodes towards a
+ * ring based port, checking the hop limit of the forwarded packets and that
+ * the ones whose hop limit expires are dropped.
+ */
+
+#define NB_MBUF 512
+#define RING_SIZE 256
+#define NB_PKTS 10
+
+/* Spread over the x4 loop and the single packet loop of ip6_rewrite */
+static const uint8_t hop_limits[NB_PKTS] = {
+	64, 1, 0, 2, 255, 64, 64, 64, 1, 2,
+};
+
+static const uint8_t dst_ip[RTE_LPM6_IPV6_ADDR_SIZE] = {
+	0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+};
+
+static struct rte_mbuf *src_pkts[NB_PKTS];
+static uint16_t src_nb_pkts;
+
+static uint16_t
+test_ip6_source(struct rte_graph *graph, struct rte_node *node, void **objs,
+		uint16_t nb_objs)
+{
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	if (src_nb_pkts == 0)
+		return 0;
+
+	rte_node_enqueue(graph, node, 0, (void **)src_pkts, src_nb_pkts);
+	nb_objs = src_nb_pkts;
+	src_nb_pkts = 0;
+
+	return nb_objs;
+}
+
+static struct rte_node_register test_ip6_source_node = {
+	.process = test_ip6_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.name = "test_ip6_source",
+	.nb_edges = 1,
+	.next_nodes = {
+		[0] = "ip6_lookup",
+	},
+};
+
+RTE_NODE_REGISTER(test_ip6_source_node);
+
+static int
+build_pkts(struct rte_mempool *mp)
+{
+	struct rte_ipv6_hdr *ip;
+	struct rte_ether_hdr *eth;
+	uint16_t i;
+
+	if (rte_pktmbuf_alloc_bulk(mp, src_pkts, NB_PKTS) != 0)
+		return -1;
+
+	for (i = 0; i < NB_PKTS; i++) {
+		eth = (struct rte_ether_hdr *)rte_pktmbuf_append(src_pkts[i],
+				sizeof(*eth) + sizeof(*ip));
+		memset(eth, 0, sizeof(*eth) + sizeof(*ip));
+		eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6);
+
+		ip = (struct rte_ipv6_hdr *)(eth + 1);
+		ip->vtc_flow = rte_cpu_to_be_32(6 << 28);
+		ip->proto = IPPROTO_UDP;
+		ip->hop_limits = hop_limits[i];
+		memcpy(ip->dst_addr, dst_ip, sizeof(dst_ip));
+		/* Identify the packet once forwarded */
+		ip->src_addr[15] = i;
+	}
+	src_nb_pkts = NB_PKTS;
+
+	return 0;
+}
+
+static int
+test_node_ip6_rewrite_hop_limit(void)
+{
+	static const char *patterns[] = {"test_ip6_source"};
+	struct rte_graph_param graph_conf = {
+		.node_patterns = patterns,
+		.nb_node_patterns = RTE_DIM(patterns),
+		.socket_id = (int)rte_socket_id(),
+	};
+	struct rte_node_ethdev_config eth_conf = {
+		.num_rx_queues = 0,
+		.num_tx_queues = 1,
+	};
+	struct rte_eth_conf port_conf = {0};
+	uint8_t rewrite[sizeof(struct rte_ether_hdr)] = {0};
+	struct rte_mbuf *out[NB_PKTS];
+	struct rte_ring *rx_ring, *tx_ring;
+	struct rte_mempool *mp = NULL;
+	struct rte_ipv6_hdr *ip;
+	unsigned int i, n, expected = 0;
+	rte_graph_t graph = RTE_GRAPH_ID_INVALID;
+	struct rte_graph *g;
+	int port, ret = TEST_FAILED;
+	uint8_t idx;
+
+	/* The port's nodes are cloned for good, configure them only once */
+	if (rte_eth_dev_get_port_by_name("net_test_node_ip6",
+			&eth_conf.port_id) == 0)
+		return TEST_SKIPPED;
+
+	rx_ring = rte_ring_create("test_node_ip6_rx", RING_SIZE,
+			SOCKET_ID_ANY, RING_F_SP_ENQ | RING_F_SC_DEQ);
+	tx_ring = rte_ring_create("test_node_ip6_tx", RING_SIZE,
+			SOCKET_ID_ANY, RING_F_SP_ENQ | RING_F_SC_DEQ);
+	if (rx_ring == NULL || tx_ring == NULL) {
+		printf("Failed to create rings\n");
+		goto ring_free;
+	}
+
+	port = rte_eth_from_rings("net_test_node_ip6", &rx_ring, 1, &tx_ring,
+			1, SOCKET_ID_ANY);
+	if (port < 0) {
+		printf("Failed to create ring port\n");
+		goto ring_free;
+	}
+	eth_conf.port_id = port;
+
+	mp = rte_pktmbuf_pool_create("test_node_ip6", NB_MBUF, 0, 0,
+			RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	if (mp == NULL) {
+		printf("Failed to create mbuf pool\n");
+		goto port_stop;
+	}
+
+	if (rte_eth_dev_configure(port, 1, 1, &port_conf) < 0 ||
+			rte_eth_rx_queue_setup(port, 0, RING_SIZE,
+				SOCKET_ID_ANY, NULL, mp) < 0 ||
+			rte_eth_tx_queue_setup(port, 0, RING_SIZE,
+				SOCKET_ID_ANY, NULL) < 0 ||
+			rte_eth_dev_start(port) < 0) {
+		printf("Failed to start ring port\n");
+		goto port_stop;
+	}
+
+	if (rte_node_eth_config(&eth_conf, 1, 1) < 0) {
+		printf("Failed to configure ethdev nodes\n");
+		goto port_stop;
+	}
+
+	/* The lookup and rewrite nodes are pulled in as edges */
+	graph = rte_graph_create("test_node_ip6", &graph_conf);
+	if (graph == RTE_GRAPH_ID_INVALID) {
+		printf("Failed to create graph\n");
+		goto port_stop;
+	}
+	g = rte_graph_lookup("test_node_ip6");
+
+	if (rte_node_ip6_route_add(dst_ip, 64, 0,
+			RTE_NODE_IP6_LOOKUP_NEXT_REWRITE) < 0 ||
+			rte_node_ip6_rewrite_add(0, rewrite, sizeof(rewrite),
+				port) < 0) {
+		printf("Failed to add route\n");
+		goto graph_destroy;
+	}
+
+	if (build_pkts(mp) < 0) {
+		printf("Failed to allocate packets\n");
+		goto graph_destroy;
+	}
+
+	rte_graph_walk(g);
+
+	n = rte_ring_dequeue_burst(tx_ring, (void **)out, RTE_DIM(out), NULL);
+	for (i = 0; i < NB_PKTS; i++)
+		expected += hop_limits[i] > 1;
+	if (n != expected) {
+		printf("Forwarded %u packets, expected %u\n", n, expected);
+		rte_pktmbuf_free_bulk(out, n);
+		goto graph_destroy;
+	}
+
+	for (i = 0; i < n; i++) {
+		ip = rte_pktmbuf_mtod_offset(out[i], struct rte_ipv6_hdr *,
+				sizeof(struct rte_ether_hdr));
+		idx = ip->src_addr[15];
+		if (idx >= NB_PKTS || hop_limits[idx] <= 1 ||
+				ip->hop_limits != hop_limits[idx] - 1) {
+			printf("Packet %u forwarded with hop limit %u\n",
+				idx, ip->hop_limits);
+			rte_pktmbuf_free_bulk(out, n);
+			goto graph_destroy;
+		}
+	}
+	rte_pktmbuf_free_bulk(out, n);
+
+	/* Dropped packets are back in the pool */
+	if (rte_mempool_avail_count(mp) != NB_MBUF) {
+		printf("%u packets not freed\n",
+			NB_MBUF - rte_mempool_avail_count(mp));
+		goto graph_destroy;
+	}
+
+	ret = TEST_SUCCESS;
+graph_destroy:
+	rte_graph_destroy(graph);
+port_stop:
+	rte_eth_dev_stop(port);
+	rte_mempool_free(mp);
+	return ret;
+ring_free:
+	rte_ring_free(rx_ring);
+	rte_ring_free(tx_ring);
+	return ret;
+}
+
+static struct unit_test_suite node_ip6_testsuite = {
+	.suite_name = "node ip6 autotest",
+	.unit_test_cases = {
+		TEST_CASE(test_node_ip6_rewrite_hop_limit),
+		TEST_CASES_END(), /**< NULL terminate unit test array */
+	},
+};
+
+static int
+test_node_ip6(void)
+{
+	return unit_test_suite_runner(&node_ip6_testsuite);
+}
+
+REGISTER_TEST_COMMAND(node_ip6_autotest, test_node_ip6);
@@ -268,8 +268,10 @@ test_reorder_drain(void)
 		ret = -1;
 		goto exit;
 	}
-	if (robufs[0] != NULL)
+	if (robufs[0] != NULL) {
 		rte_pktmbuf_free(robufs[0]);
+		robufs[0] = NULL;
+	}
 
 	/* Insert more packets
 	 * RB[] = {NULL, NULL, NULL, NULL}
@@ -303,8 +305,10 @@ test_reorder_drain(void)
 		goto exit;
 	}
 	for (i = 0; i < 3; i++) {
-		if (robufs[i] != NULL)
+		if (robufs[i] != NULL) {
 			rte_pktmbuf_free(robufs[i]);
+			robufs[i] = NULL;
+		}
 	}
 
 	/*
@@ -330,6 +334,284 @@ test_reorder_drain(void)
 	return ret;
 }
 
+static int
+test_reorder_insert_bulk(void)
+{
+	struct rte_reorder_buffer *b = NULL;
+	struct rte_mempool *p = test_params->p;
+	const unsigned int size = 8;
+	const unsigned int num_bufs = 12;
+	struct rte_mbuf *bufs[num_bufs];
+	struct rte_mbuf *robufs[num_bufs];
+	unsigned int i, cnt;
+	int ret = 0;
+
+	b = rte_reorder_create("test_insert_bulk", rte_socket_id(), size);
+	TEST_ASSERT_NOT_NULL(b, "Failed to create reorder buffer");
+
+	/* seqn: 0, 2, 1, 4, 3, 6, 5, 7, then 24 (late) and 9, 10, 11 */
+	for (i = 0; i < num_bufs; i++) {
+		bufs[i] = rte_pktmbuf_alloc(p);
+		TEST_ASSERT_NOT_NULL(bufs[i], "Packet allocation failed\n");
+		bufs[i]->seqn = (i == 0 || i >= size - 1) ? i :
+				((i - 1) ^ 1) + 1;
+		robufs[i] = NULL;
+	}
+	bufs[size]->seqn = 3 * size;
+
+	/* Stops at the late packet */
+	cnt = rte_reorder_insert_bulk(b, bufs, num_bufs);
+	for (i = 0; i < cnt; i++)
+		bufs[i] = NULL;
+	if (cnt != size || rte_errno != ERANGE) {
+		printf("%s:%d: Wrong bulk insert count %u\n",
+				__func__, __LINE__, cnt);
+		ret = -1;
+		goto exit;
+	}
+
+	cnt = rte_reorder_insert_bulk(b, &bufs[size + 1],
+			num_bufs - size - 1);
+	for (i = 0; i < cnt; i++)
+		bufs[size + 1 + i] = NULL;
+	if (cnt != num_bufs - size - 1) {
+		printf("%s:%d: Wrong bulk insert count %u\n",
+				__func__, __LINE__, cnt);
+		ret = -1;
+		goto exit;
+	}
+
+	/* 0..7 in order, then the gap at 8 holds 9..11 back */
+	cnt = rte_reorder_drain(b, robufs, num_bufs);
+	if (cnt != size) {
+		printf("%s:%d:%u: number of expected packets not drained\n",
+				__func__, __LINE__, cnt);
+		ret = -1;
+		goto exit;
+	}
+	for (i = 0; i < cnt; i++) {
+		if (robufs[i]->seqn != i) {
+			printf("%s:%d: Packet %u drained out of order\n",
+					__func__, __LINE__, i);
+			ret = -1;
+			goto exit;
+		}
+	}
+exit:
+	rte_reorder_free(b);
+	for (i = 0; i < num_bufs; i++) {
+		if (bufs[i] != NULL)
+			rte_pktmbuf_free(bufs[i]);
+		if (robufs[i] != NULL)
+			rte_pktmbuf_free(robufs[i]);
+	}
+	return ret;
+}
+
+static int
+test_reorder_drain_overflow(void)
+{
+	struct rte_reorder_buffer *b = NULL;
+	struct rte_mempool *p = test_params->p;
+	const unsigned int size = 8;
+	const unsigned int num_bufs = 10;
+	struct rte_mbuf *bufs[num_bufs];
+	struct rte_mbuf *robufs[num_bufs];
+	unsigned int i, cnt;
+	int ret = 0;
+
+	b = rte_reorder_create("test_drain_overflow", rte_socket_id(), size);
+	TEST_ASSERT_NOT_NULL(b, "Failed to create reorder buffer");
+
+	for (i = 0; i < num_bufs; i++) {
+		bufs[i] = rte_pktmbuf_alloc(p);
+		TEST_ASSERT_NOT_NULL(bufs[i], "Packet allocation failed\n");
+		bufs[i]->seqn = i;
+		robufs[i] = NULL;
+	}
+
+	/* Fill the window [0, 7] and drain it */
+	for (i = 0; i < size; i++) {
+		if (rte_reorder_insert(b, bufs[i]) != 0) {
+			printf("%s:%d: Error inserting packet with seqn less than"
+					" size\n", __func__, __LINE__);
+			ret = -1;
+			goto exit;
+		}
+		bufs[i] = NULL;
+	}
+
+	cnt = rte_reorder_drain(b, robufs, num_bufs);
+	if (cnt != size) {
+		printf("%s:%d:%u: number of expected packets not drained\n",
+				__func__, __LINE__, cnt);
+		ret = -1;
+		goto exit;
+	}
+	for (i = 0; i < cnt; i++) {
+		rte_pktmbuf_free(robufs[i]);
+		robufs[i] = NULL;
+	}
+
+	/*
+	 * Window is [8, 15]: insert 9, then 16 which overflows it, skips the
+	 * missing 8 and moves 9 to the ready buffer through drained entries.
+	 */
+	bufs[9]->seqn = 9;
+	bufs[8]->seqn = 16;
+	if (rte_reorder_insert(b, bufs[9]) != 0 ||
+			rte_reorder_insert(b, bufs[8]) != 0) {
+		printf("%s:%d: Error inserting packets after a drain\n",
+				__func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+	bufs[8] = bufs[9] = NULL;
+
+	/* Only 9 is ready, 10 to 15 are missing in front of 16 */
+	cnt = rte_reorder_drain(b, robufs, num_bufs);
+	if (cnt != 1 || robufs[0]->seqn != 9) {
+		printf("%s:%d:%u: number of expected packets not drained\n",
+				__func__, __LINE__, cnt);
+		ret = -1;
+		goto exit;
+	}
+exit:
+	rte_reorder_free(b);
+	for (i = 0; i < num_bufs; i++) {
+		if (bufs[i] != NULL)
+			rte_pktmbuf_free(bufs[i]);
+		if (robufs[i] != NULL)
+			rte_pktmbuf_free(robufs[i]);
+	}
+	return ret;
+}
+
+static int
+test_reorder_mp_insert(void)
+{
+	struct rte_reorder_buffer *b = NULL;
+	struct rte_mempool *p = test_params->p;
+	const unsigned int size = 4;
+	const unsigned int num_bufs = 8;
+	struct rte_mbuf *bufs[num_bufs];
+	struct rte_mbuf *robufs[num_bufs];
+	unsigned int i, cnt;
+	int ret = 0;
+
+	b = rte_reorder_create("test_mp_insert", rte_socket_id(), size);
+	TEST_ASSERT_NOT_NULL(b, "Failed to create reorder buffer");
+
+	for (i = 0; i < num_bufs; i++) {
+		bufs[i] = rte_pktmbuf_alloc(p);
+		TEST_ASSERT_NOT_NULL(bufs[i], "Packet allocation failed\n");
+		bufs[i]->seqn = i;
+		robufs[i] = NULL;
+	}
+
+	/* Window is [0, 3], packet 1 is missing */
+	if (rte_reorder_mp_insert_bulk(b, &bufs[0], 1) != 1 ||
+			rte_reorder_mp_insert_bulk(b, &bufs[2], 2) != 2) {
+		printf("%s:%d: Error inserting packets in window\n",
+				__func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+	bufs[0] = bufs[2] = bufs[3] = NULL;
+
+	/* Duplicate sequence number */
+	bufs[6]->seqn = 2;
+	cnt = rte_reorder_mp_insert_bulk(b, &bufs[6], 1);
+	if (cnt != 0 || rte_errno != EEXIST) {
+		printf("%s:%d: No error inserting duplicate packet\n",
+				__func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+	bufs[6]->seqn = 6;
+
+	/* Early packet 5 does not fit until packet 1 is skipped */
+	cnt = rte_reorder_mp_insert_bulk(b, &bufs[5], 1);
+	if (cnt != 0 || rte_errno != ENOSPC) {
+		printf("%s:%d: No error inserting early packet\n",
+				__func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+
+	cnt = rte_reorder_drain(b, robufs, num_bufs);
+	if (cnt != 3 || robufs[0]->seqn != 0 || robufs[1]->seqn != 2 ||
+			robufs[2]->seqn != 3) {
+		printf("%s:%d:%u: number of expected packets not drained\n",
+				__func__, __LINE__, cnt);
+		ret = -1;
+		goto exit;
+	}
+	for (i = 0; i < cnt; i++) {
+		rte_pktmbuf_free(robufs[i]);
+		robufs[i] = NULL;
+	}
+
+	/* Packet 1 was skipped, it is now late */
+	cnt = rte_reorder_mp_insert_bulk(b, &bufs[1], 1);
+	if (cnt != 0 || rte_errno != ERANGE) {
+		printf("%s:%d: No error inserting skipped packet\n",
+				__func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+
+	/* Window moved to [4, 7]: 5 now fits, 4 is still missing */
+	if (rte_reorder_mp_insert_bulk(b, &bufs[5], 3) != 3) {
+		printf("%s:%d: Error inserting packets in window\n",
+				__func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+	bufs[5] = bufs[6] = bufs[7] = NULL;
+
+	cnt = rte_reorder_drain(b, robufs, num_bufs);
+	if (cnt != 0) {
+		printf("%s:%d:%u: drained packets behind a gap\n",
+				__func__, __LINE__, cnt);
+		ret = -1;
+		goto exit;
+	}
+
+	if (rte_reorder_mp_insert_bulk(b, &bufs[4], 1) != 1) {
+		printf("%s:%d: Error inserting packet in window\n",
+				__func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+	bufs[4] = NULL;
+
+	cnt = rte_reorder_drain(b, robufs, num_bufs);
+	if (cnt != 4) {
+		printf("%s:%d:%u: number of expected packets not drained\n",
+				__func__, __LINE__, cnt);
+		ret = -1;
+		goto exit;
+	}
+	for (i = 0; i < cnt; i++) {
+		if (robufs[i]->seqn != i + 4) {
+			printf("%s:%d: Packet %u drained out of order\n",
+					__func__, __LINE__, i);
+			ret = -1;
+			goto exit;
+		}
+	}
+exit:
+	rte_reorder_free(b);
+	for (i = 0; i < num_bufs; i++) {
+		if (bufs[i] != NULL)
+			rte_pktmbuf_free(bufs[i]);
+		if (robufs[i] != NULL)
+			rte_pktmbuf_free(robufs[i]);
+	}
+	return ret;
+}
+
 static int
 test_setup(void)
 {
@@ -380,6 +662,9 @@ static struct unit_test_suite reorder_test_suite  = {
 		TEST_CASE(test_reorder_free),
 		TEST_CASE(test_reorder_insert),
 		TEST_CASE(test_reorder_drain),
+		TEST_CASE(test_reorder_insert_bulk),
+		TEST_CASE(test_reorder_drain_overflow),
+		TEST_CASE(test_reorder_mp_insert),
 		TEST_CASES_END()
 	}
 };
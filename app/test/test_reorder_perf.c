@@ -0,0 +1,265 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2020 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include <rte_cycles.h>
+#include <rte_errno.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_pause.h>
+#include <rte_reorder.h>
+
+#include "test.h"
+
+/*
+ * Reorder performance test cases, measures the cost of inserting mbufs
+ * arriving slightly out of order and draining them back in order, for the
+ * single mbuf, bulk and multi-producer insert APIs.
+ */
+
+#define REORDER_SIZE 1024
+#define BURST 32
+#define NUM_PKTS (1 << 18)
+#define MAX_WORKERS 8u
+
+/* mbufs are only used for their seqn, they never leave this test */
+static struct rte_mbuf *pkts;
+static struct rte_mbuf *pkt_ptrs[NUM_PKTS];
+
+static struct rte_reorder_buffer *perf_b;
+static unsigned int n_workers;
+static volatile uint32_t start;
+static uint32_t n_dropped;
+
+/*
+ * Swap neighbours so that every burst arrives out of order, keeping the
+ * first mbuf of each burst in place as it sets the initial sequence number.
+ */
+static void
+init_pkts(void)
+{
+	unsigned int i, j;
+
+	for (i = 0; i < NUM_PKTS; i++) {
+		j = i % BURST;
+		if (j != 0 && j != BURST - 1)
+			j = ((j - 1) ^ 1) + 1;
+		pkts[i].seqn = i - i % BURST + j;
+		pkt_ptrs[i] = &pkts[i];
+	}
+}
+
+static unsigned int
+drain_all(struct rte_reorder_buffer *b, unsigned int expected)
+{
+	struct rte_mbuf *out[BURST];
+	unsigned int n, total = 0;
+
+	do {
+		n = rte_reorder_drain(b, out, BURST);
+		total += n;
+	} while (n != 0 && total < expected);
+
+	return total;
+}
+
+static int
+test_insert_single(struct rte_reorder_buffer *b)
+{
+	unsigned int i, j, drained = 0;
+	uint64_t begin, end;
+
+	begin = rte_rdtsc();
+	for (i = 0; i < NUM_PKTS; i += BURST) {
+		for (j = 0; j < BURST; j++)
+			if (rte_reorder_insert(b, pkt_ptrs[i + j]) != 0)
+				return -1;
+		drained += drain_all(b, BURST);
+	}
+	end = rte_rdtsc();
+
+	if (drained != NUM_PKTS)
+		return -1;
+
+	printf("single insert + drain: %.2f cycles/pkt\n",
+			(double)(end - begin) / NUM_PKTS);
+	return 0;
+}
+
+static int
+test_insert_bulk(struct rte_reorder_buffer *b)
+{
+	unsigned int i, drained = 0;
+	uint64_t begin, end;
+
+	begin = rte_rdtsc();
+	for (i = 0; i < NUM_PKTS; i += BURST) {
+		if (rte_reorder_insert_bulk(b, &pkt_ptrs[i], BURST) != BURST)
+			return -1;
+		drained += drain_all(b, BURST);
+	}
+	end = rte_rdtsc();
+
+	if (drained != NUM_PKTS)
+		return -1;
+
+	printf("bulk insert + drain: %.2f cycles/pkt\n",
+			(double)(end - begin) / NUM_PKTS);
+	return 0;
+}
+
+static int
+test_mp_insert_bulk(struct rte_reorder_buffer *b)
+{
+	unsigned int i, drained = 0;
+	uint64_t begin, end;
+
+	begin = rte_rdtsc();
+	for (i = 0; i < NUM_PKTS; i += BURST) {
+		if (rte_reorder_mp_insert_bulk(b, &pkt_ptrs[i], BURST) != BURST)
+			return -1;
+		drained += drain_all(b, BURST);
+	}
+	end = rte_rdtsc();
+
+	if (drained != NUM_PKTS)
+		return -1;
+
+	printf("MP bulk insert + drain, single lcore: %.2f cycles/pkt\n",
+			(double)(end - begin) / NUM_PKTS);
+	return 0;
+}
+
+/* Worker w inserts bursts w, w + n_workers, w + 2 * n_workers, ... */
+static int
+mp_insert_worker(void *arg)
+{
+	unsigned int w = (uintptr_t)arg;
+	unsigned int i, n;
+
+	while (start == 0)
+		rte_pause();
+
+	for (i = w * BURST; i < NUM_PKTS; i += n_workers * BURST) {
+		n = 0;
+		while (n < BURST) {
+			n += rte_reorder_mp_insert_bulk(perf_b,
+					&pkt_ptrs[i + n], BURST - n);
+			if (n == BURST || rte_errno == ENOSPC)
+				continue;
+
+			/* Late mbuf, skipped by the drain side: drop it */
+			__atomic_fetch_add(&n_dropped, 1, __ATOMIC_RELAXED);
+			n++;
+		}
+	}
+
+	return 0;
+}
+
+static int
+test_mp_insert_lcores(void)
+{
+	struct rte_mbuf *out[BURST];
+	unsigned int lcore_id, w = 0, drained = 0;
+	uint32_t last_seqn = 0;
+	uint64_t begin, end;
+	int ret = 0;
+	unsigned int i;
+
+	n_workers = RTE_MIN(rte_lcore_count() - 1, MAX_WORKERS);
+	if (n_workers == 0) {
+		printf("MP bulk insert, multiple lcores: skipped, not enough lcores\n");
+		return 0;
+	}
+
+	start = 0;
+	n_dropped = 0;
+	RTE_LCORE_FOREACH_SLAVE(lcore_id) {
+		if (w == n_workers)
+			break;
+		rte_eal_remote_launch(mp_insert_worker,
+				(void *)(uintptr_t)w++, lcore_id);
+	}
+
+	begin = rte_rdtsc();
+	start = 1;
+	while (drained + __atomic_load_n(&n_dropped, __ATOMIC_RELAXED) <
+			NUM_PKTS) {
+		unsigned int n = rte_reorder_drain(perf_b, out, BURST);
+
+		for (i = 0; i < n; i++) {
+			if (drained + i != 0 && out[i]->seqn <= last_seqn)
+				ret = -1;
+			last_seqn = out[i]->seqn;
+		}
+		drained += n;
+	}
+	end = rte_rdtsc();
+
+	RTE_LCORE_FOREACH_SLAVE(lcore_id)
+		if (rte_eal_wait_lcore(lcore_id) < 0)
+			ret = -1;
+
+	if (ret != 0) {
+		printf("MP bulk insert: packets drained out of order\n");
+		return ret;
+	}
+
+	printf("MP bulk insert + drain, %u producer lcores: %.2f cycles/pkt, "
+			"%u late mbufs dropped\n", n_workers,
+			(double)(end - begin) / NUM_PKTS, n_dropped);
+	return 0;
+}
+
+static int
+test_reorder_perf(void)
+{
+	struct rte_reorder_buffer *b;
+	int ret = -1;
+
+	pkts = rte_zmalloc(NULL, NUM_PKTS * sizeof(struct rte_mbuf),
+			RTE_CACHE_LINE_SIZE);
+	if (pkts == NULL) {
+		printf("Cannot allocate mbufs\n");
+		return -1;
+	}
+
+	b = rte_reorder_create("PKT_RO_PERF", rte_socket_id(), REORDER_SIZE);
+	if (b == NULL) {
+		printf("Cannot create reorder buffer\n");
+		goto exit;
+	}
+
+	init_pkts();
+	if (test_insert_single(b) != 0)
+		goto exit;
+
+	rte_reorder_reset(b);
+	if (test_insert_bulk(b) != 0)
+		goto exit;
+
+	rte_reorder_reset(b);
+	if (test_mp_insert_bulk(b) != 0)
+		goto exit;
+
+	rte_reorder_reset(b);
+	perf_b = b;
+	if (test_mp_insert_lcores() != 0)
+		goto exit;
+
+	ret = 0;
+exit:
+	if (ret != 0)
+		printf("Reorder perf test failed\n");
+	rte_reorder_free(b);
+	rte_free(pkts);
+	return ret;
+}
+
+REGISTER_TEST_COMMAND(reorder_perf_autotest, test_reorder_perf);
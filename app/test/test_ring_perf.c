@@ -17,7 +17,8 @@
 
 /*
  * Ring performance test cases, measures performance of various operations
- * using rdtsc for legacy and 16B size ring elements.
+ * using rdtsc for legacy and 16B size ring elements, and of the zero-copy
+ * API for 64B size ring elements.
  */
 
 #define RING_NAME "RING_PERF"
@@ -491,6 +492,149 @@ test_burst_bulk_enqueue_dequeue(struct rte_ring *r, const int esize,
 	return 0;
 }
 
+/* 64B metadata record, as built by a pipeline stage */
+struct zc_record {
+	uint64_t seq;
+	uint64_t data[7];
+};
+
+static __rte_always_inline void
+zc_record_fill(struct zc_record *rec, uint64_t seq)
+{
+	unsigned int i;
+
+	rec->seq = seq;
+	for (i = 0; i < RTE_DIM(rec->data); i++)
+		rec->data[i] = seq + i;
+}
+
+/* fill the records reserved by a zero-copy enqueue, in place */
+static __rte_always_inline void
+zc_records_fill(const struct rte_ring_zc_data *zcd, unsigned int n,
+	uint64_t *seq)
+{
+	struct zc_record *rec = zcd->ptr1;
+	unsigned int i;
+
+	for (i = 0; i < zcd->n1; i++)
+		zc_record_fill(&rec[i], (*seq)++);
+	rec = zcd->ptr2;
+	for (; i < n; i++)
+		zc_record_fill(rec++, (*seq)++);
+}
+
+/* check the records returned by a zero-copy dequeue, in place */
+static __rte_always_inline unsigned int
+zc_records_check(const struct rte_ring_zc_data *zcd, unsigned int n,
+	uint64_t *seq)
+{
+	const struct zc_record *rec = zcd->ptr1;
+	unsigned int i, err = 0;
+
+	for (i = 0; i < zcd->n1; i++)
+		err += rec[i].seq != (*seq)++;
+	rec = zcd->ptr2;
+	for (; i < n; i++, rec++)
+		err += rec->seq != (*seq)++;
+	return err;
+}
+
+/*
+ * Compare building records in a local table and copying them with the
+ * bulk elem API, to building and reading them in place with the zero-copy
+ * API.
+ */
+static int
+test_zero_copy_bulk(struct rte_ring *r, const char *mode)
+{
+	const unsigned int iterations = 1 << 20;
+	struct zc_record recs[MAX_BURST];
+	struct rte_ring_zc_data zcd;
+	uint64_t start, copy, zc;
+	uint64_t eseq, dseq;
+	unsigned int sz, i, j, n, err = 0;
+
+	for (sz = 0; sz < RTE_DIM(bulk_sizes); sz++) {
+		const unsigned int bsz = bulk_sizes[sz];
+
+		eseq = dseq = 0;
+		start = rte_rdtsc();
+		for (i = 0; i < iterations; i++) {
+			for (j = 0; j < bsz; j++)
+				zc_record_fill(&recs[j], eseq++);
+			rte_ring_enqueue_bulk_elem(r, recs, sizeof(recs[0]),
+				bsz, NULL);
+			rte_ring_dequeue_bulk_elem(r, recs, sizeof(recs[0]),
+				bsz, NULL);
+			for (j = 0; j < bsz; j++)
+				err += recs[j].seq != dseq++;
+		}
+		copy = rte_rdtsc() - start;
+
+		eseq = dseq = 0;
+		start = rte_rdtsc();
+		for (i = 0; i < iterations; i++) {
+			n = rte_ring_enqueue_zc_bulk_elem_start(r,
+				sizeof(recs[0]), bsz, &zcd, NULL);
+			zc_records_fill(&zcd, n, &eseq);
+			rte_ring_enqueue_zc_elem_finish(r, n);
+			n = rte_ring_dequeue_zc_bulk_elem_start(r,
+				sizeof(recs[0]), bsz, &zcd, NULL);
+			err += zc_records_check(&zcd, n, &dseq);
+			rte_ring_dequeue_zc_elem_finish(r, n);
+		}
+		zc = rte_rdtsc() - start;
+
+		if (err != 0 || eseq != dseq ||
+				dseq != (uint64_t)iterations * bsz) {
+			printf("%s: invalid records dequeued\n", mode);
+			return -1;
+		}
+
+		printf("%s 64B records bulk (size: %u): "
+			"enqueue_bulk_elem %.2F, zero-copy %.2F cycles\n",
+			mode, bsz, (double)copy / iterations,
+			(double)zc / iterations);
+	}
+
+	return 0;
+}
+
+static int
+test_ring_perf_zero_copy(void)
+{
+	static const struct {
+		const char *mode;
+		unsigned int flags;
+	} modes[] = {
+		{ "SP/SC", RING_F_SP_ENQ | RING_F_SC_DEQ },
+		{ "MP_HTS/MC_HTS", RING_F_MP_HTS_ENQ | RING_F_MC_HTS_DEQ },
+	};
+	struct zc_record rec = { 0 };
+	struct rte_ring *r;
+	unsigned int i;
+	int ret;
+
+	printf("\n### Testing zero-copy enq/deq ###\n");
+	for (i = 0; i < RTE_DIM(modes); i++) {
+		r = rte_ring_create_elem(RING_NAME, sizeof(rec), RING_SIZE,
+			rte_socket_id(), modes[i].flags);
+		if (r == NULL)
+			return -1;
+
+		/* unaligned start, so that reservations wrap around */
+		rte_ring_enqueue_bulk_elem(r, &rec, sizeof(rec), 1, NULL);
+		rte_ring_dequeue_bulk_elem(r, &rec, sizeof(rec), 1, NULL);
+
+		ret = test_zero_copy_bulk(r, modes[i].mode);
+		rte_ring_free(r);
+		if (ret < 0)
+			return -1;
+	}
+
+	return 0;
+}
+
 /* Run all tests for a given element size */
 static __rte_always_inline int
 test_ring_perf_esize(const int esize)
@@ -577,6 +721,9 @@ test_ring_perf(void)
 	if (test_ring_perf_esize(16) == -1)
 		return -1;
 
+	if (test_ring_perf_zero_copy() == -1)
+		return -1;
+
 	return 0;
 }
 
@@ -114,6 +114,89 @@ prepare_pkt(struct rte_sched_port *port, struct rte_mbuf *mbuf)
 }
 
 
+#define SHARD_PKTS      8
+
+/* Shard a two subport port and drain it through the arbiter */
+static int
+test_sched_shard(struct rte_mempool *mp)
+{
+	struct rte_sched_port_params params = port_param;
+	struct rte_sched_port_shard_params shard_params;
+	static const uint32_t subport_shard[] = {0, 1};
+	struct rte_mbuf *in_mbufs[2 * SHARD_PKTS];
+	struct rte_mbuf *out_mbufs[2 * SHARD_PKTS];
+	uint32_t n_subport_pkts[2] = {0, 0};
+	struct rte_sched_port *port;
+	uint32_t subport, pipe;
+	int i, err;
+
+	params.n_subports_per_port = 2;
+	port = rte_sched_port_config(&params);
+	TEST_ASSERT_NOT_NULL(port, "Error config sched port\n");
+
+	for (subport = 0; subport < 2; subport++) {
+		err = rte_sched_subport_config(port, subport, subport_param);
+		TEST_ASSERT_SUCCESS(err, "Error config sched, err=%d\n", err);
+
+		for (pipe = 0; pipe < subport_param[0].n_pipes_per_subport_enabled;
+				pipe++) {
+			err = rte_sched_pipe_config(port, subport, pipe, 0);
+			TEST_ASSERT_SUCCESS(err,
+				"Error config sched pipe %u, err=%d\n", pipe, err);
+		}
+	}
+
+	shard_params.n_shards = 2;
+	shard_params.subport_shard = subport_shard;
+	shard_params.ring_size = 2 * SHARD_PKTS;
+	err = rte_sched_port_shard_config(port, &shard_params);
+	TEST_ASSERT_SUCCESS(err, "Error config sched shards, err=%d\n", err);
+
+	err = rte_sched_port_shard_config(port, &shard_params);
+	TEST_ASSERT_EQUAL(err, -EEXIST, "Port sharded twice, err=%d\n", err);
+
+	for (i = 0; i < 2 * SHARD_PKTS; i++) {
+		in_mbufs[i] = rte_pktmbuf_alloc(mp);
+		TEST_ASSERT_NOT_NULL(in_mbufs[i], "Packet allocation failed\n");
+		prepare_pkt(port, in_mbufs[i]);
+		rte_sched_port_pkt_write(port, in_mbufs[i], i / SHARD_PKTS,
+			PIPE, TC, QUEUE, RTE_COLOR_YELLOW);
+	}
+
+	/* Each worker enqueues the packets of its own subport */
+	for (i = 0; i < 2; i++) {
+		err = rte_sched_port_enqueue(port, &in_mbufs[i * SHARD_PKTS],
+			SHARD_PKTS);
+		TEST_ASSERT_EQUAL(err, SHARD_PKTS, "Wrong enqueue, err=%d\n", err);
+	}
+
+	for (i = 0; i < 2; i++) {
+		err = rte_sched_port_shard_dequeue(port, i, 2 * SHARD_PKTS);
+		TEST_ASSERT_EQUAL(err, SHARD_PKTS,
+			"Wrong shard %d dequeue, err=%d\n", i, err);
+	}
+
+	err = rte_sched_port_arbiter_dequeue(port, out_mbufs, 2 * SHARD_PKTS);
+	TEST_ASSERT_EQUAL(err, 2 * SHARD_PKTS, "Wrong arbiter dequeue, err=%d\n",
+		err);
+
+	for (i = 0; i < 2 * SHARD_PKTS; i++) {
+		uint32_t traffic_class, queue;
+
+		rte_sched_port_pkt_read_tree_path(port, out_mbufs[i],
+				&subport, &pipe, &traffic_class, &queue);
+		TEST_ASSERT(subport < 2, "Wrong subport\n");
+		n_subport_pkts[subport]++;
+	}
+	TEST_ASSERT(n_subport_pkts[0] == SHARD_PKTS &&
+		n_subport_pkts[1] == SHARD_PKTS, "Wrong arbiter output\n");
+
+	rte_pktmbuf_free_bulk(out_mbufs, 2 * SHARD_PKTS);
+	rte_sched_port_free(port);
+
+	return 0;
+}
+
 /**
  * test main entrance for library sched
  */
@@ -192,7 +275,7 @@ test_sched(void)
 
 	rte_sched_port_free(port);
 
-	return 0;
+	return test_sched_shard(mp);
 }
 
 REGISTER_TEST_COMMAND(sched_autotest, test_sched);
@@ -399,6 +399,273 @@ timer_stress2_main_loop(__rte_unused void *arg)
 	return 0;
 }
 
+#define STRESS3_BURST 32
+
+/* third stress test, using the bulk API: all cores hand off bursts of
+ * timers to the master lcore, which then stops half of them in bulk */
+static int
+timer_stress3_main_loop(__rte_unused void *arg)
+{
+	static struct rte_timer *timers;
+	struct rte_timer *burst[STRESS3_BURST];
+	uint64_t delay = rte_get_timer_hz() / 20;
+	unsigned lcore_id = rte_lcore_id();
+	unsigned master = rte_get_master_lcore();
+	int i, j, n, ret;
+
+	if (lcore_id == master) {
+		cb_count = 0;
+		test_failed = 0;
+		master_init_slaves();
+		timers = rte_malloc(NULL, sizeof(*timers) * NB_STRESS2_TIMERS, 0);
+		if (timers == NULL) {
+			printf("Test Failed\n");
+			printf("- Cannot allocate memory for timers\n" );
+			test_failed = 1;
+			master_start_slaves();
+			goto cleanup;
+		}
+		for (i = 0; i < NB_STRESS2_TIMERS; i++)
+			rte_timer_init(&timers[i]);
+		master_start_slaves();
+	} else {
+		slave_wait_to_start();
+		if (test_failed)
+			goto cleanup;
+	}
+
+	/* have all cores schedule all timers on master lcore, skipping
+	 * the ones being configured by another core */
+	for (i = 0; i < NB_STRESS2_TIMERS; i += n) {
+		n = RTE_MIN(STRESS3_BURST, NB_STRESS2_TIMERS - i);
+		for (j = 0; j < n; j++)
+			burst[j] = &timers[i + j];
+		ret = rte_timer_reset_bulk(burst, n, delay, SINGLE, master,
+				timer_stress2_cb, NULL);
+		if (ret < n)
+			n = ret + 1;
+	}
+
+	/* wait long enough for timers to expire */
+	rte_delay_ms(100);
+
+	if (lcore_id != master) {
+		slave_finish();
+		return 0;
+	}
+	master_wait_for_slaves();
+
+	rte_timer_manage();
+	if (cb_count != NB_STRESS2_TIMERS) {
+		printf("Test Failed\n");
+		printf("- Stress test 3, part 1 failed\n");
+		printf("- Expected %d callbacks, got %d\n", NB_STRESS2_TIMERS,
+				cb_count);
+		test_failed = 1;
+		goto cleanup;
+	}
+	cb_count = 0;
+
+	/* arm all timers locally, then stop the odd ones */
+	for (i = 0; i < NB_STRESS2_TIMERS; i += n) {
+		n = RTE_MIN(STRESS3_BURST, NB_STRESS2_TIMERS - i);
+		for (j = 0; j < n; j++)
+			burst[j] = &timers[i + j];
+		ret = rte_timer_reset_bulk(burst, n, delay, SINGLE, master,
+				timer_stress2_cb, NULL);
+		for (j = 0; j < n / 2; j++)
+			burst[j] = &timers[i + 2 * j + 1];
+		ret += rte_timer_stop_bulk(burst, n / 2);
+		if (ret != n + n / 2) {
+			printf("Test Failed\n");
+			printf("- Stress test 3, bulk calls failed\n");
+			test_failed = 1;
+			goto cleanup;
+		}
+	}
+
+	rte_delay_ms(100);
+	rte_timer_manage();
+	if (cb_count != NB_STRESS2_TIMERS / 2) {
+		printf("Test Failed\n");
+		printf("- Stress test 3, part 2 failed\n");
+		printf("- Expected %d callbacks, got %d\n",
+				NB_STRESS2_TIMERS / 2, cb_count);
+		test_failed = 1;
+	} else {
+		printf("Test OK\n");
+	}
+
+cleanup:
+	if (lcore_id == master) {
+		rte_free(timers);
+		timers = NULL;
+	} else {
+		slave_finish();
+	}
+
+	return 0;
+}
+
+static struct rte_timer stress4_lock_tim;
+static volatile int stress4_refresh;
+static rte_atomic32_t stress4_refreshed;
+
+/* called for each timer pending on the master lcore, with its list lock
+ * held: let the slave lcores refresh the timers and wait for them */
+static void
+timer_stress4_stop_cb(struct rte_timer *tim, void *arg __rte_unused)
+{
+	uint64_t end = rte_get_timer_cycles() + rte_get_timer_hz();
+
+	if (tim != &stress4_lock_tim)
+		return;
+
+	stress4_refresh = 1;
+	while (rte_atomic32_read(&stress4_refreshed) != (int)rte_lcore_count() - 1) {
+		if (rte_get_timer_cycles() > end) {
+			printf("Test Failed\n");
+			printf("- Stress test 4, refresh took a remote list lock\n");
+			test_failed = 1;
+			return;
+		}
+		rte_pause();
+	}
+}
+
+static void
+timer_stress4_cb(struct rte_timer *tim __rte_unused)
+{
+	cb_count++;
+}
+
+/* fourth stress test: all slave lcores refresh in bulk timers pending on
+ * the master lcore, while the master lcore holds its list lock */
+static int
+timer_stress4_main_loop(__rte_unused void *arg)
+{
+	static struct rte_timer *timers;
+	static uint32_t data_id;
+	static int data_allocated;
+	struct rte_timer *burst[STRESS3_BURST];
+	uint64_t hz = rte_get_timer_hz();
+	unsigned lcore_id = rte_lcore_id();
+	unsigned master = rte_get_master_lcore();
+	unsigned nb_slaves = rte_lcore_count() - 1;
+	unsigned rank = 0, slave_id, per_slave, first, last;
+	int i, j, n, ret;
+
+	if (lcore_id == master) {
+		cb_count = 0;
+		test_failed = 0;
+		stress4_refresh = 0;
+		rte_atomic32_set(&stress4_refreshed, 0);
+		master_init_slaves();
+		timers = rte_malloc(NULL, sizeof(*timers) * NB_STRESS2_TIMERS, 0);
+		data_allocated = rte_timer_data_alloc(&data_id) == 0;
+		if (timers == NULL || !data_allocated) {
+			printf("Test Failed\n");
+			printf("- Cannot allocate timers\n");
+			test_failed = 1;
+			master_start_slaves();
+			goto cleanup;
+		}
+
+		/* the timer used to hold the list lock expires first */
+		rte_timer_init(&stress4_lock_tim);
+		rte_timer_alt_reset(data_id, &stress4_lock_tim, hz, SINGLE,
+				master, NULL, NULL);
+		for (i = 0; i < NB_STRESS2_TIMERS; i += n) {
+			n = RTE_MIN(STRESS3_BURST, NB_STRESS2_TIMERS - i);
+			for (j = 0; j < n; j++) {
+				rte_timer_init(&timers[i + j]);
+				burst[j] = &timers[i + j];
+			}
+			rte_timer_alt_reset_bulk(data_id, burst, n, 2 * hz,
+					SINGLE, master, NULL, NULL);
+		}
+		master_start_slaves();
+
+		rte_timer_stop_all(data_id, &master, 1, timer_stress4_stop_cb,
+				NULL);
+		master_wait_for_slaves();
+		if (test_failed)
+			goto cleanup;
+
+		/* the refreshed timers are waiting for the master lcore */
+		for (i = 0; i < NB_STRESS2_TIMERS; i++) {
+			if (rte_timer_pending(&timers[i])) {
+				printf("Test Failed\n");
+				printf("- Stress test 4, timer %d not handed off\n",
+						i);
+				test_failed = 1;
+				goto cleanup;
+			}
+		}
+
+		rte_timer_alt_manage(data_id, NULL, 0, timer_stress4_cb);
+		rte_delay_ms(100);
+		rte_timer_alt_manage(data_id, NULL, 0, timer_stress4_cb);
+		if (cb_count != NB_STRESS2_TIMERS) {
+			printf("Test Failed\n");
+			printf("- Stress test 4 failed\n");
+			printf("- Expected %d callbacks, got %d\n",
+					NB_STRESS2_TIMERS, cb_count);
+			test_failed = 1;
+		} else {
+			printf("Test OK\n");
+		}
+		goto cleanup;
+	}
+
+	slave_wait_to_start();
+	if (test_failed)
+		goto cleanup;
+
+	RTE_LCORE_FOREACH_SLAVE(slave_id) {
+		if (slave_id == lcore_id)
+			break;
+		rank++;
+	}
+	per_slave = NB_STRESS2_TIMERS / nb_slaves;
+	first = rank * per_slave;
+	last = rank == nb_slaves - 1 ? NB_STRESS2_TIMERS : first + per_slave;
+
+	while (stress4_refresh == 0)
+		rte_pause();
+
+	/* refresh the timers of this slave, pending on the master lcore */
+	for (i = first; i < (int)last; i += n) {
+		n = RTE_MIN(STRESS3_BURST, (int)last - i);
+		for (j = 0; j < n; j++)
+			burst[j] = &timers[i + j];
+		ret = rte_timer_alt_reset_bulk(data_id, burst, n, hz / 20,
+				SINGLE, master, NULL, NULL);
+		if (ret != n) {
+			printf("Test Failed\n");
+			printf("- Stress test 4, refresh failed\n");
+			test_failed = 1;
+			break;
+		}
+	}
+	rte_atomic32_inc(&stress4_refreshed);
+
+cleanup:
+	if (lcore_id == master) {
+		if (data_allocated) {
+			rte_timer_stop_all(data_id, &master, 1, NULL, NULL);
+			rte_timer_data_dealloc(data_id);
+			data_allocated = 0;
+		}
+		rte_free(timers);
+		timers = NULL;
+	} else {
+		slave_finish();
+	}
+
+	return 0;
+}
+
 /* timer callback for basic tests */
 static void
 timer_basic_cb(struct rte_timer *tim, void *arg)
@@ -577,6 +844,25 @@ test_timer(void)
 	if (test_failed)
 		return TEST_FAILED;
 
+	/* run the second set of stress tests with the bulk API */
+	printf("\nStart timer stress tests 3\n");
+	test_failed = 0;
+	rte_eal_mp_remote_launch(timer_stress3_main_loop, NULL, CALL_MASTER);
+	rte_eal_mp_wait_lcore();
+	if (test_failed)
+		return TEST_FAILED;
+
+	/* refresh timers pending on another lcore without taking its lock */
+	if (rte_lcore_count() > 1) {
+		printf("\nStart timer stress tests 4\n");
+		test_failed = 0;
+		rte_eal_mp_remote_launch(timer_stress4_main_loop, NULL,
+				CALL_MASTER);
+		rte_eal_mp_wait_lcore();
+		if (test_failed)
+			return TEST_FAILED;
+	}
+
 	/* calculate the "end of test" time */
 	cur_time = rte_get_timer_cycles();
 	hz = rte_get_timer_hz();
@@ -33,6 +33,109 @@ timer_cb(struct rte_timer *t __rte_unused, void *param __rte_unused)
 #define do_delay() rte_pause()
 #endif
 
+/* Number of timers of the backend comparison, from min to max by x10 */
+#define BACKEND_MIN_TIMERS 1000000
+#define BACKEND_MAX_TIMERS 10000000
+/* Timers expire at random in [1, 2) times this delay */
+#define BACKEND_DELAY_MS 100
+
+static unsigned int early_count;
+
+static void
+backend_timer_cb(struct rte_timer *tim)
+{
+	if (tim->expire > rte_get_timer_cycles())
+		early_count++;
+	outstanding_count--;
+}
+
+static int
+timer_perf_backend(enum rte_timer_backend backend, const char *name,
+		   struct rte_timer *tms, unsigned int nb_timers)
+{
+	const uint64_t delay = rte_get_timer_hz() * BACKEND_DELAY_MS / MS_PER_S;
+	uint64_t start_tsc, arm_tsc, cancel_tsc, expire_tsc;
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int i, nb_calls = 0;
+	uint32_t id;
+	int ret;
+
+	ret = rte_timer_data_alloc_backend(&id, backend);
+	if (ret < 0) {
+		printf("Cannot allocate %s timer data: %d\n", name, ret);
+		return -1;
+	}
+
+	for (i = 0; i < nb_timers; i++)
+		rte_timer_init(&tms[i]);
+
+	start_tsc = rte_rdtsc();
+	for (i = 0; i < nb_timers; i++)
+		rte_timer_alt_reset(id, &tms[i], delay + rte_rand() % delay,
+				    SINGLE, lcore_id, NULL, NULL);
+	arm_tsc = rte_rdtsc() - start_tsc;
+
+	/* cancel every other timer */
+	start_tsc = rte_rdtsc();
+	for (i = 0; i < nb_timers; i += 2)
+		rte_timer_alt_stop(id, &tms[i]);
+	cancel_tsc = rte_rdtsc() - start_tsc;
+
+	/* wait for all the remaining timers to be due, then expire them */
+	rte_delay_us_block(2 * BACKEND_DELAY_MS * 1000);
+	outstanding_count = nb_timers / 2;
+	early_count = 0;
+	start_tsc = rte_rdtsc();
+	while (outstanding_count > 0 && nb_calls++ < 1000)
+		rte_timer_alt_manage(id, NULL, 0, backend_timer_cb);
+	expire_tsc = rte_rdtsc() - start_tsc;
+
+	printf("%-8s %8u timers: arm %4"PRIu64", cancel %4"PRIu64
+	       ", expire %4"PRIu64" cycles/timer\n", name, nb_timers,
+	       arm_tsc / nb_timers, cancel_tsc / (nb_timers / 2),
+	       expire_tsc / (nb_timers / 2));
+
+	rte_timer_data_dealloc(id);
+
+	if (outstanding_count != 0 || early_count != 0) {
+		printf("Error: %s outstanding %d, early %u\n", name,
+		       outstanding_count, early_count);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+test_timer_perf_backends(void)
+{
+	struct rte_timer *tms;
+	unsigned int nb_timers;
+
+	printf("\nComparing timer backends\n");
+	for (nb_timers = BACKEND_MIN_TIMERS; nb_timers <= BACKEND_MAX_TIMERS;
+	     nb_timers *= 10) {
+		tms = rte_malloc(NULL, sizeof(*tms) * nb_timers, 0);
+		if (tms == NULL) {
+			printf("Not enough memory for %u timers, skipping\n",
+			       nb_timers);
+			break;
+		}
+
+		if (timer_perf_backend(RTE_TIMER_BACKEND_SKIPLIST, "skiplist",
+				       tms, nb_timers) < 0 ||
+		    timer_perf_backend(RTE_TIMER_BACKEND_WHEEL, "wheel",
+				       tms, nb_timers) < 0) {
+			rte_free(tms);
+			return -1;
+		}
+
+		rte_free(tms);
+	}
+
+	return 0;
+}
+
 static int
 test_timer_perf(void)
 {
@@ -128,7 +231,8 @@ test_timer_perf(void)
 			(end_tsc - start_tsc + iterations/2) / iterations);
 
 	rte_free(tms);
-	return 0;
+
+	return test_timer_perf_backends();
 }
 
 REGISTER_TEST_COMMAND(timer_perf_autotest, test_timer_perf);
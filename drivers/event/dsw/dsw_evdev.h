@@ -99,6 +99,23 @@
 
 #define DSW_MAX_FLOWS_PER_MIGRATION (8)
 
+/* Under a mild imbalance, only a single flow is migrated per round,
+ * to avoid overshooting. Only when the difference between the source
+ * port's load and the least loaded port's load is beyond this
+ * threshold, up to DSW_MAX_FLOWS_PER_MIGRATION flows are moved at
+ * once, to more quickly get out of the overload situation.
+ */
+#define DSW_HEAVY_IMBALANCE_THRESHOLD (DSW_LOAD_FROM_PERCENT(25))
+
+/* Migrating a flow to a port used by an lcore on another NUMA node
+ * means the flow's state (both the application's and the scheduler's
+ * own) will be accessed across the interconnect. Such a migration is
+ * only considered if the expected improvement in balance is larger
+ * than this cost, and a port on the same node is preferred over a
+ * remote one with up to this much more load.
+ */
+#define DSW_REMOTE_MIGRATION_COST (DSW_LOAD_FROM_PERCENT(10))
+
 /* Only one outstanding migration per port is allowed */
 #define DSW_MAX_PAUSED_FLOWS (DSW_MAX_PORTS*DSW_MAX_FLOWS_PER_MIGRATION)
 
@@ -172,6 +189,13 @@ struct dsw_port {
 	uint64_t emigration_start;
 	uint64_t emigrations;
 	uint64_t emigration_latency;
+	uint64_t max_emigration_latency;
+	uint64_t remote_emigrations;
+
+	/* Estimated load of the heaviest flow seen when emigration was
+	 * last considered.
+	 */
+	int16_t max_flow_load;
 
 	uint8_t emigration_target_port_ids[DSW_MAX_FLOWS_PER_MIGRATION];
 	struct dsw_queue_flow
@@ -222,6 +246,11 @@ struct dsw_port {
 	rte_atomic16_t load __rte_cache_aligned;
 	/* Estimate of flows currently migrating to this port. */
 	rte_atomic32_t immigration_load __rte_cache_aligned;
+
+	/* NUMA node of the lcore last seen using this port, or
+	 * SOCKET_ID_ANY if unknown.
+	 */
+	int32_t socket_id;
 } __rte_cache_aligned;
 
 struct dsw_queue {
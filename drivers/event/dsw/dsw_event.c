@@ -13,6 +13,7 @@
 
 #include <rte_atomic.h>
 #include <rte_cycles.h>
+#include <rte_lcore.h>
 #include <rte_memcpy.h>
 #include <rte_random.h>
 
@@ -359,6 +360,19 @@ dsw_sort_qfs_to_bursts(struct dsw_queue_flow *qfs, uint16_t qfs_len,
 	return num_bursts;
 }
 
+static uint16_t
+dsw_max_burst_count(const struct dsw_queue_flow_burst *bursts,
+		    uint16_t num_bursts)
+{
+	uint16_t max_count = 0;
+	uint16_t i;
+
+	for (i = 0; i < num_bursts; i++)
+		max_count = RTE_MAX(max_count, bursts[i].count);
+
+	return max_count;
+}
+
 static bool
 dsw_retrieve_port_loads(struct dsw_evdev *dsw, int16_t *port_loads,
 			int16_t load_limit)
@@ -388,9 +402,35 @@ dsw_flow_load(uint16_t num_events, int16_t port_load)
 		DSW_MAX_EVENTS_RECORDED;
 }
 
+static bool
+dsw_ports_on_different_nodes(struct dsw_evdev *dsw, uint8_t port_id_a,
+			     uint8_t port_id_b)
+{
+	int32_t socket_a = __atomic_load_n(&dsw->ports[port_id_a].socket_id,
+					   __ATOMIC_RELAXED);
+	int32_t socket_b = __atomic_load_n(&dsw->ports[port_id_b].socket_id,
+					   __ATOMIC_RELAXED);
+
+	/* Ports not (yet) used by any EAL thread are assumed to be
+	 * local.
+	 */
+	return socket_a != SOCKET_ID_ANY && socket_b != SOCKET_ID_ANY &&
+		socket_a != socket_b;
+}
+
+static int16_t
+dsw_migration_cost(struct dsw_evdev *dsw, uint8_t source_port_id,
+		   uint8_t target_port_id)
+{
+	if (dsw_ports_on_different_nodes(dsw, source_port_id, target_port_id))
+		return DSW_REMOTE_MIGRATION_COST;
+
+	return 0;
+}
+
 static int16_t
 dsw_evaluate_migration(int16_t source_load, int16_t target_load,
-		       int16_t flow_load)
+		       int16_t flow_load, int16_t migration_cost)
 {
 	int32_t res_target_load;
 	int32_t imbalance;
@@ -400,23 +440,23 @@ dsw_evaluate_migration(int16_t source_load, int16_t target_load,
 
 	imbalance = source_load - target_load;
 
-	if (imbalance < DSW_REBALANCE_THRESHOLD)
+	if (imbalance < DSW_REBALANCE_THRESHOLD + migration_cost)
 		return -1;
 
 	res_target_load = target_load + flow_load;
 
-	/* If the estimated load of the target port will be higher
-	 * than the source port's load, it doesn't make sense to move
-	 * the flow.
+	/* If the estimated load of the target port, including the
+	 * cost of the move, will be higher than the source port's
+	 * load, it doesn't make sense to move the flow.
 	 */
-	if (res_target_load > source_load)
+	if (res_target_load + migration_cost > source_load)
 		return -1;
 
 	/* The more idle the target will be, the better. This will
 	 * make migration prefer moving smaller flows, and flows to
-	 * lightly loaded ports.
+	 * lightly loaded ports, on the same NUMA node.
 	 */
-	return DSW_MAX_LOAD - res_target_load;
+	return DSW_MAX_LOAD - res_target_load - migration_cost;
 }
 
 static bool
@@ -465,6 +505,7 @@ dsw_select_emigration_target(struct dsw_evdev *dsw,
 
 		for (port_id = 0; port_id < num_ports; port_id++) {
 			int16_t weight;
+			int16_t cost;
 
 			if (port_id == source_port_id)
 				continue;
@@ -472,9 +513,12 @@ dsw_select_emigration_target(struct dsw_evdev *dsw,
 			if (!dsw_is_serving_port(dsw, port_id, qf->queue_id))
 				continue;
 
+			cost = dsw_migration_cost(dsw, source_port_id,
+						  port_id);
+
 			weight = dsw_evaluate_migration(source_port_load,
 							port_loads[port_id],
-							flow_load);
+							flow_load, cost);
 
 			if (weight > candidate_weight) {
 				candidate_qf = qf;
@@ -508,6 +552,27 @@ dsw_select_emigration_target(struct dsw_evdev *dsw,
 	return true;
 }
 
+/* Only move several flows in one round if the source port is far more
+ * loaded than the least loaded of the other ports.
+ */
+static uint16_t
+dsw_max_flows_per_migration(struct dsw_evdev *dsw, uint8_t source_port_id,
+			    const int16_t *port_loads)
+{
+	int16_t min_load = DSW_MAX_LOAD;
+	uint16_t port_id;
+
+	for (port_id = 0; port_id < dsw->num_ports; port_id++)
+		if (port_id != source_port_id)
+			min_load = RTE_MIN(min_load, port_loads[port_id]);
+
+	if (port_loads[source_port_id] - min_load >=
+	    DSW_HEAVY_IMBALANCE_THRESHOLD)
+		return DSW_MAX_FLOWS_PER_MIGRATION;
+
+	return 1;
+}
+
 static void
 dsw_select_emigration_targets(struct dsw_evdev *dsw,
 			      struct dsw_port *source_port,
@@ -517,9 +582,13 @@ dsw_select_emigration_targets(struct dsw_evdev *dsw,
 	struct dsw_queue_flow *target_qfs = source_port->emigration_target_qfs;
 	uint8_t *target_port_ids = source_port->emigration_target_port_ids;
 	uint8_t *targets_len = &source_port->emigration_targets_len;
+	uint16_t max_flows;
 	uint16_t i;
 
-	for (i = 0; i < DSW_MAX_FLOWS_PER_MIGRATION; i++) {
+	max_flows = dsw_max_flows_per_migration(dsw, source_port->id,
+						port_loads);
+
+	for (i = 0; i < max_flows; i++) {
 		bool found;
 
 		found = dsw_select_emigration_target(dsw, bursts, num_bursts,
@@ -712,14 +781,18 @@ dsw_port_flush_paused_events(struct dsw_evdev *dsw,
 }
 
 static void
-dsw_port_emigration_stats(struct dsw_port *port, uint8_t finished)
+dsw_port_emigration_stats(struct dsw_port *port, uint8_t finished,
+			  uint8_t finished_remote)
 {
 	uint64_t flow_migration_latency;
 
 	flow_migration_latency =
 		(rte_get_timer_cycles() - port->emigration_start);
 	port->emigration_latency += (flow_migration_latency * finished);
+	port->max_emigration_latency = RTE_MAX(port->max_emigration_latency,
+					       flow_migration_latency);
 	port->emigrations += finished;
+	port->remote_emigrations += finished_remote;
 }
 
 static void
@@ -730,6 +803,7 @@ dsw_port_end_emigration(struct dsw_evdev *dsw, struct dsw_port *port,
 	struct dsw_queue_flow left_qfs[DSW_MAX_FLOWS_PER_MIGRATION];
 	uint8_t left_port_ids[DSW_MAX_FLOWS_PER_MIGRATION];
 	uint8_t left_qfs_len = 0;
+	uint8_t finished_remote = 0;
 	uint8_t finished;
 
 	for (i = 0; i < port->emigration_targets_len; i++) {
@@ -751,6 +825,10 @@ dsw_port_end_emigration(struct dsw_evdev *dsw, struct dsw_port *port,
 				"queue_id %d flow_hash %d.\n", queue_id,
 				flow_hash);
 
+		if (dsw_ports_on_different_nodes(dsw, port->id,
+					port->emigration_target_port_ids[i]))
+			finished_remote++;
+
 		if (queue_schedule_type == RTE_SCHED_TYPE_ATOMIC) {
 			dsw_port_remove_paused_flow(port, qf);
 			dsw_port_flush_paused_events(dsw, port, qf);
@@ -760,7 +838,7 @@ dsw_port_end_emigration(struct dsw_evdev *dsw, struct dsw_port *port,
 	finished = port->emigration_targets_len - left_qfs_len;
 
 	if (finished > 0)
-		dsw_port_emigration_stats(port, finished);
+		dsw_port_emigration_stats(port, finished, finished_remote);
 
 	for (i = 0; i < left_qfs_len; i++) {
 		port->emigration_target_port_ids[i] = left_port_ids[i];
@@ -875,6 +953,10 @@ dsw_port_consider_emigration(struct dsw_evdev *dsw,
 	num_bursts = dsw_sort_qfs_to_bursts(seen_events, seen_events_len,
 					    bursts);
 
+	source_port->max_flow_load =
+		dsw_flow_load(dsw_max_burst_count(bursts, num_bursts),
+			      source_port_load);
+
 	/* For non-big-little systems, there's no point in moving the
 	 * only (known) flow.
 	 */
@@ -1121,6 +1203,13 @@ dsw_port_bg_process(struct dsw_evdev *dsw, struct dsw_port *port)
 
 		port->last_bg = now;
 
+		/* Track which NUMA node the port is used from, for
+		 * the benefit of other ports picking migration
+		 * targets.
+		 */
+		__atomic_store_n(&port->socket_id, (int32_t)rte_socket_id(),
+				 __ATOMIC_RELAXED);
+
 		/* Logic to avoid having events linger in the output
 		 * buffer too long.
 		 */
@@ -85,6 +85,7 @@ dsw_xstats_port_get_queue_dequeued(struct dsw_evdev *dsw, uint8_t port_id,
 }
 
 DSW_GEN_PORT_ACCESS_FN(emigrations)
+DSW_GEN_PORT_ACCESS_FN(remote_emigrations)
 DSW_GEN_PORT_ACCESS_FN(immigrations)
 
 static uint64_t
@@ -97,6 +98,15 @@ dsw_xstats_port_get_migration_latency(struct dsw_evdev *dsw, uint8_t port_id,
 	return num_emigrations > 0 ? total_latency / num_emigrations : 0;
 }
 
+DSW_GEN_PORT_ACCESS_FN(max_emigration_latency)
+
+static uint64_t
+dsw_xstats_port_get_max_flow_load(struct dsw_evdev *dsw, uint8_t port_id,
+				  uint8_t queue_id __rte_unused)
+{
+	return DSW_LOAD_TO_PERCENT(dsw->ports[port_id].max_flow_load);
+}
+
 static uint64_t
 dsw_xstats_port_get_event_proc_latency(struct dsw_evdev *dsw, uint8_t port_id,
 				       uint8_t queue_id __rte_unused)
@@ -148,8 +158,14 @@ static struct dsw_xstats_port dsw_port_xstats[] = {
 	  true },
 	{ "port_%u_emigrations", dsw_xstats_port_get_emigrations,
 	  false },
+	{ "port_%u_remote_emigrations", dsw_xstats_port_get_remote_emigrations,
+	  false },
 	{ "port_%u_migration_latency", dsw_xstats_port_get_migration_latency,
 	  false },
+	{ "port_%u_max_migration_latency",
+	  dsw_xstats_port_get_max_emigration_latency, false },
+	{ "port_%u_max_flow_load", dsw_xstats_port_get_max_flow_load,
+	  false },
 	{ "port_%u_immigrations", dsw_xstats_port_get_immigrations,
 	  false },
 	{ "port_%u_event_proc_latency", dsw_xstats_port_get_event_proc_latency,
@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <rte_eventdev.h>
+#include <rte_memcpy.h>
 
 #define IQ_ROB_NAMESIZE 12
 
@@ -29,36 +30,36 @@ iq_count(const struct sw_iq *iq)
 }
 
 static __rte_always_inline struct sw_queue_chunk *
-iq_alloc_chunk(struct sw_evdev *sw)
+iq_alloc_chunk(struct sw_shard *sh)
 {
-	struct sw_queue_chunk *chunk = sw->chunk_list_head;
-	sw->chunk_list_head = chunk->next;
+	struct sw_queue_chunk *chunk = sh->chunk_list_head;
+	sh->chunk_list_head = chunk->next;
 	chunk->next = NULL;
 	return chunk;
 }
 
 static __rte_always_inline void
-iq_free_chunk(struct sw_evdev *sw, struct sw_queue_chunk *chunk)
+iq_free_chunk(struct sw_shard *sh, struct sw_queue_chunk *chunk)
 {
-	chunk->next = sw->chunk_list_head;
-	sw->chunk_list_head = chunk;
+	chunk->next = sh->chunk_list_head;
+	sh->chunk_list_head = chunk;
 }
 
 static __rte_always_inline void
-iq_free_chunk_list(struct sw_evdev *sw, struct sw_queue_chunk *head)
+iq_free_chunk_list(struct sw_shard *sh, struct sw_queue_chunk *head)
 {
 	while (head) {
 		struct sw_queue_chunk *next;
 		next = head->next;
-		iq_free_chunk(sw, head);
+		iq_free_chunk(sh, head);
 		head = next;
 	}
 }
 
 static __rte_always_inline void
-iq_init(struct sw_evdev *sw, struct sw_iq *iq)
+iq_init(struct sw_shard *sh, struct sw_iq *iq)
 {
-	iq->head = iq_alloc_chunk(sw);
+	iq->head = iq_alloc_chunk(sh);
 	iq->tail = iq->head;
 	iq->head_idx = 0;
 	iq->tail_idx = 0;
@@ -66,7 +67,7 @@ iq_init(struct sw_evdev *sw, struct sw_iq *iq)
 }
 
 static __rte_always_inline void
-iq_enqueue(struct sw_evdev *sw, struct sw_iq *iq, const struct rte_event *ev)
+iq_enqueue(struct sw_shard *sh, struct sw_iq *iq, const struct rte_event *ev)
 {
 	iq->tail->events[iq->tail_idx++] = *ev;
 	iq->count++;
@@ -76,7 +77,7 @@ iq_enqueue(struct sw_evdev *sw, struct sw_iq *iq, const struct rte_event *ev)
 		 * number of inflight events and number of IQS such that
 		 * allocation will always succeed.
 		 */
-		struct sw_queue_chunk *chunk = iq_alloc_chunk(sw);
+		struct sw_queue_chunk *chunk = iq_alloc_chunk(sh);
 		iq->tail->next = chunk;
 		iq->tail = chunk;
 		iq->tail_idx = 0;
@@ -84,14 +85,14 @@ iq_enqueue(struct sw_evdev *sw, struct sw_iq *iq, const struct rte_event *ev)
 }
 
 static __rte_always_inline void
-iq_pop(struct sw_evdev *sw, struct sw_iq *iq)
+iq_pop(struct sw_shard *sh, struct sw_iq *iq)
 {
 	iq->head_idx++;
 	iq->count--;
 
 	if (unlikely(iq->head_idx == SW_EVS_PER_Q_CHUNK)) {
 		struct sw_queue_chunk *next = iq->head->next;
-		iq_free_chunk(sw, iq->head);
+		iq_free_chunk(sh, iq->head);
 		iq->head = next;
 		iq->head_idx = 0;
 	}
@@ -105,46 +106,31 @@ iq_peek(struct sw_iq *iq)
 
 /* Note: the caller must ensure that count <= iq_count() */
 static __rte_always_inline uint16_t
-iq_dequeue_burst(struct sw_evdev *sw,
+iq_dequeue_burst(struct sw_shard *sh,
 		 struct sw_iq *iq,
 		 struct rte_event *ev,
 		 uint16_t count)
 {
-	struct sw_queue_chunk *current;
-	uint16_t total, index;
+	uint16_t total = 0;
 
 	count = RTE_MIN(count, iq_count(iq));
 
-	current = iq->head;
-	index = iq->head_idx;
-	total = 0;
-
-	/* Loop over the chunks */
-	while (1) {
-		struct sw_queue_chunk *next;
-		for (; index < SW_EVS_PER_Q_CHUNK;) {
-			ev[total++] = current->events[index++];
-
-			if (unlikely(total == count))
-				goto done;
+	/* Copy the events of each chunk as one contiguous run */
+	while (total < count) {
+		const uint16_t n = RTE_MIN(count - total,
+				SW_EVS_PER_Q_CHUNK - iq->head_idx);
+
+		rte_memcpy(&ev[total], &iq->head->events[iq->head_idx],
+				n * sizeof(*ev));
+		total += n;
+		iq->head_idx += n;
+
+		if (iq->head_idx == SW_EVS_PER_Q_CHUNK) {
+			struct sw_queue_chunk *next = iq->head->next;
+			iq_free_chunk(sh, iq->head);
+			iq->head = next;
+			iq->head_idx = 0;
 		}
-
-		/* Move to the next chunk */
-		next = current->next;
-		iq_free_chunk(sw, current);
-		current = next;
-		index = 0;
-	}
-
-done:
-	if (unlikely(index == SW_EVS_PER_Q_CHUNK)) {
-		struct sw_queue_chunk *next = current->next;
-		iq_free_chunk(sw, current);
-		iq->head = next;
-		iq->head_idx = 0;
-	} else {
-		iq->head = current;
-		iq->head_idx = index;
 	}
 
 	iq->count -= total;
@@ -153,7 +139,7 @@ iq_dequeue_burst(struct sw_evdev *sw,
 }
 
 static __rte_always_inline void
-iq_put_back(struct sw_evdev *sw,
+iq_put_back(struct sw_shard *sh,
 	    struct sw_iq *iq,
 	    struct rte_event *ev,
 	    unsigned int count)
@@ -166,28 +152,23 @@ iq_put_back(struct sw_evdev *sw,
 	uint16_t avail_space = iq->head_idx;
 
 	if (avail_space >= count) {
-		const uint16_t idx = avail_space - count;
-		uint16_t i;
-
-		for (i = 0; i < count; i++)
-			iq->head->events[idx + i] = ev[i];
-
-		iq->head_idx = idx;
-	} else if (avail_space < count) {
+		iq->head_idx = avail_space - count;
+		rte_memcpy(&iq->head->events[iq->head_idx], ev,
+				count * sizeof(*ev));
+	} else {
 		const uint16_t remaining = count - avail_space;
 		struct sw_queue_chunk *new_head;
-		uint16_t i;
 
-		for (i = 0; i < avail_space; i++)
-			iq->head->events[i] = ev[remaining + i];
+		rte_memcpy(iq->head->events, &ev[remaining],
+				avail_space * sizeof(*ev));
 
-		new_head = iq_alloc_chunk(sw);
+		new_head = iq_alloc_chunk(sh);
 		new_head->next = iq->head;
 		iq->head = new_head;
 		iq->head_idx = SW_EVS_PER_Q_CHUNK - remaining;
 
-		for (i = 0; i < remaining; i++)
-			iq->head->events[iq->head_idx + i] = ev[i];
+		rte_memcpy(&iq->head->events[iq->head_idx], ev,
+				remaining * sizeof(*ev));
 	}
 
 	iq->count += count;
@@ -11,6 +11,7 @@
 #include <rte_errno.h>
 #include <rte_event_ring.h>
 #include <rte_service_component.h>
+#include <rte_string_fns.h>
 
 #include "sw_evdev.h"
 #include "iq_chunk.h"
@@ -19,10 +20,51 @@
 #define NUMA_NODE_ARG "numa_node"
 #define SCHED_QUANTA_ARG "sched_quanta"
 #define CREDIT_QUANTA_ARG "credit_quanta"
+#define SCHED_SHARDS_ARG "sched_shards"
 
 static void
 sw_info_get(struct rte_eventdev *dev, struct rte_event_dev_info *info);
 
+/* The copies of the queues held by the shards are built on start from the
+ * port links, keep the copy of the port's shard in sync with the links made
+ * while the device runs.
+ */
+static void
+sw_shard_qid_link(struct sw_evdev *sw, const struct sw_port *p,
+		uint8_t queue_id)
+{
+	struct sw_qid *q;
+
+	if (sw->shard_count == 1 || !sw->started)
+		return;
+
+	q = &sw->shards[p->shard].qids[queue_id];
+	q->cq_map[q->cq_num_mapped_cqs] = p->id;
+	rte_smp_wmb();
+	q->cq_num_mapped_cqs++;
+}
+
+static void
+sw_shard_qid_unlink(struct sw_evdev *sw, const struct sw_port *p,
+		uint8_t queue_id)
+{
+	struct sw_qid *q;
+	unsigned int j;
+
+	if (sw->shard_count == 1 || !sw->started)
+		return;
+
+	q = &sw->shards[p->shard].qids[queue_id];
+	for (j = 0; j < q->cq_num_mapped_cqs; j++) {
+		if (q->cq_map[j] == p->id) {
+			q->cq_map[j] = q->cq_map[q->cq_num_mapped_cqs - 1];
+			rte_smp_wmb();
+			q->cq_num_mapped_cqs--;
+			break;
+		}
+	}
+}
+
 static int
 sw_port_link(struct rte_eventdev *dev, void *port, const uint8_t queues[],
 		const uint8_t priorities[], uint16_t num)
@@ -81,6 +123,7 @@ sw_port_link(struct rte_eventdev *dev, void *port, const uint8_t queues[],
 		q->cq_map[q->cq_num_mapped_cqs] = p->id;
 		rte_smp_wmb();
 		q->cq_num_mapped_cqs++;
+		sw_shard_qid_link(sw, p, queues[i]);
 	}
 	return i;
 }
@@ -109,6 +152,7 @@ sw_port_unlink(struct rte_eventdev *dev, void *port, uint8_t queues[],
 				if (q->type == RTE_SCHED_TYPE_ORDERED)
 					p->num_ordered_qids--;
 
+				sw_shard_qid_unlink(sw, p, queues[i]);
 				continue;
 			}
 		}
@@ -153,6 +197,7 @@ sw_port_setup(struct rte_eventdev *dev, uint8_t port_id,
 
 	*p = (struct sw_port){0}; /* zero entire structure */
 	p->id = port_id;
+	p->shard = port_id % sw->shard_count;
 	p->sw = sw;
 
 	/* check to see if rings exists - port_setup() can be called multiple
@@ -219,6 +264,72 @@ sw_port_release(void *port)
 	memset(p, 0, sizeof(*p));
 }
 
+static void
+qid_reorder_buffer_free(struct sw_qid *qid)
+{
+	if (qid->reorder_buffer) {
+		rte_free(qid->reorder_buffer);
+		qid->reorder_buffer = NULL;
+	}
+
+	if (qid->reorder_buffer_freelist) {
+		rte_ring_free(qid->reorder_buffer_freelist);
+		qid->reorder_buffer_freelist = NULL;
+	}
+}
+
+static int
+qid_reorder_buffer_init(struct sw_qid *qid, const char *buf,
+		const char *ring_name, uint32_t window_size, int socket_id)
+{
+	unsigned int i;
+
+	qid->reorder_buffer = rte_zmalloc_socket(buf,
+			window_size * sizeof(qid->reorder_buffer[0]),
+			0, socket_id);
+	if (!qid->reorder_buffer) {
+		SW_LOG_DBG("reorder_buffer malloc failed\n");
+		goto cleanup;
+	}
+
+	memset(&qid->reorder_buffer[0],
+	       0,
+	       window_size * sizeof(qid->reorder_buffer[0]));
+
+	/* lookup the ring, and if it already exists, free it */
+	struct rte_ring *cleanup = rte_ring_lookup(ring_name);
+	if (cleanup)
+		rte_ring_free(cleanup);
+
+	qid->reorder_buffer_freelist = rte_ring_create(ring_name,
+			window_size,
+			socket_id,
+			RING_F_SP_ENQ | RING_F_SC_DEQ);
+	if (!qid->reorder_buffer_freelist) {
+		SW_LOG_DBG("freelist ring create failed");
+		goto cleanup;
+	}
+
+	/* Populate the freelist with reorder buffer entries. Enqueue
+	 * 'window_size - 1' entries because the rte_ring holds only
+	 * that many.
+	 */
+	for (i = 0; i < window_size - 1; i++) {
+		if (rte_ring_sp_enqueue(qid->reorder_buffer_freelist,
+					&qid->reorder_buffer[i]) < 0)
+			goto cleanup;
+	}
+
+	qid->reorder_buffer_index = 0;
+
+	return 0;
+
+cleanup:
+	qid_reorder_buffer_free(qid);
+
+	return -1;
+}
+
 static int32_t
 qid_init(struct sw_evdev *sw, unsigned int idx, int type,
 		const struct rte_event_queue_conf *queue_conf)
@@ -258,46 +369,12 @@ qid_init(struct sw_evdev *sw, unsigned int idx, int type,
 		}
 
 		snprintf(buf, sizeof(buf), "sw%d_iq_%d_rob", dev_id, i);
-		qid->reorder_buffer = rte_zmalloc_socket(buf,
-				window_size * sizeof(qid->reorder_buffer[0]),
-				0, socket_id);
-		if (!qid->reorder_buffer) {
-			SW_LOG_DBG("reorder_buffer malloc failed\n");
-			goto cleanup;
-		}
-
-		memset(&qid->reorder_buffer[0],
-		       0,
-		       window_size * sizeof(qid->reorder_buffer[0]));
-
 		snprintf(ring_name, sizeof(ring_name), "sw%d_q%d_freelist",
 				dev_id, idx);
-
-		/* lookup the ring, and if it already exists, free it */
-		struct rte_ring *cleanup = rte_ring_lookup(ring_name);
-		if (cleanup)
-			rte_ring_free(cleanup);
-
-		qid->reorder_buffer_freelist = rte_ring_create(ring_name,
-				window_size,
-				socket_id,
-				RING_F_SP_ENQ | RING_F_SC_DEQ);
-		if (!qid->reorder_buffer_freelist) {
-			SW_LOG_DBG("freelist ring create failed");
+		if (qid_reorder_buffer_init(qid, buf, ring_name, window_size,
+				socket_id) < 0)
 			goto cleanup;
-		}
-
-		/* Populate the freelist with reorder buffer entries. Enqueue
-		 * 'window_size - 1' entries because the rte_ring holds only
-		 * that many.
-		 */
-		for (i = 0; i < window_size - 1; i++) {
-			if (rte_ring_sp_enqueue(qid->reorder_buffer_freelist,
-						&qid->reorder_buffer[i]) < 0)
-				goto cleanup;
-		}
 
-		qid->reorder_buffer_index = 0;
 		qid->cq_next_tx = 0;
 	}
 
@@ -306,15 +383,7 @@ qid_init(struct sw_evdev *sw, unsigned int idx, int type,
 	return 0;
 
 cleanup:
-	if (qid->reorder_buffer) {
-		rte_free(qid->reorder_buffer);
-		qid->reorder_buffer = NULL;
-	}
-
-	if (qid->reorder_buffer_freelist) {
-		rte_ring_free(qid->reorder_buffer_freelist);
-		qid->reorder_buffer_freelist = NULL;
-	}
+	qid_reorder_buffer_free(qid);
 
 	return -EINVAL;
 }
@@ -359,29 +428,41 @@ sw_queue_setup(struct rte_eventdev *dev, uint8_t queue_id,
 static void
 sw_init_qid_iqs(struct sw_evdev *sw)
 {
-	int i, j;
+	unsigned int i, j, s;
 
-	/* Initialize the IQ memory of all configured qids */
-	for (i = 0; i < RTE_EVENT_MAX_QUEUES_PER_DEV; i++) {
-		struct sw_qid *qid = &sw->qids[i];
+	/* Initialize the IQ memory of all configured qids of each shard */
+	for (s = 0; s < sw->shard_count; s++) {
+		struct sw_shard *sh = &sw->shards[s];
 
-		if (!qid->initialized)
-			continue;
+		for (i = 0; i < sw->qid_count; i++) {
+			struct sw_qid *qid = &sh->qids[i];
+
+			if (!qid->initialized)
+				continue;
 
-		for (j = 0; j < SW_IQS_MAX; j++)
-			iq_init(sw, &qid->iq[j]);
+			for (j = 0; j < SW_IQS_MAX; j++)
+				iq_init(sh, &qid->iq[j]);
+		}
 	}
 }
 
 static int
 sw_qids_empty(struct sw_evdev *sw)
 {
-	unsigned int i, j;
+	unsigned int i, j, s;
 
-	for (i = 0; i < sw->qid_count; i++) {
-		for (j = 0; j < SW_IQS_MAX; j++) {
-			if (iq_count(&sw->qids[i].iq[j]))
-				return 0;
+	for (s = 0; s < sw->shard_count; s++) {
+		const struct sw_shard *sh = &sw->shards[s];
+
+		if (sh->handoff_ring &&
+				rte_event_ring_count(sh->handoff_ring))
+			return 0;
+
+		for (i = 0; i < sw->qid_count; i++) {
+			for (j = 0; j < SW_IQS_MAX; j++) {
+				if (iq_count(&sh->qids[i].iq[j]))
+					return 0;
+			}
 		}
 	}
 
@@ -429,9 +510,9 @@ sw_drain_ports(struct rte_eventdev *dev)
 }
 
 static void
-sw_drain_queue(struct rte_eventdev *dev, struct sw_iq *iq)
+sw_drain_queue(struct rte_eventdev *dev, struct sw_shard *sh,
+		struct sw_iq *iq)
 {
-	struct sw_evdev *sw = sw_pmd_priv(dev);
 	eventdev_stop_flush_t flush;
 	uint8_t dev_id;
 	void *arg;
@@ -443,7 +524,7 @@ sw_drain_queue(struct rte_eventdev *dev, struct sw_iq *iq)
 	while (iq_count(iq) > 0) {
 		struct rte_event ev;
 
-		iq_dequeue_burst(sw, iq, &ev, 1);
+		iq_dequeue_burst(sh, iq, &ev, 1);
 
 		if (flush)
 			flush(dev_id, ev, arg);
@@ -454,11 +535,15 @@ static void
 sw_drain_queues(struct rte_eventdev *dev)
 {
 	struct sw_evdev *sw = sw_pmd_priv(dev);
-	unsigned int i, j;
+	unsigned int i, j, s;
 
-	for (i = 0; i < sw->qid_count; i++) {
-		for (j = 0; j < SW_IQS_MAX; j++)
-			sw_drain_queue(dev, &sw->qids[i].iq[j]);
+	for (s = 0; s < sw->shard_count; s++) {
+		struct sw_shard *sh = &sw->shards[s];
+
+		for (i = 0; i < sw->qid_count; i++) {
+			for (j = 0; j < SW_IQS_MAX; j++)
+				sw_drain_queue(dev, sh, &sh->qids[i].iq[j]);
+		}
 	}
 }
 
@@ -466,17 +551,21 @@ static void
 sw_clean_qid_iqs(struct rte_eventdev *dev)
 {
 	struct sw_evdev *sw = sw_pmd_priv(dev);
-	int i, j;
+	unsigned int i, j, s;
 
-	/* Release the IQ memory of all configured qids */
-	for (i = 0; i < RTE_EVENT_MAX_QUEUES_PER_DEV; i++) {
-		struct sw_qid *qid = &sw->qids[i];
+	/* Release the IQ memory of all configured qids of each shard */
+	for (s = 0; s < sw->shard_count; s++) {
+		struct sw_shard *sh = &sw->shards[s];
 
-		for (j = 0; j < SW_IQS_MAX; j++) {
-			if (!qid->iq[j].head)
-				continue;
-			iq_free_chunk_list(sw, qid->iq[j].head);
-			qid->iq[j].head = NULL;
+		for (i = 0; i < sw->qid_count; i++) {
+			struct sw_qid *qid = &sh->qids[i];
+
+			for (j = 0; j < SW_IQS_MAX; j++) {
+				if (!qid->iq[j].head)
+					continue;
+				iq_free_chunk_list(sh, qid->iq[j].head);
+				qid->iq[j].head = NULL;
+			}
 		}
 	}
 }
@@ -517,14 +606,17 @@ sw_dev_configure(const struct rte_eventdev *dev)
 	struct sw_evdev *sw = sw_pmd_priv(dev);
 	const struct rte_eventdev_data *data = dev->data;
 	const struct rte_event_dev_config *conf = &data->dev_conf;
-	int num_chunks, i;
+	int num_chunks, i, s;
 
 	sw->qid_count = conf->nb_event_queues;
 	sw->port_count = conf->nb_event_ports;
 	sw->nb_events_limit = conf->nb_events_limit;
 	rte_atomic32_set(&sw->inflights, 0);
 
-	/* Number of chunks sized for worst-case spread of events across IQs */
+	/* Number of chunks sized for worst-case spread of events across IQs.
+	 * As all events may end up in a single shard, each shard gets that
+	 * many.
+	 */
 	num_chunks = ((SW_INFLIGHT_EVENTS_TOTAL/SW_EVS_PER_Q_CHUNK)+1) +
 			sw->qid_count*SW_IQS_MAX*2;
 
@@ -537,15 +629,34 @@ sw_dev_configure(const struct rte_eventdev *dev)
 
 	sw->chunks = rte_malloc_socket(NULL,
 				       sizeof(struct sw_queue_chunk) *
-				       num_chunks,
+				       num_chunks * sw->shard_count,
 				       0,
 				       sw->data->socket_id);
 	if (!sw->chunks)
 		return -ENOMEM;
 
-	sw->chunk_list_head = NULL;
-	for (i = 0; i < num_chunks; i++)
-		iq_free_chunk(sw, &sw->chunks[i]);
+	for (s = 0; s < sw->shard_count; s++) {
+		struct sw_shard *sh = &sw->shards[s];
+
+		sh->chunk_list_head = NULL;
+		for (i = 0; i < num_chunks; i++)
+			iq_free_chunk(sh, &sw->chunks[s * num_chunks + i]);
+	}
+
+	/* When sharded, each shard schedules its own copy of the queues */
+	if (sw->shard_count > 1) {
+		for (s = 0; s < sw->shard_count; s++) {
+			struct sw_shard *sh = &sw->shards[s];
+
+			rte_free(sh->qids);
+			sh->qids = rte_zmalloc_socket(NULL,
+					sizeof(struct sw_qid) * sw->qid_count,
+					RTE_CACHE_LINE_SIZE,
+					sw->data->socket_id);
+			if (!sh->qids)
+				return -ENOMEM;
+		}
+	}
 
 	if (conf->event_dev_cfg & RTE_EVENT_DEV_CFG_PER_DEQUEUE_TIMEOUT)
 		return -ENOTSUP;
@@ -621,6 +732,64 @@ sw_info_get(struct rte_eventdev *dev, struct rte_event_dev_info *info)
 	*info = evdev_sw_info;
 }
 
+#define COL_RED "\x1b[31m"
+#define COL_RESET "\x1b[0m"
+
+static void
+sw_dump_qid(const struct sw_evdev *sw, const struct sw_qid *qid, FILE *f)
+{
+	int affinities_per_port[SW_PORTS_MAX] = {0};
+	uint32_t inflights = 0;
+
+	fprintf(f, "\trx   %"PRIu64"\tdrop %"PRIu64"\ttx   %"PRIu64"\n",
+		qid->stats.rx_pkts, qid->stats.rx_dropped,
+		qid->stats.tx_pkts);
+	if (qid->type == RTE_SCHED_TYPE_ORDERED) {
+		struct rte_ring *rob_buf_free =
+			qid->reorder_buffer_freelist;
+		if (rob_buf_free)
+			fprintf(f, "\tReorder entries in use: %u\n",
+				rte_ring_free_count(rob_buf_free));
+		else
+			fprintf(f,
+				"\tReorder buffer not initialized\n");
+	}
+
+	uint32_t flow;
+	for (flow = 0; flow < RTE_DIM(qid->fids); flow++)
+		if (qid->fids[flow].cq != -1) {
+			affinities_per_port[qid->fids[flow].cq]++;
+			inflights += qid->fids[flow].pcount;
+		}
+
+	uint32_t port;
+	fprintf(f, "\tPer Port Stats:\n");
+	for (port = 0; port < sw->port_count; port++) {
+		fprintf(f, "\t  Port %d: Pkts: %"PRIu64, port,
+				qid->to_port[port]);
+		fprintf(f, "\tFlows: %d\n", affinities_per_port[port]);
+	}
+
+	uint32_t iq;
+	uint32_t iq_printed = 0;
+	for (iq = 0; iq < SW_IQS_MAX; iq++) {
+		if (!qid->iq[iq].head) {
+			fprintf(f, "\tiq %d is not initialized.\n", iq);
+			iq_printed = 1;
+			continue;
+		}
+		uint32_t used = iq_count(&qid->iq[iq]);
+		const char *col = COL_RESET;
+		if (used > 0) {
+			fprintf(f, "\t%siq %d: Used %d"
+				COL_RESET"\n", col, iq, used);
+			iq_printed = 1;
+		}
+	}
+	if (iq_printed == 0)
+		fprintf(f, "\t-- iqs empty --\n");
+}
+
 static void
 sw_dump(struct rte_eventdev *dev, FILE *f)
 {
@@ -629,23 +798,31 @@ sw_dump(struct rte_eventdev *dev, FILE *f)
 	static const char * const q_type_strings[] = {
 			"Ordered", "Atomic", "Parallel", "Directed"
 	};
-	uint32_t i;
-	fprintf(f, "EventDev %s: ports %d, qids %d\n", "todo-fix-name",
-			sw->port_count, sw->qid_count);
-
-	fprintf(f, "\trx   %"PRIu64"\n\tdrop %"PRIu64"\n\ttx   %"PRIu64"\n",
-		sw->stats.rx_pkts, sw->stats.rx_dropped, sw->stats.tx_pkts);
-	fprintf(f, "\tsched calls: %"PRIu64"\n", sw->sched_called);
-	fprintf(f, "\tsched cq/qid call: %"PRIu64"\n", sw->sched_cq_qid_called);
-	fprintf(f, "\tsched no IQ enq: %"PRIu64"\n", sw->sched_no_iq_enqueues);
-	fprintf(f, "\tsched no CQ enq: %"PRIu64"\n", sw->sched_no_cq_enqueues);
+	uint32_t i, s;
+	fprintf(f, "EventDev %s: ports %d, qids %d, shards %d\n",
+			"todo-fix-name", sw->port_count, sw->qid_count,
+			sw->shard_count);
+
+	for (s = 0; s < sw->shard_count; s++) {
+		const struct sw_shard *sh = &sw->shards[s];
+
+		if (sw->shard_count > 1)
+			fprintf(f, "  Shard %u: %u ports\n", s, sh->port_count);
+		fprintf(f, "\trx   %"PRIu64"\n\tdrop %"PRIu64"\n\ttx   %"PRIu64
+			"\n", sh->stats.rx_pkts, sh->stats.rx_dropped,
+			sh->stats.tx_pkts);
+		fprintf(f, "\tsched calls: %"PRIu64"\n", sh->sched_called);
+		fprintf(f, "\tsched cq/qid call: %"PRIu64"\n",
+			sh->sched_cq_qid_called);
+		fprintf(f, "\tsched no IQ enq: %"PRIu64"\n",
+			sh->sched_no_iq_enqueues);
+		fprintf(f, "\tsched no CQ enq: %"PRIu64"\n",
+			sh->sched_no_cq_enqueues);
+	}
 	uint32_t inflights = rte_atomic32_read(&sw->inflights);
 	uint32_t credits = sw->nb_events_limit - inflights;
 	fprintf(f, "\tinflight %d, credits: %d\n", inflights, credits);
 
-#define COL_RED "\x1b[31m"
-#define COL_RESET "\x1b[0m"
-
 	for (i = 0; i < sw->port_count; i++) {
 		int max, j;
 		const struct sw_port *p = &sw->ports[i];
@@ -716,73 +893,153 @@ sw_dump(struct rte_eventdev *dev, FILE *f)
 				COL_RED, i, COL_RESET);
 			continue;
 		}
-		int affinities_per_port[SW_PORTS_MAX] = {0};
-		uint32_t inflights = 0;
-
 		fprintf(f, "  Queue %d (%s)\n", i, q_type_strings[qid->type]);
-		fprintf(f, "\trx   %"PRIu64"\tdrop %"PRIu64"\ttx   %"PRIu64"\n",
-			qid->stats.rx_pkts, qid->stats.rx_dropped,
-			qid->stats.tx_pkts);
-		if (qid->type == RTE_SCHED_TYPE_ORDERED) {
-			struct rte_ring *rob_buf_free =
-				qid->reorder_buffer_freelist;
-			if (rob_buf_free)
-				fprintf(f, "\tReorder entries in use: %u\n",
-					rte_ring_free_count(rob_buf_free));
-			else
-				fprintf(f,
-					"\tReorder buffer not initialized\n");
+		for (s = 0; s < sw->shard_count; s++) {
+			if (sw->shard_count > 1)
+				fprintf(f, "   Shard %u\n", s);
+			sw_dump_qid(sw, &sw->shards[s].qids[i], f);
 		}
+	}
+}
 
-		uint32_t flow;
-		for (flow = 0; flow < RTE_DIM(qid->fids); flow++)
-			if (qid->fids[flow].cq != -1) {
-				affinities_per_port[qid->fids[flow].cq]++;
-				inflights += qid->fids[flow].pcount;
-			}
+static void
+sw_shards_stop(struct sw_evdev *sw)
+{
+	unsigned int i, s;
+
+	if (sw->shard_count == 1)
+		return;
+
+	for (s = 0; s < sw->shard_count; s++) {
+		struct sw_shard *sh = &sw->shards[s];
+
+		for (i = 0; i < sw->qid_count; i++)
+			qid_reorder_buffer_free(&sh->qids[i]);
+
+		rte_event_ring_free(sh->handoff_ring);
+		sh->handoff_ring = NULL;
+	}
+}
+
+/* Split the ports, and the flows of each queue, between the shards */
+static int
+sw_shards_start(struct sw_evdev *sw)
+{
+	const struct sw_fid_t fid = {.cq = -1, .pcount = 0};
+	int dev_id = sw->data->dev_id;
+	int socket_id = sw->data->socket_id;
+	char buf[RTE_RING_NAMESIZE];
+	unsigned int i, j, s;
+
+	for (s = 0; s < sw->shard_count; s++) {
+		struct sw_shard *sh = &sw->shards[s];
+
+		sh->port_count = 0;
+		for (i = 0; i < sw->port_count; i++)
+			if (sw->ports[i].shard == s)
+				sh->ports[sh->port_count++] = i;
+	}
+
+	if (sw->shard_count == 1)
+		return 0;
+
+	for (s = 0; s < sw->shard_count; s++) {
+		struct sw_shard *sh = &sw->shards[s];
 
-		uint32_t port;
-		fprintf(f, "\tPer Port Stats:\n");
-		for (port = 0; port < sw->port_count; port++) {
-			fprintf(f, "\t  Port %d: Pkts: %"PRIu64, port,
-					qid->to_port[port]);
-			fprintf(f, "\tFlows: %d\n", affinities_per_port[port]);
+		/* as for the port rings, free a ring left from a previous
+		 * run so it gets re-created
+		 */
+		snprintf(buf, sizeof(buf), "sw%d_s%u_handoff_ring", dev_id, s);
+		struct rte_event_ring *existing_ring =
+				rte_event_ring_lookup(buf);
+		if (existing_ring)
+			rte_event_ring_free(existing_ring);
+
+		/* sized for all events of the device, see handoff flush */
+		sh->handoff_ring = rte_event_ring_create(buf,
+				SW_INFLIGHT_EVENTS_TOTAL, socket_id,
+				RING_F_SC_DEQ | RING_F_EXACT_SZ);
+		if (sh->handoff_ring == NULL) {
+			SW_LOG_ERR("Error creating handoff ring for shard %u\n",
+					s);
+			goto cleanup;
 		}
+		memset(sh->handoff_count, 0, sizeof(sh->handoff_count));
 
-		uint32_t iq;
-		uint32_t iq_printed = 0;
-		for (iq = 0; iq < SW_IQS_MAX; iq++) {
-			if (!qid->iq[iq].head) {
-				fprintf(f, "\tiq %d is not initialized.\n", iq);
-				iq_printed = 1;
-				continue;
-			}
-			uint32_t used = iq_count(&qid->iq[iq]);
-			const char *col = COL_RESET;
-			if (used > 0) {
-				fprintf(f, "\t%siq %d: Used %d"
-					COL_RESET"\n", col, iq, used);
-				iq_printed = 1;
+		/* the shard's copy of each queue only maps its own ports */
+		for (i = 0; i < sw->qid_count; i++) {
+			const struct sw_qid *q = &sw->qids[i];
+			struct sw_qid *sq = &sh->qids[i];
+
+			sq->id = q->id;
+			sq->type = q->type;
+			sq->priority = q->priority;
+			sq->cq_num_mapped_cqs = 0;
+			sq->cq_next_tx = 0;
+			for (j = 0; j < q->cq_num_mapped_cqs; j++)
+				if (sw->ports[q->cq_map[j]].shard == s)
+					sq->cq_map[sq->cq_num_mapped_cqs++] =
+						q->cq_map[j];
+
+			for (j = 0; j < RTE_DIM(sq->fids); j++)
+				sq->fids[j] = fid;
+
+			if (q->type == RTE_SCHED_TYPE_ORDERED) {
+				char ring_name[RTE_RING_NAMESIZE];
+
+				snprintf(ring_name, sizeof(ring_name),
+						"sw%d_q%u_s%u_freelist",
+						dev_id, i, s);
+				if (qid_reorder_buffer_init(sq, NULL,
+						ring_name, q->window_size + 1,
+						socket_id) < 0)
+					goto cleanup;
+				sq->window_size = q->window_size;
 			}
+
+			sq->initialized = q->initialized;
 		}
-		if (iq_printed == 0)
-			fprintf(f, "\t-- iqs empty --\n");
 	}
+
+	/* spread the flows of each queue over the shards serving it */
+	for (i = 0; i < sw->qid_count; i++) {
+		struct sw_qid *q = &sw->qids[i];
+		uint8_t serving[SW_SCHED_SHARDS_MAX];
+		unsigned int nb_serving = 0;
+
+		for (s = 0; s < sw->shard_count; s++)
+			if (sw->shards[s].qids[i].cq_num_mapped_cqs > 0)
+				serving[nb_serving++] = s;
+
+		for (j = 0; j < SW_SHARD_MAP_SIZE; j++)
+			q->shard_map[j] = serving[j % nb_serving];
+	}
+
+	return 0;
+
+cleanup:
+	sw_shards_stop(sw);
+	return -ENOMEM;
 }
 
 static int
 sw_start(struct rte_eventdev *dev)
 {
-	unsigned int i, j;
+	unsigned int i, j, s;
 	struct sw_evdev *sw = sw_pmd_priv(dev);
+	int ret;
 
-	rte_service_component_runstate_set(sw->service_id, 1);
+	for (s = 0; s < sw->shard_count; s++) {
+		struct sw_shard *sh = &sw->shards[s];
 
-	/* check a service core is mapped to this service */
-	if (!rte_service_runstate_get(sw->service_id)) {
-		SW_LOG_ERR("Warning: No Service core enabled on service %s\n",
-				sw->service_name);
-		return -ENOENT;
+		rte_service_component_runstate_set(sh->service_id, 1);
+
+		/* check a service core is mapped to this service */
+		if (!rte_service_runstate_get(sh->service_id)) {
+			SW_LOG_ERR("Warning: No Service core enabled on service %s\n",
+					sh->service_name);
+			return -ENOENT;
+		}
 	}
 
 	/* check all ports are set up */
@@ -800,26 +1057,38 @@ sw_start(struct rte_eventdev *dev)
 			return -ENOLINK;
 		}
 
+	ret = sw_shards_start(sw);
+	if (ret < 0)
+		return ret;
+
 	/* build up our prioritized array of qids */
 	/* We don't use qsort here, as if all/multiple entries have the same
 	 * priority, the result is non-deterministic. From "man 3 qsort":
 	 * "If two members compare as equal, their order in the sorted
 	 * array is undefined."
 	 */
-	uint32_t qidx = 0;
-	for (j = 0; j <= RTE_EVENT_DEV_PRIORITY_LOWEST; j++) {
-		for (i = 0; i < sw->qid_count; i++) {
-			if (sw->qids[i].priority == j) {
-				sw->qids_prioritized[qidx] = &sw->qids[i];
-				qidx++;
+	for (s = 0; s < sw->shard_count; s++) {
+		struct sw_shard *sh = &sw->shards[s];
+		uint32_t qidx = 0;
+
+		for (j = 0; j <= RTE_EVENT_DEV_PRIORITY_LOWEST; j++) {
+			for (i = 0; i < sw->qid_count; i++) {
+				if (sh->qids[i].priority == j) {
+					sh->qids_prioritized[qidx] =
+						&sh->qids[i];
+					qidx++;
+				}
 			}
 		}
 	}
 
 	sw_init_qid_iqs(sw);
 
-	if (sw_xstats_init(sw) < 0)
+	if (sw_xstats_init(sw) < 0) {
+		sw_clean_qid_iqs(dev);
+		sw_shards_stop(sw);
 		return -EINVAL;
+	}
 
 	rte_smp_wmb();
 	sw->started = 1;
@@ -831,15 +1100,19 @@ static void
 sw_stop(struct rte_eventdev *dev)
 {
 	struct sw_evdev *sw = sw_pmd_priv(dev);
-	int32_t runstate;
-
-	/* Stop the scheduler if it's running */
-	runstate = rte_service_runstate_get(sw->service_id);
-	if (runstate == 1)
-		rte_service_runstate_set(sw->service_id, 0);
+	int32_t runstate[SW_SCHED_SHARDS_MAX];
+	unsigned int s;
+
+	/* Stop the scheduler shards if they're running */
+	for (s = 0; s < sw->shard_count; s++) {
+		runstate[s] = rte_service_runstate_get(sw->shards[s].service_id);
+		if (runstate[s] == 1)
+			rte_service_runstate_set(sw->shards[s].service_id, 0);
+	}
 
-	while (rte_service_may_be_active(sw->service_id))
-		rte_pause();
+	for (s = 0; s < sw->shard_count; s++)
+		while (rte_service_may_be_active(sw->shards[s].service_id))
+			rte_pause();
 
 	/* Flush all events out of the device */
 	while (!(sw_qids_empty(sw) && sw_ports_empty(sw))) {
@@ -849,12 +1122,14 @@ sw_stop(struct rte_eventdev *dev)
 	}
 
 	sw_clean_qid_iqs(dev);
+	sw_shards_stop(sw);
 	sw_xstats_uninit(sw);
 	sw->started = 0;
 	rte_smp_wmb();
 
-	if (runstate == 1)
-		rte_service_runstate_set(sw->service_id, 1);
+	for (s = 0; s < sw->shard_count; s++)
+		if (runstate[s] == 1)
+			rte_service_runstate_set(sw->shards[s].service_id, 1);
 }
 
 static int
@@ -871,11 +1146,20 @@ sw_close(struct rte_eventdev *dev)
 		sw_port_release(&sw->ports[i]);
 	sw->port_count = 0;
 
-	memset(&sw->stats, 0, sizeof(sw->stats));
-	sw->sched_called = 0;
-	sw->sched_no_iq_enqueues = 0;
-	sw->sched_no_cq_enqueues = 0;
-	sw->sched_cq_qid_called = 0;
+	for (i = 0; i < sw->shard_count; i++) {
+		struct sw_shard *sh = &sw->shards[i];
+
+		if (sw->shard_count > 1) {
+			rte_free(sh->qids);
+			sh->qids = NULL;
+		}
+
+		memset(&sh->stats, 0, sizeof(sh->stats));
+		sh->sched_called = 0;
+		sh->sched_no_iq_enqueues = 0;
+		sh->sched_no_cq_enqueues = 0;
+		sh->sched_cq_qid_called = 0;
+	}
 
 	return 0;
 }
@@ -910,11 +1194,21 @@ set_credit_quanta(const char *key __rte_unused, const char *value, void *opaque)
 	return 0;
 }
 
+static int
+set_sched_shards(const char *key __rte_unused, const char *value, void *opaque)
+{
+	int *shards = opaque;
+	*shards = atoi(value);
+	if (*shards < 1 || *shards > SW_SCHED_SHARDS_MAX)
+		return -1;
+	return 0;
+}
+
 
 static int32_t sw_sched_service_func(void *args)
 {
-	struct rte_eventdev *dev = args;
-	sw_event_schedule(dev);
+	struct sw_shard *sh = args;
+	sw_shard_schedule(sh);
 	return 0;
 }
 
@@ -957,6 +1251,7 @@ sw_probe(struct rte_vdev_device *vdev)
 		NUMA_NODE_ARG,
 		SCHED_QUANTA_ARG,
 		CREDIT_QUANTA_ARG,
+		SCHED_SHARDS_ARG,
 		NULL
 	};
 	const char *name;
@@ -966,6 +1261,8 @@ sw_probe(struct rte_vdev_device *vdev)
 	int socket_id = rte_socket_id();
 	int sched_quanta  = SW_DEFAULT_SCHED_QUANTA;
 	int credit_quanta = SW_DEFAULT_CREDIT_QUANTA;
+	int sched_shards = 1;
+	int s;
 
 	name = rte_vdev_device_name(vdev);
 	params = rte_vdev_device_args(vdev);
@@ -1007,13 +1304,24 @@ sw_probe(struct rte_vdev_device *vdev)
 				return ret;
 			}
 
+			ret = rte_kvargs_process(kvlist, SCHED_SHARDS_ARG,
+					set_sched_shards, &sched_shards);
+			if (ret != 0) {
+				SW_LOG_ERR(
+					"%s: Error parsing sched shards parameter",
+					name);
+				rte_kvargs_free(kvlist);
+				return ret;
+			}
+
 			rte_kvargs_free(kvlist);
 		}
 	}
 
 	SW_LOG_INFO(
-			"Creating eventdev sw device %s, numa_node=%d, sched_quanta=%d, credit_quanta=%d\n",
-			name, socket_id, sched_quanta, credit_quanta);
+			"Creating eventdev sw device %s, numa_node=%d, sched_quanta=%d, credit_quanta=%d, sched_shards=%d\n",
+			name, socket_id, sched_quanta, credit_quanta,
+			sched_shards);
 
 	dev = rte_event_pmd_vdev_init(name,
 			sizeof(struct sw_evdev), socket_id);
@@ -1038,25 +1346,42 @@ sw_probe(struct rte_vdev_device *vdev)
 	/* copy values passed from vdev command line to instance */
 	sw->credit_update_quanta = credit_quanta;
 	sw->sched_quanta = sched_quanta;
+	sw->shard_count = sched_shards;
 
-	/* register service with EAL */
-	struct rte_service_spec service;
-	memset(&service, 0, sizeof(struct rte_service_spec));
-	snprintf(service.name, sizeof(service.name), "%s_service", name);
-	snprintf(sw->service_name, sizeof(sw->service_name), "%s_service",
-			name);
-	service.socket_id = socket_id;
-	service.callback = sw_sched_service_func;
-	service.callback_userdata = (void *)dev;
-
-	int32_t ret = rte_service_component_register(&service, &sw->service_id);
-	if (ret) {
-		SW_LOG_ERR("service register() failed");
-		return -ENOEXEC;
+	/* register a service with EAL for each scheduler shard, the first
+	 * one being the service of the eventdev
+	 */
+	for (s = 0; s < sched_shards; s++) {
+		struct sw_shard *sh = &sw->shards[s];
+		struct rte_service_spec service;
+
+		sh->sw = sw;
+		sh->id = s;
+		if (sched_shards == 1)
+			sh->qids = sw->qids;
+
+		memset(&service, 0, sizeof(struct rte_service_spec));
+		if (s == 0)
+			snprintf(sh->service_name, sizeof(sh->service_name),
+					"%s_service", name);
+		else
+			snprintf(sh->service_name, sizeof(sh->service_name),
+					"%s_service_%d", name, s);
+		strlcpy(service.name, sh->service_name, sizeof(service.name));
+		service.socket_id = socket_id;
+		service.callback = sw_sched_service_func;
+		service.callback_userdata = (void *)sh;
+
+		int32_t ret = rte_service_component_register(&service,
+				&sh->service_id);
+		if (ret) {
+			SW_LOG_ERR("service register() failed");
+			return -ENOEXEC;
+		}
 	}
 
 	dev->data->service_inited = 1;
-	dev->data->service_id = sw->service_id;
+	dev->data->service_id = sw->shards[0].service_id;
 
 	return 0;
 }
@@ -1064,7 +1389,10 @@ sw_probe(struct rte_vdev_device *vdev)
 static int
 sw_remove(struct rte_vdev_device *vdev)
 {
+	struct rte_eventdev *dev;
+	struct sw_evdev *sw;
 	const char *name;
+	unsigned int s;
 
 	name = rte_vdev_device_name(vdev);
 	if (name == NULL)
@@ -1072,6 +1400,15 @@ sw_remove(struct rte_vdev_device *vdev)
 
 	SW_LOG_INFO("Closing eventdev sw device %s\n", name);
 
+	/* the shard services must not outlive the device */
+	dev = rte_event_pmd_get_named_dev(name);
+	if (dev != NULL && dev->data->service_inited) {
+		sw = sw_pmd_priv(dev);
+		for (s = 0; s < sw->shard_count; s++)
+			rte_service_component_unregister(
+					sw->shards[s].service_id);
+	}
+
 	return rte_event_pmd_vdev_uninit(name);
 }
 
@@ -1082,5 +1419,6 @@ static struct rte_vdev_driver evdev_sw_pmd_drv = {
 
 RTE_PMD_REGISTER_VDEV(EVENTDEV_NAME_SW_PMD, evdev_sw_pmd_drv);
 RTE_PMD_REGISTER_PARAM_STRING(event_sw, NUMA_NODE_ARG "=<int> "
-		SCHED_QUANTA_ARG "=<int>" CREDIT_QUANTA_ARG "=<int>");
+		SCHED_QUANTA_ARG "=<int>" CREDIT_QUANTA_ARG "=<int> "
+		SCHED_SHARDS_ARG "=<int>");
 RTE_LOG_REGISTER(eventdev_sw_log_level, pmd.event.sw, NOTICE);
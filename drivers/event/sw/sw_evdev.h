@@ -21,6 +21,9 @@
 /* allow for lots of over-provisioning */
 #define MAX_SW_PROD_Q_DEPTH 4096
 #define SW_FRAGMENTS_MAX 16
+#define SW_SCHED_SHARDS_MAX 8
+/* size of the per queue flow to shard lookup table, power of two */
+#define SW_SHARD_MAP_SIZE 64
 
 /* Should be power-of-two minus one, to leave room for the next pointer */
 #define SW_EVS_PER_Q_CHUNK 255
@@ -30,6 +33,8 @@
 #define SW_DEQ_STAT_BUCKET_SHIFT 2
 /* how many packets pulled from port by sched */
 #define SCHED_DEQUEUE_BURST_SIZE 32
+/* how many packets batched up before handing them to another shard */
+#define SW_SHARD_HANDOFF_BURST_SIZE 32
 
 #define SW_PORT_HIST_LIST (MAX_SW_PROD_Q_DEPTH) /* size of our history list */
 #define NUM_SAMPLES 64 /* how many data points use for average stats */
@@ -72,14 +77,20 @@ struct sw_point_stats {
 	uint64_t tx_pkts;
 };
 
-/* structure used to track what port a flow (FID) is pinned to */
+/* structure used to track what port a flow (FID) is pinned to, kept to 4
+ * bytes so that a cache line holds the state of 16 flows
+ */
 struct sw_fid_t {
 	/* which CQ this FID is currently pinned to */
-	int32_t cq;
+	int16_t cq;
 	/* number of packets gone to the CQ with this FID */
-	uint32_t pcount;
+	uint16_t pcount;
 };
 
+#if SW_INFLIGHT_EVENTS_TOTAL > UINT16_MAX || SW_PORTS_MAX > INT16_MAX
+#error struct sw_fid_t fields too narrow for SW_INFLIGHT_EVENTS_TOTAL
+#endif
+
 struct reorder_buffer_entry {
 	uint16_t num_fragments;		/**< Number of packet fragments */
 	uint16_t fragment_index;	/**< Points to the oldest valid frag */
@@ -127,6 +138,11 @@ struct sw_qid {
 	uint32_t window_size;          /* Used to wrap reorder_buffer_index */
 
 	uint8_t priority;
+
+	/* Shard scheduling each slice of the flow space of this queue, set
+	 * on start when the scheduler is sharded.
+	 */
+	uint8_t shard_map[SW_SHARD_MAP_SIZE];
 };
 
 struct sw_hist_list_entry {
@@ -147,6 +163,8 @@ struct sw_port {
 	uint8_t initialized;
 	/* A numeric ID for the port */
 	uint8_t id;
+	/* The scheduler shard pulling from and scheduling to this port */
+	uint8_t shard;
 
 	/* An atomic counter for when the port has been unlinked, and the
 	 * scheduler has not yet acked this unlink - hence there may still be
@@ -203,6 +221,46 @@ struct sw_port {
 	uint8_t num_qids_mapped;
 };
 
+/*
+ * One instance of the scheduling loop, run by its own service. Each port is
+ * owned by a single shard, which is the only one to pull events from it and
+ * to schedule events to it. The flows of each queue are split between the
+ * shards owning a port linked to the queue, so an atomic flow is pinned and
+ * an ordered flow is reordered by one shard only. Events for a flow of
+ * another shard are handed over to it through its handoff ring.
+ */
+struct sw_shard {
+	struct sw_evdev *sw;
+	uint8_t id;
+
+	/* Ports owned by this shard */
+	uint32_t port_count;
+	uint8_t ports[SW_PORTS_MAX];
+
+	/* The shard's own copy of the queues, sw->qids if not sharded */
+	struct sw_qid *qids;
+	/* Array of pointers to load-balanced QIDs sorted by priority level */
+	struct sw_qid *qids_prioritized[RTE_EVENT_MAX_QUEUES_PER_DEV];
+	struct sw_queue_chunk *chunk_list_head;
+
+	/* Events handed over by the other shards */
+	struct rte_event_ring *handoff_ring;
+	/* Events waiting to be handed over to each of the other shards */
+	uint16_t handoff_count[SW_SCHED_SHARDS_MAX];
+	struct rte_event handoff_buf[SW_SCHED_SHARDS_MAX]
+			[SW_SHARD_HANDOFF_BURST_SIZE];
+
+	/* Stats */
+	struct sw_point_stats stats __rte_cache_aligned;
+	uint64_t sched_called;
+	uint64_t sched_no_iq_enqueues;
+	uint64_t sched_no_cq_enqueues;
+	uint64_t sched_cq_qid_called;
+
+	uint32_t service_id;
+	char service_name[SW_PMD_NAME_MAX];
+} __rte_cache_aligned;
+
 struct sw_evdev {
 	struct rte_eventdev_data *data;
 
@@ -227,23 +285,12 @@ struct sw_evdev {
 
 	/* Internal queues - one per logical queue */
 	struct sw_qid qids[RTE_EVENT_MAX_QUEUES_PER_DEV] __rte_cache_aligned;
-	struct sw_queue_chunk *chunk_list_head;
 	struct sw_queue_chunk *chunks;
 
 	/* Cache how many packets are in each cq */
 	uint16_t cq_ring_space[SW_PORTS_MAX] __rte_cache_aligned;
 
-	/* Array of pointers to load-balanced QIDs sorted by priority level */
-	struct sw_qid *qids_prioritized[RTE_EVENT_MAX_QUEUES_PER_DEV];
-
-	/* Stats */
-	struct sw_point_stats stats __rte_cache_aligned;
-	uint64_t sched_called;
 	int32_t sched_quanta;
-	uint64_t sched_no_iq_enqueues;
-	uint64_t sched_no_cq_enqueues;
-	uint64_t sched_cq_qid_called;
-
 	uint8_t started;
 	uint32_t credit_update_quanta;
 
@@ -254,8 +301,8 @@ struct sw_evdev {
 	uint16_t xstats_count_per_qid[RTE_EVENT_MAX_QUEUES_PER_DEV];
 	uint16_t xstats_offset_for_qid[RTE_EVENT_MAX_QUEUES_PER_DEV];
 
-	uint32_t service_id;
-	char service_name[SW_PMD_NAME_MAX];
+	uint8_t shard_count;
+	struct sw_shard shards[SW_SCHED_SHARDS_MAX];
 };
 
 static inline struct sw_evdev *
@@ -278,6 +325,7 @@ uint16_t sw_event_dequeue(void *port, struct rte_event *ev, uint64_t wait);
 uint16_t sw_event_dequeue_burst(void *port, struct rte_event *ev, uint16_t num,
 			uint64_t wait);
 void sw_event_schedule(struct rte_eventdev *dev);
+void sw_shard_schedule(struct sw_shard *sh);
 int sw_xstats_init(struct sw_evdev *dev);
 int sw_xstats_uninit(struct sw_evdev *dev);
 int sw_xstats_get_names(const struct rte_eventdev *dev,
@@ -5,6 +5,7 @@
 #include <rte_ring.h>
 #include <rte_hash_crc.h>
 #include <rte_event_ring.h>
+#include <rte_prefetch.h>
 #include "sw_evdev.h"
 #include "iq_chunk.h"
 
@@ -26,14 +27,43 @@
 /* use cheap bit mixing, we only need to lose a few bits */
 #define SW_HASH_FLOWID(f) (((f) ^ (f >> 10)) & FLOWID_MASK)
 
+/* Pin an unpinned atomic flow to the mapped CQ with the most free space */
+static __rte_always_inline int
+sw_atomic_pin_cq(struct sw_evdev *sw, struct sw_qid * const qid)
+{
+	uint32_t cq_idx;
+	int cq;
+
+	if (qid->cq_next_tx >= qid->cq_num_mapped_cqs)
+		qid->cq_next_tx = 0;
+	cq_idx = qid->cq_next_tx++;
+
+	cq = qid->cq_map[cq_idx];
+
+	/* find least used */
+	int cq_free_cnt = sw->cq_ring_space[cq];
+	for (cq_idx = 0; cq_idx < qid->cq_num_mapped_cqs; cq_idx++) {
+		int test_cq = qid->cq_map[cq_idx];
+		int test_cq_free = sw->cq_ring_space[test_cq];
+		if (test_cq_free > cq_free_cnt) {
+			cq = test_cq;
+			cq_free_cnt = test_cq_free;
+		}
+	}
+
+	return cq;
+}
+
 static inline uint32_t
-sw_schedule_atomic_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
+sw_schedule_atomic_to_cq(struct sw_shard *sh, struct sw_qid * const qid,
 		uint32_t iq_num, unsigned int count)
 {
+	struct sw_evdev *sw = sh->sw;
 	struct rte_event qes[MAX_PER_IQ_DEQUEUE]; /* count <= MAX */
 	struct rte_event blocked_qes[MAX_PER_IQ_DEQUEUE];
+	uint16_t flow_ids[MAX_PER_IQ_DEQUEUE];
 	uint32_t nb_blocked = 0;
-	uint32_t i;
+	uint32_t i, j, run;
 
 	if (count > MAX_PER_IQ_DEQUEUE)
 		count = MAX_PER_IQ_DEQUEUE;
@@ -43,76 +73,88 @@ sw_schedule_atomic_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 	 */
 	uint32_t qid_id = qid->id;
 
-	iq_dequeue_burst(sw, &qid->iq[iq_num], qes, count);
+	iq_dequeue_burst(sh, &qid->iq[iq_num], qes, count);
+
+	/* Classify the burst by flow once, warming up the flow state */
 	for (i = 0; i < count; i++) {
-		const struct rte_event *qe = &qes[i];
-		const uint16_t flow_id = SW_HASH_FLOWID(qes[i].flow_id);
+		flow_ids[i] = SW_HASH_FLOWID(qes[i].flow_id);
+		rte_prefetch0(&qid->fids[flow_ids[i]]);
+	}
+
+	/* Schedule each run of consecutive events of a flow as one block */
+	for (i = 0; i < count; i += run) {
+		const uint16_t flow_id = flow_ids[i];
 		struct sw_fid_t *fid = &qid->fids[flow_id];
 		int cq = fid->cq;
 
-		if (cq < 0) {
-			uint32_t cq_idx;
-			if (qid->cq_next_tx >= qid->cq_num_mapped_cqs)
-				qid->cq_next_tx = 0;
-			cq_idx = qid->cq_next_tx++;
-
-			cq = qid->cq_map[cq_idx];
-
-			/* find least used */
-			int cq_free_cnt = sw->cq_ring_space[cq];
-			for (cq_idx = 0; cq_idx < qid->cq_num_mapped_cqs;
-					cq_idx++) {
-				int test_cq = qid->cq_map[cq_idx];
-				int test_cq_free = sw->cq_ring_space[test_cq];
-				if (test_cq_free > cq_free_cnt) {
-					cq = test_cq;
-					cq_free_cnt = test_cq_free;
-				}
-			}
+		for (run = 1; i + run < count; run++)
+			if (flow_ids[i + run] != flow_id)
+				break;
 
+		if (cq < 0) {
+			cq = sw_atomic_pin_cq(sw, qid);
 			fid->cq = cq; /* this pins early */
 		}
 
-		if (sw->cq_ring_space[cq] == 0 ||
-				sw->ports[cq].inflights == SW_PORT_HIST_LIST) {
-			blocked_qes[nb_blocked++] = *qe;
-			continue;
-		}
-
 		struct sw_port *p = &sw->ports[cq];
+		uint32_t done = 0;
+
+		while (done < run) {
+			uint32_t n = RTE_MIN(run - done,
+					sw->cq_ring_space[cq]);
+			n = RTE_MIN(n,
+				(uint32_t)(SW_PORT_HIST_LIST - p->inflights));
+			if (n == 0)
+				break;
 
-		/* at this point we can queue up the packet on the cq_buf */
-		fid->pcount++;
-		p->cq_buf[p->cq_buf_count++] = *qe;
-		p->inflights++;
-		sw->cq_ring_space[cq]--;
+			/* at this point we can queue up the run on the
+			 * cq_buf
+			 */
+			rte_memcpy(&p->cq_buf[p->cq_buf_count], &qes[i + done],
+					n * sizeof(qes[0]));
+			for (j = 0; j < n; j++) {
+				int head = (p->hist_head++ &
+						(SW_PORT_HIST_LIST-1));
+				p->hist_list[head].fid = flow_id;
+				p->hist_list[head].qid = qid_id;
+			}
 
-		int head = (p->hist_head++ & (SW_PORT_HIST_LIST-1));
-		p->hist_list[head].fid = flow_id;
-		p->hist_list[head].qid = qid_id;
+			fid->pcount += n;
+			p->cq_buf_count += n;
+			p->inflights += n;
+			sw->cq_ring_space[cq] -= n;
+			done += n;
 
-		p->stats.tx_pkts++;
-		qid->stats.tx_pkts++;
-		qid->to_port[cq]++;
-
-		/* if we just filled in the last slot, flush the buffer */
-		if (sw->cq_ring_space[cq] == 0) {
-			struct rte_event_ring *worker = p->cq_worker_ring;
-			rte_event_ring_enqueue_burst(worker, p->cq_buf,
-					p->cq_buf_count,
-					&sw->cq_ring_space[cq]);
-			p->cq_buf_count = 0;
+			p->stats.tx_pkts += n;
+			qid->stats.tx_pkts += n;
+			qid->to_port[cq] += n;
+
+			/* if we just filled in the last slot, flush the
+			 * buffer
+			 */
+			if (sw->cq_ring_space[cq] == 0) {
+				struct rte_event_ring *worker =
+						p->cq_worker_ring;
+				rte_event_ring_enqueue_burst(worker, p->cq_buf,
+						p->cq_buf_count,
+						&sw->cq_ring_space[cq]);
+				p->cq_buf_count = 0;
+			}
 		}
+
+		for (; done < run; done++)
+			blocked_qes[nb_blocked++] = qes[i + done];
 	}
-	iq_put_back(sw, &qid->iq[iq_num], blocked_qes, nb_blocked);
+	iq_put_back(sh, &qid->iq[iq_num], blocked_qes, nb_blocked);
 
 	return count - nb_blocked;
 }
 
 static inline uint32_t
-sw_schedule_parallel_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
+sw_schedule_parallel_to_cq(struct sw_shard *sh, struct sw_qid * const qid,
 		uint32_t iq_num, unsigned int count, int keep_order)
 {
+	struct sw_evdev *sw = sh->sw;
 	uint32_t i;
 	uint32_t cq_idx = qid->cq_next_tx;
 
@@ -168,7 +210,7 @@ sw_schedule_parallel_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 					(void *)&p->hist_list[head].rob_entry);
 
 		sw->ports[cq].cq_buf[sw->ports[cq].cq_buf_count++] = *qe;
-		iq_pop(sw, &qid->iq[iq_num]);
+		iq_pop(sh, &qid->iq[iq_num]);
 
 		rte_compiler_barrier();
 		p->inflights++;
@@ -181,9 +223,10 @@ sw_schedule_parallel_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 }
 
 static uint32_t
-sw_schedule_dir_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
+sw_schedule_dir_to_cq(struct sw_shard *sh, struct sw_qid * const qid,
 		uint32_t iq_num, unsigned int count __rte_unused)
 {
+	struct sw_evdev *sw = sh->sw;
 	uint32_t cq_id = qid->cq_map[0];
 	struct sw_port *port = &sw->ports[cq_id];
 
@@ -194,7 +237,7 @@ sw_schedule_dir_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 
 	/* burst dequeue from the QID IQ ring */
 	struct sw_iq *iq = &qid->iq[iq_num];
-	uint32_t ret = iq_dequeue_burst(sw, iq,
+	uint32_t ret = iq_dequeue_burst(sh, iq,
 			&port->cq_buf[port->cq_buf_count], count_free);
 	port->cq_buf_count += ret;
 
@@ -209,15 +252,15 @@ sw_schedule_dir_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 }
 
 static uint32_t
-sw_schedule_qid_to_cq(struct sw_evdev *sw)
+sw_schedule_qid_to_cq(struct sw_shard *sh)
 {
 	uint32_t pkts = 0;
 	uint32_t qid_idx;
 
-	sw->sched_cq_qid_called++;
+	sh->sched_cq_qid_called++;
 
-	for (qid_idx = 0; qid_idx < sw->qid_count; qid_idx++) {
-		struct sw_qid *qid = sw->qids_prioritized[qid_idx];
+	for (qid_idx = 0; qid_idx < sh->sw->qid_count; qid_idx++) {
+		struct sw_qid *qid = sh->qids_prioritized[qid_idx];
 
 		int type = qid->type;
 		int iq_num = PKT_MASK_TO_IQ(qid->iq_pkt_mask);
@@ -231,13 +274,13 @@ sw_schedule_qid_to_cq(struct sw_evdev *sw)
 
 		if (count > 0) {
 			if (type == SW_SCHED_TYPE_DIRECT)
-				pkts_done += sw_schedule_dir_to_cq(sw, qid,
+				pkts_done += sw_schedule_dir_to_cq(sh, qid,
 						iq_num, count);
 			else if (type == RTE_SCHED_TYPE_ATOMIC)
-				pkts_done += sw_schedule_atomic_to_cq(sw, qid,
+				pkts_done += sw_schedule_atomic_to_cq(sh, qid,
 						iq_num, count);
 			else
-				pkts_done += sw_schedule_parallel_to_cq(sw, qid,
+				pkts_done += sw_schedule_parallel_to_cq(sh, qid,
 						iq_num, count,
 						type == RTE_SCHED_TYPE_ORDERED);
 		}
@@ -254,19 +297,92 @@ sw_schedule_qid_to_cq(struct sw_evdev *sw)
 	return pkts;
 }
 
+static __rte_always_inline void
+sw_shard_iq_enqueue(struct sw_shard *sh, const struct rte_event *qe)
+{
+	const uint32_t iq_num = PRIO_TO_IQ(qe->priority);
+	struct sw_qid *qid = &sh->qids[qe->queue_id];
+
+	qid->iq_pkt_mask |= (1 << (iq_num));
+	iq_enqueue(sh, &qid->iq[iq_num], qe);
+	qid->iq_pkt_count[iq_num]++;
+	qid->stats.rx_pkts++;
+}
+
+static void
+sw_shard_handoff_flush(struct sw_shard *sh, uint32_t dst)
+{
+	struct rte_event_ring *ring = sh->sw->shards[dst].handoff_ring;
+
+	/* The handoff ring holds as many events as the whole device, hence
+	 * the enqueue always succeeds.
+	 */
+	rte_event_ring_enqueue_burst(ring, sh->handoff_buf[dst],
+			sh->handoff_count[dst], NULL);
+	sh->handoff_count[dst] = 0;
+}
+
+/* Push an event into the IQ of its destination QID. If the event's flow is
+ * scheduled by another shard, batch it up for that shard instead.
+ */
+static __rte_always_inline void
+sw_qid_enqueue(struct sw_shard *sh, const struct rte_event *qe)
+{
+	struct sw_evdev *sw = sh->sw;
+
+	if (sw->shard_count > 1) {
+		const struct sw_qid *qid = &sw->qids[qe->queue_id];
+		const uint32_t slice = SW_HASH_FLOWID(qe->flow_id) &
+				(SW_SHARD_MAP_SIZE - 1);
+		const uint32_t dst = qid->shard_map[slice];
+
+		if (dst != sh->id) {
+			sh->handoff_buf[dst][sh->handoff_count[dst]++] = *qe;
+			if (sh->handoff_count[dst] ==
+					SW_SHARD_HANDOFF_BURST_SIZE)
+				sw_shard_handoff_flush(sh, dst);
+			return;
+		}
+	}
+
+	sw_shard_iq_enqueue(sh, qe);
+}
+
+/* Flush the events batched up for the other shards, and take in the events
+ * they handed over to this one.
+ */
+static uint32_t
+sw_schedule_handoff(struct sw_shard *sh)
+{
+	struct rte_event evs[SW_SHARD_HANDOFF_BURST_SIZE];
+	uint32_t i, n;
+
+	for (i = 0; i < sh->sw->shard_count; i++)
+		if (sh->handoff_count[i] != 0)
+			sw_shard_handoff_flush(sh, i);
+
+	n = rte_event_ring_dequeue_burst(sh->handoff_ring, evs,
+			RTE_DIM(evs), NULL);
+	for (i = 0; i < n; i++)
+		sw_shard_iq_enqueue(sh, &evs[i]);
+
+	return n;
+}
+
 /* This function will perform re-ordering of packets, and injecting into
  * the appropriate QID IQ. As LB and DIR QIDs are in the same array, but *NOT*
  * contiguous in that array, this function accepts a "range" of QIDs to scan.
  */
 static uint16_t
-sw_schedule_reorder(struct sw_evdev *sw, int qid_start, int qid_end)
+sw_schedule_reorder(struct sw_shard *sh, int qid_start, int qid_end)
 {
+	struct sw_evdev *sw = sh->sw;
 	/* Perform egress reordering */
 	struct rte_event *qe;
 	uint32_t pkts_iter = 0;
 
 	for (; qid_start < qid_end; qid_start++) {
-		struct sw_qid *qid = &sw->qids[qid_start];
+		struct sw_qid *qid = &sh->qids[qid_start];
 		int i, num_entries_in_use;
 
 		if (qid->type != RTE_SCHED_TYPE_ORDERED)
@@ -285,32 +401,20 @@ sw_schedule_reorder(struct sw_evdev *sw, int qid_start, int qid_end)
 				break;
 
 			for (j = 0; j < entry->num_fragments; j++) {
-				uint16_t dest_qid;
-				uint16_t dest_iq;
-
 				int idx = entry->fragment_index + j;
 				qe = &entry->fragments[idx];
 
-				dest_qid = qe->queue_id;
-				dest_iq  = PRIO_TO_IQ(qe->priority);
-
-				if (dest_qid >= sw->qid_count) {
-					sw->stats.rx_dropped++;
+				if (qe->queue_id >= sw->qid_count) {
+					sh->stats.rx_dropped++;
 					continue;
 				}
 
 				pkts_iter++;
 
-				struct sw_qid *q = &sw->qids[dest_qid];
-				struct sw_iq *iq = &q->iq[dest_iq];
-
 				/* we checked for space above, so enqueue must
 				 * succeed
 				 */
-				iq_enqueue(sw, iq, qe);
-				q->iq_pkt_mask |= (1 << (dest_iq));
-				q->iq_pkt_count[dest_iq]++;
-				q->stats.rx_pkts++;
+				sw_qid_enqueue(sh, qe);
 			}
 
 			entry->ready = (j != entry->num_fragments);
@@ -333,9 +437,8 @@ sw_schedule_reorder(struct sw_evdev *sw, int qid_start, int qid_end)
 }
 
 static __rte_always_inline void
-sw_refill_pp_buf(struct sw_evdev *sw, struct sw_port *port)
+sw_refill_pp_buf(struct sw_port *port)
 {
-	RTE_SET_USED(sw);
 	struct rte_event_ring *worker = port->rx_worker_ring;
 	port->pp_buf_start = 0;
 	port->pp_buf_count = rte_event_ring_dequeue_burst(worker, port->pp_buf,
@@ -343,15 +446,16 @@ sw_refill_pp_buf(struct sw_evdev *sw, struct sw_port *port)
 }
 
 static __rte_always_inline uint32_t
-__pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
+__pull_port_lb(struct sw_shard *sh, uint32_t port_id, int allow_reorder)
 {
 	static struct reorder_buffer_entry dummy_rob;
+	struct sw_evdev *sw = sh->sw;
 	uint32_t pkts_iter = 0;
 	struct sw_port *port = &sw->ports[port_id];
 
 	/* If shadow ring has 0 pkts, pull from worker ring */
 	if (port->pp_buf_count == 0)
-		sw_refill_pp_buf(sw, port);
+		sw_refill_pp_buf(port);
 
 	while (port->pp_buf_count) {
 		const struct rte_event *qe = &port->pp_buf[port->pp_buf_start];
@@ -363,15 +467,6 @@ __pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
 		if (!allow_reorder && !eop)
 			flags = QE_FLAG_VALID;
 
-		/*
-		 * if we don't have space for this packet in an IQ,
-		 * then move on to next queue. Technically, for a
-		 * packet that needs reordering, we don't need to check
-		 * here, but it simplifies things not to special-case
-		 */
-		uint32_t iq_num = PRIO_TO_IQ(qe->priority);
-		struct sw_qid *qid = &sw->qids[qe->queue_id];
-
 		/* now process based on flags. Note that for directed
 		 * queues, the enqueue_flush masks off all but the
 		 * valid flag. This makes FWD and PARTIAL enqueues just
@@ -386,7 +481,7 @@ __pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
 			const uint32_t hist_fid = hist_entry->fid;
 
 			struct sw_fid_t *fid =
-				&sw->qids[hist_qid].fids[hist_fid];
+				&sh->qids[hist_qid].fids[hist_fid];
 			fid->pcount -= eop;
 			if (fid->pcount == 0)
 				fid->cq = -1;
@@ -422,7 +517,7 @@ __pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
 				 */
 				int num_frag = rob_entry->num_fragments;
 				if (num_frag == SW_FRAGMENTS_MAX)
-					sw->stats.rx_dropped++;
+					sh->stats.rx_dropped++;
 				else {
 					int idx = rob_entry->num_fragments++;
 					rob_entry->fragments[idx] = *qe;
@@ -430,14 +525,8 @@ __pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
 				goto end_qe;
 			}
 
-			/* Use the iq_num from above to push the QE
-			 * into the qid at the right priority
-			 */
-
-			qid->iq_pkt_mask |= (1 << (iq_num));
-			iq_enqueue(sw, &qid->iq[iq_num], qe);
-			qid->iq_pkt_count[iq_num]++;
-			qid->stats.rx_pkts++;
+			/* Push the QE into the qid at the right priority */
+			sw_qid_enqueue(sh, qe);
 			pkts_iter++;
 		}
 
@@ -450,26 +539,26 @@ __pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
 }
 
 static uint32_t
-sw_schedule_pull_port_lb(struct sw_evdev *sw, uint32_t port_id)
+sw_schedule_pull_port_lb(struct sw_shard *sh, uint32_t port_id)
 {
-	return __pull_port_lb(sw, port_id, 1);
+	return __pull_port_lb(sh, port_id, 1);
 }
 
 static uint32_t
-sw_schedule_pull_port_no_reorder(struct sw_evdev *sw, uint32_t port_id)
+sw_schedule_pull_port_no_reorder(struct sw_shard *sh, uint32_t port_id)
 {
-	return __pull_port_lb(sw, port_id, 0);
+	return __pull_port_lb(sh, port_id, 0);
 }
 
 static uint32_t
-sw_schedule_pull_port_dir(struct sw_evdev *sw, uint32_t port_id)
+sw_schedule_pull_port_dir(struct sw_shard *sh, uint32_t port_id)
 {
 	uint32_t pkts_iter = 0;
-	struct sw_port *port = &sw->ports[port_id];
+	struct sw_port *port = &sh->sw->ports[port_id];
 
 	/* If shadow ring has 0 pkts, pull from worker ring */
 	if (port->pp_buf_count == 0)
-		sw_refill_pp_buf(sw, port);
+		sw_refill_pp_buf(port);
 
 	while (port->pp_buf_count) {
 		const struct rte_event *qe = &port->pp_buf[port->pp_buf_start];
@@ -478,19 +567,10 @@ sw_schedule_pull_port_dir(struct sw_evdev *sw, uint32_t port_id)
 		if ((flags & QE_FLAG_VALID) == 0)
 			goto end_qe;
 
-		uint32_t iq_num = PRIO_TO_IQ(qe->priority);
-		struct sw_qid *qid = &sw->qids[qe->queue_id];
-		struct sw_iq *iq = &qid->iq[iq_num];
-
 		port->stats.rx_pkts++;
 
-		/* Use the iq_num from above to push the QE
-		 * into the qid at the right priority
-		 */
-		qid->iq_pkt_mask |= (1 << (iq_num));
-		iq_enqueue(sw, iq, qe);
-		qid->iq_pkt_count[iq_num]++;
-		qid->stats.rx_pkts++;
+		/* Push the QE into the qid at the right priority */
+		sw_qid_enqueue(sh, qe);
 		pkts_iter++;
 
 end_qe:
@@ -502,15 +582,16 @@ sw_schedule_pull_port_dir(struct sw_evdev *sw, uint32_t port_id)
 }
 
 void
-sw_event_schedule(struct rte_eventdev *dev)
+sw_shard_schedule(struct sw_shard *sh)
 {
-	struct sw_evdev *sw = sw_pmd_priv(dev);
+	struct sw_evdev *sw = sh->sw;
 	uint32_t in_pkts, out_pkts;
 	uint32_t out_pkts_total = 0, in_pkts_total = 0;
+	uint32_t handoff_pkts, handoff_pkts_total = 0;
 	int32_t sched_quanta = sw->sched_quanta;
 	uint32_t i;
 
-	sw->sched_called++;
+	sh->sched_called++;
 	if (unlikely(!sw->started))
 		return;
 
@@ -520,27 +601,42 @@ sw_event_schedule(struct rte_eventdev *dev)
 		/* Pull from rx_ring for ports */
 		do {
 			in_pkts = 0;
-			for (i = 0; i < sw->port_count; i++) {
-				/* ack the unlinks in progress as done */
-				if (sw->ports[i].unlinks_in_progress)
-					sw->ports[i].unlinks_in_progress = 0;
+			for (i = 0; i < sh->port_count; i++) {
+				uint32_t port_id = sh->ports[i];
+				struct sw_port *port = &sw->ports[port_id];
 
-				if (sw->ports[i].is_directed)
-					in_pkts += sw_schedule_pull_port_dir(sw, i);
-				else if (sw->ports[i].num_ordered_qids > 0)
-					in_pkts += sw_schedule_pull_port_lb(sw, i);
+				/* ack the unlinks in progress as done */
+				if (port->unlinks_in_progress)
+					port->unlinks_in_progress = 0;
+
+				if (port->is_directed)
+					in_pkts += sw_schedule_pull_port_dir(sh,
+							port_id);
+				else if (port->num_ordered_qids > 0)
+					in_pkts += sw_schedule_pull_port_lb(sh,
+							port_id);
 				else
-					in_pkts += sw_schedule_pull_port_no_reorder(sw, i);
+					in_pkts += sw_schedule_pull_port_no_reorder(
+							sh, port_id);
 			}
 
 			/* QID scan for re-ordered */
-			in_pkts += sw_schedule_reorder(sw, 0,
+			in_pkts += sw_schedule_reorder(sh, 0,
 					sw->qid_count);
+
+			/* Exchange events with the other shards. Events handed
+			 * over were counted by the shard which pulled them.
+			 */
+			if (sw->shard_count > 1) {
+				handoff_pkts = sw_schedule_handoff(sh);
+				handoff_pkts_total += handoff_pkts;
+				in_pkts += handoff_pkts;
+			}
 			in_pkts_this_iteration += in_pkts;
 		} while (in_pkts > 4 &&
 				(int)in_pkts_this_iteration < sched_quanta);
 
-		out_pkts = sw_schedule_qid_to_cq(sw);
+		out_pkts = sw_schedule_qid_to_cq(sh);
 		out_pkts_total += out_pkts;
 		in_pkts_total += in_pkts_this_iteration;
 
@@ -548,21 +644,33 @@ sw_event_schedule(struct rte_eventdev *dev)
 			break;
 	} while ((int)out_pkts_total < sched_quanta);
 
-	sw->stats.tx_pkts += out_pkts_total;
-	sw->stats.rx_pkts += in_pkts_total;
+	sh->stats.tx_pkts += out_pkts_total;
+	sh->stats.rx_pkts += in_pkts_total - handoff_pkts_total;
 
-	sw->sched_no_iq_enqueues += (in_pkts_total == 0);
-	sw->sched_no_cq_enqueues += (out_pkts_total == 0);
+	sh->sched_no_iq_enqueues += (in_pkts_total == 0);
+	sh->sched_no_cq_enqueues += (out_pkts_total == 0);
 
 	/* push all the internal buffered QEs in port->cq_ring to the
 	 * worker cores: aka, do the ring transfers batched.
 	 */
-	for (i = 0; i < sw->port_count; i++) {
-		struct rte_event_ring *worker = sw->ports[i].cq_worker_ring;
-		rte_event_ring_enqueue_burst(worker, sw->ports[i].cq_buf,
-				sw->ports[i].cq_buf_count,
-				&sw->cq_ring_space[i]);
-		sw->ports[i].cq_buf_count = 0;
+	for (i = 0; i < sh->port_count; i++) {
+		uint32_t port_id = sh->ports[i];
+		struct sw_port *port = &sw->ports[port_id];
+		struct rte_event_ring *worker = port->cq_worker_ring;
+		rte_event_ring_enqueue_burst(worker, port->cq_buf,
+				port->cq_buf_count,
+				&sw->cq_ring_space[port_id]);
+		port->cq_buf_count = 0;
 	}
 
 }
+
+void
+sw_event_schedule(struct rte_eventdev *dev)
+{
+	struct sw_evdev *sw = sw_pmd_priv(dev);
+	uint32_t i;
+
+	for (i = 0; i < sw->shard_count; i++)
+		sw_shard_schedule(&sw->shards[i]);
+}
@@ -3155,6 +3155,184 @@ worker_loopback(struct test *t, uint8_t disable_implicit_release)
 	return 0;
 }
 
+/*
+ * Split the scheduler of a second device in two shards and run an atomic
+ * then an ordered stage on it. Both stages have a worker port in each shard
+ * and the producer, the workers and the tx port are spread over the shards,
+ * so that events cross shards at every stage. Check that an atomic flow is
+ * never held by two ports at once and that the order of every flow is kept
+ * up to the tx port.
+ */
+#define SHARDED_NB_FLOWS 16
+#define SHARDED_NB_EVENTS 512
+
+static int
+sharded_pipeline(struct test *t)
+{
+	const char *sharded_name = "event_sw_sharded";
+	const uint8_t w_atomic[] = {0, 1};
+	const uint8_t w_ordered[] = {2, 3};
+	const uint8_t tx_port = 4;
+	const uint8_t rx_port = 5;
+	uint32_t next_seq[SHARDED_NB_FLOWS] = {0};
+	uint32_t service_ids[2];
+	struct rte_event ev[SHARDED_NB_EVENTS];
+	char name[RTE_SERVICE_NAME_MAX];
+	int main_evdev = evdev;
+	uint32_t rx = 0, i, j, loops;
+	int ret = -1;
+
+	evdev = rte_event_dev_get_dev_id(sharded_name);
+	if (evdev < 0) {
+		if (rte_vdev_init(sharded_name, "sched_shards=2") < 0) {
+			printf("%d: Error creating sharded eventdev\n",
+					__LINE__);
+			goto out;
+		}
+		evdev = rte_event_dev_get_dev_id(sharded_name);
+	}
+
+	/* shard 0 runs the eventdev service, shard 1 its own */
+	rte_event_dev_service_id_get(evdev, &service_ids[0]);
+	snprintf(name, sizeof(name), "%s_service_1", sharded_name);
+	if (rte_service_get_by_name(name, &service_ids[1]) < 0) {
+		printf("%d: Error finding service of shard 1\n", __LINE__);
+		goto out;
+	}
+	for (i = 0; i < RTE_DIM(service_ids); i++) {
+		rte_service_runstate_set(service_ids[i], 1);
+		rte_service_set_runstate_mapped_check(service_ids[i], 0);
+	}
+
+	if (init(t, 3, rx_port + 1) < 0 ||
+			create_ports(t, rx_port + 1) < 0 ||
+			create_atomic_qids(t, 1) < 0 ||
+			create_ordered_qids(t, 1) < 0 ||
+			create_directed_qids(t, 1, &tx_port) < 0) {
+		printf("%d: Error initializing device\n", __LINE__);
+		goto out;
+	}
+
+	for (i = 0; i < 2; i++) {
+		if (rte_event_port_link(evdev, w_atomic[i], &t->qid[0],
+					NULL, 1) != 1 ||
+				rte_event_port_link(evdev, w_ordered[i],
+					&t->qid[1], NULL, 1) != 1) {
+			printf("%d: error mapping lb qid\n", __LINE__);
+			goto cleanup;
+		}
+	}
+
+	if (rte_event_dev_start(evdev) < 0) {
+		printf("%d: Error with start call\n", __LINE__);
+		goto cleanup;
+	}
+
+	for (i = 0; i < SHARDED_NB_EVENTS; i++) {
+		uint32_t flow = i % SHARDED_NB_FLOWS;
+
+		ev[i] = (struct rte_event){
+			.op = RTE_EVENT_OP_NEW,
+			.queue_id = t->qid[0],
+			.sched_type = RTE_SCHED_TYPE_ATOMIC,
+			.flow_id = flow,
+			.u64 = ((uint64_t)flow << 32) | (i / SHARDED_NB_FLOWS),
+		};
+	}
+	for (i = 0; i < SHARDED_NB_EVENTS; i += j) {
+		j = rte_event_enqueue_burst(evdev, t->port[rx_port], &ev[i],
+				SHARDED_NB_EVENTS - i);
+		if (j == 0) {
+			printf("%d: Failed to enqueue\n", __LINE__);
+			goto cleanup;
+		}
+	}
+
+	for (loops = 0; rx < SHARDED_NB_EVENTS && loops < 10000; loops++) {
+		int held_by[SHARDED_NB_FLOWS];
+		uint16_t n[2];
+
+		for (i = 0; i < RTE_DIM(service_ids); i++)
+			rte_service_run_iter_on_app_lcore(service_ids[i], 1);
+
+		/* atomic stage: all events dequeued are held until the
+		 * next dequeue, a flow must only be on one of the ports
+		 */
+		memset(held_by, -1, sizeof(held_by));
+		for (i = 0; i < 2; i++) {
+			n[i] = rte_event_dequeue_burst(evdev, w_atomic[i],
+					ev, RTE_DIM(ev), 0);
+			for (j = 0; j < n[i]; j++) {
+				uint32_t flow = ev[j].flow_id;
+
+				if (held_by[flow] != -1 &&
+						held_by[flow] != (int)i) {
+					printf("%d: atomic flow %u on two ports\n",
+							__LINE__, flow);
+					goto cleanup;
+				}
+				held_by[flow] = i;
+				ev[j].op = RTE_EVENT_OP_FORWARD;
+				ev[j].queue_id = t->qid[1];
+				ev[j].sched_type = RTE_SCHED_TYPE_ORDERED;
+			}
+			if (rte_event_enqueue_burst(evdev, w_atomic[i], ev,
+						n[i]) != n[i]) {
+				printf("%d: Failed to forward\n", __LINE__);
+				goto cleanup;
+			}
+		}
+
+		/* ordered stage: forward from the last port first, to be
+		 * fixed up by the reorder buffers
+		 */
+		for (i = 2; i-- > 0;) {
+			n[i] = rte_event_dequeue_burst(evdev, w_ordered[i],
+					ev, RTE_DIM(ev), 0);
+			for (j = 0; j < n[i]; j++) {
+				ev[j].op = RTE_EVENT_OP_FORWARD;
+				ev[j].queue_id = t->qid[2];
+			}
+			if (rte_event_enqueue_burst(evdev, w_ordered[i], ev,
+						n[i]) != n[i]) {
+				printf("%d: Failed to forward\n", __LINE__);
+				goto cleanup;
+			}
+		}
+
+		n[0] = rte_event_dequeue_burst(evdev, t->port[tx_port], ev,
+				RTE_DIM(ev), 0);
+		for (j = 0; j < n[0]; j++) {
+			uint32_t flow = ev[j].u64 >> 32;
+			uint32_t seq = (uint32_t)ev[j].u64;
+
+			if (flow >= SHARDED_NB_FLOWS ||
+					seq != next_seq[flow]) {
+				printf("%d: flow %u: got seq %u, expected %u\n",
+						__LINE__, flow, seq,
+						next_seq[flow]);
+				goto cleanup;
+			}
+			next_seq[flow]++;
+		}
+		rx += n[0];
+	}
+
+	if (rx != SHARDED_NB_EVENTS) {
+		printf("%d: expected %u events at tx port, got %u\n",
+				__LINE__, SHARDED_NB_EVENTS, rx);
+		rte_event_dev_dump(evdev, stdout);
+		goto cleanup;
+	}
+
+	ret = 0;
+cleanup:
+	cleanup(t);
+out:
+	evdev = main_evdev;
+	return ret;
+}
+
 static struct rte_mempool *eventdev_func_mempool;
 
 int
@@ -3367,6 +3545,12 @@ test_sw_eventdev(void)
 		printf("ERROR - Stop Flush test FAILED.\n");
 		goto test_fail;
 	}
+	printf("*** Running Sharded Scheduler Pipeline test...\n");
+	ret = sharded_pipeline(t);
+	if (ret != 0) {
+		printf("ERROR - Sharded Scheduler Pipeline test FAILED.\n");
+		goto test_fail;
+	}
 	if (rte_lcore_count() >= 3) {
 		printf("*** Running Worker loopback test...\n");
 		ret = worker_loopback(t, 0);
@@ -46,17 +46,33 @@ struct sw_xstats_entry {
 	uint64_t reset_value; /* an offset to be taken away to emulate resets */
 };
 
+static uint64_t
+get_shard_stat(const struct sw_shard *sh, enum xstats_type type)
+{
+	switch (type) {
+	case rx: return sh->stats.rx_pkts;
+	case tx: return sh->stats.tx_pkts;
+	case dropped: return sh->stats.rx_dropped;
+	case calls: return sh->sched_called;
+	case no_iq_enq: return sh->sched_no_iq_enqueues;
+	case no_cq_enq: return sh->sched_no_cq_enqueues;
+	default: return -1;
+	}
+}
+
 static uint64_t
 get_dev_stat(const struct sw_evdev *sw, uint16_t obj_idx __rte_unused,
 		enum xstats_type type, int extra_arg __rte_unused)
 {
+	uint64_t val = 0;
+	unsigned int s;
+
 	switch (type) {
-	case rx: return sw->stats.rx_pkts;
-	case tx: return sw->stats.tx_pkts;
-	case dropped: return sw->stats.rx_dropped;
-	case calls: return sw->sched_called;
-	case no_iq_enq: return sw->sched_no_iq_enqueues;
-	case no_cq_enq: return sw->sched_no_cq_enqueues;
+	case rx: case tx: case dropped:
+	case calls: case no_iq_enq: case no_cq_enq:
+		for (s = 0; s < sw->shard_count; s++)
+			val += get_shard_stat(&sw->shards[s], type);
+		return val;
 	default: return -1;
 	}
 }
@@ -97,11 +113,8 @@ get_port_bucket_stat(const struct sw_evdev *sw, uint16_t obj_idx,
 }
 
 static uint64_t
-get_qid_stat(const struct sw_evdev *sw, uint16_t obj_idx,
-		enum xstats_type type, int extra_arg __rte_unused)
+get_shard_qid_stat(const struct sw_qid *qid, enum xstats_type type)
 {
-	const struct sw_qid *qid = &sw->qids[obj_idx];
-
 	switch (type) {
 	case rx: return qid->stats.rx_pkts;
 	case tx: return qid->stats.tx_pkts;
@@ -119,26 +132,45 @@ get_qid_stat(const struct sw_evdev *sw, uint16_t obj_idx,
 	}
 }
 
+/* When sharded, a queue's stats are split over the shards' copies of it */
+static uint64_t
+get_qid_stat(const struct sw_evdev *sw, uint16_t obj_idx,
+		enum xstats_type type, int extra_arg __rte_unused)
+{
+	uint64_t val = 0;
+	unsigned int s;
+
+	switch (type) {
+	case rx: case tx: case dropped: case inflight:
+		for (s = 0; s < sw->shard_count; s++)
+			val += get_shard_qid_stat(&sw->shards[s].qids[obj_idx],
+					type);
+		return val;
+	default: return -1;
+	}
+}
+
 static uint64_t
 get_qid_iq_stat(const struct sw_evdev *sw, uint16_t obj_idx,
 		enum xstats_type type, int extra_arg)
 {
-	const struct sw_qid *qid = &sw->qids[obj_idx];
 	const int iq_idx = extra_arg;
+	uint64_t val = 0;
+	unsigned int s;
 
 	switch (type) {
-	case iq_used: return iq_count(&qid->iq[iq_idx]);
+	case iq_used:
+		for (s = 0; s < sw->shard_count; s++)
+			val += iq_count(&sw->shards[s].qids[obj_idx].iq[iq_idx]);
+		return val;
 	default: return -1;
 	}
 }
 
 static uint64_t
-get_qid_port_stat(const struct sw_evdev *sw, uint16_t obj_idx,
-		enum xstats_type type, int extra_arg)
+get_shard_qid_port_stat(const struct sw_qid *qid, enum xstats_type type,
+		uint16_t port)
 {
-	const struct sw_qid *qid = &sw->qids[obj_idx];
-	uint16_t port = extra_arg;
-
 	switch (type) {
 	case pinned:
 		do {
@@ -156,6 +188,24 @@ get_qid_port_stat(const struct sw_evdev *sw, uint16_t obj_idx,
 	}
 }
 
+static uint64_t
+get_qid_port_stat(const struct sw_evdev *sw, uint16_t obj_idx,
+		enum xstats_type type, int extra_arg)
+{
+	uint64_t val = 0;
+	unsigned int s;
+
+	switch (type) {
+	case pinned: case pkts:
+		for (s = 0; s < sw->shard_count; s++)
+			val += get_shard_qid_port_stat(
+					&sw->shards[s].qids[obj_idx],
+					type, extra_arg);
+		return val;
+	default: return -1;
+	}
+}
+
 int
 sw_xstats_init(struct sw_evdev *sw)
 {
@@ -0,0 +1,515 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2020 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_errno.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_memory.h>
+#include <rte_mempool.h>
+#include <rte_ring.h>
+
+/*
+ * The NUMA mempool driver splits the objects of a mempool in one shard
+ * per socket, each shard being a ring allocated on its socket and holding
+ * the objects whose memory is on this socket.
+ *
+ * The socket of an object is found from the memory chunks given to the
+ * driver when the mempool is populated, kept sorted by address. Objects
+ * freed on the socket they belong to go straight back to the local shard.
+ * Objects freed on another socket are first gathered in per-lcore return
+ * queues, one per socket, and go back to their shard in batches, so that
+ * the remote ring is updated once per batch instead of once per object.
+ *
+ * An object always goes back to the same shard, so each shard is sized to
+ * the objects populated from its memory.
+ *
+ * Objects are allocated from the shard of the calling lcore first, and
+ * from the other shards only when it does not have enough of them. The
+ * lcore then flushes its return queues, so that the objects it holds for
+ * the other shards are not stranded while the pool runs dry.
+ */
+
+/* Number of remote objects gathered before returning them to their shard */
+#define NUMA_RETURN_BURST	32
+
+/* Maximum number of memory ranges tracked to find the socket of objects */
+#define NUMA_MAX_RANGES		64
+
+/* Objects on a socket without a shard go to the default shard */
+#define NUMA_NO_SHARD		UINT8_MAX
+
+struct numa_range {
+	uintptr_t start;
+	size_t len;
+	unsigned int shard;
+};
+
+/* Objects freed by an lcore which belong to the shard of another socket */
+struct numa_return_queue {
+	unsigned int len;
+	void *objs[NUMA_RETURN_BURST];
+} __rte_cache_aligned;
+
+struct numa_data {
+	unsigned int nb_shards;
+	unsigned int default_shard;
+	uint8_t socket_shard[RTE_MAX_NUMA_NODES];
+	struct rte_ring *shards[RTE_MAX_NUMA_NODES];
+	/* Number of objects populated in each shard */
+	unsigned int shard_objs[RTE_MAX_NUMA_NODES];
+	unsigned int ring_flags;
+	/* Memory chunks of the mempool, sorted by address */
+	unsigned int nb_ranges;
+	struct numa_range ranges[NUMA_MAX_RANGES];
+	/* Return queues of each lcore, one per shard */
+	struct numa_return_queue *return_queues[RTE_MAX_LCORE];
+	struct rte_mempool *pool;
+	void *lcore_callback_handle;
+};
+
+static inline unsigned int
+numa_socket_shard(const struct numa_data *nd, unsigned int socket_id)
+{
+	if (socket_id >= RTE_MAX_NUMA_NODES ||
+			nd->socket_shard[socket_id] == NUMA_NO_SHARD)
+		return nd->default_shard;
+	return nd->socket_shard[socket_id];
+}
+
+/*
+ * Get the shard of an object. The range of the previous object is tried
+ * first, as consecutive objects often come from the same memory chunk.
+ */
+static inline unsigned int
+numa_obj_shard(const struct numa_data *nd, const void *obj,
+		const struct numa_range **last)
+{
+	const struct numa_range *r = *last;
+	uintptr_t addr = (uintptr_t)obj;
+	unsigned int lo, hi, mid;
+
+	if (r != NULL && addr - r->start < r->len)
+		return r->shard;
+
+	lo = 0;
+	hi = nd->nb_ranges;
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		r = &nd->ranges[mid];
+		if (addr < r->start)
+			hi = mid;
+		else if (addr - r->start < r->len) {
+			*last = r;
+			return r->shard;
+		} else
+			lo = mid + 1;
+	}
+
+	/* Object from a chunk the driver could not track */
+	return nd->default_shard;
+}
+
+static inline int
+numa_shard_enqueue(const struct numa_data *nd, unsigned int shard,
+		void * const *obj_table, unsigned int n)
+{
+	return rte_ring_enqueue_bulk(nd->shards[shard],
+			obj_table, n, NULL) == 0 ? -ENOBUFS : 0;
+}
+
+/* Give back the objects of the return queues of an lcore to their shard */
+static void
+numa_return_flush(const struct numa_data *nd, struct numa_return_queue *rq)
+{
+	unsigned int shard;
+
+	for (shard = 0; shard < nd->nb_shards; shard++) {
+		if (rq[shard].len == 0)
+			continue;
+		numa_shard_enqueue(nd, shard, rq[shard].objs, rq[shard].len);
+		rq[shard].len = 0;
+	}
+}
+
+static int
+numa_enqueue(struct rte_mempool *mp, void * const *obj_table,
+		unsigned int n)
+{
+	struct numa_data *nd = mp->pool_data;
+	struct numa_return_queue *rq, *q;
+	const struct numa_range *last = NULL;
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int local, shard, i, first;
+	int ret = 0;
+
+	if (nd->nb_shards == 1)
+		return numa_shard_enqueue(nd, 0, obj_table, n);
+
+	local = numa_socket_shard(nd, rte_socket_id());
+	rq = lcore_id < RTE_MAX_LCORE ? nd->return_queues[lcore_id] : NULL;
+
+	/* Enqueue the runs of local objects directly from the table */
+	for (first = 0, i = 0; i < n; i++) {
+		shard = numa_obj_shard(nd, obj_table[i], &last);
+		if (shard == local)
+			continue;
+
+		if (i != first)
+			ret |= numa_shard_enqueue(nd, local, &obj_table[first],
+					i - first);
+		first = i + 1;
+
+		if (rq == NULL) {
+			/* Unregistered non-EAL thread, no return queue */
+			ret |= numa_shard_enqueue(nd, shard, &obj_table[i], 1);
+			continue;
+		}
+
+		q = &rq[shard];
+		q->objs[q->len++] = obj_table[i];
+		if (q->len == NUMA_RETURN_BURST) {
+			ret |= numa_shard_enqueue(nd, shard, q->objs, q->len);
+			q->len = 0;
+		}
+	}
+	if (i != first)
+		ret |= numa_shard_enqueue(nd, local, &obj_table[first],
+				i - first);
+
+	return ret;
+}
+
+static int
+numa_dequeue(struct rte_mempool *mp, void **obj_table, unsigned int n)
+{
+	struct numa_data *nd = mp->pool_data;
+	struct numa_return_queue *rq;
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int local, shard, i, got;
+
+	local = nd->nb_shards == 1 ? 0 :
+		numa_socket_shard(nd, rte_socket_id());
+	if (rte_ring_dequeue_bulk(nd->shards[local], obj_table, n, NULL) != 0)
+		return 0;
+	if (nd->nb_shards == 1)
+		return -ENOBUFS;
+
+	/* The objects this lcore holds for other shards may be missing */
+	rq = lcore_id < RTE_MAX_LCORE ? nd->return_queues[lcore_id] : NULL;
+	if (rq != NULL)
+		numa_return_flush(nd, rq);
+
+	/* Not enough local objects, complete with the other shards */
+	got = rte_ring_dequeue_burst(nd->shards[local], obj_table, n, NULL);
+	for (i = 1; i < nd->nb_shards && got < n; i++) {
+		shard = (local + i) % nd->nb_shards;
+		got += rte_ring_dequeue_burst(nd->shards[shard],
+				obj_table + got, n - got, NULL);
+	}
+
+	if (got < n) {
+		/* Shards are multi-producer when there are several of them */
+		numa_enqueue(mp, obj_table, got);
+		if (rq != NULL)
+			numa_return_flush(nd, rq);
+		return -ENOBUFS;
+	}
+
+	return 0;
+}
+
+struct numa_count_per_lcore_ctx {
+	const struct numa_data *nd;
+	unsigned int count;
+};
+
+static int
+numa_count_per_lcore(unsigned int lcore_id, void *arg)
+{
+	struct numa_count_per_lcore_ctx *nplc = arg;
+	const struct numa_return_queue *rq =
+		nplc->nd->return_queues[lcore_id];
+	unsigned int shard;
+
+	for (shard = 0; rq != NULL && shard < nplc->nd->nb_shards; shard++)
+		nplc->count += rq[shard].len;
+	return 0;
+}
+
+static unsigned int
+numa_get_count(const struct rte_mempool *mp)
+{
+	struct numa_count_per_lcore_ctx nplc;
+	unsigned int shard;
+
+	nplc.nd = mp->pool_data;
+	nplc.count = 0;
+	for (shard = 0; shard < nplc.nd->nb_shards; shard++)
+		nplc.count += rte_ring_count(nplc.nd->shards[shard]);
+
+	if (nplc.nd->nb_shards > 1)
+		rte_lcore_iterate(numa_count_per_lcore, &nplc);
+
+	return nplc.count;
+}
+
+static int
+numa_init_per_lcore(unsigned int lcore_id, void *arg)
+{
+	struct numa_data *nd = arg;
+
+	nd->return_queues[lcore_id] = rte_zmalloc_socket("numa_return_queue",
+		nd->nb_shards * sizeof(struct numa_return_queue),
+		RTE_CACHE_LINE_SIZE, rte_lcore_to_socket_id(lcore_id));
+	if (nd->return_queues[lcore_id] == NULL)
+		return -1;
+
+	return 0;
+}
+
+static void
+numa_uninit_per_lcore(unsigned int lcore_id, void *arg)
+{
+	struct numa_data *nd = arg;
+	struct numa_return_queue *rq = nd->return_queues[lcore_id];
+
+	nd->return_queues[lcore_id] = NULL;
+	/* Do not lose the objects the lcore did not give back yet */
+	if (rq != NULL)
+		numa_return_flush(nd, rq);
+	rte_free(rq);
+}
+
+/*
+ * Make room in a shard for count objects. The ring is replaced by a larger
+ * one when needed, which is only done while populating the mempool, so
+ * that its objects can be moved without concurrent access.
+ */
+static int
+numa_shard_reserve(struct numa_data *nd, unsigned int shard,
+		unsigned int count)
+{
+	char rg_name[RTE_RING_NAMESIZE];
+	struct rte_ring *r, *old = nd->shards[shard];
+	void *objs[NUMA_RETURN_BURST];
+	unsigned int socket_id, n;
+	ssize_t size;
+	int rc;
+
+	if (old != NULL && rte_ring_get_capacity(old) >= count)
+		return 0;
+
+	socket_id = rte_socket_id_by_idx(shard);
+	rc = snprintf(rg_name, sizeof(rg_name), RTE_MEMPOOL_MZ_FORMAT ".%u",
+		nd->pool->name, socket_id);
+	if (rc < 0 || rc >= (int)sizeof(rg_name))
+		return -ENAMETOOLONG;
+
+	size = rte_ring_get_memsize(rte_align32pow2(count + 1));
+	if (size < 0)
+		return size;
+
+	r = rte_zmalloc_socket(rg_name, size, RTE_CACHE_LINE_SIZE, socket_id);
+	if (r == NULL)
+		r = rte_zmalloc_socket(rg_name, size, RTE_CACHE_LINE_SIZE,
+				SOCKET_ID_ANY);
+	if (r == NULL)
+		return -ENOMEM;
+
+	rc = rte_ring_init(r, rg_name, count, nd->ring_flags | RING_F_EXACT_SZ);
+	if (rc < 0) {
+		rte_free(r);
+		return rc;
+	}
+
+	if (old != NULL) {
+		while ((n = rte_ring_dequeue_burst(old, objs, RTE_DIM(objs),
+				NULL)) != 0)
+			rte_ring_enqueue_bulk(r, objs, n, NULL);
+		rte_free(old);
+	}
+	nd->shards[shard] = r;
+
+	return 0;
+}
+
+static int
+numa_alloc(struct rte_mempool *mp)
+{
+	struct numa_data *nd;
+	unsigned int i, socket_id;
+	int rc;
+
+	nd = rte_zmalloc_socket("numa_pool", sizeof(*nd),
+				RTE_CACHE_LINE_SIZE, mp->socket_id);
+	if (nd == NULL) {
+		rc = -ENOMEM;
+		goto no_mem_for_data;
+	}
+	nd->pool = mp;
+	memset(nd->socket_shard, NUMA_NO_SHARD, sizeof(nd->socket_shard));
+
+	/* With several shards, the objects of a shard are also put back by
+	 * the consumers rolling back a partial dequeue, and by the lcores
+	 * flushing their return queues.
+	 */
+	if ((mp->flags & MEMPOOL_F_SP_PUT) && rte_socket_count() == 1)
+		nd->ring_flags |= RING_F_SP_ENQ;
+	if (mp->flags & MEMPOOL_F_SC_GET)
+		nd->ring_flags |= RING_F_SC_DEQ;
+
+	/* Shards are empty until populated */
+	for (i = 0; i < rte_socket_count(); i++) {
+		rc = numa_shard_reserve(nd, i, 0);
+		if (rc < 0)
+			goto cannot_create_shard;
+		socket_id = rte_socket_id_by_idx(i);
+		nd->socket_shard[socket_id] = i;
+		nd->nb_shards++;
+	}
+
+	/* Objects of an unknown socket go to the shard of the mempool */
+	nd->default_shard = 0;
+	nd->default_shard = numa_socket_shard(nd, mp->socket_id);
+
+	mp->pool_data = nd;
+
+	nd->lcore_callback_handle = rte_lcore_callback_register("numa",
+		numa_init_per_lcore, numa_uninit_per_lcore, nd);
+	if (nd->lcore_callback_handle == NULL) {
+		rc = -ENOMEM;
+		goto no_mem_for_return_queues;
+	}
+
+	return 0;
+
+no_mem_for_return_queues:
+	mp->pool_data = NULL;
+cannot_create_shard:
+	for (i = 0; i < nd->nb_shards; i++)
+		rte_free(nd->shards[i]);
+	rte_free(nd);
+no_mem_for_data:
+	rte_errno = -rc;
+	return rc;
+}
+
+static void
+numa_free(struct rte_mempool *mp)
+{
+	struct numa_data *nd = mp->pool_data;
+	unsigned int i;
+
+	if (nd == NULL)
+		return;
+
+	rte_lcore_callback_unregister(nd->lcore_callback_handle);
+
+	for (i = 0; i < nd->nb_shards; i++)
+		rte_free(nd->shards[i]);
+
+	rte_free(nd);
+}
+
+/* Track a memory chunk, and return the shard of its objects */
+static unsigned int
+numa_add_range(struct numa_data *nd, const struct rte_mempool *mp,
+		void *vaddr, size_t len)
+{
+	const struct rte_memseg_list *msl;
+	uintptr_t start = (uintptr_t)vaddr;
+	struct numa_range *r;
+	unsigned int shard, i;
+	int socket_id;
+
+	msl = rte_mem_virt2memseg_list(vaddr);
+	if (msl != NULL && !msl->external)
+		socket_id = msl->socket_id;
+	else
+		socket_id = mp->socket_id;
+	shard = numa_socket_shard(nd, socket_id);
+
+	for (i = 0; i < nd->nb_ranges; i++)
+		if (nd->ranges[i].start > start)
+			break;
+
+	/* Chunks of a virtual area populated one after the other */
+	if (i != 0) {
+		r = &nd->ranges[i - 1];
+		if (r->shard == shard && r->start + r->len == start) {
+			r->len += len;
+			return shard;
+		}
+	}
+	if (i != nd->nb_ranges) {
+		r = &nd->ranges[i];
+		if (r->shard == shard && start + len == r->start) {
+			r->start = start;
+			r->len += len;
+			return shard;
+		}
+	}
+
+	if (nd->nb_ranges == NUMA_MAX_RANGES) {
+		RTE_LOG(DEBUG, MEMPOOL,
+			"%s: too many memory chunks, objects of %p go to the default shard\n",
+			mp->name, vaddr);
+		return nd->default_shard;
+	}
+
+	memmove(&nd->ranges[i + 1], &nd->ranges[i],
+		(nd->nb_ranges - i) * sizeof(nd->ranges[0]));
+	nd->nb_ranges++;
+	r = &nd->ranges[i];
+	r->start = start;
+	r->len = len;
+	r->shard = shard;
+
+	return shard;
+}
+
+static int
+numa_populate(struct rte_mempool *mp, unsigned int max_objs,
+		void *vaddr, rte_iova_t iova, size_t len,
+		rte_mempool_populate_obj_cb_t *obj_cb, void *obj_cb_arg)
+{
+	struct numa_data *nd = mp->pool_data;
+	unsigned int shard, n;
+	size_t total_elt_sz;
+	int ret;
+
+	if (nd == NULL)
+		return -EINVAL;
+
+	/* At most that many objects from the chunk, all in the same shard */
+	total_elt_sz = mp->header_size + mp->elt_size + mp->trailer_size;
+	n = RTE_MIN(max_objs, len / total_elt_sz);
+
+	shard = numa_add_range(nd, mp, vaddr, len);
+	ret = numa_shard_reserve(nd, shard, nd->shard_objs[shard] + n);
+	if (ret < 0)
+		return ret;
+
+	ret = rte_mempool_op_populate_helper(mp, 0, max_objs, vaddr, iova,
+			len, obj_cb, obj_cb_arg);
+	if (ret > 0)
+		nd->shard_objs[shard] += ret;
+
+	return ret;
+}
+
+static const struct rte_mempool_ops ops_numa = {
+	.name = "numa",
+	.alloc = numa_alloc,
+	.free = numa_free,
+	.enqueue = numa_enqueue,
+	.dequeue = numa_dequeue,
+	.get_count = numa_get_count,
+	.populate = numa_populate,
+};
+
+MEMPOOL_REGISTER_OPS(ops_numa);
@@ -0,0 +1,335 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2020 Intel Corporation
+ */
+
+#include "acl_run_sse.h"
+
+/*
+ * Permutation indexes to split 16 64-bit transitions (stored in two ZMM
+ * registers) into their low and high 32-bit halves.
+ */
+static const uint32_t zmm_idx_lo[MAX_SEARCHES_AVX512X16] = {
+	0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30,
+};
+
+static const uint32_t zmm_idx_hi[MAX_SEARCHES_AVX512X16] = {
+	1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31,
+};
+
+/*
+ * Set of constants used by the 16 flows transition.
+ * They are the same as for SSE/AVX2, just broadcast to 512 bits.
+ */
+struct acl_avx512_const {
+	__m512i match_mask;
+	__m512i index_mask;
+	__m512i shuffle_input;
+	__m512i range_base;
+	__m512i ones_16;
+};
+
+static inline void
+acl_avx512_const_init(struct acl_avx512_const *c)
+{
+	c->match_mask = _mm512_set1_epi32(RTE_ACL_NODE_MATCH);
+	c->index_mask = _mm512_set1_epi32(RTE_ACL_NODE_INDEX);
+	c->shuffle_input = _mm512_broadcast_i32x4(xmm_shuffle_input.x);
+	c->range_base = _mm512_broadcast_i32x4(xmm_range_base.x);
+	c->ones_16 = _mm512_set1_epi16(1);
+}
+
+/*
+ * Calculate the address of the next transition for 16 flows.
+ * Same algorithm as ACL_TR_CALC_ADDR(), but AVX512 comparisons produce
+ * masks instead of vectors, so the DFA/QUAD selection is done with
+ * mask operations.
+ */
+static __rte_always_inline __m512i
+calc_addr_avx512x16(const struct acl_avx512_const *c, __m512i next_input,
+	__m512i tr_lo, __m512i tr_hi)
+{
+	__mmask64 qm;
+	__mmask16 dfa_msk;
+	__m512i addr, in, node_type, r, t;
+	__m512i dfa_ofs, quad_ofs;
+
+	t = _mm512_setzero_si512();
+	in = _mm512_shuffle_epi8(next_input, c->shuffle_input);
+
+	/* Calc node type and node addr */
+	node_type = _mm512_andnot_si512(c->index_mask, tr_lo);
+	addr = _mm512_and_si512(c->index_mask, tr_lo);
+
+	/* mask for DFA type(0) nodes */
+	dfa_msk = _mm512_cmpeq_epi32_mask(node_type, t);
+
+	/* DFA calculations. */
+	r = _mm512_srli_epi32(in, 30);
+	r = _mm512_add_epi8(r, c->range_base);
+	t = _mm512_srli_epi32(in, 24);
+	r = _mm512_shuffle_epi8(tr_hi, r);
+
+	dfa_ofs = _mm512_sub_epi32(t, r);
+
+	/* QUAD/SINGLE calculations. */
+	qm = _mm512_cmpgt_epi8_mask(in, tr_hi);
+	t = _mm512_maskz_set1_epi8(qm, 1);
+	t = _mm512_maddubs_epi16(t, t);
+	quad_ofs = _mm512_madd_epi16(t, c->ones_16);
+
+	/* blend DFA and QUAD/SINGLE. */
+	t = _mm512_mask_mov_epi32(quad_ofs, dfa_msk, dfa_ofs);
+
+	/* calculate address for next transitions. */
+	return _mm512_add_epi32(addr, t);
+}
+
+/*
+ * Process 16 transitions in parallel.
+ * tr_lo contains low 32 bits for 16 transitions.
+ * tr_hi contains high 32 bits for 16 transitions.
+ * next_input contains up to 4 input bytes for 16 flows.
+ */
+static __rte_always_inline __m512i
+transition16(const struct acl_avx512_const *c, __m512i next_input,
+	const uint64_t *trans, __m512i *tr_lo, __m512i *tr_hi)
+{
+	const int32_t *tr;
+	__m512i addr;
+
+	tr = (const int32_t *)(uintptr_t)trans;
+
+	/* Calculate the address (array index) for all 16 transitions. */
+	addr = calc_addr_avx512x16(c, next_input, *tr_lo, *tr_hi);
+
+	/* load lower 32 bits of 16 transactions at once. */
+	*tr_lo = _mm512_i32gather_epi32(addr, tr, sizeof(trans[0]));
+
+	next_input = _mm512_srli_epi32(next_input, CHAR_BIT);
+
+	/* load high 32 bits of 16 transactions at once. */
+	*tr_hi = _mm512_i32gather_epi32(addr, tr + 1, sizeof(trans[0]));
+
+	return next_input;
+}
+
+/*
+ * Split 16 64-bit transitions into low and high 32-bit halves.
+ */
+static inline void
+acl_tr_hilo_avx512x16(const uint64_t tr[MAX_SEARCHES_AVX512X16],
+	__m512i *tr_lo, __m512i *tr_hi)
+{
+	__m512i t0, t1;
+
+	t0 = _mm512_loadu_si512(tr);
+	t1 = _mm512_loadu_si512(tr + MAX_SEARCHES_AVX512X16 / 2);
+
+	*tr_lo = _mm512_permutex2var_epi32(t0,
+		_mm512_loadu_si512(zmm_idx_lo), t1);
+	*tr_hi = _mm512_permutex2var_epi32(t0,
+		_mm512_loadu_si512(zmm_idx_hi), t1);
+}
+
+/*
+ * Process matches for 16 flows.
+ * Only flows with the bit set in *matches* are touched,
+ * transitions for all other flows are kept intact.
+ */
+static inline void
+acl_process_matches_avx512x16(const struct rte_acl_ctx *ctx,
+	struct parms *parms, struct acl_flow_data *flows, uint32_t slot,
+	uint32_t matches, __m512i *tr_lo, __m512i *tr_hi)
+{
+	uint32_t i;
+	uint64_t tr;
+	uint32_t lo[MAX_SEARCHES_AVX512X16], hi[MAX_SEARCHES_AVX512X16];
+
+	_mm512_storeu_si512(lo, *tr_lo);
+	_mm512_storeu_si512(hi, *tr_hi);
+
+	do {
+		i = __builtin_ctz(matches);
+		matches &= matches - 1;
+
+		tr = lo[i] | (uint64_t)hi[i] << 32;
+		tr = acl_match_check(tr, slot + i,
+			ctx, parms, flows, resolve_priority_sse);
+
+		lo[i] = (uint32_t)tr;
+		hi[i] = tr >> 32;
+	} while (matches != 0);
+
+	*tr_lo = _mm512_loadu_si512(lo);
+	*tr_hi = _mm512_loadu_si512(hi);
+}
+
+static inline void
+acl_match_check_avx512x16(const struct rte_acl_ctx *ctx, struct parms *parms,
+	struct acl_flow_data *flows, uint32_t slot,
+	__m512i *tr_lo, __m512i *tr_hi, __m512i match_mask)
+{
+	uint32_t msk;
+
+	/* test for match node */
+	msk = _mm512_test_epi32_mask(*tr_lo, match_mask);
+
+	while (msk != 0) {
+		acl_process_matches_avx512x16(ctx, parms, flows, slot,
+			msk, tr_lo, tr_hi);
+		msk = _mm512_test_epi32_mask(*tr_lo, match_mask);
+	}
+}
+
+/*
+ * Gather 4 bytes of input data for 16 flows.
+ */
+static __rte_always_inline __m512i
+acl_get_next_input_avx512x16(struct parms *parms, uint32_t slot)
+{
+	__m128i in[4];
+
+	in[0] = _mm_cvtsi32_si128(GET_NEXT_4BYTES(parms, slot + 0));
+	in[1] = _mm_cvtsi32_si128(GET_NEXT_4BYTES(parms, slot + 4));
+	in[2] = _mm_cvtsi32_si128(GET_NEXT_4BYTES(parms, slot + 8));
+	in[3] = _mm_cvtsi32_si128(GET_NEXT_4BYTES(parms, slot + 12));
+
+	in[0] = _mm_insert_epi32(in[0], GET_NEXT_4BYTES(parms, slot + 1), 1);
+	in[1] = _mm_insert_epi32(in[1], GET_NEXT_4BYTES(parms, slot + 5), 1);
+	in[2] = _mm_insert_epi32(in[2], GET_NEXT_4BYTES(parms, slot + 9), 1);
+	in[3] = _mm_insert_epi32(in[3], GET_NEXT_4BYTES(parms, slot + 13), 1);
+
+	in[0] = _mm_insert_epi32(in[0], GET_NEXT_4BYTES(parms, slot + 2), 2);
+	in[1] = _mm_insert_epi32(in[1], GET_NEXT_4BYTES(parms, slot + 6), 2);
+	in[2] = _mm_insert_epi32(in[2], GET_NEXT_4BYTES(parms, slot + 10), 2);
+	in[3] = _mm_insert_epi32(in[3], GET_NEXT_4BYTES(parms, slot + 14), 2);
+
+	in[0] = _mm_insert_epi32(in[0], GET_NEXT_4BYTES(parms, slot + 3), 3);
+	in[1] = _mm_insert_epi32(in[1], GET_NEXT_4BYTES(parms, slot + 7), 3);
+	in[2] = _mm_insert_epi32(in[2], GET_NEXT_4BYTES(parms, slot + 11), 3);
+	in[3] = _mm_insert_epi32(in[3], GET_NEXT_4BYTES(parms, slot + 15), 3);
+
+	return _mm512_inserti64x4(
+		_mm512_castsi256_si512(_mm256_set_m128i(in[1], in[0])),
+		_mm256_set_m128i(in[3], in[2]), 1);
+}
+
+/*
+ * Execute trie traversal for up to 16 flows in parallel.
+ */
+static inline int
+search_avx512x16(const struct rte_acl_ctx *ctx, const uint8_t **data,
+	uint32_t *results, uint32_t total_packets, uint32_t categories)
+{
+	uint32_t n;
+	struct acl_avx512_const c;
+	struct acl_flow_data flows;
+	uint64_t index_array[MAX_SEARCHES_AVX512X16];
+	struct completion cmplt[MAX_SEARCHES_AVX512X16];
+	struct parms parms[MAX_SEARCHES_AVX512X16];
+	__m512i input, tr_lo, tr_hi;
+
+	acl_avx512_const_init(&c);
+	acl_set_flow(&flows, cmplt, RTE_DIM(cmplt), data, results,
+		total_packets, categories, ctx->trans_table);
+
+	for (n = 0; n < RTE_DIM(cmplt); n++) {
+		cmplt[n].count = 0;
+		index_array[n] = acl_start_next_trie(&flows, parms, n, ctx);
+	}
+
+	acl_tr_hilo_avx512x16(index_array, &tr_lo, &tr_hi);
+
+	 /* Check for any matches. */
+	acl_match_check_avx512x16(ctx, parms, &flows, 0, &tr_lo, &tr_hi,
+		c.match_mask);
+
+	while (flows.started > 0) {
+
+		input = acl_get_next_input_avx512x16(parms, 0);
+
+		input = transition16(&c, input, flows.trans, &tr_lo, &tr_hi);
+		input = transition16(&c, input, flows.trans, &tr_lo, &tr_hi);
+		input = transition16(&c, input, flows.trans, &tr_lo, &tr_hi);
+		input = transition16(&c, input, flows.trans, &tr_lo, &tr_hi);
+
+		 /* Check for any matches. */
+		acl_match_check_avx512x16(ctx, parms, &flows, 0,
+			&tr_lo, &tr_hi, c.match_mask);
+	}
+
+	return 0;
+}
+
+/*
+ * Execute trie traversal for up to 32 flows in parallel.
+ * Two independent sets of 16 flows are interleaved to hide
+ * the latency of the gathers.
+ */
+static inline int
+search_avx512x32(const struct rte_acl_ctx *ctx, const uint8_t **data,
+	uint32_t *results, uint32_t total_packets, uint32_t categories)
+{
+	uint32_t n;
+	struct acl_avx512_const c;
+	struct acl_flow_data flows;
+	uint64_t index_array[MAX_SEARCHES_AVX512X32];
+	struct completion cmplt[MAX_SEARCHES_AVX512X32];
+	struct parms parms[MAX_SEARCHES_AVX512X32];
+	__m512i input[2], tr_lo[2], tr_hi[2];
+
+	acl_avx512_const_init(&c);
+	acl_set_flow(&flows, cmplt, RTE_DIM(cmplt), data, results,
+		total_packets, categories, ctx->trans_table);
+
+	for (n = 0; n < RTE_DIM(cmplt); n++) {
+		cmplt[n].count = 0;
+		index_array[n] = acl_start_next_trie(&flows, parms, n, ctx);
+	}
+
+	acl_tr_hilo_avx512x16(index_array, &tr_lo[0], &tr_hi[0]);
+	acl_tr_hilo_avx512x16(index_array + MAX_SEARCHES_AVX512X16,
+		&tr_lo[1], &tr_hi[1]);
+
+	 /* Check for any matches. */
+	acl_match_check_avx512x16(ctx, parms, &flows, 0, &tr_lo[0], &tr_hi[0],
+		c.match_mask);
+	acl_match_check_avx512x16(ctx, parms, &flows, MAX_SEARCHES_AVX512X16,
+		&tr_lo[1], &tr_hi[1], c.match_mask);
+
+	while (flows.started > 0) {
+
+		input[0] = acl_get_next_input_avx512x16(parms, 0);
+		input[1] = acl_get_next_input_avx512x16(parms,
+			MAX_SEARCHES_AVX512X16);
+
+		input[0] = transition16(&c, input[0], flows.trans,
+			&tr_lo[0], &tr_hi[0]);
+		input[1] = transition16(&c, input[1], flows.trans,
+			&tr_lo[1], &tr_hi[1]);
+
+		input[0] = transition16(&c, input[0], flows.trans,
+			&tr_lo[0], &tr_hi[0]);
+		input[1] = transition16(&c, input[1], flows.trans,
+			&tr_lo[1], &tr_hi[1]);
+
+		input[0] = transition16(&c, input[0], flows.trans,
+			&tr_lo[0], &tr_hi[0]);
+		input[1] = transition16(&c, input[1], flows.trans,
+			&tr_lo[1], &tr_hi[1]);
+
+		input[0] = transition16(&c, input[0], flows.trans,
+			&tr_lo[0], &tr_hi[0]);
+		input[1] = transition16(&c, input[1], flows.trans,
+			&tr_lo[1], &tr_hi[1]);
+
+		 /* Check for any matches. */
+		acl_match_check_avx512x16(ctx, parms, &flows, 0,
+			&tr_lo[0], &tr_hi[0], c.match_mask);
+		acl_match_check_avx512x16(ctx, parms, &flows,
+			MAX_SEARCHES_AVX512X16, &tr_lo[1], &tr_hi[1],
+			c.match_mask);
+	}
+
+	return 0;
+}
@@ -16,6 +16,32 @@ static struct rte_tailq_elem rte_acl_tailq = {
 };
 EAL_REGISTER_TAILQ(rte_acl_tailq)
 
+#ifndef CC_AVX512_SUPPORT
+/*
+ * If the compiler doesn't support AVX512 instructions,
+ * then the dummy ones would be used instead for AVX512 classify methods.
+ */
+int
+rte_acl_classify_avx512x16(__rte_unused const struct rte_acl_ctx *ctx,
+	__rte_unused const uint8_t **data,
+	__rte_unused uint32_t *results,
+	__rte_unused uint32_t num,
+	__rte_unused uint32_t categories)
+{
+	return -ENOTSUP;
+}
+
+int
+rte_acl_classify_avx512x32(__rte_unused const struct rte_acl_ctx *ctx,
+	__rte_unused const uint8_t **data,
+	__rte_unused uint32_t *results,
+	__rte_unused uint32_t num,
+	__rte_unused uint32_t categories)
+{
+	return -ENOTSUP;
+}
+#endif
+
 #ifndef RTE_ARCH_X86
 #ifndef CC_AVX2_SUPPORT
 /*
@@ -77,6 +103,8 @@ static const rte_acl_classify_t classify_fns[] = {
 	[RTE_ACL_CLASSIFY_AVX2] = rte_acl_classify_avx2,
 	[RTE_ACL_CLASSIFY_NEON] = rte_acl_classify_neon,
 	[RTE_ACL_CLASSIFY_ALTIVEC] = rte_acl_classify_altivec,
+	[RTE_ACL_CLASSIFY_AVX512X16] = rte_acl_classify_avx512x16,
+	[RTE_ACL_CLASSIFY_AVX512X32] = rte_acl_classify_avx512x32,
 };
 
 /* by default, use always available scalar code path. */
@@ -89,21 +117,80 @@ rte_acl_set_default_classify(enum rte_acl_classify_alg alg)
 	rte_acl_default_classify = alg;
 }
 
+/*
+ * Check that given classify method is supported both by the compiler
+ * (at build time) and by the target cpu (at run time).
+ */
+static int
+acl_check_alg(enum rte_acl_classify_alg alg)
+{
+	switch (alg) {
+	case RTE_ACL_CLASSIFY_AVX512X32:
+	case RTE_ACL_CLASSIFY_AVX512X16:
+#ifdef CC_AVX512_SUPPORT
+		if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) &&
+				rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW))
+			return 0;
+#endif
+		return -ENOTSUP;
+	case RTE_ACL_CLASSIFY_AVX2:
+#ifdef CC_AVX2_SUPPORT
+		if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2))
+			return 0;
+#endif
+		return -ENOTSUP;
+	case RTE_ACL_CLASSIFY_SSE:
+#ifdef RTE_ARCH_X86
+		if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_SSE4_1))
+			return 0;
+#endif
+		return -ENOTSUP;
+	case RTE_ACL_CLASSIFY_NEON:
+#if defined(RTE_ARCH_ARM64)
+		return 0;
+#elif defined(RTE_ARCH_ARM)
+		if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_NEON))
+			return 0;
+#endif
+		return -ENOTSUP;
+	case RTE_ACL_CLASSIFY_ALTIVEC:
+#if defined(RTE_ARCH_PPC_64)
+		return 0;
+#else
+		return -ENOTSUP;
+#endif
+	case RTE_ACL_CLASSIFY_DEFAULT:
+	case RTE_ACL_CLASSIFY_SCALAR:
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
 extern int
 rte_acl_set_ctx_classify(struct rte_acl_ctx *ctx, enum rte_acl_classify_alg alg)
 {
+	int32_t rc;
+
 	if (ctx == NULL || (uint32_t)alg >= RTE_DIM(classify_fns))
 		return -EINVAL;
 
+	if (alg == RTE_ACL_CLASSIFY_DEFAULT)
+		alg = rte_acl_default_classify;
+
+	rc = acl_check_alg(alg);
+	if (rc != 0)
+		return rc;
+
 	ctx->alg = alg;
 	return 0;
 }
 
 /*
  * Select highest available classify method as default one.
- * Note that CLASSIFY_AVX2 should be set as a default only
- * if both conditions are met:
- * at build time compiler supports AVX2 and target cpu supports AVX2.
+ * Note that a vector method (i.e. CLASSIFY_AVX512X32 or CLASSIFY_AVX2)
+ * should be set as a default only if both conditions are met:
+ * at build time compiler supports it and target cpu supports it.
  */
 RTE_INIT(rte_acl_init)
 {
@@ -117,15 +204,12 @@ RTE_INIT(rte_acl_init)
 #elif defined(RTE_ARCH_PPC_64)
 	alg = RTE_ACL_CLASSIFY_ALTIVEC;
 #else
-#ifdef CC_AVX2_SUPPORT
-	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2))
+	if (acl_check_alg(RTE_ACL_CLASSIFY_AVX512X32) == 0)
+		alg = RTE_ACL_CLASSIFY_AVX512X32;
+	else if (acl_check_alg(RTE_ACL_CLASSIFY_AVX2) == 0)
 		alg = RTE_ACL_CLASSIFY_AVX2;
-	else if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_SSE4_1))
-#else
-	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_SSE4_1))
-#endif
+	else if (acl_check_alg(RTE_ACL_CLASSIFY_SSE) == 0)
 		alg = RTE_ACL_CLASSIFY_SSE;
-
 #endif
 	rte_acl_set_default_classify(alg);
 }
@@ -512,21 +512,36 @@ static inline int
 __rte_bitmap_scan_read(struct rte_bitmap *bmp, uint32_t *pos, uint64_t *slab)
 {
 	uint64_t *slab2;
+	uint32_t index2, mask2, i;
 
-	slab2 = bmp->array2 + bmp->index2;
-	for ( ; bmp->go2 ; bmp->index2 ++, slab2 ++, bmp->go2 = bmp->index2 & RTE_BITMAP_CL_SLAB_MASK) {
-		if (*slab2) {
-			*pos = bmp->index2 << RTE_BITMAP_SLAB_BIT_SIZE_LOG2;
-			*slab = *slab2;
+	if (!bmp->go2)
+		return 0;
 
-			bmp->index2 ++;
-			slab2 ++;
-			bmp->go2 = bmp->index2 & RTE_BITMAP_CL_SLAB_MASK;
-			return 1;
-		}
+	/*
+	 * Build a mask of the non-empty slabs of the current array2 cache
+	 * line, so the next one is found with a single bit scan instead of a
+	 * data dependent branch per slab.
+	 */
+	index2 = bmp->index2 & ~RTE_BITMAP_CL_SLAB_MASK;
+	slab2 = bmp->array2 + index2;
+	mask2 = 0;
+	for (i = 0; i < RTE_BITMAP_CL_SLAB_SIZE; i ++)
+		mask2 |= (uint32_t)(slab2[i] != 0) << i;
+	mask2 &= ~0u << (bmp->index2 & RTE_BITMAP_CL_SLAB_MASK);
+
+	if (mask2 == 0) {
+		bmp->index2 = index2 + RTE_BITMAP_CL_SLAB_SIZE;
+		bmp->go2 = 0;
+		return 0;
 	}
 
-	return 0;
+	i = rte_bsf32(mask2);
+	*pos = (index2 + i) << RTE_BITMAP_SLAB_BIT_SIZE_LOG2;
+	*slab = slab2[i];
+
+	bmp->index2 = index2 + i + 1;
+	bmp->go2 = bmp->index2 & RTE_BITMAP_CL_SLAB_MASK;
+	return 1;
 }
 
 /**
@@ -14,6 +14,7 @@
 #include <rte_ethdev.h>
 #include <rte_log.h>
 #include <rte_malloc.h>
+#include <rte_mempool.h>
 #include <rte_service_component.h>
 #include <rte_thash.h>
 #include <rte_interrupts.h>
@@ -59,6 +60,31 @@ struct eth_rx_poll_entry {
 	uint16_t eth_rx_qid;
 };
 
+/*
+ * Event vector being filled with the mbufs of an Rx queue, it is linked in
+ * the adapter vector list while it holds mbufs
+ */
+struct eth_rx_vector_data {
+	TAILQ_ENTRY(eth_rx_vector_data) next;
+	/* Eth port and Rx queue the mbufs are received from */
+	uint16_t port;
+	uint16_t queue;
+	/* Vector size configured for the Rx queue */
+	uint16_t max_vector_count;
+	/* Event template of the vector events */
+	uint64_t event;
+	/* TSC timestamp of the first mbuf in the vector */
+	uint64_t ts;
+	/* Timeout after which a partial vector is enqueued */
+	uint64_t vector_timeout_ticks;
+	/* Mempool the vectors are allocated from */
+	struct rte_mempool *vector_pool;
+	/* Vector being filled, NULL if none */
+	struct rte_event_vector *vector_ev;
+};
+
+TAILQ_HEAD(eth_rx_vector_data_list, eth_rx_vector_data);
+
 /* Instance per adapter */
 struct rte_eth_event_enqueue_buffer {
 	/* Count of events in this buffer */
@@ -92,6 +118,8 @@ struct rte_event_eth_rx_adapter {
 	uint32_t wrr_pos;
 	/* Event burst buffer */
 	struct rte_eth_event_enqueue_buffer event_enqueue_buffer;
+	/* Event vectors holding mbufs, oldest first */
+	struct eth_rx_vector_data_list vector_list;
 	/* Per adapter stats */
 	struct rte_event_eth_rx_adapter_stats stats;
 	/* Block count, counts up to BLOCK_CNT_THRESHOLD */
@@ -201,6 +229,8 @@ struct eth_rx_queue_info {
 	uint16_t wt;		/* Polling weight */
 	uint32_t flow_id_mask;	/* Set to ~0 if app provides flow id else 0 */
 	uint64_t event;
+	int ena_vector;		/* True if mbufs are aggregated in vectors */
+	struct eth_rx_vector_data vector_data;
 };
 
 static struct rte_event_eth_rx_adapter **event_eth_rx_adapter;
@@ -742,6 +772,118 @@ rxa_flush_event_buffer(struct rte_event_eth_rx_adapter *rx_adapter)
 	return n;
 }
 
+static inline void
+rxa_init_vector(struct rte_event_eth_rx_adapter *rx_adapter,
+		struct eth_rx_vector_data *vec)
+{
+	vec->vector_ev->nb_elem = 0;
+	vec->vector_ev->port = vec->port;
+	vec->vector_ev->queue = vec->queue;
+	vec->vector_ev->attr_valid = 1;
+	vec->ts = rte_get_tsc_cycles();
+	TAILQ_INSERT_TAIL(&rx_adapter->vector_list, vec, next);
+}
+
+/* Aggregate mbufs in the Rx queue vector, returns the number of full vector
+ * events added to the event buffer
+ */
+static inline uint16_t
+rxa_create_event_vector(struct rte_event_eth_rx_adapter *rx_adapter,
+			struct eth_rx_queue_info *queue_info,
+			struct rte_eth_event_enqueue_buffer *buf,
+			struct rte_mbuf **mbufs, uint16_t num)
+{
+	struct rte_event *ev = &buf->events[buf->count];
+	struct eth_rx_vector_data *vec = &queue_info->vector_data;
+	struct rte_event_vector *vector;
+	uint16_t filled = 0;
+	uint16_t sz;
+
+	while (num) {
+		if (vec->vector_ev == NULL) {
+			if (unlikely(rte_mempool_get(vec->vector_pool,
+					(void **)&vec->vector_ev) < 0)) {
+				vec->vector_ev = NULL;
+				rte_pktmbuf_free_bulk(mbufs, num);
+				rx_adapter->stats.rx_dropped += num;
+				break;
+			}
+			rxa_init_vector(rx_adapter, vec);
+		}
+
+		vector = vec->vector_ev;
+		sz = RTE_MIN(num,
+			(uint16_t)(vec->max_vector_count - vector->nb_elem));
+		memcpy(&vector->mbufs[vector->nb_elem], mbufs,
+			sz * sizeof(mbufs[0]));
+		vector->nb_elem += sz;
+		mbufs += sz;
+		num -= sz;
+
+		if (vector->nb_elem == vec->max_vector_count) {
+			ev->event = vec->event;
+			ev->vec = vector;
+			ev++;
+			filled++;
+			vec->vector_ev = NULL;
+			TAILQ_REMOVE(&rx_adapter->vector_list, vec, next);
+		}
+	}
+
+	return filled;
+}
+
+/* Enqueue the vectors that have been waiting for more mbufs for too long */
+static void
+rxa_vector_expire(struct rte_event_eth_rx_adapter *rx_adapter)
+{
+	struct rte_eth_event_enqueue_buffer *buf =
+					&rx_adapter->event_enqueue_buffer;
+	struct eth_rx_vector_data *vec, *tmp;
+	uint64_t now = rte_get_tsc_cycles();
+	struct rte_event *ev;
+
+	for (vec = TAILQ_FIRST(&rx_adapter->vector_list); vec != NULL;
+			vec = tmp) {
+		tmp = TAILQ_NEXT(vec, next);
+		if (now - vec->ts < vec->vector_timeout_ticks)
+			continue;
+
+		if (buf->count == ETH_EVENT_BUFFER_SIZE) {
+			rxa_flush_event_buffer(rx_adapter);
+			if (buf->count == ETH_EVENT_BUFFER_SIZE)
+				break;
+		}
+
+		ev = &buf->events[buf->count++];
+		ev->event = vec->event;
+		ev->vec = vec->vector_ev;
+		vec->vector_ev = NULL;
+		TAILQ_REMOVE(&rx_adapter->vector_list, vec, next);
+	}
+
+	if (buf->count > 0)
+		rxa_flush_event_buffer(rx_adapter);
+}
+
+/* Drop the mbufs of the Rx queue vector and disable vectorization */
+static void
+rxa_vector_free(struct rte_event_eth_rx_adapter *rx_adapter,
+		struct eth_rx_queue_info *queue_info)
+{
+	struct eth_rx_vector_data *vec = &queue_info->vector_data;
+
+	if (vec->vector_ev != NULL) {
+		rx_adapter->stats.rx_dropped += vec->vector_ev->nb_elem;
+		rte_pktmbuf_free_bulk(vec->vector_ev->mbufs,
+				vec->vector_ev->nb_elem);
+		rte_mempool_put(vec->vector_pool, vec->vector_ev);
+		vec->vector_ev = NULL;
+		TAILQ_REMOVE(&rx_adapter->vector_list, vec, next);
+	}
+	queue_info->ena_vector = 0;
+}
+
 static inline void
 rxa_buffer_mbufs(struct rte_event_eth_rx_adapter *rx_adapter,
 		uint16_t eth_dev_id,
@@ -781,6 +923,12 @@ rxa_buffer_mbufs(struct rte_event_eth_rx_adapter *rx_adapter,
 		}
 	}
 
+	if (eth_rx_queue_info->ena_vector) {
+		buf->count += rxa_create_event_vector(rx_adapter,
+				eth_rx_queue_info, buf, mbufs, num);
+		return;
+	}
+
 	for (i = 0; i < num; i++) {
 		m = mbufs[i];
 
@@ -1151,6 +1299,8 @@ rxa_service_func(void *args)
 	stats = &rx_adapter->stats;
 	stats->rx_packets += rxa_intr_ring_dequeue(rx_adapter);
 	stats->rx_packets += rxa_poll(rx_adapter);
+	if (unlikely(!TAILQ_EMPTY(&rx_adapter->vector_list)))
+		rxa_vector_expire(rx_adapter);
 	rte_spinlock_unlock(&rx_adapter->rx_lock);
 	return 0;
 }
@@ -1677,6 +1827,7 @@ rxa_sw_del(struct rte_event_eth_rx_adapter *rx_adapter,
 	pollq = rxa_polled_queue(dev_info, rx_queue_id);
 	intrq = rxa_intr_queue(dev_info, rx_queue_id);
 	sintrq = rxa_shared_intr(dev_info, rx_queue_id);
+	rxa_vector_free(rx_adapter, &dev_info->rx_queue[rx_queue_id]);
 	rxa_update_queue(rx_adapter, dev_info, rx_queue_id, 0);
 	rx_adapter->num_rx_polled -= pollq;
 	dev_info->nb_rx_poll -= pollq;
@@ -1714,6 +1865,7 @@ rxa_add_queue(struct rte_event_eth_rx_adapter *rx_adapter,
 
 	queue_info = &dev_info->rx_queue[rx_queue_id];
 	queue_info->wt = conf->servicing_weight;
+	rxa_vector_free(rx_adapter, queue_info);
 
 	qi_ev = (struct rte_event *)&queue_info->event;
 	qi_ev->event = ev->event;
@@ -1993,6 +2145,7 @@ rte_event_eth_rx_adapter_create_ext(uint8_t id, uint8_t dev_id,
 		return -ENOMEM;
 	}
 	rte_spinlock_init(&rx_adapter->rx_lock);
+	TAILQ_INIT(&rx_adapter->vector_list);
 	for (i = 0; i < RTE_MAX_ETHPORTS; i++)
 		rx_adapter->eth_devices[i].dev = &rte_eth_devices[i];
 
@@ -2419,3 +2572,115 @@ rte_event_eth_rx_adapter_cb_register(uint8_t id,
 
 	return 0;
 }
+
+static void
+rxa_set_vector_data(struct rte_event_eth_rx_adapter *rx_adapter,
+		struct eth_device_info *dev_info,
+		uint16_t eth_dev_id, int32_t rx_queue_id,
+		const struct rte_event_eth_rx_adapter_event_vector_config *config)
+{
+	struct eth_rx_queue_info *queue_info;
+	struct eth_rx_vector_data *vec;
+	struct rte_event *ev;
+	uint32_t flow_id;
+
+	if (rx_queue_id == -1) {
+		uint16_t i;
+
+		for (i = 0; i < dev_info->dev->data->nb_rx_queues; i++)
+			if (dev_info->rx_queue[i].queue_enabled)
+				rxa_set_vector_data(rx_adapter, dev_info,
+						eth_dev_id, i, config);
+		return;
+	}
+
+	queue_info = &dev_info->rx_queue[rx_queue_id];
+	rxa_vector_free(rx_adapter, queue_info);
+
+	vec = &queue_info->vector_data;
+	vec->port = eth_dev_id;
+	vec->queue = rx_queue_id;
+	vec->max_vector_count = config->vector_sz;
+	vec->vector_pool = config->vector_mp;
+	vec->vector_timeout_ticks = config->vector_timeout_ns *
+		rte_get_tsc_hz() / NS_PER_S;
+
+	/* Without an application flow ID, use one flow per Rx queue */
+	vec->event = queue_info->event;
+	ev = (struct rte_event *)&vec->event;
+	if (queue_info->flow_id_mask == 0) {
+		flow_id = (rx_queue_id & 0xFFF) | (eth_dev_id & 0xFF) << 12;
+		ev->flow_id = flow_id;
+	}
+	ev->event_type = RTE_EVENT_TYPE_ETH_RX_ADAPTER_VECTOR;
+
+	queue_info->ena_vector = 1;
+}
+
+int
+rte_event_eth_rx_adapter_queue_event_vector_config(uint8_t id,
+		uint16_t eth_dev_id, int32_t rx_queue_id,
+		const struct rte_event_eth_rx_adapter_event_vector_config *config)
+{
+	struct rte_event_eth_rx_adapter *rx_adapter;
+	struct eth_device_info *dev_info;
+	uint32_t elt_cap;
+	uint32_t cap;
+	int ret;
+
+	RTE_EVENT_ETH_RX_ADAPTER_ID_VALID_OR_ERR_RET(id, -EINVAL);
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(eth_dev_id, -EINVAL);
+
+	rx_adapter = rxa_id_to_adapter(id);
+	if (rx_adapter == NULL || config == NULL)
+		return -EINVAL;
+
+	ret = rte_event_eth_rx_adapter_caps_get(rx_adapter->eventdev_id,
+						eth_dev_id,
+						&cap);
+	if (ret) {
+		RTE_EDEV_LOG_ERR("Failed to get adapter caps edev %" PRIu8
+			"eth port %" PRIu16, id, eth_dev_id);
+		return ret;
+	}
+
+	if (cap & RTE_EVENT_ETH_RX_ADAPTER_CAP_INTERNAL_PORT) {
+		RTE_EDEV_LOG_ERR("Event vectorization not supported for eth"
+				" port %" PRIu16, eth_dev_id);
+		return -ENOTSUP;
+	}
+
+	if (config->vector_sz == 0 || config->vector_timeout_ns == 0 ||
+			config->vector_mp == NULL) {
+		RTE_EDEV_LOG_ERR("Invalid event vector configuration");
+		return -EINVAL;
+	}
+
+	elt_cap = (config->vector_mp->elt_size -
+			sizeof(struct rte_event_vector)) / sizeof(void *);
+	if (config->vector_mp->elt_size < sizeof(struct rte_event_vector) ||
+			elt_cap < config->vector_sz) {
+		RTE_EDEV_LOG_ERR("Event vector mempool element too small for"
+				" %" PRIu16 " mbufs", config->vector_sz);
+		return -EINVAL;
+	}
+
+	dev_info = &rx_adapter->eth_devices[eth_dev_id];
+	if (dev_info->rx_queue == NULL)
+		return -EINVAL;
+
+	if (rx_queue_id != -1 && ((uint16_t)rx_queue_id >=
+			dev_info->dev->data->nb_rx_queues ||
+			!dev_info->rx_queue[rx_queue_id].queue_enabled)) {
+		RTE_EDEV_LOG_ERR("Rx queue %" PRId32 " not added to adapter",
+				rx_queue_id);
+		return -EINVAL;
+	}
+
+	rte_spinlock_lock(&rx_adapter->rx_lock);
+	rxa_set_vector_data(rx_adapter, dev_info, eth_dev_id, rx_queue_id,
+			config);
+	rte_spinlock_unlock(&rx_adapter->rx_lock);
+
+	return 0;
+}
@@ -37,6 +37,7 @@
  *  - rte_event_eth_rx_adapter_stop()
  *  - rte_event_eth_rx_adapter_stats_get()
  *  - rte_event_eth_rx_adapter_stats_reset()
+ *  - rte_event_eth_rx_adapter_queue_event_vector_config()
  *
  * The application creates an ethernet to event adapter using
  * rte_event_eth_rx_adapter_create_ext() or rte_event_eth_rx_adapter_create()
@@ -77,6 +78,15 @@
  * allows the application to register a callback that selects which packets are
  * enqueued to the event device by the SW adapter. The callback interface is
  * event based so the callback can also modify the event data if it needs to.
+ *
+ * When the RTE_EVENT_ETH_RX_ADAPTER_CAP_EVENT_VECTOR capability is set, the
+ * application can use rte_event_eth_rx_adapter_queue_event_vector_config() to
+ * have the adapter aggregate the mbufs received from an Rx queue into event
+ * vectors, see struct rte_event_vector. A vector event is enqueued once the
+ * vector holds the configured number of mbufs, or once the configured timeout
+ * has elapsed since its first mbuf was received, whichever comes first. This
+ * reduces the number of events scheduled by the event device to one per
+ * vector.
  */
 
 #ifdef __cplusplus
@@ -173,6 +183,27 @@ struct rte_event_eth_rx_adapter_queue_conf {
 	 */
 };
 
+/**
+ * Rx queue event vector configuration structure
+ */
+struct rte_event_eth_rx_adapter_event_vector_config {
+	uint16_t vector_sz;
+	/**< Maximum number of mbufs to aggregate in a single event vector.
+	 * The event vectors are enqueued with ev.event_type set to
+	 * RTE_EVENT_TYPE_ETH_RX_ADAPTER_VECTOR.
+	 */
+	uint64_t vector_timeout_ns;
+	/**< Maximum number of nanoseconds to wait for aggregating mbufs, a
+	 * partially filled event vector is enqueued once this timeout elapses
+	 * after its first mbuf was received.
+	 */
+	struct rte_mempool *vector_mp;
+	/**< Mempool the event vectors are allocated from, its elements must
+	 * be able to hold vector_sz mbufs.
+	 * @see rte_event_vector_pool_create()
+	 */
+};
+
 /**
  * A structure used to retrieve statistics for an eth rx adapter instance.
  */
@@ -471,6 +502,45 @@ int rte_event_eth_rx_adapter_cb_register(uint8_t id, uint16_t eth_dev_id,
 					 rte_event_eth_rx_adapter_cb_fn cb_fn,
 					 void *cb_arg);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Configure event vectorization for a given ethernet device Rx queue, this
+ * is supported for SW based packet transfers.
+ *
+ * The Rx queue must have been added to the adapter with
+ * rte_event_eth_rx_adapter_queue_add(). The vectorization is disabled again
+ * when the Rx queue is added again or deleted from the adapter.
+ *
+ * The mbufs of a vector event all belong to the same Rx queue, the vector
+ * has its port and queue attributes set accordingly. Unless the
+ * RTE_EVENT_ETH_RX_ADAPTER_QUEUE_FLOW_ID_VALID flag was used when adding the
+ * Rx queue, the flow ID of the vector events is derived from the ethernet
+ * port and queue identifiers. The Rx callback registered with
+ * rte_event_eth_rx_adapter_cb_register() is not invoked for vector events.
+ *
+ * @param id
+ *  Adapter identifier.
+ * @param eth_dev_id
+ *  Port identifier of Ethernet device.
+ * @param rx_queue_id
+ *  Ethernet device receive queue index.
+ *  If rx_queue_id is -1, then all Rx queues configured for the ethernet
+ *  device are configured.
+ * @param config
+ *  Event vector configuration structure.
+ * @return
+ *  - 0: Success
+ *  - -ENOTSUP: Event vectorization is not supported for this ethernet
+ *    device.
+ *  - <0: Error code on failure.
+ */
+__rte_experimental
+int rte_event_eth_rx_adapter_queue_event_vector_config(uint8_t id,
+		uint16_t eth_dev_id, int32_t rx_queue_id,
+		const struct rte_event_eth_rx_adapter_event_vector_config *config);
+
 #ifdef __cplusplus
 }
 #endif
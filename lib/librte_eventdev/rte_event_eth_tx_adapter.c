@@ -510,12 +510,52 @@ txa_service_buffer_retry(struct rte_mbuf **pkts, uint16_t unsent,
 	stats->tx_dropped += unsent - sent;
 }
 
+/* Transmit the mbufs of an event vector and free the vector */
+static uint16_t
+txa_process_event_vector(struct txa_service_data *txa,
+	struct rte_event_vector *vec)
+{
+	struct txa_service_queue_info *tqi;
+	uint16_t port, queue, nb_tx = 0;
+	struct rte_mbuf **mbufs;
+	uint16_t i;
+
+	mbufs = vec->mbufs;
+	if (vec->attr_valid) {
+		port = vec->port;
+		queue = vec->queue;
+		tqi = txa_service_queue(txa, port, queue);
+		if (unlikely(tqi == NULL || !tqi->added)) {
+			rte_pktmbuf_free_bulk(mbufs, vec->nb_elem);
+		} else {
+			for (i = 0; i < vec->nb_elem; i++)
+				nb_tx += rte_eth_tx_buffer(port, queue,
+						tqi->tx_buf, mbufs[i]);
+		}
+	} else {
+		for (i = 0; i < vec->nb_elem; i++) {
+			port = mbufs[i]->port;
+			queue = rte_event_eth_tx_adapter_txq_get(mbufs[i]);
+			tqi = txa_service_queue(txa, port, queue);
+			if (unlikely(tqi == NULL || !tqi->added)) {
+				rte_pktmbuf_free(mbufs[i]);
+				continue;
+			}
+			nb_tx += rte_eth_tx_buffer(port, queue, tqi->tx_buf,
+					mbufs[i]);
+		}
+	}
+
+	rte_mempool_put(rte_mempool_from_obj(vec), vec);
+	return nb_tx;
+}
+
 static void
 txa_service_tx(struct txa_service_data *txa, struct rte_event *ev,
 	uint32_t n)
 {
 	uint32_t i;
-	uint16_t nb_tx;
+	uint32_t nb_tx;
 	struct rte_event_eth_tx_adapter_stats *stats;
 
 	stats = &txa->stats;
@@ -527,6 +567,11 @@ txa_service_tx(struct txa_service_data *txa, struct rte_event *ev,
 		uint16_t queue;
 		struct txa_service_queue_info *tqi;
 
+		if (unlikely(ev[i].event_type & RTE_EVENT_TYPE_VECTOR)) {
+			nb_tx += txa_process_event_vector(txa, ev[i].vec);
+			continue;
+		}
+
 		m = ev[i].mbuf;
 		port = m->port;
 		queue = rte_event_eth_tx_adapter_txq_get(m);
@@ -68,6 +68,13 @@
  * and rte_event_eth_tx_adapter_txq_get() functions to access the transmit
  * queue index, using these macros will help with minimizing application
  * impact due to a change in how the transmit queue index is specified.
+ *
+ * The common implementation also transmits vector events, i.e. events whose
+ * event_type has RTE_EVENT_TYPE_VECTOR set. If the attr_valid bit of the
+ * struct rte_event_vector is set, all its mbufs are transmitted on the
+ * vector port and queue, else each mbuf is transmitted on its own port and
+ * transmit queue as above. The adapter returns the vector to its mempool once
+ * its mbufs have been transmitted.
  */
 
 #ifdef __cplusplus
@@ -36,6 +36,7 @@ RTE_LOG_REGISTER(evtim_svc_logtype, lib.eventdev.adapter.timer.svc, NOTICE);
 static struct rte_event_timer_adapter adapters[RTE_EVENT_TIMER_ADAPTER_NUM_MAX];
 
 static const struct rte_event_timer_adapter_ops swtim_ops;
+static const struct rte_event_timer_adapter_ops swwheel_ops;
 
 #define EVTIM_LOG(level, logtype, ...) \
 	rte_log(RTE_LOG_ ## level, logtype, \
@@ -57,6 +58,15 @@ static const struct rte_event_timer_adapter_ops swtim_ops;
 #define EVTIM_SVC_LOG_DBG(...) (void)0
 #endif
 
+static const struct rte_event_timer_adapter_ops *
+sw_adapter_ops(uint64_t flags)
+{
+	if (flags & RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL)
+		return &swwheel_ops;
+
+	return &swtim_ops;
+}
+
 static int
 default_port_conf_cb(uint16_t id, uint8_t event_dev_id, uint8_t *event_port_id,
 		     void *conf_arg)
@@ -212,7 +222,7 @@ rte_event_timer_adapter_create_ext(
 	 * implementation.
 	 */
 	if (adapter->ops == NULL)
-		adapter->ops = &swtim_ops;
+		adapter->ops = sw_adapter_ops(adapter->data->conf.flags);
 
 	/* Allow driver to do some setup */
 	FUNC_PTR_OR_NULL_RET_WITH_ERRNO(adapter->ops->init, ENOTSUP);
@@ -343,7 +353,7 @@ rte_event_timer_adapter_lookup(uint16_t adapter_id)
 	 * implementation.
 	 */
 	if (adapter->ops == NULL)
-		adapter->ops = &swtim_ops;
+		adapter->ops = sw_adapter_ops(adapter->data->conf.flags);
 
 	/* Set fast-path function pointers */
 	adapter->arm_burst = adapter->ops->arm_burst;
@@ -1219,3 +1229,728 @@ static const struct rte_event_timer_adapter_ops swtim_ops = {
 	.arm_tmo_tick_burst	= swtim_arm_tmo_tick_burst,
 	.cancel_burst		= swtim_cancel_burst,
 };
+
+/*
+ * Timer wheel based software event timer adapter implementation
+ *
+ * Every lcore arming timers gets its own hierarchical timer wheel. Arming
+ * takes a node from a mempool and pushes it, along with the rest of the
+ * burst, on the wheel's pending stack with a single compare-and-swap. The
+ * service is the only thread touching the wheel slots: it places the pending
+ * nodes, cascades them down the levels as time advances, and expires the
+ * nodes of the current slot in one go. Cancelling clears the node's timer
+ * pointer with a compare-and-swap, racing with the service doing the same on
+ * expiry; the node itself is left in the wheel and freed when its slot
+ * expires.
+ */
+
+#define SWWHEEL_LEVEL_BITS 8
+#define SWWHEEL_LEVEL_SLOTS (1 << SWWHEEL_LEVEL_BITS)
+#define SWWHEEL_LEVEL_MASK (SWWHEEL_LEVEL_SLOTS - 1)
+/* 4 levels of 256 slots cover 2^32 ticks, timers further out than that are
+ * kept in an overflow list revisited every 2^32 ticks.
+ */
+#define SWWHEEL_LEVELS 4
+
+struct swwheel_node {
+	struct swwheel_node *next;
+	/* Cleared by whichever of cancel and expiry gets to it first */
+	struct rte_event_timer *evtim;
+	/* Adapter tick the timer expires at */
+	uint64_t expiry_tick;
+};
+
+struct swwheel_wheel {
+	/* Nodes armed on this lcore, not yet placed in a slot. Pushed to by
+	 * the arming threads, and taken as a whole by the service.
+	 */
+	struct swwheel_node *pending __rte_cache_aligned;
+	/* The fields below are only accessed by the service */
+	uint64_t cur_tick __rte_cache_aligned;
+	/* Number of nodes in the slots, due and overflow lists */
+	uint64_t nb_nodes;
+	/* Nodes at or past their expiry tick, not yet expired */
+	struct swwheel_node *due;
+	struct swwheel_node *overflow;
+	struct swwheel_node *slots[SWWHEEL_LEVELS][SWWHEEL_LEVEL_SLOTS];
+};
+
+struct swwheel {
+	/* Identifier of service executing timer management logic. */
+	uint32_t service_id;
+	/* The tick resolution used by adapter instance. */
+	uint64_t timer_tick_ns;
+	/* Maximum timeout in nanoseconds allowed by adapter instance. */
+	uint64_t max_tmo_ns;
+	/* Timer cycles per adapter tick */
+	uint64_t cycles_per_tick;
+	/* The adapter tick the service last ran at */
+	uint64_t last_tick;
+	/* Buffered timer expiry events to be enqueued to an event device. */
+	struct event_buffer buffer;
+	/* Statistics */
+	struct rte_event_timer_adapter_stats stats;
+	/* Mempool of wheel nodes */
+	struct rte_mempool *node_pool;
+	/* Back pointer for convenience */
+	struct rte_event_timer_adapter *adapter;
+	/* Track which cores have actually armed a timer */
+	struct {
+		uint16_t v;
+	} __rte_cache_aligned in_use[RTE_MAX_LCORE];
+	/* Track which cores' wheels should be polled */
+	unsigned int poll_lcores[RTE_MAX_LCORE];
+	/* The number of wheels that should be polled */
+	int n_poll_lcores;
+	/* Nodes which have expired and can be returned to the mempool */
+	struct swwheel_node *expired_nodes[EXP_TIM_BUF_SZ];
+	/* The number of nodes that can be returned to the mempool */
+	size_t n_expired_nodes;
+	struct swwheel_wheel wheels[RTE_MAX_LCORE];
+};
+
+static inline struct swwheel *
+swwheel_pmd_priv(const struct rte_event_timer_adapter *adapter)
+{
+	return adapter->data->adapter_priv;
+}
+
+static __rte_always_inline uint64_t
+swwheel_cur_tick(const struct swwheel *sw)
+{
+	return rte_get_timer_cycles() / sw->cycles_per_tick;
+}
+
+/* Round up, so that timers armed in the middle of a tick never expire early */
+static __rte_always_inline uint64_t
+swwheel_next_tick(const struct swwheel *sw)
+{
+	uint64_t cycles = rte_get_timer_cycles();
+
+	return (cycles + sw->cycles_per_tick - 1) / sw->cycles_per_tick;
+}
+
+static void
+swwheel_flush_buffer(struct swwheel *sw)
+{
+	struct rte_event_timer_adapter *adapter = sw->adapter;
+	uint16_t nb_evs_flushed = 0;
+	uint16_t nb_evs_invalid = 0;
+
+	event_buffer_flush(&sw->buffer,
+			   adapter->data->event_dev_id,
+			   adapter->data->event_port_id,
+			   &nb_evs_flushed,
+			   &nb_evs_invalid);
+
+	sw->stats.ev_enq_count += nb_evs_flushed;
+	sw->stats.ev_inv_count += nb_evs_invalid;
+}
+
+static __rte_always_inline void
+swwheel_free_node(struct swwheel *sw, struct swwheel_node *node)
+{
+	if (unlikely(sw->n_expired_nodes == EXP_TIM_BUF_SZ)) {
+		rte_mempool_put_bulk(sw->node_pool,
+				     (void **)sw->expired_nodes,
+				     sw->n_expired_nodes);
+		sw->n_expired_nodes = 0;
+	}
+
+	sw->expired_nodes[sw->n_expired_nodes++] = node;
+}
+
+/* Put a node in the slot of the lowest level where it does not share the
+ * current slot, i.e. the slot that is cascaded or expired first once time
+ * reaches the node's expiry tick.
+ */
+static __rte_always_inline void
+swwheel_place(struct swwheel_wheel *w, struct swwheel_node *node)
+{
+	uint64_t expiry = node->expiry_tick;
+	uint64_t cur = w->cur_tick;
+	struct swwheel_node **list;
+	unsigned int level;
+
+	if (expiry <= cur)
+		list = &w->due;
+	else {
+		for (level = 0; level < SWWHEEL_LEVELS; level++)
+			if ((expiry >> ((level + 1) * SWWHEEL_LEVEL_BITS)) ==
+			    (cur >> ((level + 1) * SWWHEEL_LEVEL_BITS)))
+				break;
+
+		if (level == SWWHEEL_LEVELS)
+			list = &w->overflow;
+		else
+			list = &w->slots[level][(expiry >>
+				(level * SWWHEEL_LEVEL_BITS)) &
+				SWWHEEL_LEVEL_MASK];
+	}
+
+	node->next = *list;
+	*list = node;
+}
+
+static __rte_always_inline void
+swwheel_place_list(struct swwheel_wheel *w, struct swwheel_node *node)
+{
+	while (node != NULL) {
+		struct swwheel_node *next = node->next;
+
+		swwheel_place(w, node);
+		node = next;
+	}
+}
+
+/* Expire the nodes of a list, buffering up the expiry events of the timers
+ * that were not cancelled. Returns false, leaving the remaining nodes in the
+ * list, if the event buffer cannot be drained into the event device.
+ */
+static bool
+swwheel_expire(struct swwheel *sw, struct swwheel_wheel *w,
+	       struct swwheel_node **list)
+{
+	struct swwheel_node *node;
+
+	while ((node = *list) != NULL) {
+		struct rte_event_timer *evtim;
+
+		if (unlikely(event_buffer_full(&sw->buffer))) {
+			swwheel_flush_buffer(sw);
+			if (event_buffer_full(&sw->buffer)) {
+				sw->stats.evtim_retry_count++;
+				return false;
+			}
+		}
+
+		*list = node->next;
+
+		evtim = __atomic_exchange_n(&node->evtim, NULL,
+					    __ATOMIC_ACQ_REL);
+		if (evtim != NULL) {
+			event_buffer_add(&sw->buffer, &evtim->ev);
+			sw->stats.evtim_exp_count++;
+
+			__atomic_store_n(&evtim->state,
+					 RTE_EVENT_TIMER_NOT_ARMED,
+					 __ATOMIC_RELEASE);
+		}
+
+		swwheel_free_node(sw, node);
+		w->nb_nodes--;
+
+		if (event_buffer_batch_ready(&sw->buffer))
+			swwheel_flush_buffer(sw);
+	}
+
+	return true;
+}
+
+static __rte_always_inline struct swwheel_node *
+swwheel_take(struct swwheel_node **list)
+{
+	struct swwheel_node *head = *list;
+
+	*list = NULL;
+	return head;
+}
+
+static void
+swwheel_run(struct swwheel *sw, struct swwheel_wheel *w, uint64_t now)
+{
+	struct swwheel_node *pending, *node;
+	unsigned int level;
+
+	pending = __atomic_exchange_n(&w->pending, NULL, __ATOMIC_ACQUIRE);
+	for (node = pending; node != NULL; node = node->next)
+		w->nb_nodes++;
+	swwheel_place_list(w, pending);
+
+	if (w->due != NULL && !swwheel_expire(sw, w, &w->due))
+		return;
+
+	while (w->cur_tick < now) {
+		struct swwheel_node *slot;
+		uint64_t cur;
+
+		/* Nothing to cascade or expire, skip ahead */
+		if (w->nb_nodes == 0) {
+			w->cur_tick = now;
+			break;
+		}
+
+		cur = ++w->cur_tick;
+
+		/* Moving into a new slot of a level above, spread the nodes
+		 * of that slot over the levels below.
+		 */
+		for (level = 1; level <= SWWHEEL_LEVELS; level++) {
+			if (cur & ((1ULL << (level * SWWHEEL_LEVEL_BITS)) - 1))
+				break;
+
+			if (level == SWWHEEL_LEVELS)
+				node = swwheel_take(&w->overflow);
+			else
+				node = swwheel_take(&w->slots[level][(cur >>
+					(level * SWWHEEL_LEVEL_BITS)) &
+					SWWHEEL_LEVEL_MASK]);
+
+			swwheel_place_list(w, node);
+		}
+
+		slot = swwheel_take(&w->slots[0][cur & SWWHEEL_LEVEL_MASK]);
+		if (!swwheel_expire(sw, w, &slot)) {
+			/* Retry what is left on the next run */
+			while (slot != NULL) {
+				node = slot->next;
+				slot->next = w->due;
+				w->due = slot;
+				slot = node;
+			}
+			return;
+		}
+
+		/* Nodes cascaded right onto their expiry tick */
+		if (w->due != NULL && !swwheel_expire(sw, w, &w->due))
+			return;
+	}
+}
+
+static int
+swwheel_service_func(void *arg)
+{
+	struct rte_event_timer_adapter *adapter = arg;
+	struct swwheel *sw = swwheel_pmd_priv(adapter);
+	uint64_t now = swwheel_cur_tick(sw);
+	int i, n_poll_lcores;
+
+	n_poll_lcores = __atomic_load_n(&sw->n_poll_lcores, __ATOMIC_ACQUIRE);
+	for (i = 0; i < n_poll_lcores; i++) {
+		unsigned int lcore = __atomic_load_n(&sw->poll_lcores[i],
+						     __ATOMIC_RELAXED);
+
+		swwheel_run(sw, &sw->wheels[lcore], now);
+	}
+
+	/* Return expired nodes back to mempool */
+	rte_mempool_put_bulk(sw->node_pool, (void **)sw->expired_nodes,
+			     sw->n_expired_nodes);
+	sw->n_expired_nodes = 0;
+
+	swwheel_flush_buffer(sw);
+
+	if (now != sw->last_tick) {
+		sw->last_tick = now;
+		sw->stats.adapter_tick_count++;
+	}
+
+	return 0;
+}
+
+static int
+swwheel_init(struct rte_event_timer_adapter *adapter)
+{
+	struct rte_service_spec service;
+	char name[SWTIM_NAMESIZE];
+	struct swwheel *sw;
+	uint64_t nb_nodes;
+	uint64_t now;
+	int cache_size;
+	int i, ret;
+
+	snprintf(name, SWTIM_NAMESIZE, "swwheel_%"PRIu8, adapter->data->id);
+	sw = rte_zmalloc_socket(name, sizeof(*sw), RTE_CACHE_LINE_SIZE,
+			adapter->data->socket_id);
+	if (sw == NULL) {
+		EVTIM_LOG_ERR("failed to allocate space for private data");
+		rte_errno = ENOMEM;
+		return -1;
+	}
+
+	/* Connect storage to adapter instance */
+	adapter->data->adapter_priv = sw;
+	sw->adapter = adapter;
+
+	sw->timer_tick_ns = adapter->data->conf.timer_tick_ns;
+	sw->max_tmo_ns = adapter->data->conf.max_tmo_ns;
+	/* Multiply first and round up, so that a tick is never shorter */
+	sw->cycles_per_tick = RTE_MAX((uint64_t)1,
+			(sw->timer_tick_ns * rte_get_timer_hz() +
+			 (uint64_t)NSECPERSEC - 1) / (uint64_t)NSECPERSEC);
+
+	/* Create a node pool, sized as the timer pool of the skiplist based
+	 * implementation.
+	 */
+	snprintf(name, SWTIM_NAMESIZE, "swwheel_pool_%"PRIu8,
+		 adapter->data->id);
+	nb_nodes = rte_align64pow2(adapter->data->conf.nb_timers);
+	cache_size = compute_msg_mempool_cache_size(
+				adapter->data->conf.nb_timers, nb_nodes);
+	sw->node_pool = rte_mempool_create(name, nb_nodes - 1,
+			sizeof(struct swwheel_node), cache_size, 0, NULL, NULL,
+			NULL, NULL, adapter->data->socket_id, 0);
+	if (sw->node_pool == NULL) {
+		EVTIM_LOG_ERR("failed to create wheel node mempool");
+		rte_errno = ENOMEM;
+		goto free_alloc;
+	}
+
+	now = swwheel_cur_tick(sw);
+	for (i = 0; i < RTE_MAX_LCORE; i++)
+		sw->wheels[i].cur_tick = now;
+	sw->last_tick = now;
+
+	/* Initialize timer event buffer */
+	event_buffer_init(&sw->buffer);
+
+	/* Register a service component to run adapter logic */
+	memset(&service, 0, sizeof(service));
+	snprintf(service.name, RTE_SERVICE_NAME_MAX,
+		 "swwheel_svc_%"PRIu8, adapter->data->id);
+	service.socket_id = adapter->data->socket_id;
+	service.callback = swwheel_service_func;
+	service.callback_userdata = adapter;
+	service.capabilities &= ~(RTE_SERVICE_CAP_MT_SAFE);
+	ret = rte_service_component_register(&service, &sw->service_id);
+	if (ret < 0) {
+		EVTIM_LOG_ERR("failed to register service %s with id %"PRIu32
+			      ": err = %d", service.name, sw->service_id,
+			      ret);
+
+		rte_errno = ENOSPC;
+		goto free_mempool;
+	}
+
+	EVTIM_LOG_DBG("registered service %s with id %"PRIu32, service.name,
+		      sw->service_id);
+
+	adapter->data->service_id = sw->service_id;
+	adapter->data->service_inited = 1;
+
+	return 0;
+free_mempool:
+	rte_mempool_free(sw->node_pool);
+free_alloc:
+	rte_free(sw);
+	return -1;
+}
+
+/* Outstanding nodes all live in the node mempool, so there is no need to
+ * walk the wheels before freeing it.
+ */
+static int
+swwheel_uninit(struct rte_event_timer_adapter *adapter)
+{
+	struct swwheel *sw = swwheel_pmd_priv(adapter);
+	int ret;
+
+	ret = rte_service_component_unregister(sw->service_id);
+	if (ret < 0) {
+		EVTIM_LOG_ERR("failed to unregister service component");
+		return ret;
+	}
+
+	rte_mempool_free(sw->node_pool);
+	rte_free(sw);
+	adapter->data->adapter_priv = NULL;
+
+	return 0;
+}
+
+static int
+swwheel_start(const struct rte_event_timer_adapter *adapter)
+{
+	struct swwheel *sw = swwheel_pmd_priv(adapter);
+	int mapped_count;
+
+	/* The wheels are owned by the service, so only one core may run it */
+	mapped_count = get_mapped_count_for_service(sw->service_id);
+
+	if (mapped_count != 1)
+		return mapped_count < 1 ? -ENOENT : -ENOTSUP;
+
+	return rte_service_component_runstate_set(sw->service_id, 1);
+}
+
+static int
+swwheel_stop(const struct rte_event_timer_adapter *adapter)
+{
+	struct swwheel *sw = swwheel_pmd_priv(adapter);
+	int ret;
+
+	ret = rte_service_component_runstate_set(sw->service_id, 0);
+	if (ret < 0)
+		return ret;
+
+	/* Wait for the service to complete its final iteration */
+	while (rte_service_may_be_active(sw->service_id))
+		rte_pause();
+
+	return 0;
+}
+
+static void
+swwheel_get_info(const struct rte_event_timer_adapter *adapter,
+		 struct rte_event_timer_adapter_info *adapter_info)
+{
+	struct swwheel *sw = swwheel_pmd_priv(adapter);
+
+	adapter_info->min_resolution_ns = sw->timer_tick_ns;
+	adapter_info->max_tmo_ns = sw->max_tmo_ns;
+}
+
+static int
+swwheel_stats_get(const struct rte_event_timer_adapter *adapter,
+		  struct rte_event_timer_adapter_stats *stats)
+{
+	struct swwheel *sw = swwheel_pmd_priv(adapter);
+
+	*stats = sw->stats; /* structure copy */
+	return 0;
+}
+
+static int
+swwheel_stats_reset(const struct rte_event_timer_adapter *adapter)
+{
+	struct swwheel *sw = swwheel_pmd_priv(adapter);
+
+	memset(&sw->stats, 0, sizeof(sw->stats));
+	return 0;
+}
+
+/* Check that event timer timeout value is in range */
+static __rte_always_inline int
+swwheel_check_timeout(const struct swwheel *sw,
+		      const struct rte_event_timer *evtim)
+{
+	uint64_t tmo_nsec = evtim->timeout_ticks * sw->timer_tick_ns;
+
+	if (tmo_nsec > sw->max_tmo_ns)
+		return -1;
+	if (tmo_nsec < sw->timer_tick_ns)
+		return -2;
+
+	return 0;
+}
+
+static uint16_t
+__swwheel_arm_burst(const struct rte_event_timer_adapter *adapter,
+		    struct rte_event_timer **evtims,
+		    uint16_t nb_evtims)
+{
+	struct swwheel *sw = swwheel_pmd_priv(adapter);
+	struct swwheel_node *nodes[nb_evtims];
+	struct swwheel_node *head = NULL, *tail = NULL;
+	struct swwheel_wheel *w;
+	uint32_t lcore_id = rte_lcore_id();
+	enum rte_event_timer_state n_state;
+	/* Wheel for this lcore is not in use. */
+	uint16_t exp_state = 0;
+	uint64_t now;
+	int n_lcores;
+	int i, ret;
+
+#ifdef RTE_LIBRTE_EVENTDEV_DEBUG
+	/* Check that the service is running. */
+	if (rte_service_runstate_get(adapter->data->service_id) != 1) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+#endif
+
+	/* Adjust lcore_id if non-EAL thread. Arbitrarily pick the wheel of
+	 * the highest lcore to insert such timers into
+	 */
+	if (lcore_id == LCORE_ID_ANY)
+		lcore_id = RTE_MAX_LCORE - 1;
+
+	/* If this is the first time we're arming an event timer on this lcore,
+	 * mark this lcore as "in use"; this will cause the service function
+	 * to process the wheel that corresponds to this lcore.
+	 */
+	if (unlikely(__atomic_compare_exchange_n(&sw->in_use[lcore_id].v,
+			&exp_state, 1, 0,
+			__ATOMIC_RELAXED, __ATOMIC_RELAXED))) {
+		EVTIM_LOG_DBG("Adding lcore id = %u to list of lcores to poll",
+			      lcore_id);
+		n_lcores = __atomic_fetch_add(&sw->n_poll_lcores, 1,
+					     __ATOMIC_RELAXED);
+		__atomic_store_n(&sw->poll_lcores[n_lcores], lcore_id,
+				__ATOMIC_RELAXED);
+	}
+
+	ret = rte_mempool_get_bulk(sw->node_pool, (void **)nodes, nb_evtims);
+	if (ret < 0) {
+		rte_errno = ENOSPC;
+		return 0;
+	}
+
+	now = swwheel_next_tick(sw);
+
+	for (i = 0; i < nb_evtims; i++) {
+		struct swwheel_node *node = nodes[i];
+
+		n_state = __atomic_load_n(&evtims[i]->state, __ATOMIC_ACQUIRE);
+		if (n_state == RTE_EVENT_TIMER_ARMED) {
+			rte_errno = EALREADY;
+			break;
+		} else if (!(n_state == RTE_EVENT_TIMER_NOT_ARMED ||
+			     n_state == RTE_EVENT_TIMER_CANCELED)) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		ret = swwheel_check_timeout(sw, evtims[i]);
+		if (unlikely(ret == -1)) {
+			__atomic_store_n(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR_TOOLATE,
+					__ATOMIC_RELAXED);
+			rte_errno = EINVAL;
+			break;
+		} else if (unlikely(ret == -2)) {
+			__atomic_store_n(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR_TOOEARLY,
+					__ATOMIC_RELAXED);
+			rte_errno = EINVAL;
+			break;
+		}
+
+		if (unlikely(check_destination_event_queue(evtims[i],
+							   adapter) < 0)) {
+			__atomic_store_n(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR,
+					__ATOMIC_RELAXED);
+			rte_errno = EINVAL;
+			break;
+		}
+
+		node->evtim = evtims[i];
+		node->expiry_tick = now + evtims[i]->timeout_ticks;
+		node->next = head;
+		head = node;
+		if (tail == NULL)
+			tail = node;
+
+		evtims[i]->impl_opaque[0] = (uintptr_t)node;
+		evtims[i]->impl_opaque[1] = (uintptr_t)adapter;
+
+		EVTIM_LOG_DBG("armed an event timer");
+		/* RELEASE ordering guarantees the adapter specific value
+		 * changes observed before the update of state.
+		 */
+		__atomic_store_n(&evtims[i]->state, RTE_EVENT_TIMER_ARMED,
+				__ATOMIC_RELEASE);
+	}
+
+	if (i < nb_evtims)
+		rte_mempool_put_bulk(sw->node_pool, (void **)&nodes[i],
+				     nb_evtims - i);
+
+	if (head == NULL)
+		return i;
+
+	/* Hand the whole burst over to the service at once */
+	w = &sw->wheels[lcore_id];
+	tail->next = __atomic_load_n(&w->pending, __ATOMIC_RELAXED);
+	while (!__atomic_compare_exchange_n(&w->pending, &tail->next, head, 1,
+					    __ATOMIC_RELEASE,
+					    __ATOMIC_RELAXED))
+		;
+
+	return i;
+}
+
+static uint16_t
+swwheel_arm_burst(const struct rte_event_timer_adapter *adapter,
+		  struct rte_event_timer **evtims,
+		  uint16_t nb_evtims)
+{
+	return __swwheel_arm_burst(adapter, evtims, nb_evtims);
+}
+
+static uint16_t
+swwheel_cancel_burst(const struct rte_event_timer_adapter *adapter,
+		     struct rte_event_timer **evtims,
+		     uint16_t nb_evtims)
+{
+	enum rte_event_timer_state n_state;
+	struct rte_event_timer *expected;
+	struct swwheel_node *node;
+	int i;
+
+	RTE_SET_USED(adapter);
+
+#ifdef RTE_LIBRTE_EVENTDEV_DEBUG
+	/* Check that the service is running. */
+	if (rte_service_runstate_get(adapter->data->service_id) != 1) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+#endif
+
+	for (i = 0; i < nb_evtims; i++) {
+		/* ACQUIRE ordering guarantees the access of implementation
+		 * specific opaque data under the correct state.
+		 */
+		n_state = __atomic_load_n(&evtims[i]->state, __ATOMIC_ACQUIRE);
+		if (n_state == RTE_EVENT_TIMER_CANCELED) {
+			rte_errno = EALREADY;
+			break;
+		} else if (n_state != RTE_EVENT_TIMER_ARMED) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		node = (struct swwheel_node *)(uintptr_t)
+			evtims[i]->impl_opaque[0];
+		RTE_ASSERT(node != NULL);
+
+		/* Detach the timer from its node, unless the service is
+		 * already expiring it.
+		 */
+		expected = evtims[i];
+		if (!__atomic_compare_exchange_n(&node->evtim, &expected, NULL,
+						 0, __ATOMIC_ACQ_REL,
+						 __ATOMIC_RELAXED)) {
+			rte_errno = EAGAIN;
+			break;
+		}
+
+		/* The RELEASE ordering here pairs with atomic ordering
+		 * to make sure the state update data observed between
+		 * threads.
+		 */
+		__atomic_store_n(&evtims[i]->state, RTE_EVENT_TIMER_CANCELED,
+				__ATOMIC_RELEASE);
+	}
+
+	return i;
+}
+
+static uint16_t
+swwheel_arm_tmo_tick_burst(const struct rte_event_timer_adapter *adapter,
+			   struct rte_event_timer **evtims,
+			   uint64_t timeout_ticks,
+			   uint16_t nb_evtims)
+{
+	int i;
+
+	for (i = 0; i < nb_evtims; i++)
+		evtims[i]->timeout_ticks = timeout_ticks;
+
+	return __swwheel_arm_burst(adapter, evtims, nb_evtims);
+}
+
+static const struct rte_event_timer_adapter_ops swwheel_ops = {
+	.init			= swwheel_init,
+	.uninit			= swwheel_uninit,
+	.start			= swwheel_start,
+	.stop			= swwheel_stop,
+	.get_info		= swwheel_get_info,
+	.stats_get		= swwheel_stats_get,
+	.stats_reset		= swwheel_stats_reset,
+	.arm_burst		= swwheel_arm_burst,
+	.arm_tmo_tick_burst	= swwheel_arm_tmo_tick_burst,
+	.cancel_burst		= swwheel_cancel_burst,
+};
@@ -150,6 +150,19 @@ enum rte_event_timer_adapter_clk_src {
  *
  * @see struct rte_event_timer_adapter_conf::flags
  */
+#define RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL	(1ULL << 2)
+/**< Use the timer wheel based software implementation of the adapter, for
+ * event devices without a timer adapter implementation of their own.
+ * Timers are kept in per lcore hierarchical timer wheels, which makes arming
+ * a constant time operation, and arm and cancel operations lock-free from any
+ * lcore. Expiry is processed one wheel slot at a time, with the expiry events
+ * of a slot buffered up and enqueued to the event device in bursts. A
+ * cancelled timer holds on to its adapter timer object until its original
+ * expiry time, so the adapter should be created with *nb_timers* large
+ * enough to cover timers armed and cancelled within the maximum timeout.
+ *
+ * @see struct rte_event_timer_adapter_conf::flags
+ */
 
 /**
  * Timer adapter configuration structure
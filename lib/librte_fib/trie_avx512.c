@@ -0,0 +1,223 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2020 Intel Corporation
+ */
+
+#include <rte_vect.h>
+#include <rte_fib6.h>
+
+#include "trie.h"
+#include "trie_avx512.h"
+
+/* Offset of every address of a burst from the first one. */
+#define TRIE_VEC_IP_OFFSETS						\
+	_mm512_set_epi32(15 * RTE_FIB6_IPV6_ADDR_SIZE,			\
+		14 * RTE_FIB6_IPV6_ADDR_SIZE,				\
+		13 * RTE_FIB6_IPV6_ADDR_SIZE,				\
+		12 * RTE_FIB6_IPV6_ADDR_SIZE,				\
+		11 * RTE_FIB6_IPV6_ADDR_SIZE,				\
+		10 * RTE_FIB6_IPV6_ADDR_SIZE,				\
+		9 * RTE_FIB6_IPV6_ADDR_SIZE,				\
+		8 * RTE_FIB6_IPV6_ADDR_SIZE,				\
+		7 * RTE_FIB6_IPV6_ADDR_SIZE,				\
+		6 * RTE_FIB6_IPV6_ADDR_SIZE,				\
+		5 * RTE_FIB6_IPV6_ADDR_SIZE,				\
+		4 * RTE_FIB6_IPV6_ADDR_SIZE,				\
+		3 * RTE_FIB6_IPV6_ADDR_SIZE,				\
+		2 * RTE_FIB6_IPV6_ADDR_SIZE,				\
+		1 * RTE_FIB6_IPV6_ADDR_SIZE, 0)
+
+static __rte_always_inline uint32_t
+trie_vec_tbl24_idx(const uint8_t *ip)
+{
+	return ip[0] << 16 | ip[1] << 8 | ip[2];
+}
+
+/*
+ * Gather byte j of every address whose lane is set in msk.
+ * Bytes near the end of an address are fetched from an earlier
+ * position so the 4 byte loads never cross the end of the burst.
+ */
+static __rte_always_inline __m512i
+trie_vec_get_bytes(uint8_t ips[][RTE_FIB6_IPV6_ADDR_SIZE], __mmask16 msk,
+	int j)
+{
+	const __m512i zero = _mm512_set1_epi32(0);
+	const __m512i lsbyte_msk = _mm512_set1_epi32(0xff);
+	__m512i bytes;
+
+	if (j <= RTE_FIB6_IPV6_ADDR_SIZE - (int)sizeof(uint32_t)) {
+		bytes = _mm512_mask_i32gather_epi32(zero, msk,
+			TRIE_VEC_IP_OFFSETS, (const int *)&ips[0][j], 1);
+		return _mm512_and_epi32(bytes, lsbyte_msk);
+	}
+
+	bytes = _mm512_mask_i32gather_epi32(zero, msk, TRIE_VEC_IP_OFFSETS,
+		(const int *)&ips[0][j - (sizeof(uint32_t) - 1)], 1);
+	return _mm512_srli_epi32(bytes, 24);
+}
+
+static __rte_always_inline void
+trie_vec_lookup_x16(void *p, uint8_t ips[16][RTE_FIB6_IPV6_ADDR_SIZE],
+	uint64_t *next_hops, int size)
+{
+	struct rte_trie_tbl *dp = (struct rte_trie_tbl *)p;
+	const __m512i zero = _mm512_set1_epi32(0);
+	const __m512i lsb = _mm512_set1_epi32(1);
+	uint32_t tbl24_idx[16] __rte_aligned(64);
+	__m512i idxes, res, bytes, tmp, res_msk;
+	__mmask16 msk_ext;
+	int i, j;
+
+	/* used to mask gather values if size is 2 (16 bit next hops) */
+	if (size == sizeof(uint16_t))
+		res_msk = _mm512_set1_epi32(UINT16_MAX);
+	else
+		res_msk = _mm512_set1_epi32(UINT32_MAX);
+
+	for (i = 0; i < 16; i++)
+		tbl24_idx[i] = trie_vec_tbl24_idx(ips[i]);
+	idxes = _mm512_load_si512(tbl24_idx);
+
+	/**
+	 * lookup in tbl24
+	 * Put it inside branch to make compiler happy with -O0
+	 */
+	if (size == sizeof(uint16_t)) {
+		res = _mm512_i32gather_epi32(idxes, (const int *)dp->tbl24, 2);
+		res = _mm512_and_epi32(res, res_msk);
+	} else
+		res = _mm512_i32gather_epi32(idxes, (const int *)dp->tbl24, 4);
+
+	/* walk tbl8 groups, one address byte per level for all lanes */
+	msk_ext = _mm512_test_epi32_mask(res, lsb);
+	for (j = 3; msk_ext != 0 && j < RTE_FIB6_IPV6_ADDR_SIZE; j++) {
+		bytes = trie_vec_get_bytes(ips, msk_ext, j);
+		idxes = _mm512_srli_epi32(res, 1);
+		idxes = _mm512_slli_epi32(idxes, 8);
+		idxes = _mm512_maskz_add_epi32(msk_ext, idxes, bytes);
+		if (size == sizeof(uint16_t)) {
+			tmp = _mm512_mask_i32gather_epi32(zero, msk_ext,
+				idxes, (const int *)dp->tbl8, 2);
+			tmp = _mm512_and_epi32(tmp, res_msk);
+		} else
+			tmp = _mm512_mask_i32gather_epi32(zero, msk_ext,
+				idxes, (const int *)dp->tbl8, 4);
+		res = _mm512_mask_blend_epi32(msk_ext, res, tmp);
+		msk_ext = _mm512_mask_test_epi32_mask(msk_ext, res, lsb);
+	}
+
+	res = _mm512_srli_epi32(res, 1);
+	/* zero extend next hops to 64 bits */
+	_mm512_storeu_si512(next_hops,
+		_mm512_cvtepu32_epi64(_mm512_castsi512_si256(res)));
+	_mm512_storeu_si512(next_hops + 8,
+		_mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(res, 1)));
+}
+
+static __rte_always_inline void
+trie_vec_lookup_x8_8b(void *p, uint8_t ips[8][RTE_FIB6_IPV6_ADDR_SIZE],
+	uint64_t *next_hops)
+{
+	struct rte_trie_tbl *dp = (struct rte_trie_tbl *)p;
+	const __m512i zero = _mm512_set1_epi32(0);
+	const __m512i lsb = _mm512_set1_epi64(1);
+	uint32_t tbl24_idx[8] __rte_aligned(32);
+	__m512i idxes, res, bytes, tmp;
+	__m256i idxes_256;
+	__mmask8 msk_ext;
+	int i, j;
+
+	for (i = 0; i < 8; i++)
+		tbl24_idx[i] = trie_vec_tbl24_idx(ips[i]);
+	idxes_256 = _mm256_load_si256((const void *)tbl24_idx);
+
+	/* lookup in tbl24 */
+	res = _mm512_i32gather_epi64(idxes_256, (const void *)dp->tbl24, 8);
+
+	/* walk tbl8 groups, one address byte per level for all lanes */
+	msk_ext = _mm512_test_epi64_mask(res, lsb);
+	for (j = 3; msk_ext != 0 && j < RTE_FIB6_IPV6_ADDR_SIZE; j++) {
+		bytes = trie_vec_get_bytes(ips, msk_ext, j);
+		bytes = _mm512_cvtepu32_epi64(_mm512_castsi512_si256(bytes));
+		idxes = _mm512_srli_epi64(res, 1);
+		idxes = _mm512_slli_epi64(idxes, 8);
+		idxes = _mm512_maskz_add_epi64(msk_ext, idxes, bytes);
+		tmp = _mm512_mask_i64gather_epi64(zero, msk_ext, idxes,
+			(const void *)dp->tbl8, 8);
+		res = _mm512_mask_blend_epi64(msk_ext, res, tmp);
+		msk_ext = _mm512_mask_test_epi64_mask(msk_ext, res, lsb);
+	}
+
+	res = _mm512_srli_epi64(res, 1);
+	_mm512_storeu_si512(next_hops, res);
+}
+
+/*
+ * Remaining addresses of a burst are resolved the same way the scalar
+ * trie lookup does it.
+ */
+#define TRIE_TAIL_FUNC(suffix, type)					\
+static inline void							\
+trie_tail_##suffix(void *p, uint8_t ips[][RTE_FIB6_IPV6_ADDR_SIZE],	\
+	uint64_t *next_hops, const unsigned int n)			\
+{									\
+	struct rte_trie_tbl *dp = (struct rte_trie_tbl *)p;		\
+	uint64_t tmp;							\
+	uint32_t i, j;							\
+									\
+	for (i = 0; i < n; i++) {					\
+		tmp = ((type *)dp->tbl24)[trie_vec_tbl24_idx(ips[i])];	\
+		j = 3;							\
+		while ((tmp & TRIE_EXT_ENT) == TRIE_EXT_ENT) {		\
+			tmp = ((type *)dp->tbl8)[ips[i][j++] +		\
+				((tmp >> 1) * TRIE_TBL8_GRP_NUM_ENT)];	\
+		}							\
+		next_hops[i] = tmp >> 1;				\
+	}								\
+}
+
+TRIE_TAIL_FUNC(2b, uint16_t)
+TRIE_TAIL_FUNC(4b, uint32_t)
+TRIE_TAIL_FUNC(8b, uint64_t)
+
+void
+rte_trie_vec_lookup_bulk_2b(void *p, uint8_t ips[][RTE_FIB6_IPV6_ADDR_SIZE],
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+
+	for (i = 0; i < (n / 16); i++)
+		trie_vec_lookup_x16(p, &ips[i * 16],
+			next_hops + i * 16, sizeof(uint16_t));
+
+	trie_tail_2b(p, &ips[i * 16],
+		next_hops + i * 16, n - i * 16);
+}
+
+void
+rte_trie_vec_lookup_bulk_4b(void *p, uint8_t ips[][RTE_FIB6_IPV6_ADDR_SIZE],
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+
+	for (i = 0; i < (n / 16); i++)
+		trie_vec_lookup_x16(p, &ips[i * 16],
+			next_hops + i * 16, sizeof(uint32_t));
+
+	trie_tail_4b(p, &ips[i * 16],
+		next_hops + i * 16, n - i * 16);
+}
+
+void
+rte_trie_vec_lookup_bulk_8b(void *p, uint8_t ips[][RTE_FIB6_IPV6_ADDR_SIZE],
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+
+	for (i = 0; i < (n / 8); i++)
+		trie_vec_lookup_x8_8b(p, &ips[i * 8],
+			next_hops + i * 8);
+
+	trie_tail_8b(p, &ips[i * 8],
+		next_hops + i * 8, n - i * 8);
+}
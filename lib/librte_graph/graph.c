@@ -8,8 +8,11 @@
 #include <rte_common.h>
 #include <rte_debug.h>
 #include <rte_errno.h>
+#include <rte_lcore.h>
 #include <rte_malloc.h>
 #include <rte_memzone.h>
+#include <rte_pause.h>
+#include <rte_ring.h>
 #include <rte_spinlock.h>
 #include <rte_string_fns.h>
 
@@ -18,6 +21,8 @@
 static struct graph_head graph_list = STAILQ_HEAD_INITIALIZER(graph_list);
 static rte_spinlock_t graph_lock = RTE_SPINLOCK_INITIALIZER;
 static rte_graph_t graph_id;
+/* Graph walked by each lcore in dispatch model */
+static struct graph *dispatch_graphs[RTE_MAX_LCORE];
 
 #define GRAPH_ID_CHECK(id) ID_CHECK(id, graph_id)
 
@@ -209,6 +214,101 @@ graph_node_fini(struct graph *graph)
 						       graph_node->node->name));
 }
 
+/* Queue of a node in the graph bound to the lcore the node is pinned to */
+static struct rte_ring *
+graph_dispatch_ring_lookup(const struct rte_node *node)
+{
+	struct graph *peer = dispatch_graphs[node->lcore_id];
+	struct rte_node *remote;
+
+	if (peer == NULL)
+		return NULL;
+
+	remote = graph_node_name_to_ptr(peer->graph, node->name);
+	return remote != NULL ? remote->dispatch_ring : NULL;
+}
+
+/* Point the nodes pinned to an lcore in the other graphs at its queues */
+static void
+graph_dispatch_peers_update(struct graph *graph, unsigned int lcore_id)
+{
+	struct rte_node *node;
+	rte_graph_off_t off;
+	rte_node_t count;
+	struct graph *tmp;
+
+	STAILQ_FOREACH(tmp, &graph_list, next) {
+		if (tmp == graph)
+			continue;
+		rte_graph_foreach_node(count, off, tmp->graph, node)
+			if (node->lcore_id == lcore_id)
+				__atomic_store_n(&node->dispatch_ring,
+						 graph_dispatch_ring_lookup(node),
+						 __ATOMIC_RELEASE);
+	}
+}
+
+/* Wait for the walks which may still hold a queue of the lcore to end */
+static void
+graph_dispatch_peers_quiesce(struct graph *graph)
+{
+	struct graph *tmp;
+	uint32_t seq;
+
+	rte_smp_mb();
+	STAILQ_FOREACH(tmp, &graph_list, next) {
+		if (tmp == graph || tmp->graph->model != RTE_GRAPH_MODEL_DISPATCH)
+			continue;
+		seq = __atomic_load_n(&tmp->graph->dispatch_seq,
+				      __ATOMIC_ACQUIRE);
+		if (!(seq & 1))
+			continue;
+		while (__atomic_load_n(&tmp->graph->dispatch_seq,
+				       __ATOMIC_ACQUIRE) == seq)
+			rte_pause();
+	}
+}
+
+static void
+graph_dispatch_unbind(struct graph *_graph)
+{
+	struct rte_graph *graph = _graph->graph;
+	const unsigned int lcore_id = graph->lcore_id;
+	struct rte_node *node;
+	rte_node_t count;
+
+	if (graph->model != RTE_GRAPH_MODEL_DISPATCH)
+		return;
+
+	graph->model = RTE_GRAPH_MODEL_RTC;
+	graph->lcore_id = RTE_GRAPH_DISPATCH_LCORE_ANY;
+	dispatch_graphs[lcore_id] = NULL;
+
+	/* Objects handed over from now on are held back by the other graphs */
+	graph_dispatch_peers_update(_graph, lcore_id);
+	graph_dispatch_peers_quiesce(_graph);
+
+	for (count = 0; count < graph->nb_dispatch_nodes; count++) {
+		node = graph->dispatch_nodes[count];
+		rte_ring_free(node->dispatch_ring);
+		node->dispatch_ring = NULL;
+	}
+	rte_free(graph->dispatch_nodes);
+	graph->dispatch_nodes = NULL;
+	graph->nb_dispatch_nodes = 0;
+
+	/* Streams held back are now processed locally by the next walk */
+	for (count = 0; count < graph->nb_dispatch_remotes; count++) {
+		node = graph->dispatch_remotes[count];
+		node->dispatch_ring = NULL;
+		if (node->idx)
+			__rte_node_enqueue_tail_update(graph, node);
+	}
+	rte_free(graph->dispatch_remotes);
+	graph->dispatch_remotes = NULL;
+	graph->nb_dispatch_remotes = 0;
+}
+
 static struct rte_graph *
 graph_mem_fixup_node_ctx(struct rte_graph *graph)
 {
@@ -366,6 +466,7 @@ rte_graph_destroy(rte_graph_t id)
 	while (graph != NULL) {
 		tmp = STAILQ_NEXT(graph, next);
 		if (graph->id == id) {
+			graph_dispatch_unbind(graph);
 			/* Call fini() of the all the nodes in the graph */
 			graph_node_fini(graph);
 			/* Destroy graph fast path memory */
@@ -457,6 +558,188 @@ rte_graph_node_get_by_name(const char *graph_name, const char *node_name)
 	return NULL;
 }
 
+int
+rte_graph_dispatch_core_bind(rte_graph_t id, unsigned int lcore_id)
+{
+	char name[RTE_RING_NAMESIZE];
+	struct rte_node **nodes, **remotes;
+	rte_node_t count, nb, nb_remotes;
+	struct rte_graph *rg;
+	struct rte_node *node;
+	struct graph *graph;
+	rte_graph_off_t off;
+
+	graph_spinlock_lock();
+
+	GRAPH_ID_CHECK(id);
+	if (lcore_id >= RTE_MAX_LCORE || !rte_lcore_is_enabled(lcore_id))
+		SET_ERR_JMP(EINVAL, fail, "Invalid lcore %u", lcore_id);
+	if (dispatch_graphs[lcore_id] != NULL)
+		SET_ERR_JMP(EEXIST, fail, "Lcore %u already bound to graph %s",
+			    lcore_id, dispatch_graphs[lcore_id]->name);
+
+	STAILQ_FOREACH(graph, &graph_list, next)
+		if (graph->id == id)
+			break;
+	if (graph == NULL)
+		SET_ERR_JMP(ENOENT, fail, "Graph %u not found", id);
+
+	rg = graph->graph;
+	if (rg->model == RTE_GRAPH_MODEL_DISPATCH)
+		SET_ERR_JMP(EBUSY, fail, "Graph %s already bound to lcore %u",
+			    graph->name, rg->lcore_id);
+
+	nb = 0;
+	nb_remotes = 0;
+	rte_graph_foreach_node(count, off, rg, node)
+		if (node->lcore_id == lcore_id)
+			nb++;
+		else if (node->lcore_id != RTE_GRAPH_DISPATCH_LCORE_ANY)
+			nb_remotes++;
+
+	nodes = rte_zmalloc_socket(NULL, sizeof(*nodes) * RTE_MAX(nb, 1U),
+				   RTE_CACHE_LINE_SIZE, graph->socket);
+	if (nodes == NULL)
+		SET_ERR_JMP(ENOMEM, fail, "Failed to alloc dispatch nodes");
+	remotes = rte_zmalloc_socket(NULL,
+				     sizeof(*remotes) * RTE_MAX(nb_remotes, 1U),
+				     RTE_CACHE_LINE_SIZE, graph->socket);
+	if (remotes == NULL) {
+		rte_free(nodes);
+		SET_ERR_JMP(ENOMEM, fail, "Failed to alloc dispatch remotes");
+	}
+
+	/* One queue per pinned node, fed by any lcore, drained by this one */
+	nb = 0;
+	nb_remotes = 0;
+	rte_graph_foreach_node(count, off, rg, node) {
+		if (node->lcore_id == RTE_GRAPH_DISPATCH_LCORE_ANY)
+			continue;
+		if (node->lcore_id != lcore_id) {
+			/* Queues are resolved once, never from the fast path */
+			node->dispatch_ring = graph_dispatch_ring_lookup(node);
+			remotes[nb_remotes++] = node;
+			continue;
+		}
+		snprintf(name, sizeof(name), "graph_%u_node_%u", id, node->id);
+		node->dispatch_ring = rte_ring_create(name,
+			RTE_GRAPH_DISPATCH_RING_SIZE, graph->socket,
+			RING_F_SC_DEQ);
+		if (node->dispatch_ring == NULL)
+			SET_ERR_JMP(rte_errno, ring_free,
+				    "Failed to create queue for node %s",
+				    node->name);
+		nodes[nb++] = node;
+	}
+
+	rg->dispatch_nodes = nodes;
+	rg->nb_dispatch_nodes = nb;
+	rg->dispatch_remotes = remotes;
+	rg->nb_dispatch_remotes = nb_remotes;
+	rg->lcore_id = lcore_id;
+	rg->model = RTE_GRAPH_MODEL_DISPATCH;
+	dispatch_graphs[lcore_id] = graph;
+
+	/* The other graphs start handing over to the new queues */
+	graph_dispatch_peers_update(graph, lcore_id);
+
+	graph_spinlock_unlock();
+	return 0;
+
+ring_free:
+	while (nb--) {
+		rte_ring_free(nodes[nb]->dispatch_ring);
+		nodes[nb]->dispatch_ring = NULL;
+	}
+	while (nb_remotes--)
+		remotes[nb_remotes]->dispatch_ring = NULL;
+	rte_free(remotes);
+	rte_free(nodes);
+fail:
+	graph_spinlock_unlock();
+	return -rte_errno;
+}
+
+int
+rte_graph_dispatch_core_unbind(rte_graph_t id)
+{
+	struct graph *graph;
+
+	graph_spinlock_lock();
+
+	GRAPH_ID_CHECK(id);
+	STAILQ_FOREACH(graph, &graph_list, next)
+		if (graph->id == id)
+			break;
+	if (graph == NULL)
+		SET_ERR_JMP(ENOENT, fail, "Graph %u not found", id);
+
+	graph_dispatch_unbind(graph);
+
+	graph_spinlock_unlock();
+	return 0;
+fail:
+	graph_spinlock_unlock();
+	return -rte_errno;
+}
+
+int
+rte_graph_stats_sample_set(rte_graph_t id, uint32_t interval)
+{
+	struct graph *graph;
+
+	if (!rte_graph_has_stats_feature())
+		SET_ERR_JMP(ENOTSUP, fail, "Stats feature is not enabled");
+	if (interval == 0)
+		SET_ERR_JMP(EINVAL, fail, "Invalid sample interval");
+
+	GRAPH_ID_CHECK(id);
+
+	graph_spinlock_lock();
+	STAILQ_FOREACH(graph, &graph_list, next)
+		if (graph->id == id)
+			break;
+	if (graph == NULL)
+		SET_ERR_JMP(ENOENT, unlock, "Graph %u not found", id);
+
+	graph->graph->stats_interval = interval;
+	graph->graph->stats_countdown = 0;
+
+	graph_spinlock_unlock();
+	return 0;
+unlock:
+	graph_spinlock_unlock();
+fail:
+	return -rte_errno;
+}
+
+int
+rte_graph_stats_hist_enable(rte_graph_t id, bool enable)
+{
+	struct graph *graph;
+
+	if (!rte_graph_has_stats_feature())
+		SET_ERR_JMP(ENOTSUP, fail, "Stats feature is not enabled");
+
+	GRAPH_ID_CHECK(id);
+
+	graph_spinlock_lock();
+	STAILQ_FOREACH(graph, &graph_list, next)
+		if (graph->id == id)
+			break;
+	if (graph == NULL)
+		SET_ERR_JMP(ENOENT, unlock, "Graph %u not found", id);
+
+	graph->graph->stats_hist = enable;
+
+	graph_spinlock_unlock();
+	return 0;
+unlock:
+	graph_spinlock_unlock();
+fail:
+	return -rte_errno;
+}
+
 void __rte_noinline
 __rte_node_stream_alloc(struct rte_graph *graph, struct rte_node *node)
 {
@@ -38,6 +38,8 @@ node_dump(FILE *f, struct node *n)
 	fprintf(f, "  addr=%p\n", n);
 	fprintf(f, "  process=%p\n", n->process);
 	fprintf(f, "  nb_edges=%d\n", n->nb_edges);
+	if (n->lcore_id != RTE_GRAPH_DISPATCH_LCORE_ANY)
+		fprintf(f, "  lcore_id=%u\n", n->lcore_id);
 
 	for (i = 0; i < n->nb_edges; i++)
 		fprintf(f, "     edge[%d] <%s>\n", i, n->next_nodes[i]);
@@ -58,6 +60,13 @@ rte_graph_obj_dump(FILE *f, struct rte_graph *g, bool all)
 	fprintf(f, "  cir_mask=0x%" PRIx32 "\n", g->cir_mask);
 	fprintf(f, "  nb_nodes=%" PRId32 "\n", g->nb_nodes);
 	fprintf(f, "  socket=%d\n", g->socket);
+	if (g->model == RTE_GRAPH_MODEL_DISPATCH) {
+		fprintf(f, "  lcore_id=%u\n", g->lcore_id);
+		fprintf(f, "  nb_dispatch_nodes=%" PRIu32 "\n",
+			g->nb_dispatch_nodes);
+		fprintf(f, "  nb_dispatch_remotes=%" PRIu32 "\n",
+			g->nb_dispatch_remotes);
+	}
 	fprintf(f, "  fence=0x%" PRIx64 "\n", g->fence);
 	fprintf(f, "  nodes_start=0x%" PRIx32 "\n", g->nodes_start);
 	fprintf(f, "  cir_start=%p\n", g->cir_start);
@@ -75,6 +84,8 @@ rte_graph_obj_dump(FILE *f, struct rte_graph *g, bool all)
 		fprintf(f, "       realloc_count=%d\n", n->realloc_count);
 		fprintf(f, "       size=%d\n", n->size);
 		fprintf(f, "       idx=%d\n", n->idx);
+		if (n->lcore_id != RTE_GRAPH_DISPATCH_LCORE_ANY)
+			fprintf(f, "       lcore_id=%u\n", n->lcore_id);
 		fprintf(f, "       total_objs=%" PRId64 "\n", n->total_objs);
 		fprintf(f, "       total_calls=%" PRId64 "\n", n->total_calls);
 		for (i = 0; i < n->nb_edges; i++)
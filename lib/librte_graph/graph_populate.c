@@ -57,6 +57,9 @@ graph_header_popluate(struct graph *_graph)
 	graph->cir_start = RTE_PTR_ADD(graph, _graph->cir_start);
 	graph->nodes_start = _graph->nodes_start;
 	graph->socket = _graph->socket;
+	graph->model = RTE_GRAPH_MODEL_RTC;
+	graph->lcore_id = RTE_GRAPH_DISPATCH_LCORE_ANY;
+	graph->stats_interval = 1;
 	graph->id = _graph->id;
 	memcpy(graph->name, _graph->name, RTE_GRAPH_NAMESIZE);
 	graph->fence = RTE_GRAPH_FENCE;
@@ -86,6 +89,7 @@ graph_nodes_populate(struct graph *_graph)
 		}
 		node->id = graph_node->node->id;
 		node->parent_id = pid;
+		node->lcore_id = graph_node->node->lcore_id;
 		nb_edges = graph_node->node->nb_edges;
 		node->nb_edges = nb_edges;
 		off += sizeof(struct rte_node);
@@ -8,6 +8,7 @@
 #include <rte_common.h>
 #include <rte_errno.h>
 #include <rte_malloc.h>
+#include <rte_telemetry.h>
 
 #include "graph_private.h"
 
@@ -332,7 +333,10 @@ cluster_node_arregate_stats(struct cluster_node *cluster)
 	struct rte_graph_cluster_node_stats *stat = &cluster->stat;
 	struct rte_node *node;
 	rte_node_t count;
+	unsigned int i;
 
+	memset(stat->objs_hist, 0, sizeof(stat->objs_hist));
+	memset(stat->cycles_hist, 0, sizeof(stat->cycles_hist));
 	for (count = 0; count < cluster->nb_nodes; count++) {
 		node = cluster->nodes[count];
 
@@ -340,6 +344,10 @@ cluster_node_arregate_stats(struct cluster_node *cluster)
 		objs += node->total_objs;
 		cycles += node->total_cycles;
 		realloc_count += node->realloc_count;
+		for (i = 0; i < RTE_GRAPH_STATS_HIST_BINS; i++) {
+			stat->objs_hist[i] += node->objs_hist[i];
+			stat->cycles_hist[i] += node->cycles_hist[i];
+		}
 	}
 
 	stat->calls = calls;
@@ -401,6 +409,90 @@ rte_graph_cluster_stats_reset(struct rte_graph_cluster_stats *stat)
 		node->prev_objs = 0;
 		node->prev_cycles = 0;
 		node->realloc_count = 0;
+		memset(node->objs_hist, 0, sizeof(node->objs_hist));
+		memset(node->cycles_hist, 0, sizeof(node->cycles_hist));
 		cluster = RTE_PTR_ADD(cluster, stat->cluster_node_size);
 	}
 }
+
+static int
+graph_handle_list(const char *cmd __rte_unused,
+		  const char *params __rte_unused, struct rte_tel_data *d)
+{
+	struct graph_head *graph_head = graph_list_head_get();
+	struct graph *graph;
+
+	rte_tel_data_start_array(d, RTE_TEL_STRING_VAL);
+	graph_spinlock_lock();
+	STAILQ_FOREACH(graph, graph_head, next)
+		rte_tel_data_add_array_string(d, graph->name);
+	graph_spinlock_unlock();
+
+	return 0;
+}
+
+static int
+graph_handle_node_stats(const char *cmd __rte_unused, const char *params,
+			struct rte_tel_data *d)
+{
+	uint64_t objs_hist[RTE_GRAPH_STATS_HIST_BINS] = {0};
+	uint64_t cycles_hist[RTE_GRAPH_STATS_HIST_BINS] = {0};
+	struct graph_head *graph_head = graph_list_head_get();
+	uint64_t calls = 0, cycles = 0, objs = 0;
+	char name[RTE_TEL_MAX_STRING_LEN];
+	struct rte_node *node;
+	struct graph *graph;
+	bool found = false;
+	unsigned int i;
+
+	if (!rte_graph_has_stats_feature())
+		return -ENOTSUP;
+
+	if (params == NULL || strlen(params) == 0)
+		return -EINVAL;
+
+	/* Aggregate the node across all the graphs it is part of */
+	graph_spinlock_lock();
+	STAILQ_FOREACH(graph, graph_head, next) {
+		node = graph_node_name_to_ptr(graph->graph, params);
+		if (node == NULL)
+			continue;
+
+		calls += node->total_calls;
+		objs += node->total_objs;
+		cycles += node->total_cycles;
+		for (i = 0; i < RTE_GRAPH_STATS_HIST_BINS; i++) {
+			objs_hist[i] += node->objs_hist[i];
+			cycles_hist[i] += node->cycles_hist[i];
+		}
+		found = true;
+	}
+	graph_spinlock_unlock();
+
+	if (!found)
+		return -EINVAL;
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_string(d, "name", params);
+	rte_tel_data_add_dict_u64(d, "calls", calls);
+	rte_tel_data_add_dict_u64(d, "objs", objs);
+	rte_tel_data_add_dict_u64(d, "cycles", cycles);
+	for (i = 0; i < RTE_GRAPH_STATS_HIST_BINS; i++) {
+		snprintf(name, sizeof(name), "objs_hist_%u", i);
+		rte_tel_data_add_dict_u64(d, name, objs_hist[i]);
+	}
+	for (i = 0; i < RTE_GRAPH_STATS_HIST_BINS; i++) {
+		snprintf(name, sizeof(name), "cycles_hist_%u", i);
+		rte_tel_data_add_dict_u64(d, name, cycles_hist[i]);
+	}
+
+	return 0;
+}
+
+RTE_INIT(graph_init_telemetry)
+{
+	rte_telemetry_register_cmd("/graph/list", graph_handle_list,
+		"Returns list of available graphs. Takes no parameters");
+	rte_telemetry_register_cmd("/graph/node_stats", graph_handle_node_stats,
+		"Returns node stats and histograms summed over graphs. Parameters: node name");
+}
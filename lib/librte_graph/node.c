@@ -96,6 +96,7 @@ __rte_node_register(const struct rte_node_register *reg)
 	node->fini = reg->fini;
 	node->nb_edges = reg->nb_edges;
 	node->parent_id = reg->parent_id;
+	node->lcore_id = RTE_GRAPH_DISPATCH_LCORE_ANY;
 	for (i = 0; i < reg->nb_edges; i++) {
 		if (rte_strscpy(node->next_nodes[i], reg->next_nodes[i],
 				RTE_NODE_NAMESIZE) < 0) {
@@ -382,6 +383,28 @@ rte_node_edge_get(rte_node_t id, char *next_nodes[])
 	return rc;
 }
 
+int
+rte_graph_dispatch_node_lcore_set(const char *name, unsigned int lcore_id)
+{
+	struct node *node;
+
+	if (name == NULL || (lcore_id != RTE_GRAPH_DISPATCH_LCORE_ANY &&
+			     lcore_id >= RTE_MAX_LCORE)) {
+		rte_errno = EINVAL;
+		return -rte_errno;
+	}
+
+	graph_spinlock_lock();
+	node = node_from_name(name);
+	if (node != NULL)
+		node->lcore_id = lcore_id;
+	else
+		rte_errno = ENOENT;
+	graph_spinlock_unlock();
+
+	return node != NULL ? 0 : -rte_errno;
+}
+
 static void
 node_scan_dump(FILE *f, rte_node_t id, bool all)
 {
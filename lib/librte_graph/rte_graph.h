@@ -40,6 +40,9 @@ extern "C" {
 #define RTE_EDGE_ID_INVALID UINT16_MAX   /**< Invalid edge id. */
 #define RTE_GRAPH_ID_INVALID UINT16_MAX  /**< Invalid graph id. */
 #define RTE_GRAPH_FENCE 0xdeadbeef12345678ULL /**< Graph fence data. */
+#define RTE_GRAPH_DISPATCH_LCORE_ANY UINT32_MAX /**< Node runs on any lcore. */
+#define RTE_GRAPH_DISPATCH_RING_SIZE 4096 /**< Dispatch queue size in objs. */
+#define RTE_GRAPH_STATS_HIST_BINS 16 /**< Number of node stats histogram bins. */
 
 typedef uint32_t rte_graph_off_t;  /**< Graph offset type. */
 typedef uint32_t rte_node_t;       /**< Node id type. */
@@ -75,6 +78,18 @@ struct rte_graph; /**< Graph object */
 struct rte_graph_cluster_stats;      /**< Stats for Cluster of graphs */
 struct rte_graph_cluster_node_stats; /**< Node stats within cluster of graphs */
 
+/**
+ * Graph walk models.
+ *
+ * @see rte_graph_dispatch_core_bind()
+ */
+enum rte_graph_model {
+	RTE_GRAPH_MODEL_RTC = 0,
+	/**< Run-to-completion, the walking lcore runs every node. */
+	RTE_GRAPH_MODEL_DISPATCH,
+	/**< Nodes pinned to an lcore are handed over to the graph bound to it. */
+};
+
 /**
  * Node process function.
  *
@@ -206,6 +221,11 @@ struct rte_graph_cluster_node_stats {
 
 	uint64_t realloc_count; /**< Realloc count. */
 
+	uint64_t objs_hist[RTE_GRAPH_STATS_HIST_BINS];
+	/**< Histogram of objs per call, bin n counts [2^(n - 1), 2^n). */
+	uint64_t cycles_hist[RTE_GRAPH_STATS_HIST_BINS];
+	/**< Histogram of cycles per obj, bin n counts [2^(n - 1), 2^n). */
+
 	rte_node_t id;	/**< Node identifier of stats. */
 	uint64_t hz;	/**< Cycles per seconds. */
 	char name[RTE_NODE_NAMESIZE];	/**< Name of the node. */
@@ -375,6 +395,58 @@ __rte_experimental
 struct rte_node *rte_graph_node_get_by_name(const char *graph,
 					    const char *name);
 
+/**
+ * Bind a graph to an lcore and switch it to the dispatch walk model.
+ *
+ * In the dispatch model, rte_graph_walk() only runs the nodes pinned to
+ * @p lcore_id with rte_graph_dispatch_node_lcore_set() and the nodes without
+ * affinity. Pending streams of nodes pinned to another lcore are handed over
+ * to the graph bound to that lcore through a lock-free multi-producer,
+ * single-consumer queue of RTE_GRAPH_DISPATCH_RING_SIZE objects owned by the
+ * destination node. The queues are resolved by this function, never by
+ * rte_graph_walk(). If the queue is full or no graph is bound to the
+ * destination lcore, the rest of the stream is kept and handed over by the
+ * next walks; while more than RTE_GRAPH_DISPATCH_RING_SIZE objects are held
+ * back, the walks neither run the source nodes nor drain the queues of the
+ * lcore. A node is never processed by an lcore it is not pinned to.
+ *
+ * The graph must not be walked during the call, the other graphs may.
+ *
+ * Typically the same node patterns are used to create one graph per lcore,
+ * and each graph is bound to the lcore that walks it.
+ *
+ * @param id
+ *   Graph id to bind.
+ * @param lcore_id
+ *   Lcore which walks the graph. At most one graph can be bound to an lcore.
+ *
+ * @return
+ *   0 on success, negative errno value otherwise.
+ */
+__rte_experimental
+int rte_graph_dispatch_core_bind(rte_graph_t id, unsigned int lcore_id);
+
+/**
+ * Unbind a graph from its lcore and switch it back to run-to-completion.
+ *
+ * The other graphs stop handing over to the lcore, and the queues feeding the
+ * nodes pinned to it are freed once the walks of the other graphs which may
+ * still use them have returned; the objects left in them are dropped. The
+ * other graphs hold their streams for the lcore back until a graph is bound
+ * to it again. The streams held back by this graph are processed by its next
+ * run-to-completion walk.
+ *
+ * The graph must not be walked during the call, the other graphs may.
+ *
+ * @param id
+ *   Graph id to unbind.
+ *
+ * @return
+ *   0 on success, negative errno value otherwise.
+ */
+__rte_experimental
+int rte_graph_dispatch_core_unbind(rte_graph_t id);
+
 /**
  * Create graph stats cluster to aggregate runtime node stats.
  *
@@ -419,6 +491,42 @@ void rte_graph_cluster_stats_get(struct rte_graph_cluster_stats *stat,
 __rte_experimental
 void rte_graph_cluster_stats_reset(struct rte_graph_cluster_stats *stat);
 
+/**
+ * Sample the node stats of a graph once every given number of walks.
+ *
+ * Calls and objs are always counted, but the cycles are measured only on
+ * sampled walks and scaled by the interval, so that stats can be left on
+ * without paying a timestamp read around every node call.
+ *
+ * @param id
+ *   Graph id.
+ * @param interval
+ *   Number of walks per sampled walk, 1 samples every walk.
+ *
+ * @return
+ *   0 on success, negative errno value otherwise.
+ */
+__rte_experimental
+int rte_graph_stats_sample_set(rte_graph_t id, uint32_t interval);
+
+/**
+ * Enable or disable the node histograms of a graph.
+ *
+ * When enabled, the objs per call and cycles per obj of every sampled node
+ * call are accounted in the log2 histograms reported in
+ * struct rte_graph_cluster_node_stats.
+ *
+ * @param id
+ *   Graph id.
+ * @param enable
+ *   true to enable the histograms.
+ *
+ * @return
+ *   0 on success, negative errno value otherwise.
+ */
+__rte_experimental
+int rte_graph_stats_hist_enable(rte_graph_t id, bool enable);
+
 /**
  * Structure defines the node registration parameters.
  *
@@ -581,6 +689,25 @@ rte_node_t rte_node_edge_get(rte_node_t id, char *next_nodes[]);
 __rte_experimental
 rte_node_t rte_node_max_count(void);
 
+/**
+ * Pin a node to an lcore for the dispatch walk model.
+ *
+ * The affinity is applied to the graphs created afterwards.
+ *
+ * @param name
+ *   Name of the node.
+ * @param lcore_id
+ *   Lcore which runs the node, or RTE_GRAPH_DISPATCH_LCORE_ANY to run it on
+ *   whichever lcore walks the graph.
+ *
+ * @return
+ *   0 on success, negative errno value otherwise.
+ *
+ * @see rte_graph_dispatch_core_bind()
+ */
+__rte_experimental
+int rte_graph_dispatch_node_lcore_set(const char *name, unsigned int lcore_id);
+
 /**
  * Dump node info to file.
  *
@@ -21,6 +21,7 @@
 #include <rte_prefetch.h>
 #include <rte_memcpy.h>
 #include <rte_memory.h>
+#include <rte_ring.h>
 
 #include "rte_graph.h"
 
@@ -42,6 +43,17 @@ struct rte_graph {
 	rte_graph_off_t nodes_start; /**< Offset at which node memory starts. */
 	rte_graph_t id;	/**< Graph identifier. */
 	int socket;	/**< Socket ID where memory is allocated. */
+	enum rte_graph_model model;	/**< Walk model of the graph. */
+	unsigned int lcore_id;	/**< Lcore bound in dispatch model. */
+	rte_node_t nb_dispatch_nodes;	/**< Number of nodes pinned to lcore. */
+	struct rte_node **dispatch_nodes; /**< Nodes pinned to lcore. */
+	rte_node_t nb_dispatch_remotes;	/**< Number of nodes pinned elsewhere. */
+	struct rte_node **dispatch_remotes; /**< Nodes pinned elsewhere. */
+	uint32_t dispatch_seq;	/**< Odd while walked in dispatch model. */
+	uint32_t stats_interval;	/**< Walks per sampled walk. */
+	uint32_t stats_countdown;	/**< Walks left to the next sample. */
+	uint8_t stats_sampled;		/**< Current walk is sampled. */
+	uint8_t stats_hist;		/**< Node histograms are enabled. */
 	char name[RTE_GRAPH_NAMESIZE];	/**< Name of the graph. */
 	uint64_t fence;			/**< Fence. */
 } __rte_cache_aligned;
@@ -59,6 +71,12 @@ struct rte_node {
 	rte_node_t parent_id;	/**< Parent Node identifier. */
 	rte_edge_t nb_edges;	/**< Number of edges from this node. */
 	uint32_t realloc_count;	/**< Number of times realloced. */
+	unsigned int lcore_id;	/**< Lcore affinity in dispatch model. */
+	struct rte_ring *dispatch_ring;	/**< Dispatch queue of the node. */
+	uint64_t objs_hist[RTE_GRAPH_STATS_HIST_BINS];
+	/**< Histogram of objs per sampled call. */
+	uint64_t cycles_hist[RTE_GRAPH_STATS_HIST_BINS];
+	/**< Histogram of cycles per obj of sampled calls. */
 
 	char parent[RTE_NODE_NAMESIZE];	/**< Parent node name. */
 	char name[RTE_NODE_NAMESIZE];	/**< Name of the node. */
@@ -118,10 +136,240 @@ __rte_experimental
 void __rte_node_stream_alloc_size(struct rte_graph *graph,
 				  struct rte_node *node, uint16_t req_size);
 
+/**
+ * @internal
+ *
+ * Enqueue a given node to the tail of the graph reel.
+ *
+ * @param graph
+ *   Pointer Graph object.
+ * @param node
+ *   Pointer to node object to be enqueued.
+ */
+static __rte_always_inline void
+__rte_node_enqueue_tail_update(struct rte_graph *graph, struct rte_node *node)
+{
+	uint32_t tail;
+
+	tail = graph->tail;
+	graph->cir_start[tail++] = node->off;
+	graph->tail = tail & graph->cir_mask;
+}
+
+/**
+ * @internal
+ *
+ * Get the log2 histogram bin of a value, bin n holds [2^(n - 1), 2^n).
+ *
+ * @param val
+ *   Value to be accounted.
+ *
+ * @return
+ *   Histogram bin index.
+ */
+static __rte_always_inline unsigned int
+__rte_graph_stats_hist_bin(uint64_t val)
+{
+	unsigned int bin;
+
+	bin = val ? 64 - __builtin_clzll(val) : 0;
+	return RTE_MIN(bin, (unsigned int)RTE_GRAPH_STATS_HIST_BINS - 1);
+}
+
+/**
+ * @internal
+ *
+ * Decide whether the stats of the walk starting now are sampled.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ */
+static __rte_always_inline void
+__rte_graph_stats_sample(struct rte_graph *graph)
+{
+	if (likely(graph->stats_countdown == 0)) {
+		graph->stats_countdown = graph->stats_interval - 1;
+		graph->stats_sampled = 1;
+	} else {
+		graph->stats_countdown--;
+		graph->stats_sampled = 0;
+	}
+}
+
+/**
+ * @internal
+ *
+ * Invoke the process function of a node and collect the stats.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param node
+ *   Pointer to the node object.
+ */
+static __rte_always_inline void
+__rte_node_process(struct rte_graph *graph, struct rte_node *node)
+{
+	void **objs = node->objs;
+	uint64_t start, cycles;
+	uint16_t rc;
+
+	RTE_ASSERT(node->fence == RTE_GRAPH_FENCE);
+	rte_prefetch0(objs);
+
+	if (rte_graph_has_stats_feature()) {
+		if (graph->stats_sampled) {
+			start = rte_rdtsc();
+			rc = node->process(graph, node, objs, node->idx);
+			cycles = rte_rdtsc() - start;
+			/* Scale up to estimate the cycles of skipped walks */
+			node->total_cycles += cycles * graph->stats_interval;
+			if (unlikely(graph->stats_hist)) {
+				node->objs_hist[__rte_graph_stats_hist_bin(rc)]++;
+				node->cycles_hist[__rte_graph_stats_hist_bin(
+					rc ? cycles / rc : cycles)]++;
+			}
+		} else {
+			rc = node->process(graph, node, objs, node->idx);
+		}
+		node->total_calls++;
+		node->total_objs += rc;
+	} else {
+		node->process(graph, node, objs, node->idx);
+	}
+	node->idx = 0;
+}
+
+/**
+ * @internal
+ *
+ * Move the objects handed over by other lcores to the stream of a node
+ * pinned to the lcore of the graph.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param node
+ *   Pointer to the node object.
+ */
+static __rte_always_inline void
+__rte_graph_dispatch_drain(struct rte_graph *graph, struct rte_node *node)
+{
+	const uint16_t idx = node->idx;
+	unsigned int n;
+
+	/* A burst at a time, like a stream produced by a local node */
+	if (unlikely(node->size - idx < RTE_GRAPH_BURST_SIZE))
+		__rte_node_stream_alloc(graph, node);
+
+	n = rte_ring_sc_dequeue_burst(node->dispatch_ring, &node->objs[idx],
+				      RTE_GRAPH_BURST_SIZE, NULL);
+	if (n == 0)
+		return;
+
+	if (idx == 0)
+		__rte_node_enqueue_tail_update(graph, node);
+	node->idx = idx + n;
+}
+
+/**
+ * @internal
+ *
+ * Hand over the pending stream of a node to the lcore it is pinned to.
+ *
+ * Objects which cannot be handed over, because the queue is full or no graph
+ * is bound to the lcore, are kept in the stream for the next walk.
+ *
+ * @param node
+ *   Pointer to the node object.
+ */
+static __rte_always_inline void
+__rte_graph_dispatch_handoff(struct rte_node *node)
+{
+	struct rte_ring *ring;
+	unsigned int n;
+
+	/* Set and cleared under the graph lock by the (un)binding lcore */
+	ring = __atomic_load_n(&node->dispatch_ring, __ATOMIC_ACQUIRE);
+	if (unlikely(ring == NULL))
+		return;
+
+	n = rte_ring_mp_enqueue_burst(ring, node->objs, node->idx, NULL);
+	if (likely(n == node->idx)) {
+		node->idx = 0;
+		return;
+	}
+
+	/* Keep the rest in order, process() may swap it with the next */
+	node->idx -= n;
+	if (n)
+		memmove(node->objs, &node->objs[n], node->idx * sizeof(void *));
+}
+
+/**
+ * @internal
+ *
+ * Graph walk in dispatch model.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ */
+static inline void
+__rte_graph_walk_dispatch(struct rte_graph *graph)
+{
+	const rte_graph_off_t *cir_start = graph->cir_start;
+	const unsigned int lcore_id = graph->lcore_id;
+	const rte_node_t mask = graph->cir_mask;
+	uint32_t backlog = 0;
+	struct rte_node *node;
+	uint32_t head;
+	rte_node_t i;
+
+	/* Let an unbinding lcore wait for this walk before freeing queues */
+	__atomic_store_n(&graph->dispatch_seq, graph->dispatch_seq + 1,
+			 __ATOMIC_RELAXED);
+	rte_smp_mb();
+
+	/* Retry the streams held back by the previous walks */
+	for (i = 0; i < graph->nb_dispatch_remotes; i++) {
+		node = graph->dispatch_remotes[i];
+		if (unlikely(node->idx)) {
+			__rte_graph_dispatch_handoff(node);
+			backlog += node->idx;
+		}
+	}
+
+	/* Stop pulling new objects until the other lcores catch up */
+	if (unlikely(backlog >= RTE_GRAPH_DISPATCH_RING_SIZE))
+		goto done;
+
+	/* Pull the streams handed over by the other lcores first */
+	for (i = 0; i < graph->nb_dispatch_nodes; i++)
+		__rte_graph_dispatch_drain(graph, graph->dispatch_nodes[i]);
+
+	head = graph->head;
+	while (likely(head != graph->tail)) {
+		node = RTE_PTR_ADD(graph, cir_start[(int32_t)head++]);
+		if (node->lcore_id == RTE_GRAPH_DISPATCH_LCORE_ANY ||
+		    node->lcore_id == lcore_id)
+			__rte_node_process(graph, node);
+		else if (node->idx)
+			/* Source nodes pinned elsewhere have no stream */
+			__rte_graph_dispatch_handoff(node);
+		head = likely((int32_t)head > 0) ? head & mask : head;
+	}
+	graph->tail = 0;
+done:
+	__atomic_store_n(&graph->dispatch_seq, graph->dispatch_seq + 1,
+			 __ATOMIC_RELEASE);
+}
+
 /**
  * Perform graph walk on the circular buffer and invoke the process function
  * of the nodes and collect the stats.
  *
+ * If the graph is bound to an lcore with rte_graph_dispatch_core_bind(), only
+ * the nodes pinned to that lcore or without affinity are processed, and the
+ * streams of the others are handed over to the lcores they are pinned to.
+ *
  * @param graph
  *   Graph pointer returned from rte_graph_lookup function.
  *
@@ -135,9 +383,14 @@ rte_graph_walk(struct rte_graph *graph)
 	const rte_node_t mask = graph->cir_mask;
 	uint32_t head = graph->head;
 	struct rte_node *node;
-	uint64_t start;
-	uint16_t rc;
-	void **objs;
+
+	if (rte_graph_has_stats_feature())
+		__rte_graph_stats_sample(graph);
+
+	if (unlikely(graph->model == RTE_GRAPH_MODEL_DISPATCH)) {
+		__rte_graph_walk_dispatch(graph);
+		return;
+	}
 
 	/*
 	 * Walk on the source node(s) ((cir_start - head) -> cir_start) and then
@@ -156,20 +409,7 @@ rte_graph_walk(struct rte_graph *graph)
 	 */
 	while (likely(head != graph->tail)) {
 		node = RTE_PTR_ADD(graph, cir_start[(int32_t)head++]);
-		RTE_ASSERT(node->fence == RTE_GRAPH_FENCE);
-		objs = node->objs;
-		rte_prefetch0(objs);
-
-		if (rte_graph_has_stats_feature()) {
-			start = rte_rdtsc();
-			rc = node->process(graph, node, objs, node->idx);
-			node->total_cycles += rte_rdtsc() - start;
-			node->total_calls++;
-			node->total_objs += rc;
-		} else {
-			node->process(graph, node, objs, node->idx);
-		}
-		node->idx = 0;
+		__rte_node_process(graph, node);
 		head = likely((int32_t)head > 0) ? head & mask : head;
 	}
 	graph->tail = 0;
@@ -177,26 +417,6 @@ rte_graph_walk(struct rte_graph *graph)
 
 /* Fast path helper functions */
 
-/**
- * @internal
- *
- * Enqueue a given node to the tail of the graph reel.
- *
- * @param graph
- *   Pointer Graph object.
- * @param node
- *   Pointer to node object to be enqueued.
- */
-static __rte_always_inline void
-__rte_node_enqueue_tail_update(struct rte_graph *graph, struct rte_node *node)
-{
-	uint32_t tail;
-
-	tail = graph->tail;
-	graph->cir_start[tail++] = node->off;
-	graph->tail = tail & graph->cir_mask;
-}
-
 /**
  * @internal
  *
@@ -224,7 +444,7 @@ __rte_node_enqueue_prologue(struct rte_graph *graph, struct rte_node *node,
 		__rte_node_enqueue_tail_update(graph, node);
 
 	if (unlikely(node->size < (idx + space)))
-		__rte_node_stream_alloc(graph, node);
+		__rte_node_stream_alloc_size(graph, node, node->size + space);
 }
 
 /**
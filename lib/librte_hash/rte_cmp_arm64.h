@@ -2,6 +2,15 @@
  * Copyright(c) 2015 Cavium, Inc
  */
 
+/* Function to compare 8 byte keys */
+static int
+rte_hash_k8_cmp_eq(const void *key1, const void *key2,
+		size_t key_len __rte_unused)
+{
+	return *(const unaligned_uint64_t *)key1 !=
+		*(const unaligned_uint64_t *)key2;
+}
+
 /* Functions to compare multiple of 16 byte keys (up to 128 bytes) */
 static int
 rte_hash_k16_cmp_eq(const void *key1, const void *key2,
@@ -38,7 +38,8 @@
 				   RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY | \
 				   RTE_HASH_EXTRA_FLAGS_EXT_TABLE |	\
 				   RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL | \
-				   RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF)
+				   RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF | \
+				   RTE_HASH_EXTRA_FLAGS_RESIZABLE)
 
 #define FOR_EACH_BUCKET(CURRENT_BKT, START_BUCKET)                            \
 	for (CURRENT_BKT = START_BUCKET;                                      \
@@ -88,6 +89,8 @@ void rte_hash_set_cmp_func(struct rte_hash *h, rte_hash_cmp_eq_t func)
 {
 	h->cmp_jump_table_idx = KEY_CUSTOM;
 	h->rte_hash_custom_cmp_eq = func;
+	if (h->resize != NULL)
+		rte_hash_rsz_set_cmp_func(h, func);
 }
 
 static inline int
@@ -99,6 +102,32 @@ rte_hash_cmp_eq(const void *key1, const void *key2, const struct rte_hash *h)
 		return cmp_jump_table[h->cmp_jump_table_idx](key1, key2, h->key_len);
 }
 
+/*
+ * Compare keys with a compare function known at build time.
+ * Used by the bulk lookup, which is instantiated for the most common
+ * key sizes, so that the key compare gets inlined instead of being
+ * called through the jump table for every candidate entry.
+ */
+static __rte_always_inline int
+rte_hash_cmp_eq_fixed(const void *key1, const void *key2,
+	const struct rte_hash *h, enum cmp_jump_table_case cmp_idx)
+{
+	switch (cmp_idx) {
+#if defined(RTE_ARCH_X86) || defined(RTE_ARCH_ARM64)
+	case KEY_8_BYTES:
+		return rte_hash_k8_cmp_eq(key1, key2, h->key_len);
+	case KEY_16_BYTES:
+		return rte_hash_k16_cmp_eq(key1, key2, h->key_len);
+	case KEY_32_BYTES:
+		return rte_hash_k32_cmp_eq(key1, key2, h->key_len);
+	case KEY_64_BYTES:
+		return rte_hash_k64_cmp_eq(key1, key2, h->key_len);
+#endif
+	default:
+		return rte_hash_cmp_eq(key1, key2, h);
+	}
+}
+
 /*
  * We use higher 16 bits of hash as the signature value stored in table.
  * We use the lower bits for the primary bucket
@@ -129,8 +158,75 @@ get_alt_bucket_index(const struct rte_hash *h,
 	return (cur_bkt_idx ^ sig) & h->bucket_bitmask;
 }
 
-struct rte_hash *
-rte_hash_create(const struct rte_hash_parameters *params)
+/*
+ * Create the handle of a table with RTE_HASH_EXTRA_FLAGS_RESIZABLE,
+ * the tables storing the keys are created by rte_hash_rsz_create.
+ */
+static struct rte_hash *
+rte_hash_create_resizable(const struct rte_hash_parameters *params)
+{
+	struct rte_tailq_entry *te;
+	struct rte_hash_list *hash_list;
+	struct rte_hash *h;
+
+	hash_list = RTE_TAILQ_CAST(rte_hash_tailq.head, rte_hash_list);
+
+	h = rte_zmalloc_socket(NULL, sizeof(struct rte_hash),
+			RTE_CACHE_LINE_SIZE, params->socket_id);
+	if (h == NULL) {
+		RTE_LOG(ERR, HASH, "memory allocation failed\n");
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	strlcpy(h->name, params->name, sizeof(h->name));
+	h->entries = params->entries;
+	h->key_len = params->key_len;
+	h->hash_func = params->hash_func;
+	h->hash_func_init_val = params->hash_func_init_val;
+	h->resize = rte_hash_rsz_create(h, params);
+	if (h->resize == NULL) {
+		rte_free(h);
+		return NULL;
+	}
+
+	rte_mcfg_tailq_write_lock();
+
+	TAILQ_FOREACH(te, hash_list, next) {
+		if (strncmp(params->name, ((struct rte_hash *)te->data)->name,
+				RTE_HASH_NAMESIZE) == 0)
+			break;
+	}
+	if (te != NULL) {
+		rte_errno = EEXIST;
+		goto err_unlock;
+	}
+
+	te = rte_zmalloc("HASH_TAILQ_ENTRY", sizeof(*te), 0);
+	if (te == NULL) {
+		RTE_LOG(ERR, HASH, "tailq entry allocation failed\n");
+		rte_errno = ENOMEM;
+		goto err_unlock;
+	}
+
+	te->data = (void *) h;
+	TAILQ_INSERT_TAIL(hash_list, te, next);
+	rte_mcfg_tailq_write_unlock();
+
+	return h;
+err_unlock:
+	rte_mcfg_tailq_write_unlock();
+	rte_hash_rsz_free(h);
+	rte_free(h);
+	return NULL;
+}
+
+/*
+ * Create a table, registered in the hash list unless it is one of the
+ * private tables of a resizable table.
+ */
+static struct rte_hash *
+hash_create(const struct rte_hash_parameters *params, unsigned int listed)
 {
 	struct rte_hash *h = NULL;
 	struct rte_tailq_entry *te = NULL;
@@ -188,6 +284,18 @@ rte_hash_create(const struct rte_hash_parameters *params)
 		return NULL;
 	}
 
+	if ((params->extra_flag & RTE_HASH_EXTRA_FLAGS_RESIZABLE) &&
+	    (params->extra_flag & (RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY |
+				   RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL))) {
+		rte_errno = EINVAL;
+		RTE_LOG(ERR, HASH, "rte_hash_create: resizable table requires "
+			"rw concurrency lock free\n");
+		return NULL;
+	}
+
+	if (params->extra_flag & RTE_HASH_EXTRA_FLAGS_RESIZABLE)
+		return rte_hash_create_resizable(params);
+
 	/* Check extra flags field to check extra options. */
 	if (params->extra_flag & RTE_HASH_EXTRA_FLAGS_TRANS_MEM_SUPPORT)
 		hw_trans_mem_support = 1;
@@ -257,24 +365,27 @@ rte_hash_create(const struct rte_hash_parameters *params)
 
 	rte_mcfg_tailq_write_lock();
 
-	/* guarantee there's no existing: this is normally already checked
-	 * by ring creation above */
-	TAILQ_FOREACH(te, hash_list, next) {
-		h = (struct rte_hash *) te->data;
-		if (strncmp(params->name, h->name, RTE_HASH_NAMESIZE) == 0)
-			break;
-	}
-	h = NULL;
-	if (te != NULL) {
-		rte_errno = EEXIST;
-		te = NULL;
-		goto err_unlock;
-	}
+	if (listed) {
+		/* guarantee there's no existing: this is normally already
+		 * checked by ring creation above */
+		TAILQ_FOREACH(te, hash_list, next) {
+			h = (struct rte_hash *) te->data;
+			if (strncmp(params->name, h->name,
+					RTE_HASH_NAMESIZE) == 0)
+				break;
+		}
+		h = NULL;
+		if (te != NULL) {
+			rte_errno = EEXIST;
+			te = NULL;
+			goto err_unlock;
+		}
 
-	te = rte_zmalloc("HASH_TAILQ_ENTRY", sizeof(*te), 0);
-	if (te == NULL) {
-		RTE_LOG(ERR, HASH, "tailq entry allocation failed\n");
-		goto err_unlock;
+		te = rte_zmalloc("HASH_TAILQ_ENTRY", sizeof(*te), 0);
+		if (te == NULL) {
+			RTE_LOG(ERR, HASH, "tailq entry allocation failed\n");
+			goto err_unlock;
+		}
 	}
 
 	h = (struct rte_hash *)rte_zmalloc_socket(hash_name, sizeof(struct rte_hash),
@@ -351,6 +462,9 @@ rte_hash_create(const struct rte_hash_parameters *params)
 #if defined(RTE_ARCH_X86) || defined(RTE_ARCH_ARM64)
 	/* Select function to compare keys */
 	switch (params->key_len) {
+	case 8:
+		h->cmp_jump_table_idx = KEY_8_BYTES;
+		break;
 	case 16:
 		h->cmp_jump_table_idx = KEY_16_BYTES;
 		break;
@@ -429,6 +543,17 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	h->readwrite_concur_lf_support = readwrite_concur_lf_support;
 
 #if defined(RTE_ARCH_X86)
+#ifdef CC_AVX512_SUPPORT
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW))
+		h->sig_cmp_fn = RTE_HASH_COMPARE_AVX512;
+	else
+#endif
+#if defined(RTE_MACHINE_CPUFLAG_AVX2)
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2))
+		h->sig_cmp_fn = RTE_HASH_COMPARE_AVX2;
+	else
+#endif
 	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_SSE2))
 		h->sig_cmp_fn = RTE_HASH_COMPARE_SSE;
 	else
@@ -456,8 +581,10 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	for (i = 1; i < num_key_slots; i++)
 		rte_ring_sp_enqueue_elem(r, &i, sizeof(uint32_t));
 
-	te->data = (void *) h;
-	TAILQ_INSERT_TAIL(hash_list, te, next);
+	if (listed) {
+		te->data = (void *) h;
+		TAILQ_INSERT_TAIL(hash_list, te, next);
+	}
 	rte_mcfg_tailq_write_unlock();
 
 	return h;
@@ -477,6 +604,41 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	return NULL;
 }
 
+struct rte_hash *
+rte_hash_create(const struct rte_hash_parameters *params)
+{
+	return hash_create(params, 1);
+}
+
+struct rte_hash *
+rte_hash_create_unlisted(const struct rte_hash_parameters *params)
+{
+	return hash_create(params, 0);
+}
+
+void
+rte_hash_free_unlisted(struct rte_hash *h)
+{
+	if (h == NULL)
+		return;
+
+	if (h->dq != NULL)
+		rte_rcu_qsbr_dq_delete(h->dq);
+
+	if (h->use_local_cache)
+		rte_free(h->local_free_slots);
+	if (h->writer_takes_lock)
+		rte_free(h->readwrite_lock);
+	rte_ring_free(h->free_slots);
+	rte_ring_free(h->free_ext_bkts);
+	rte_free(h->key_store);
+	rte_free(h->buckets);
+	rte_free(h->buckets_ext);
+	rte_free(h->tbl_chng_cnt);
+	rte_free(h->ext_bkt_to_free);
+	rte_free(h);
+}
+
 void
 rte_hash_free(struct rte_hash *h)
 {
@@ -505,21 +667,103 @@ rte_hash_free(struct rte_hash *h)
 
 	rte_mcfg_tailq_write_unlock();
 
-	if (h->use_local_cache)
-		rte_free(h->local_free_slots);
-	if (h->writer_takes_lock)
-		rte_free(h->readwrite_lock);
-	rte_ring_free(h->free_slots);
-	rte_ring_free(h->free_ext_bkts);
-	rte_free(h->key_store);
-	rte_free(h->buckets);
-	rte_free(h->buckets_ext);
-	rte_free(h->tbl_chng_cnt);
-	rte_free(h->ext_bkt_to_free);
-	rte_free(h);
+	if (h->resize != NULL) {
+		if (h->dq != NULL)
+			rte_rcu_qsbr_dq_delete(h->dq);
+		rte_hash_rsz_free(h);
+		rte_free(h);
+		rte_free(te);
+		return;
+	}
+
+	rte_hash_free_unlisted(h);
 	rte_free(te);
 }
 
+static void
+__hash_rcu_qsbr_free_resource(void *p, void *data, unsigned int n)
+{
+	RTE_SET_USED(n);
+	/* Return key index to the free slots */
+	rte_hash_free_key_with_position((struct rte_hash *)p,
+			*(int32_t *)data);
+}
+
+/* Associate QSBR variable with a hash table.
+ */
+int
+rte_hash_rcu_qsbr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg)
+{
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
+
+	if (h == NULL || cfg == NULL || cfg->v == NULL) {
+		rte_errno = EINVAL;
+		return 1;
+	}
+
+	if (h->rcu_cfg.v != NULL) {
+		rte_errno = EEXIST;
+		return 1;
+	}
+
+	if (cfg->mode == RTE_HASH_QSBR_MODE_SYNC) {
+		/* No other things to do. */
+	} else if (cfg->mode == RTE_HASH_QSBR_MODE_DQ) {
+		/* Init QSBR defer queue. */
+		snprintf(rcu_dq_name, sizeof(rcu_dq_name),
+				"HASH_RCU_%s", h->name);
+		params.name = rcu_dq_name;
+		params.size = cfg->dq_size;
+		if (params.size == 0)
+			params.size = h->entries;
+		params.trigger_reclaim_limit = cfg->reclaim_thd;
+		params.max_reclaim_size = cfg->reclaim_max;
+		if (params.max_reclaim_size == 0)
+			params.max_reclaim_size = RTE_HASH_RCU_DQ_RECLAIM_MAX;
+		if (h->resize != NULL) {
+			/* Snapshot of the tables left by a resize */
+			params.esize = sizeof(struct rte_hash_rsz_tables *);
+			params.free_fn = rte_hash_rsz_free_resource;
+		} else {
+			params.esize = sizeof(uint32_t);	/* key index */
+			params.free_fn = __hash_rcu_qsbr_free_resource;
+		}
+		params.p = h;
+		params.v = cfg->v;
+		h->dq = rte_rcu_qsbr_dq_create(&params);
+		if (h->dq == NULL) {
+			RTE_LOG(ERR, HASH, "HASH defer queue creation failed\n");
+			return 1;
+		}
+	} else {
+		rte_errno = EINVAL;
+		return 1;
+	}
+	h->rcu_cfg = *cfg;
+	h->rcu_cfg.reclaim_max = params.max_reclaim_size;
+
+	if (h->resize != NULL && rte_hash_rsz_rcu_qsbr_add(h) != 0) {
+		rte_rcu_qsbr_dq_delete(h->dq);
+		h->dq = NULL;
+		memset(&h->rcu_cfg, 0, sizeof(h->rcu_cfg));
+		return 1;
+	}
+
+	return 0;
+}
+
+int
+rte_hash_resize_step(struct rte_hash *h, uint32_t n)
+{
+	RETURN_IF_TRUE((h == NULL), -EINVAL);
+
+	if (h->resize == NULL)
+		return 0;
+
+	return rte_hash_rsz_step(h, n);
+}
+
 hash_sig_t
 rte_hash_hash(const struct rte_hash *h, const void *key)
 {
@@ -531,6 +775,8 @@ int32_t
 rte_hash_max_key_id(const struct rte_hash *h)
 {
 	RETURN_IF_TRUE((h == NULL), -EINVAL);
+	if (h->resize != NULL)
+		return rte_hash_rsz_max_key_id(h);
 	if (h->use_local_cache)
 		/*
 		 * Increase number of slots by total number of indices
@@ -551,6 +797,9 @@ rte_hash_count(const struct rte_hash *h)
 	if (h == NULL)
 		return -EINVAL;
 
+	if (h->resize != NULL)
+		return rte_hash_rsz_count(h);
+
 	if (h->use_local_cache) {
 		tot_ring_cnt = h->entries + (RTE_MAX_LCORE - 1) *
 					(LCORE_CACHE_SIZE - 1);
@@ -603,14 +852,42 @@ __hash_rw_reader_unlock(const struct rte_hash *h)
 		rte_rwlock_read_unlock(h->readwrite_lock);
 }
 
+/* Writer lock of the add path, held by the caller for a bulk insertion */
+static __rte_always_inline void
+__hash_rw_writer_lock_add(const struct rte_hash *h, const int bulk)
+{
+	if (!bulk)
+		__hash_rw_writer_lock(h);
+}
+
+static __rte_always_inline void
+__hash_rw_writer_unlock_add(const struct rte_hash *h, const int bulk)
+{
+	if (!bulk)
+		__hash_rw_writer_unlock(h);
+}
+
 void
 rte_hash_reset(struct rte_hash *h)
 {
 	uint32_t tot_ring_cnt, i;
+	unsigned int pending;
 
 	if (h == NULL)
 		return;
 
+	if (h->dq != NULL) {
+		/* Reclaim all the resources */
+		rte_rcu_qsbr_dq_reclaim(h->dq, ~0, NULL, &pending, NULL);
+		if (pending != 0)
+			RTE_LOG(ERR, HASH, "RCU reclaim all resources failed\n");
+	}
+
+	if (h->resize != NULL) {
+		rte_hash_rsz_reset(h);
+		return;
+	}
+
 	__hash_rw_writer_lock(h);
 	memset(h->buckets, 0, h->num_buckets * sizeof(struct rte_hash_bucket));
 	memset(h->key_store, 0, h->key_entry_size * (h->entries + 1));
@@ -654,14 +931,15 @@ rte_hash_reset(struct rte_hash *h)
 /*
  * Function called to enqueue back an index in the cache/ring,
  * as slot has not being used and it can be used in the
- * next addition attempt.
+ * next addition attempt. The cache is either the lcore cache
+ * or the key indexes allocated for a bulk insertion.
  */
 static inline void
 enqueue_slot_back(const struct rte_hash *h,
 		struct lcore_cache *cached_free_slots,
 		uint32_t slot_id)
 {
-	if (h->use_local_cache) {
+	if (cached_free_slots != NULL) {
 		cached_free_slots->objs[cached_free_slots->len] = slot_id;
 		cached_free_slots->len++;
 	} else
@@ -709,25 +987,25 @@ search_and_update(const struct rte_hash *h, void *data, const void *key,
  * return 1 if matching existing key, return 0 if succeeds, return -1 for no
  * empty entry.
  */
-static inline int32_t
+static __rte_always_inline int32_t
 rte_hash_cuckoo_insert_mw(const struct rte_hash *h,
 		struct rte_hash_bucket *prim_bkt,
 		struct rte_hash_bucket *sec_bkt,
 		const struct rte_hash_key *key, void *data,
 		uint16_t sig, uint32_t new_idx,
-		int32_t *ret_val)
+		int32_t *ret_val, const int bulk)
 {
 	unsigned int i;
 	struct rte_hash_bucket *cur_bkt;
 	int32_t ret;
 
-	__hash_rw_writer_lock(h);
+	__hash_rw_writer_lock_add(h, bulk);
 	/* Check if key was inserted after last check but before this
 	 * protected region in case of inserting duplicated keys.
 	 */
 	ret = search_and_update(h, data, key, prim_bkt, sig);
 	if (ret != -1) {
-		__hash_rw_writer_unlock(h);
+		__hash_rw_writer_unlock_add(h, bulk);
 		*ret_val = ret;
 		return 1;
 	}
@@ -735,7 +1013,7 @@ rte_hash_cuckoo_insert_mw(const struct rte_hash *h,
 	FOR_EACH_BUCKET(cur_bkt, sec_bkt) {
 		ret = search_and_update(h, data, key, cur_bkt, sig);
 		if (ret != -1) {
-			__hash_rw_writer_unlock(h);
+			__hash_rw_writer_unlock_add(h, bulk);
 			*ret_val = ret;
 			return 1;
 		}
@@ -759,7 +1037,7 @@ rte_hash_cuckoo_insert_mw(const struct rte_hash *h,
 			break;
 		}
 	}
-	__hash_rw_writer_unlock(h);
+	__hash_rw_writer_unlock_add(h, bulk);
 
 	if (i != RTE_HASH_BUCKET_ENTRIES)
 		return 0;
@@ -773,14 +1051,14 @@ rte_hash_cuckoo_insert_mw(const struct rte_hash *h,
  * return 1 if matched key found, return -1 if cuckoo path invalided and fail,
  * return 0 if succeeds.
  */
-static inline int
+static __rte_always_inline int
 rte_hash_cuckoo_move_insert_mw(const struct rte_hash *h,
 			struct rte_hash_bucket *bkt,
 			struct rte_hash_bucket *alt_bkt,
 			const struct rte_hash_key *key, void *data,
 			struct queue_node *leaf, uint32_t leaf_slot,
 			uint16_t sig, uint32_t new_idx,
-			int32_t *ret_val)
+			int32_t *ret_val, const int bulk)
 {
 	uint32_t prev_alt_bkt_idx;
 	struct rte_hash_bucket *cur_bkt;
@@ -789,11 +1067,11 @@ rte_hash_cuckoo_move_insert_mw(const struct rte_hash *h,
 	uint32_t prev_slot, curr_slot = leaf_slot;
 	int32_t ret;
 
-	__hash_rw_writer_lock(h);
+	__hash_rw_writer_lock_add(h, bulk);
 
 	/* In case empty slot was gone before entering protected region */
 	if (curr_bkt->key_idx[curr_slot] != EMPTY_SLOT) {
-		__hash_rw_writer_unlock(h);
+		__hash_rw_writer_unlock_add(h, bulk);
 		return -1;
 	}
 
@@ -802,7 +1080,7 @@ rte_hash_cuckoo_move_insert_mw(const struct rte_hash *h,
 	 */
 	ret = search_and_update(h, data, key, bkt, sig);
 	if (ret != -1) {
-		__hash_rw_writer_unlock(h);
+		__hash_rw_writer_unlock_add(h, bulk);
 		*ret_val = ret;
 		return 1;
 	}
@@ -810,7 +1088,7 @@ rte_hash_cuckoo_move_insert_mw(const struct rte_hash *h,
 	FOR_EACH_BUCKET(cur_bkt, alt_bkt) {
 		ret = search_and_update(h, data, key, cur_bkt, sig);
 		if (ret != -1) {
-			__hash_rw_writer_unlock(h);
+			__hash_rw_writer_unlock_add(h, bulk);
 			*ret_val = ret;
 			return 1;
 		}
@@ -831,7 +1109,7 @@ rte_hash_cuckoo_move_insert_mw(const struct rte_hash *h,
 			__atomic_store_n(&curr_bkt->key_idx[curr_slot],
 				EMPTY_SLOT,
 				__ATOMIC_RELEASE);
-			__hash_rw_writer_unlock(h);
+			__hash_rw_writer_unlock_add(h, bulk);
 			return -1;
 		}
 
@@ -889,7 +1167,7 @@ rte_hash_cuckoo_move_insert_mw(const struct rte_hash *h,
 			 new_idx,
 			 __ATOMIC_RELEASE);
 
-	__hash_rw_writer_unlock(h);
+	__hash_rw_writer_unlock_add(h, bulk);
 
 	return 0;
 
@@ -899,13 +1177,13 @@ rte_hash_cuckoo_move_insert_mw(const struct rte_hash *h,
  * Make space for new key, using bfs Cuckoo Search and Multi-Writer safe
  * Cuckoo
  */
-static inline int
+static __rte_always_inline int
 rte_hash_cuckoo_make_space_mw(const struct rte_hash *h,
 			struct rte_hash_bucket *bkt,
 			struct rte_hash_bucket *sec_bkt,
 			const struct rte_hash_key *key, void *data,
 			uint16_t sig, uint32_t bucket_idx,
-			uint32_t new_idx, int32_t *ret_val)
+			uint32_t new_idx, int32_t *ret_val, const int bulk)
 {
 	unsigned int i;
 	struct queue_node queue[RTE_HASH_BFS_QUEUE_MAX_LEN];
@@ -931,7 +1209,7 @@ rte_hash_cuckoo_make_space_mw(const struct rte_hash *h,
 				int32_t ret = rte_hash_cuckoo_move_insert_mw(h,
 						bkt, sec_bkt, key, data,
 						tail, i, sig,
-						new_idx, ret_val);
+						new_idx, ret_val, bulk);
 				if (likely(ret != -1))
 					return ret;
 			}
@@ -952,10 +1230,35 @@ rte_hash_cuckoo_make_space_mw(const struct rte_hash *h,
 	return -ENOSPC;
 }
 
-static inline int32_t
-__rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
-						hash_sig_t sig, void *data)
+/*
+ * Free the key indexes of deleted keys that the readers stopped
+ * referencing, when no free key index is left.
+ */
+static inline int
+__rte_hash_rcu_reclaim(const struct rte_hash *h)
+{
+	unsigned int freed = 0;
+
+	if (h->dq == NULL)
+		return -ENOSPC;
+
+	rte_rcu_qsbr_dq_reclaim(h->dq, h->rcu_cfg.reclaim_max,
+			&freed, NULL, NULL);
+
+	return freed != 0 ? 0 : -ENOSPC;
+}
+
+/*
+ * Add a key. With @burst NULL, the writer lock is taken when needed and the
+ * key index comes from the lcore cache or the free slots ring. Otherwise the
+ * caller holds the writer lock and the key index comes from @burst, where
+ * it is returned if unused.
+ */
+static __rte_always_inline int32_t
+__rte_hash_add_key_common(const struct rte_hash *h, const void *key,
+		hash_sig_t sig, void *data, struct lcore_cache *burst)
 {
+	const int bulk = burst != NULL;
 	uint16_t short_sig;
 	uint32_t prim_bucket_idx, sec_bucket_idx;
 	struct rte_hash_bucket *prim_bkt, *sec_bkt, *cur_bkt;
@@ -970,6 +1273,9 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 	int32_t ret_val;
 	struct rte_hash_bucket *last;
 
+	if (unlikely(h->resize != NULL))
+		return rte_hash_rsz_add(h, key, sig, data);
+
 	short_sig = get_short_sig(sig);
 	prim_bucket_idx = get_prim_bucket_index(h, sig);
 	sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx, short_sig);
@@ -979,10 +1285,10 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 	rte_prefetch0(sec_bkt);
 
 	/* Check if key is already inserted in primary location */
-	__hash_rw_writer_lock(h);
+	__hash_rw_writer_lock_add(h, bulk);
 	ret = search_and_update(h, data, key, prim_bkt, short_sig);
 	if (ret != -1) {
-		__hash_rw_writer_unlock(h);
+		__hash_rw_writer_unlock_add(h, bulk);
 		return ret;
 	}
 
@@ -990,15 +1296,21 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 	FOR_EACH_BUCKET(cur_bkt, sec_bkt) {
 		ret = search_and_update(h, data, key, cur_bkt, short_sig);
 		if (ret != -1) {
-			__hash_rw_writer_unlock(h);
+			__hash_rw_writer_unlock_add(h, bulk);
 			return ret;
 		}
 	}
 
-	__hash_rw_writer_unlock(h);
+	__hash_rw_writer_unlock_add(h, bulk);
 
 	/* Did not find a match, so get a new slot for storing the new key */
-	if (h->use_local_cache) {
+	if (bulk) {
+		if (burst->len == 0)
+			return -ENOSPC;
+		cached_free_slots = burst;
+		cached_free_slots->len--;
+		slot_id = cached_free_slots->objs[cached_free_slots->len];
+	} else if (h->use_local_cache) {
 		lcore_id = rte_lcore_id();
 		cached_free_slots = &h->local_free_slots[lcore_id];
 		/* Try to get a free slot from the local cache */
@@ -1008,7 +1320,9 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 					cached_free_slots->objs,
 					sizeof(uint32_t),
 					LCORE_CACHE_SIZE, NULL);
-			if (n_slots == 0) {
+			/* Key indexes reclaimed go to this lcore cache */
+			if (n_slots == 0 && (__rte_hash_rcu_reclaim(h) != 0 ||
+					cached_free_slots->len == 0)) {
 				return -ENOSPC;
 			}
 
@@ -1020,7 +1334,10 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 		slot_id = cached_free_slots->objs[cached_free_slots->len];
 	} else {
 		if (rte_ring_sc_dequeue_elem(h->free_slots, &slot_id,
-						sizeof(uint32_t)) != 0) {
+						sizeof(uint32_t)) != 0 &&
+				(__rte_hash_rcu_reclaim(h) != 0 ||
+				rte_ring_sc_dequeue_elem(h->free_slots,
+					&slot_id, sizeof(uint32_t)) != 0)) {
 			return -ENOSPC;
 		}
 	}
@@ -1038,7 +1355,7 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 
 	/* Find an empty slot and insert */
 	ret = rte_hash_cuckoo_insert_mw(h, prim_bkt, sec_bkt, key, data,
-					short_sig, slot_id, &ret_val);
+					short_sig, slot_id, &ret_val, bulk);
 	if (ret == 0)
 		return slot_id - 1;
 	else if (ret == 1) {
@@ -1048,7 +1365,8 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 
 	/* Primary bucket full, need to make space for new entry */
 	ret = rte_hash_cuckoo_make_space_mw(h, prim_bkt, sec_bkt, key, data,
-				short_sig, prim_bucket_idx, slot_id, &ret_val);
+				short_sig, prim_bucket_idx, slot_id, &ret_val,
+				bulk);
 	if (ret == 0)
 		return slot_id - 1;
 	else if (ret == 1) {
@@ -1058,7 +1376,8 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 
 	/* Also search secondary bucket to get better occupancy */
 	ret = rte_hash_cuckoo_make_space_mw(h, sec_bkt, prim_bkt, key, data,
-				short_sig, sec_bucket_idx, slot_id, &ret_val);
+				short_sig, sec_bucket_idx, slot_id, &ret_val,
+				bulk);
 
 	if (ret == 0)
 		return slot_id - 1;
@@ -1076,7 +1395,7 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 	/* Now we need to go through the extendable bucket. Protection is needed
 	 * to protect all extendable bucket processes.
 	 */
-	__hash_rw_writer_lock(h);
+	__hash_rw_writer_lock_add(h, bulk);
 	/* We check for duplicates again since could be inserted before the lock */
 	ret = search_and_update(h, data, key, prim_bkt, short_sig);
 	if (ret != -1) {
@@ -1106,7 +1425,7 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 				__atomic_store_n(&cur_bkt->key_idx[i],
 						 slot_id,
 						 __ATOMIC_RELEASE);
-				__hash_rw_writer_unlock(h);
+				__hash_rw_writer_unlock_add(h, bulk);
 				return slot_id - 1;
 			}
 		}
@@ -1134,15 +1453,22 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 	/* Link the new bucket to sec bucket linked list */
 	last = rte_hash_get_last_bkt(sec_bkt);
 	last->next = &h->buckets_ext[ext_bkt_id - 1];
-	__hash_rw_writer_unlock(h);
+	__hash_rw_writer_unlock_add(h, bulk);
 	return slot_id - 1;
 
 failure:
-	__hash_rw_writer_unlock(h);
+	__hash_rw_writer_unlock_add(h, bulk);
 	return ret;
 
 }
 
+static inline int32_t
+__rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
+						hash_sig_t sig, void *data)
+{
+	return __rte_hash_add_key_common(h, key, sig, data, NULL);
+}
+
 int32_t
 rte_hash_add_key_with_hash(const struct rte_hash *h,
 			const void *key, hash_sig_t sig)
@@ -1186,6 +1512,154 @@ rte_hash_add_key_data(const struct rte_hash *h, const void *key, void *data)
 		return ret;
 }
 
+/* Get up to @n free key indexes at once, from the lcore cache when used */
+static inline uint32_t
+__hash_alloc_slots(const struct rte_hash *h, uint32_t *slots, uint32_t n)
+{
+	struct lcore_cache *cached_free_slots;
+	uint32_t cnt = 0, m;
+	int retry = 1;
+
+	do {
+		if (h->use_local_cache) {
+			cached_free_slots =
+				&h->local_free_slots[rte_lcore_id()];
+			/* Refill the cache from the global ring when it
+			 * cannot provide the whole burst.
+			 */
+			if (cached_free_slots->len < n - cnt)
+				cached_free_slots->len +=
+					rte_ring_mc_dequeue_burst_elem(
+						h->free_slots,
+						cached_free_slots->objs +
+						cached_free_slots->len,
+						sizeof(uint32_t),
+						LCORE_CACHE_SIZE -
+						cached_free_slots->len, NULL);
+			m = RTE_MIN(cached_free_slots->len, n - cnt);
+			cached_free_slots->len -= m;
+			memcpy(&slots[cnt],
+				&cached_free_slots->objs[cached_free_slots->len],
+				m * sizeof(uint32_t));
+		} else
+			m = rte_ring_sc_dequeue_burst_elem(h->free_slots,
+					&slots[cnt], sizeof(uint32_t),
+					n - cnt, NULL);
+		cnt += m;
+	} while (cnt < n && retry-- != 0 && __rte_hash_rcu_reclaim(h) == 0);
+
+	return cnt;
+}
+
+/* Give back the key indexes a bulk insertion did not use */
+static inline void
+__hash_free_slots(const struct rte_hash *h, const uint32_t *slots, uint32_t n)
+{
+	struct lcore_cache *cached_free_slots;
+	uint32_t m;
+
+	if (n == 0)
+		return;
+
+	if (h->use_local_cache) {
+		cached_free_slots = &h->local_free_slots[rte_lcore_id()];
+		m = RTE_MIN(n, LCORE_CACHE_SIZE - cached_free_slots->len);
+		memcpy(&cached_free_slots->objs[cached_free_slots->len],
+			slots, m * sizeof(uint32_t));
+		cached_free_slots->len += m;
+		/* Cache full, the rest goes to the global ring */
+		if (m < n)
+			rte_ring_mp_enqueue_bulk_elem(h->free_slots, slots + m,
+					sizeof(uint32_t), n - m, NULL);
+	} else
+		rte_ring_sp_enqueue_bulk_elem(h->free_slots, slots,
+				sizeof(uint32_t), n, NULL);
+}
+
+/*
+ * Add a burst of keys. The key indexes are allocated all at once before
+ * taking the writer lock a single time for the whole burst.
+ */
+static inline int
+__rte_hash_add_key_bulk(const struct rte_hash *h, const void **keys,
+		const hash_sig_t *sig, void *data[], uint32_t num_keys,
+		int32_t *positions)
+{
+	hash_sig_t sigs[RTE_HASH_LOOKUP_BULK_MAX];
+	struct lcore_cache burst;
+	uint32_t prim_bucket_idx, sec_bucket_idx;
+	uint16_t short_sig;
+	uint32_t i;
+	int added = 0;
+
+	if (sig == NULL) {
+		for (i = 0; i < num_keys; i++)
+			sigs[i] = rte_hash_hash(h, keys[i]);
+		sig = sigs;
+	}
+
+	if (unlikely(h->resize != NULL)) {
+		for (i = 0; i < num_keys; i++) {
+			positions[i] = rte_hash_rsz_add(h, keys[i], sig[i],
+					data != NULL ? data[i] : NULL);
+			if (positions[i] >= 0)
+				added++;
+		}
+		return added;
+	}
+
+	for (i = 0; i < num_keys; i++) {
+		short_sig = get_short_sig(sig[i]);
+		prim_bucket_idx = get_prim_bucket_index(h, sig[i]);
+		sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx,
+				short_sig);
+		rte_prefetch0(&h->buckets[prim_bucket_idx]);
+		rte_prefetch0(&h->buckets[sec_bucket_idx]);
+	}
+
+	burst.len = __hash_alloc_slots(h, burst.objs, num_keys);
+
+	__hash_rw_writer_lock(h);
+	for (i = 0; i < num_keys; i++) {
+		positions[i] = __rte_hash_add_key_common(h, keys[i], sig[i],
+				data != NULL ? data[i] : NULL, &burst);
+		if (positions[i] >= 0)
+			added++;
+	}
+	__hash_rw_writer_unlock(h);
+
+	__hash_free_slots(h, burst.objs, burst.len);
+
+	return added;
+}
+
+int
+rte_hash_add_key_bulk(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, int32_t *positions)
+{
+	RETURN_IF_TRUE(((h == NULL) || (keys == NULL) || (num_keys == 0) ||
+			(num_keys > RTE_HASH_LOOKUP_BULK_MAX) ||
+			(positions == NULL)), -EINVAL);
+
+	return __rte_hash_add_key_bulk(h, keys, NULL, NULL, num_keys,
+			positions);
+}
+
+int
+rte_hash_add_key_with_hash_bulk_data(const struct rte_hash *h,
+		const void **keys, hash_sig_t *sig, void *data[],
+		uint32_t num_keys, int32_t *positions)
+{
+	int32_t pos[RTE_HASH_LOOKUP_BULK_MAX];
+
+	RETURN_IF_TRUE(((h == NULL) || (keys == NULL) || (sig == NULL) ||
+			(data == NULL) || (num_keys == 0) ||
+			(num_keys > RTE_HASH_LOOKUP_BULK_MAX)), -EINVAL);
+
+	return __rte_hash_add_key_bulk(h, keys, sig, data, num_keys,
+			positions != NULL ? positions : pos);
+}
+
 /* Search one bucket to find the match key - uses rw lock */
 static inline int32_t
 search_one_bucket_l(const struct rte_hash *h, const void *key,
@@ -1359,6 +1833,8 @@ static inline int32_t
 __rte_hash_lookup_with_hash(const struct rte_hash *h, const void *key,
 					hash_sig_t sig, void **data)
 {
+	if (unlikely(h->resize != NULL))
+		return rte_hash_rsz_lookup(h, key, sig, data);
 	if (h->readwrite_concur_lf_support)
 		return __rte_hash_lookup_with_hash_lf(h, key, sig, data);
 	else
@@ -1593,19 +2069,48 @@ __rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
 	return ret;
 }
 
+/*
+ * Delete a key and, when a RCU QSBR variable is attached to a table not
+ * freeing key indexes on delete, free its index once it is unreferenced.
+ */
+static inline int32_t
+__rte_hash_del_key_rcu(const struct rte_hash *h, const void *key,
+			hash_sig_t sig)
+{
+	int32_t pos;
+
+	if (unlikely(h->resize != NULL))
+		return rte_hash_rsz_del(h, key, sig);
+
+	pos = __rte_hash_del_key_with_hash(h, key, sig);
+	if (pos < 0 || h->rcu_cfg.v == NULL || !h->no_free_on_del)
+		return pos;
+
+	if (h->rcu_cfg.mode == RTE_HASH_QSBR_MODE_SYNC) {
+		/* Wait for quiescent state change. */
+		rte_rcu_qsbr_synchronize(h->rcu_cfg.v, RTE_QSBR_THRID_INVALID);
+		rte_hash_free_key_with_position(h, pos);
+	} else if (rte_rcu_qsbr_dq_enqueue(h->dq, &pos) != 0) {
+		/* Push into QSBR defer queue. */
+		RTE_LOG(ERR, HASH, "Failed to push QSBR FIFO\n");
+	}
+
+	return pos;
+}
+
 int32_t
 rte_hash_del_key_with_hash(const struct rte_hash *h,
 			const void *key, hash_sig_t sig)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
-	return __rte_hash_del_key_with_hash(h, key, sig);
+	return __rte_hash_del_key_rcu(h, key, sig);
 }
 
 int32_t
 rte_hash_del_key(const struct rte_hash *h, const void *key)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
-	return __rte_hash_del_key_with_hash(h, key, rte_hash_hash(h, key));
+	return __rte_hash_del_key_rcu(h, key, rte_hash_hash(h, key));
 }
 
 int
@@ -1614,6 +2119,9 @@ rte_hash_get_key_with_position(const struct rte_hash *h, const int32_t position,
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
 
+	if (h->resize != NULL)
+		return -ENOTSUP;
+
 	struct rte_hash_key *k, *keys = h->key_store;
 	k = (struct rte_hash_key *) ((char *) keys + (position + 1) *
 				     h->key_entry_size);
@@ -1643,6 +2151,9 @@ rte_hash_free_key_with_position(const struct rte_hash *h,
 		h->entries + (RTE_MAX_LCORE - 1) * (LCORE_CACHE_SIZE - 1) + 1
 							: h->entries + 1;
 
+	if (h->resize != NULL)
+		return -ENOTSUP;
+
 	/* Out of bounds */
 	if (key_idx >= total_entries)
 		return -EINVAL;
@@ -1691,6 +2202,23 @@ compare_signatures(uint32_t *prim_hash_matches, uint32_t *sec_hash_matches,
 
 	/* For match mask the first bit of every two bits indicates the match */
 	switch (sig_cmp_fn) {
+#if defined(RTE_MACHINE_CPUFLAG_AVX2)
+	case RTE_HASH_COMPARE_AVX2: {
+		uint32_t msk;
+
+		/* Compare primary and secondary bucket signatures at once */
+		msk = _mm256_movemask_epi8(_mm256_cmpeq_epi16(
+				_mm256_set_m128i(
+					_mm_load_si128((__m128i const *)
+						sec_bkt->sig_current),
+					_mm_load_si128((__m128i const *)
+						prim_bkt->sig_current)),
+				_mm256_set1_epi16(sig)));
+		*prim_hash_matches = (uint16_t)msk;
+		*sec_hash_matches = msk >> 16;
+		}
+		break;
+#endif
 #if defined(RTE_MACHINE_CPUFLAG_SSE2)
 	case RTE_HASH_COMPARE_SSE:
 		/* Compare all signatures in the bucket */
@@ -1733,12 +2261,40 @@ compare_signatures(uint32_t *prim_hash_matches, uint32_t *sec_hash_matches,
 	}
 }
 
+/*
+ * Compare signatures for a burst of keys.
+ * The AVX512 version handles several keys per iteration.
+ */
 static inline void
-__bulk_lookup_l(const struct rte_hash *h, const void **keys,
+compare_signatures_bulk(uint32_t *prim_hash_matches,
+			uint32_t *sec_hash_matches,
+			const struct rte_hash_bucket **prim_bkt,
+			const struct rte_hash_bucket **sec_bkt,
+			const uint16_t *sig, int32_t num_keys,
+			enum rte_hash_sig_compare_function sig_cmp_fn)
+{
+	int32_t i;
+
+#ifdef CC_AVX512_SUPPORT
+	if (sig_cmp_fn == RTE_HASH_COMPARE_AVX512) {
+		rte_hash_compare_signatures_avx512(prim_hash_matches,
+			sec_hash_matches, prim_bkt, sec_bkt, sig, num_keys);
+		return;
+	}
+#endif
+
+	for (i = 0; i < num_keys; i++)
+		compare_signatures(&prim_hash_matches[i], &sec_hash_matches[i],
+			prim_bkt[i], sec_bkt[i], sig[i], sig_cmp_fn);
+}
+
+static __rte_always_inline void
+__bulk_lookup_l_cmp(const struct rte_hash *h, const void **keys,
 		const struct rte_hash_bucket **primary_bkt,
 		const struct rte_hash_bucket **secondary_bkt,
 		uint16_t *sig, int32_t num_keys, int32_t *positions,
-		uint64_t *hit_mask, void *data[])
+		uint64_t *hit_mask, void *data[],
+		enum cmp_jump_table_case cmp_idx)
 {
 	uint64_t hits = 0;
 	int32_t i;
@@ -1749,12 +2305,11 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 
 	__hash_rw_reader_lock(h);
 
-	/* Compare signatures and prefetch key slot of first hit */
-	for (i = 0; i < num_keys; i++) {
-		compare_signatures(&prim_hitmask[i], &sec_hitmask[i],
-			primary_bkt[i], secondary_bkt[i],
-			sig[i], h->sig_cmp_fn);
+	compare_signatures_bulk(prim_hitmask, sec_hitmask,
+		primary_bkt, secondary_bkt, sig, num_keys, h->sig_cmp_fn);
 
+	/* Prefetch key slot of first hit */
+	for (i = 0; i < num_keys; i++) {
 		if (prim_hitmask[i]) {
 			uint32_t first_hit =
 					__builtin_ctzl(prim_hitmask[i])
@@ -1802,8 +2357,8 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 			 * as it is checking the dummy slot
 			 */
 			if (!!key_idx &
-				!rte_hash_cmp_eq(
-					key_slot->key, keys[i], h)) {
+				!rte_hash_cmp_eq_fixed(
+					key_slot->key, keys[i], h, cmp_idx)) {
 				if (data != NULL)
 					data[i] = key_slot->pdata;
 
@@ -1831,8 +2386,8 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 			 */
 
 			if (!!key_idx &
-				!rte_hash_cmp_eq(
-					key_slot->key, keys[i], h)) {
+				!rte_hash_cmp_eq_fixed(
+					key_slot->key, keys[i], h, cmp_idx)) {
 				if (data != NULL)
 					data[i] = key_slot->pdata;
 
@@ -1880,12 +2435,13 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 		*hit_mask = hits;
 }
 
-static inline void
-__bulk_lookup_lf(const struct rte_hash *h, const void **keys,
+static __rte_always_inline void
+__bulk_lookup_lf_cmp(const struct rte_hash *h, const void **keys,
 		const struct rte_hash_bucket **primary_bkt,
 		const struct rte_hash_bucket **secondary_bkt,
 		uint16_t *sig, int32_t num_keys, int32_t *positions,
-		uint64_t *hit_mask, void *data[])
+		uint64_t *hit_mask, void *data[],
+		enum cmp_jump_table_case cmp_idx)
 {
 	uint64_t hits = 0;
 	int32_t i;
@@ -1906,12 +2462,12 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 		cnt_b = __atomic_load_n(h->tbl_chng_cnt,
 					__ATOMIC_ACQUIRE);
 
-		/* Compare signatures and prefetch key slot of first hit */
-		for (i = 0; i < num_keys; i++) {
-			compare_signatures(&prim_hitmask[i], &sec_hitmask[i],
-				primary_bkt[i], secondary_bkt[i],
-				sig[i], h->sig_cmp_fn);
+		compare_signatures_bulk(prim_hitmask, sec_hitmask,
+			primary_bkt, secondary_bkt, sig, num_keys,
+			h->sig_cmp_fn);
 
+		/* Prefetch key slot of first hit */
+		for (i = 0; i < num_keys; i++) {
 			if (prim_hitmask[i]) {
 				uint32_t first_hit =
 						__builtin_ctzl(prim_hitmask[i])
@@ -1960,8 +2516,9 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 				 * as it is checking the dummy slot
 				 */
 				if (!!key_idx &
-					!rte_hash_cmp_eq(
-						key_slot->key, keys[i], h)) {
+					!rte_hash_cmp_eq_fixed(
+						key_slot->key, keys[i], h,
+						cmp_idx)) {
 					if (data != NULL)
 						data[i] = __atomic_load_n(
 							&key_slot->pdata,
@@ -1993,8 +2550,9 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 				 */
 
 				if (!!key_idx &
-					!rte_hash_cmp_eq(
-						key_slot->key, keys[i], h)) {
+					!rte_hash_cmp_eq_fixed(
+						key_slot->key, keys[i], h,
+						cmp_idx)) {
 					if (data != NULL)
 						data[i] = __atomic_load_n(
 							&key_slot->pdata,
@@ -2059,6 +2617,73 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 		*hit_mask = hits;
 }
 
+/*
+ * Instantiate the bulk lookup for the most common key sizes.
+ */
+static inline void
+__bulk_lookup_l(const struct rte_hash *h, const void **keys,
+		const struct rte_hash_bucket **primary_bkt,
+		const struct rte_hash_bucket **secondary_bkt,
+		uint16_t *sig, int32_t num_keys, int32_t *positions,
+		uint64_t *hit_mask, void *data[])
+{
+	switch (h->cmp_jump_table_idx) {
+#if defined(RTE_ARCH_X86) || defined(RTE_ARCH_ARM64)
+	case KEY_8_BYTES:
+		__bulk_lookup_l_cmp(h, keys, primary_bkt, secondary_bkt, sig,
+			num_keys, positions, hit_mask, data, KEY_8_BYTES);
+		break;
+	case KEY_16_BYTES:
+		__bulk_lookup_l_cmp(h, keys, primary_bkt, secondary_bkt, sig,
+			num_keys, positions, hit_mask, data, KEY_16_BYTES);
+		break;
+	case KEY_32_BYTES:
+		__bulk_lookup_l_cmp(h, keys, primary_bkt, secondary_bkt, sig,
+			num_keys, positions, hit_mask, data, KEY_32_BYTES);
+		break;
+	case KEY_64_BYTES:
+		__bulk_lookup_l_cmp(h, keys, primary_bkt, secondary_bkt, sig,
+			num_keys, positions, hit_mask, data, KEY_64_BYTES);
+		break;
+#endif
+	default:
+		__bulk_lookup_l_cmp(h, keys, primary_bkt, secondary_bkt, sig,
+			num_keys, positions, hit_mask, data, KEY_OTHER_BYTES);
+	}
+}
+
+static inline void
+__bulk_lookup_lf(const struct rte_hash *h, const void **keys,
+		const struct rte_hash_bucket **primary_bkt,
+		const struct rte_hash_bucket **secondary_bkt,
+		uint16_t *sig, int32_t num_keys, int32_t *positions,
+		uint64_t *hit_mask, void *data[])
+{
+	switch (h->cmp_jump_table_idx) {
+#if defined(RTE_ARCH_X86) || defined(RTE_ARCH_ARM64)
+	case KEY_8_BYTES:
+		__bulk_lookup_lf_cmp(h, keys, primary_bkt, secondary_bkt, sig,
+			num_keys, positions, hit_mask, data, KEY_8_BYTES);
+		break;
+	case KEY_16_BYTES:
+		__bulk_lookup_lf_cmp(h, keys, primary_bkt, secondary_bkt, sig,
+			num_keys, positions, hit_mask, data, KEY_16_BYTES);
+		break;
+	case KEY_32_BYTES:
+		__bulk_lookup_lf_cmp(h, keys, primary_bkt, secondary_bkt, sig,
+			num_keys, positions, hit_mask, data, KEY_32_BYTES);
+		break;
+	case KEY_64_BYTES:
+		__bulk_lookup_lf_cmp(h, keys, primary_bkt, secondary_bkt, sig,
+			num_keys, positions, hit_mask, data, KEY_64_BYTES);
+		break;
+#endif
+	default:
+		__bulk_lookup_lf_cmp(h, keys, primary_bkt, secondary_bkt, sig,
+			num_keys, positions, hit_mask, data, KEY_OTHER_BYTES);
+	}
+}
+
 #define PREFETCH_OFFSET 4
 static inline void
 __bulk_lookup_prefetching_loop(const struct rte_hash *h,
@@ -2150,7 +2775,10 @@ __rte_hash_lookup_bulk(const struct rte_hash *h, const void **keys,
 			int32_t num_keys, int32_t *positions,
 			uint64_t *hit_mask, void *data[])
 {
-	if (h->readwrite_concur_lf_support)
+	if (unlikely(h->resize != NULL))
+		rte_hash_rsz_lookup_bulk(h, keys, NULL, num_keys, positions,
+					 hit_mask, data);
+	else if (h->readwrite_concur_lf_support)
 		__rte_hash_lookup_bulk_lf(h, keys, num_keys, positions,
 					  hit_mask, data);
 	else
@@ -2262,7 +2890,10 @@ __rte_hash_lookup_with_hash_bulk(const struct rte_hash *h, const void **keys,
 			hash_sig_t *prim_hash, int32_t num_keys,
 			int32_t *positions, uint64_t *hit_mask, void *data[])
 {
-	if (h->readwrite_concur_lf_support)
+	if (unlikely(h->resize != NULL))
+		rte_hash_rsz_lookup_bulk(h, keys, prim_hash, num_keys,
+				positions, hit_mask, data);
+	else if (h->readwrite_concur_lf_support)
 		__rte_hash_lookup_with_hash_bulk_lf(h, keys, prim_hash,
 				num_keys, positions, hit_mask, data);
 	else
@@ -2311,6 +2942,9 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
 
 	RETURN_IF_TRUE(((h == NULL) || (next == NULL)), -EINVAL);
 
+	if (h->resize != NULL)
+		return rte_hash_rsz_iterate(h, key, data, next);
+
 	const uint32_t total_entries_main = h->num_buckets *
 							RTE_HASH_BUCKET_ENTRIES;
 	const uint32_t total_entries = total_entries_main << 1;
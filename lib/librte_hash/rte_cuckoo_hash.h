@@ -50,6 +50,7 @@
  */
 enum cmp_jump_table_case {
 	KEY_CUSTOM = 0,
+	KEY_8_BYTES,
 	KEY_16_BYTES,
 	KEY_32_BYTES,
 	KEY_48_BYTES,
@@ -66,8 +67,10 @@ enum cmp_jump_table_case {
  * Table storing all different key compare functions
  * (multi-process supported)
  */
-const rte_hash_cmp_eq_t cmp_jump_table[NUM_KEY_CMP_CASES] = {
+static const rte_hash_cmp_eq_t
+cmp_jump_table[NUM_KEY_CMP_CASES] __rte_unused = {
 	NULL,
+	rte_hash_k8_cmp_eq,
 	rte_hash_k16_cmp_eq,
 	rte_hash_k32_cmp_eq,
 	rte_hash_k48_cmp_eq,
@@ -93,7 +96,8 @@ enum cmp_jump_table_case {
  * Table storing all different key compare functions
  * (multi-process supported)
  */
-const rte_hash_cmp_eq_t cmp_jump_table[NUM_KEY_CMP_CASES] = {
+static const rte_hash_cmp_eq_t
+cmp_jump_table[NUM_KEY_CMP_CASES] __rte_unused = {
 	NULL,
 	memcmp
 };
@@ -142,6 +146,8 @@ enum rte_hash_sig_compare_function {
 	RTE_HASH_COMPARE_SCALAR = 0,
 	RTE_HASH_COMPARE_SSE,
 	RTE_HASH_COMPARE_NEON,
+	RTE_HASH_COMPARE_AVX2,
+	RTE_HASH_COMPARE_AVX512,
 	RTE_HASH_COMPARE_NUM
 };
 
@@ -220,8 +226,103 @@ struct rte_hash {
 	uint32_t *ext_bkt_to_free;
 	uint32_t *tbl_chng_cnt;
 	/**< Indicates if the hash table changed from last read. */
+	struct rte_hash_resize *resize;
+	/**< State of a resizable table, NULL if the table is not resizable. */
+	struct rte_hash_rcu_config rcu_cfg;
+	/**< RCU QSBR configuration, rcu_cfg.v is NULL if none is attached. */
+	struct rte_rcu_qsbr_dq *dq;	/**< RCU QSBR defer queue. */
 } __rte_cache_aligned;
 
+/** Tables of a resizable hash, published to the readers all at once. */
+struct rte_hash_rsz_tables {
+	struct rte_hash *cur;	/**< Table new keys are added to. */
+	struct rte_hash *old;	/**< Table moved to cur, or NULL. */
+	struct rte_hash *retired;
+	/**< Table freed along with this snapshot once it is unreferenced. */
+	struct rte_hash_rsz_tables *next;
+	/**< Next snapshot waiting for rte_hash_free or a synchronize. */
+};
+
+/** State of a table created with RTE_HASH_EXTRA_FLAGS_RESIZABLE. */
+struct rte_hash_resize {
+	struct rte_hash_rsz_tables *tables; /**< Tables seen by the readers. */
+	rte_spinlock_t lock;		/**< Serializes the writers. */
+	uint32_t iter;		/**< Position of the move in old. */
+	uint8_t rescan;
+	/**< Keys of old may have moved behind iter, scan it once more. */
+	uint8_t extra_flag;		/**< Flags of the tables. */
+	uint32_t gen;			/**< Number of tables created. */
+	int socket_id;			/**< NUMA Socket ID for memory. */
+	struct rte_hash *spare;
+	/**< Next table, created ahead by rte_hash_resize_step, or NULL. */
+	struct rte_hash_rsz_tables *retired;
+	/**< Snapshots waiting for rte_hash_free, without RCU QSBR. */
+	struct rte_hash_rsz_tables *sync_retired;
+	/**< Snapshots to free after a synchronize out of the lock. */
+};
+
+#if defined(RTE_ARCH_X86)
+/*
+ * Compare signatures of primary and secondary buckets for
+ * a burst of keys with AVX512 (see rte_cuckoo_hash_avx512.c).
+ */
+void
+rte_hash_compare_signatures_avx512(uint32_t *prim_hash_matches,
+	uint32_t *sec_hash_matches,
+	const struct rte_hash_bucket **prim_bkt,
+	const struct rte_hash_bucket **sec_bkt,
+	const uint16_t *sig, int32_t num_keys);
+#endif
+
+/*
+ * Create and free a table which is not registered in the hash list, nor
+ * found by rte_hash_find_existing, for the tables of a resizable table.
+ * Its rings are still named after params->name.
+ */
+struct rte_hash *
+rte_hash_create_unlisted(const struct rte_hash_parameters *params);
+void
+rte_hash_free_unlisted(struct rte_hash *h);
+
+/*
+ * Resizable tables (see rte_cuckoo_hash_resize.c). The table handle
+ * only holds the parameters shared by the tables it is made of.
+ */
+struct rte_hash_resize *
+rte_hash_rsz_create(struct rte_hash *h,
+	const struct rte_hash_parameters *params);
+void
+rte_hash_rsz_free(struct rte_hash *h);
+void
+rte_hash_rsz_free_resource(void *p, void *data, unsigned int n);
+int
+rte_hash_rsz_rcu_qsbr_add(struct rte_hash *h);
+void
+rte_hash_rsz_set_cmp_func(struct rte_hash *h, rte_hash_cmp_eq_t func);
+int32_t
+rte_hash_rsz_add(const struct rte_hash *h, const void *key, hash_sig_t sig,
+	void *data);
+int32_t
+rte_hash_rsz_del(const struct rte_hash *h, const void *key, hash_sig_t sig);
+int32_t
+rte_hash_rsz_lookup(const struct rte_hash *h, const void *key,
+	hash_sig_t sig, void **data);
+void
+rte_hash_rsz_lookup_bulk(const struct rte_hash *h, const void **keys,
+	hash_sig_t *sig, int32_t num_keys, int32_t *positions,
+	uint64_t *hit_mask, void *data[]);
+int
+rte_hash_rsz_step(const struct rte_hash *h, uint32_t n);
+void
+rte_hash_rsz_reset(struct rte_hash *h);
+int32_t
+rte_hash_rsz_count(const struct rte_hash *h);
+int32_t
+rte_hash_rsz_max_key_id(const struct rte_hash *h);
+int32_t
+rte_hash_rsz_iterate(const struct rte_hash *h, const void **key,
+	void **data, uint32_t *next);
+
 struct queue_node {
 	struct rte_hash_bucket *bkt; /* Current bucket on the bfs search */
 	uint32_t cur_bkt_idx;
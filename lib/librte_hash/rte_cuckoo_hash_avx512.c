@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2020 Intel Corporation
+ */
+
+#include <rte_common.h>
+#include <rte_vect.h>
+#include <rte_rwlock.h>
+#include <rte_spinlock.h>
+#include <rte_ring_elem.h>
+
+#include "rte_hash.h"
+#include "rte_cuckoo_hash.h"
+
+/*
+ * Compare the signatures of the primary and secondary buckets
+ * of two keys at once: each 128-bit lane of the ZMM register holds
+ * the signatures of one bucket.
+ * The produced hit masks have the same format as the ones from
+ * the SSE version: two bits per bucket entry, the first one set on match.
+ */
+void
+rte_hash_compare_signatures_avx512(uint32_t *prim_hash_matches,
+	uint32_t *sec_hash_matches,
+	const struct rte_hash_bucket **prim_bkt,
+	const struct rte_hash_bucket **sec_bkt,
+	const uint16_t *sig, int32_t num_keys)
+{
+	int32_t i;
+	uint32_t msk32;
+	uint64_t msk64;
+	__m256i b256, s256;
+	__m512i b512, s512;
+
+	for (i = 0; i + 1 < num_keys; i += 2) {
+
+		b512 = _mm512_castsi128_si512(_mm_load_si128(
+			(const __m128i *)prim_bkt[i]->sig_current));
+		b512 = _mm512_inserti32x4(b512, _mm_load_si128(
+			(const __m128i *)sec_bkt[i]->sig_current), 1);
+		b512 = _mm512_inserti32x4(b512, _mm_load_si128(
+			(const __m128i *)prim_bkt[i + 1]->sig_current), 2);
+		b512 = _mm512_inserti32x4(b512, _mm_load_si128(
+			(const __m128i *)sec_bkt[i + 1]->sig_current), 3);
+
+		s512 = _mm512_inserti64x4(
+			_mm512_castsi256_si512(_mm256_set1_epi16(sig[i])),
+			_mm256_set1_epi16(sig[i + 1]), 1);
+
+		/* expand 16-bit compare mask into 2 bits per entry */
+		msk64 = _mm512_movepi8_mask(_mm512_movm_epi16(
+			_mm512_cmpeq_epi16_mask(b512, s512)));
+
+		prim_hash_matches[i] = (uint16_t)msk64;
+		sec_hash_matches[i] = (uint16_t)(msk64 >> 16);
+		prim_hash_matches[i + 1] = (uint16_t)(msk64 >> 32);
+		sec_hash_matches[i + 1] = (uint16_t)(msk64 >> 48);
+	}
+
+	/* odd number of keys, compare the last one with 256-bit registers */
+	if (i != num_keys) {
+		b256 = _mm256_inserti128_si256(_mm256_castsi128_si256(
+			_mm_load_si128(
+				(const __m128i *)prim_bkt[i]->sig_current)),
+			_mm_load_si128(
+				(const __m128i *)sec_bkt[i]->sig_current), 1);
+		s256 = _mm256_set1_epi16(sig[i]);
+
+		msk32 = _mm256_movemask_epi8(_mm256_cmpeq_epi16(b256, s256));
+
+		prim_hash_matches[i] = (uint16_t)msk32;
+		sec_hash_matches[i] = msk32 >> 16;
+	}
+}
@@ -0,0 +1,663 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2020 Intel Corporation
+ */
+
+/*
+ * Resizable hash tables.
+ *
+ * A table created with RTE_HASH_EXTRA_FLAGS_RESIZABLE is made of lock free
+ * cuckoo tables with extendable buckets, so that an add only fails once
+ * all the key slots are used. When that happens, a table twice as large
+ * becomes the current table, and the one it outgrew is kept as the old
+ * table until all its keys are copied to the current one. The copy is
+ * done by the writers a few keys at a time, or by rte_hash_resize_step.
+ *
+ * The readers look up the current table first and the old one on a miss.
+ * Both tables are published in one snapshot, so that a reader never sees
+ * a table without the other. Keys are never deleted from the old table by
+ * the copy, a delete removes the key from both tables, so that a key is
+ * always found in one of the tables of any snapshot a reader may hold.
+ * Snapshots and the old tables are reclaimed through RCU QSBR, and the
+ * deleted key indexes through the defer queue of their table, so that the
+ * lock is never held while waiting for the readers.
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <stdio.h>
+
+#include <rte_common.h>
+#include <rte_log.h>
+#include <rte_malloc.h>
+#include <rte_errno.h>
+#include <rte_rwlock.h>
+#include <rte_spinlock.h>
+#include <rte_ring_elem.h>
+
+#include "rte_hash.h"
+#include "rte_cuckoo_hash.h"
+
+/* Number of keys copied to the current table by each add or delete. */
+#define RTE_HASH_RSZ_MOVE_BURST 32
+
+static inline const struct rte_hash_rsz_tables *
+rsz_tables(const struct rte_hash *h)
+{
+	return __atomic_load_n(&h->resize->tables, __ATOMIC_ACQUIRE);
+}
+
+static void
+rsz_tables_free(struct rte_hash_rsz_tables *t)
+{
+	rte_hash_free_unlisted(t->retired);
+	rte_free(t);
+}
+
+void
+rte_hash_rsz_free_resource(void *p, void *data, unsigned int n)
+{
+	RTE_SET_USED(p);
+	RTE_SET_USED(n);
+	rsz_tables_free(*(struct rte_hash_rsz_tables **)data);
+}
+
+/*
+ * The tables are not listed, and are named after the handle, unique
+ * while it exists, and a generation number, so that the rings and the
+ * defer queue derived from the name never clash with the ones of another
+ * table. The defer queue ring is the longest name derived from it.
+ */
+#define RSZ_NAME_MAX (RTE_RCU_QSBR_DQ_NAMESIZE - sizeof("HASH_RCU_"))
+
+/* Create a table, to be set up by rsz_table_setup under the lock. */
+static struct rte_hash *
+rsz_table_create(const struct rte_hash *h, uint32_t entries)
+{
+	struct rte_hash_resize *rsz = h->resize;
+	char name[RTE_HASH_NAMESIZE];
+	struct rte_hash_parameters params = {
+		.name = name,
+		.entries = entries,
+		.key_len = h->key_len,
+		.hash_func = h->hash_func,
+		.hash_func_init_val = h->hash_func_init_val,
+		.socket_id = rsz->socket_id,
+		.extra_flag = rsz->extra_flag,
+	};
+	int ret;
+
+	ret = snprintf(name, sizeof(name), "rsz%" PRIxPTR "_%" PRIx32,
+			(uintptr_t)h,
+			__atomic_fetch_add(&rsz->gen, 1, __ATOMIC_RELAXED));
+	if (ret < 0 || (size_t)ret > RSZ_NAME_MAX) {
+		rte_errno = ENAMETOOLONG;
+		return NULL;
+	}
+
+	return rte_hash_create_unlisted(&params);
+}
+
+/* Give a table the compare function and RCU QSBR of the handle. */
+static int
+rsz_table_setup(const struct rte_hash *h, struct rte_hash *tbl)
+{
+	struct rte_hash_rcu_config cfg;
+
+	if (h->rte_hash_custom_cmp_eq != NULL)
+		rte_hash_set_cmp_func(tbl, h->rte_hash_custom_cmp_eq);
+
+	if (h->rcu_cfg.v != NULL && tbl->rcu_cfg.v == NULL) {
+		/* Defer queue sized for the key indexes of this table */
+		cfg = h->rcu_cfg;
+		cfg.mode = RTE_HASH_QSBR_MODE_DQ;
+		cfg.dq_size = 0;
+		if (rte_hash_rcu_qsbr_add(tbl, &cfg) != 0)
+			return -ENOMEM;
+	}
+
+	return 0;
+}
+
+/*
+ * Make cur and old visible to the readers, and reclaim the previous
+ * snapshot along with the table it no longer references.
+ */
+static int
+rsz_publish(const struct rte_hash *h, struct rte_hash *cur,
+	struct rte_hash *old, struct rte_hash *retired)
+{
+	struct rte_hash_resize *rsz = h->resize;
+	struct rte_hash_rsz_tables *t, *prev = rsz->tables;
+
+	t = rte_zmalloc_socket(NULL, sizeof(*t), 0, rsz->socket_id);
+	if (t == NULL) {
+		RTE_LOG(ERR, HASH, "memory allocation failed\n");
+		return -ENOMEM;
+	}
+	t->cur = cur;
+	t->old = old;
+	__atomic_store_n(&rsz->tables, t, __ATOMIC_RELEASE);
+
+	prev->retired = retired;
+	if (h->rcu_cfg.v == NULL) {
+		/* Readers may still use it, keep it until rte_hash_free */
+		prev->next = rsz->retired;
+		rsz->retired = prev;
+	} else if (h->rcu_cfg.mode == RTE_HASH_QSBR_MODE_SYNC) {
+		/* Synchronized by rsz_unlock, out of the lock */
+		prev->next = rsz->sync_retired;
+		rsz->sync_retired = prev;
+	} else if (rte_rcu_qsbr_dq_enqueue(h->dq, &prev) != 0) {
+		/* Push into QSBR defer queue. */
+		RTE_LOG(ERR, HASH, "Failed to push QSBR FIFO\n");
+		prev->next = rsz->retired;
+		rsz->retired = prev;
+	}
+
+	return 0;
+}
+
+/*
+ * Copy up to n keys of the old table to the current one.
+ * Return 1 if keys are left to copy, 0 once the old table is retired.
+ */
+static int
+rsz_move(const struct rte_hash *h, uint32_t n)
+{
+	struct rte_hash_resize *rsz = h->resize;
+	const struct rte_hash_rsz_tables *t = rsz->tables;
+	const void *key;
+	void *data;
+	hash_sig_t sig;
+	int32_t ret;
+
+	if (t->old == NULL)
+		return 0;
+
+	for (; n != 0; n--) {
+		ret = rte_hash_iterate(t->old, &key, &data, &rsz->iter);
+		if (ret == -ENOENT) {
+			/*
+			 * A delete compacting the extendable buckets can
+			 * move a key from ahead of the iterator to behind it.
+			 */
+			if (rsz->rescan) {
+				rsz->rescan = 0;
+				rsz->iter = 0;
+				continue;
+			}
+			return rsz_publish(h, t->cur, NULL, t->old);
+		}
+
+		/* A key added since the resize is newer than the old one */
+		sig = rte_hash_hash(h, key);
+		if (rte_hash_lookup_with_hash(t->cur, key, sig) != -ENOENT)
+			continue;
+
+		ret = rte_hash_add_key_with_hash_data(t->cur, key, sig, data);
+		if (ret < 0)
+			return ret;
+	}
+
+	return 1;
+}
+
+/*
+ * Replace the current table with one twice as large, using the table
+ * created ahead by rte_hash_resize_step if any. Only two tables can be
+ * looked up, so this waits for the keys of the previous resize to be all
+ * moved, which the writers do a few keys at a time.
+ */
+static int
+rsz_grow(const struct rte_hash *h)
+{
+	struct rte_hash_resize *rsz = h->resize;
+	struct rte_hash *cur, *tbl;
+	int ret;
+
+	if (rsz->tables->old != NULL)
+		return -ENOSPC;
+
+	cur = rsz->tables->cur;
+	if (cur->entries > RTE_HASH_ENTRIES_MAX / 2)
+		return -ENOSPC;
+
+	tbl = rsz->spare;
+	rsz->spare = NULL;
+	if (tbl == NULL)
+		tbl = rsz_table_create(h, cur->entries * 2);
+	if (tbl == NULL || rsz_table_setup(h, tbl) != 0) {
+		RTE_LOG(ERR, HASH, "%s: failed to grow to %u entries\n",
+			h->name, cur->entries * 2);
+		rte_hash_free_unlisted(tbl);
+		return -ENOSPC;
+	}
+
+	ret = rsz_publish(h, tbl, cur, NULL);
+	if (ret < 0) {
+		rte_hash_free_unlisted(tbl);
+		return ret;
+	}
+	rsz->iter = 0;
+	rsz->rescan = 0;
+
+	return 0;
+}
+
+static int32_t
+rsz_add(struct rte_hash *tbl, const void *key, hash_sig_t sig, void *data)
+{
+	/* Only the APIs without data return the position */
+	if (data == NULL)
+		return rte_hash_add_key_with_hash(tbl, key, sig);
+	return rte_hash_add_key_with_hash_data(tbl, key, sig, data);
+}
+
+static int32_t
+rsz_del(const struct rte_hash *h, struct rte_hash *tbl, const void *key,
+	hash_sig_t sig)
+{
+	int32_t ret;
+
+	ret = rte_hash_del_key_with_hash(tbl, key, sig);
+	/* Without RCU QSBR nothing else frees the key index */
+	if (ret >= 0 && h->rcu_cfg.v == NULL)
+		rte_hash_free_key_with_position(tbl, ret);
+
+	return ret;
+}
+
+/*
+ * Release the lock, then wait for the readers of the snapshots retired
+ * under it in RTE_HASH_QSBR_MODE_SYNC, so that other writers do not.
+ */
+static void
+rsz_unlock(const struct rte_hash *h)
+{
+	struct rte_hash_resize *rsz = h->resize;
+	struct rte_hash_rsz_tables *t = rsz->sync_retired, *next;
+
+	rsz->sync_retired = NULL;
+	rte_spinlock_unlock(&rsz->lock);
+
+	if (t == NULL)
+		return;
+
+	/* Wait for quiescent state change. */
+	rte_rcu_qsbr_synchronize(h->rcu_cfg.v, RTE_QSBR_THRID_INVALID);
+	for (; t != NULL; t = next) {
+		next = t->next;
+		rsz_tables_free(t);
+	}
+}
+
+struct rte_hash_resize *
+rte_hash_rsz_create(struct rte_hash *h,
+	const struct rte_hash_parameters *params)
+{
+	struct rte_hash_resize *rsz;
+	struct rte_hash_rsz_tables *t;
+
+	rsz = rte_zmalloc_socket(NULL, sizeof(*rsz), RTE_CACHE_LINE_SIZE,
+			params->socket_id);
+	t = rte_zmalloc_socket(NULL, sizeof(*t), 0, params->socket_id);
+	if (rsz == NULL || t == NULL) {
+		RTE_LOG(ERR, HASH, "memory allocation failed\n");
+		rte_errno = ENOMEM;
+		goto err;
+	}
+
+	rte_spinlock_init(&rsz->lock);
+	rsz->socket_id = params->socket_id;
+	rsz->extra_flag = (params->extra_flag &
+			~RTE_HASH_EXTRA_FLAGS_RESIZABLE) |
+		RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF |
+		RTE_HASH_EXTRA_FLAGS_EXT_TABLE;
+	rsz->tables = t;
+	h->resize = rsz;
+
+	t->cur = rsz_table_create(h, params->entries);
+	if (t->cur == NULL)
+		goto err;
+	/* Nothing to set up yet, no compare function nor RCU QSBR */
+
+	/* Following tables use the same functions as the first one */
+	h->hash_func = t->cur->hash_func;
+	h->cmp_jump_table_idx = t->cur->cmp_jump_table_idx;
+
+	return rsz;
+err:
+	h->resize = NULL;
+	rte_free(t);
+	rte_free(rsz);
+	return NULL;
+}
+
+void
+rte_hash_rsz_free(struct rte_hash *h)
+{
+	struct rte_hash_resize *rsz = h->resize;
+	struct rte_hash_rsz_tables *t;
+
+	while (rsz->retired != NULL) {
+		t = rsz->retired;
+		rsz->retired = t->next;
+		rsz_tables_free(t);
+	}
+
+	t = rsz->tables;
+	rte_hash_free_unlisted(t->old);
+	rte_hash_free_unlisted(t->cur);
+	rte_hash_free_unlisted(rsz->spare);
+	rte_free(t);
+	rte_free(rsz);
+}
+
+int
+rte_hash_rsz_rcu_qsbr_add(struct rte_hash *h)
+{
+	struct rte_hash_resize *rsz = h->resize;
+	const struct rte_hash_rsz_tables *t;
+	struct rte_hash_rcu_config cfg = h->rcu_cfg;
+	int ret = 0;
+
+	/* Deleted key indexes are always deferred, never synchronized */
+	cfg.mode = RTE_HASH_QSBR_MODE_DQ;
+	cfg.dq_size = 0;
+
+	rte_spinlock_lock(&rsz->lock);
+	t = rsz->tables;
+	if (rte_hash_rcu_qsbr_add(t->cur, &cfg) != 0 ||
+			(t->old != NULL &&
+			 rte_hash_rcu_qsbr_add(t->old, &cfg) != 0) ||
+			(rsz->spare != NULL &&
+			 rte_hash_rcu_qsbr_add(rsz->spare, &cfg) != 0))
+		ret = 1;
+	rte_spinlock_unlock(&rsz->lock);
+
+	return ret;
+}
+
+void
+rte_hash_rsz_set_cmp_func(struct rte_hash *h, rte_hash_cmp_eq_t func)
+{
+	struct rte_hash_resize *rsz = h->resize;
+	const struct rte_hash_rsz_tables *t;
+
+	rte_spinlock_lock(&rsz->lock);
+	t = rsz->tables;
+	rte_hash_set_cmp_func(t->cur, func);
+	if (t->old != NULL)
+		rte_hash_set_cmp_func(t->old, func);
+	if (rsz->spare != NULL)
+		rte_hash_set_cmp_func(rsz->spare, func);
+	rte_spinlock_unlock(&rsz->lock);
+}
+
+int32_t
+rte_hash_rsz_add(const struct rte_hash *h, const void *key, hash_sig_t sig,
+	void *data)
+{
+	struct rte_hash_resize *rsz = h->resize;
+	int32_t ret;
+
+	rte_spinlock_lock(&rsz->lock);
+	/* A failed copy is retried by the next writer */
+	rsz_move(h, RTE_HASH_RSZ_MOVE_BURST);
+
+	ret = rsz_add(rsz->tables->cur, key, sig, data);
+	if (ret == -ENOSPC && rsz_grow(h) == 0)
+		ret = rsz_add(rsz->tables->cur, key, sig, data);
+	rsz_unlock(h);
+
+	return ret;
+}
+
+int32_t
+rte_hash_rsz_del(const struct rte_hash *h, const void *key, hash_sig_t sig)
+{
+	struct rte_hash_resize *rsz = h->resize;
+	const struct rte_hash_rsz_tables *t;
+	int32_t ret, ret_old;
+
+	rte_spinlock_lock(&rsz->lock);
+	rsz_move(h, RTE_HASH_RSZ_MOVE_BURST);
+
+	t = rsz->tables;
+	ret = rsz_del(h, t->cur, key, sig);
+	if (t->old != NULL) {
+		/*
+		 * Keys are only added to cur, the key indexes of old are not
+		 * reused and are freed along with it.
+		 */
+		ret_old = rte_hash_del_key_with_hash(t->old, key, sig);
+		if (ret_old >= 0) {
+			if (rsz->iter != 0)
+				rsz->rescan = 1;
+			if (ret < 0)
+				ret = ret_old;
+		}
+	}
+	rsz_unlock(h);
+
+	return ret;
+}
+
+int32_t
+rte_hash_rsz_lookup(const struct rte_hash *h, const void *key,
+	hash_sig_t sig, void **data)
+{
+	const struct rte_hash_rsz_tables *t = rsz_tables(h);
+	int32_t ret;
+
+	ret = rte_hash_lookup_with_hash_data(t->cur, key, sig, data);
+	if (ret == -ENOENT && t->old != NULL)
+		ret = rte_hash_lookup_with_hash_data(t->old, key, sig, data);
+
+	return ret;
+}
+
+void
+rte_hash_rsz_lookup_bulk(const struct rte_hash *h, const void **keys,
+	hash_sig_t *sig, int32_t num_keys, int32_t *positions,
+	uint64_t *hit_mask, void *data[])
+{
+	const struct rte_hash_rsz_tables *t = rsz_tables(h);
+	hash_sig_t hash[RTE_HASH_LOOKUP_BULK_MAX];
+	hash_sig_t miss_hash[RTE_HASH_LOOKUP_BULK_MAX];
+	const void *miss_keys[RTE_HASH_LOOKUP_BULK_MAX];
+	int32_t miss_pos[RTE_HASH_LOOKUP_BULK_MAX];
+	void *miss_data[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t miss_idx[RTE_HASH_LOOKUP_BULK_MAX];
+	uint64_t miss_mask;
+	int32_t i, num_miss = 0;
+
+	if (sig == NULL) {
+		for (i = 0; i < num_keys; i++)
+			hash[i] = rte_hash_hash(h, keys[i]);
+		sig = hash;
+	}
+
+	if (hit_mask != NULL)
+		rte_hash_lookup_with_hash_bulk_data(t->cur, keys, sig,
+				num_keys, hit_mask, data);
+	else
+		rte_hash_lookup_with_hash_bulk(t->cur, keys, sig, num_keys,
+				positions);
+
+	if (t->old == NULL)
+		return;
+
+	for (i = 0; i < num_keys; i++) {
+		if (hit_mask != NULL ? (*hit_mask >> i) & 1 :
+				positions[i] != -ENOENT)
+			continue;
+		miss_keys[num_miss] = keys[i];
+		miss_hash[num_miss] = sig[i];
+		miss_idx[num_miss] = i;
+		num_miss++;
+	}
+	if (num_miss == 0)
+		return;
+
+	if (hit_mask != NULL) {
+		rte_hash_lookup_with_hash_bulk_data(t->old, miss_keys,
+				miss_hash, num_miss, &miss_mask, miss_data);
+		for (i = 0; i < num_miss; i++) {
+			if (!((miss_mask >> i) & 1))
+				continue;
+			*hit_mask |= 1ULL << miss_idx[i];
+			data[miss_idx[i]] = miss_data[i];
+		}
+	} else {
+		rte_hash_lookup_with_hash_bulk(t->old, miss_keys, miss_hash,
+				num_miss, miss_pos);
+		for (i = 0; i < num_miss; i++)
+			positions[miss_idx[i]] = miss_pos[i];
+	}
+}
+
+/* Fill level of the current table above which the next one is created */
+#define RSZ_SPARE_THRESHOLD(entries) ((entries) - (entries) / 4)
+
+int
+rte_hash_rsz_step(const struct rte_hash *h, uint32_t n)
+{
+	struct rte_hash_resize *rsz = h->resize;
+	struct rte_hash *spare;
+	uint32_t entries = 0;
+	int ret;
+
+	rte_spinlock_lock(&rsz->lock);
+	ret = rsz_move(h, n);
+	if (ret == 0 && rsz->tables->old != NULL)
+		ret = 1;
+	if (ret == 0 && rsz->spare == NULL &&
+			rsz->tables->cur->entries <= RTE_HASH_ENTRIES_MAX / 2 &&
+			(uint32_t)rte_hash_count(rsz->tables->cur) >=
+			RSZ_SPARE_THRESHOLD(rsz->tables->cur->entries))
+		entries = rsz->tables->cur->entries * 2;
+	rsz_unlock(h);
+
+	if (entries == 0)
+		return ret;
+
+	/* Create the next table out of the lock, the writers keep going */
+	spare = rsz_table_create(h, entries);
+	if (spare == NULL)
+		return ret;
+
+	rte_spinlock_lock(&rsz->lock);
+	if (rsz->spare == NULL && rsz->tables->cur->entries * 2 == entries &&
+			rsz_table_setup(h, spare) == 0) {
+		rsz->spare = spare;
+		spare = NULL;
+	}
+	rte_spinlock_unlock(&rsz->lock);
+	rte_hash_free_unlisted(spare);
+
+	return ret;
+}
+
+void
+rte_hash_rsz_reset(struct rte_hash *h)
+{
+	struct rte_hash_resize *rsz = h->resize;
+	struct rte_hash_rsz_tables *t;
+
+	rte_spinlock_lock(&rsz->lock);
+	/* Readers are not referencing the table, free all but cur */
+	while (rsz->retired != NULL) {
+		t = rsz->retired;
+		rsz->retired = t->next;
+		rsz_tables_free(t);
+	}
+
+	t = rsz->tables;
+	rte_hash_free_unlisted(t->old);
+	t->old = NULL;
+	rsz->iter = 0;
+	rsz->rescan = 0;
+	rte_hash_reset(t->cur);
+	rte_spinlock_unlock(&rsz->lock);
+}
+
+/*
+ * Get the next key of old which is not in cur, the keys of cur being
+ * newer or copies of the ones of old.
+ */
+static int32_t
+rsz_iterate_old(const struct rte_hash *h, const struct rte_hash_rsz_tables *t,
+	const void **key, void **data, uint32_t *next)
+{
+	int32_t ret;
+
+	do {
+		ret = rte_hash_iterate(t->old, key, data, next);
+	} while (ret >= 0 && rte_hash_lookup_with_hash(t->cur, *key,
+			rte_hash_hash(h, *key)) >= 0);
+
+	return ret;
+}
+
+int32_t
+rte_hash_rsz_count(const struct rte_hash *h)
+{
+	struct rte_hash_resize *rsz = h->resize;
+	const struct rte_hash_rsz_tables *t;
+	const void *key;
+	void *data;
+	uint32_t next = 0;
+	int32_t ret;
+
+	rte_spinlock_lock(&rsz->lock);
+	t = rsz->tables;
+	ret = rte_hash_count(t->cur);
+	/* Keys not moved yet, without moving them */
+	while (ret >= 0 && t->old != NULL &&
+			rsz_iterate_old(h, t, &key, &data, &next) >= 0)
+		ret++;
+	rte_spinlock_unlock(&rsz->lock);
+
+	return ret;
+}
+
+int32_t
+rte_hash_rsz_max_key_id(const struct rte_hash *h)
+{
+	return rte_hash_max_key_id(rsz_tables(h)->cur);
+}
+
+/*
+ * Walk the slots of cur, then the ones of old, skipping the keys of old
+ * also in cur.
+ */
+int32_t
+rte_hash_rsz_iterate(const struct rte_hash *h, const void **key,
+	void **data, uint32_t *next)
+{
+	const struct rte_hash_rsz_tables *t = rsz_tables(h);
+	/* Main and extendable buckets, as walked by rte_hash_iterate */
+	const uint32_t cur_slots = t->cur->num_buckets *
+		RTE_HASH_BUCKET_ENTRIES * 2;
+	uint32_t pos;
+	int32_t ret;
+
+	if (*next < cur_slots) {
+		ret = rte_hash_iterate(t->cur, key, data, next);
+		if (ret != -ENOENT)
+			return ret;
+		*next = cur_slots;
+	}
+
+	if (t->old == NULL)
+		return -ENOENT;
+
+	pos = *next - cur_slots;
+	ret = rsz_iterate_old(h, t, key, data, &pos);
+	*next = cur_slots + pos;
+
+	return ret;
+}
@@ -15,6 +15,7 @@
 #include <stddef.h>
 
 #include <rte_compat.h>
+#include <rte_rcu_qsbr.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -54,6 +55,29 @@ extern "C" {
  */
 #define RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF 0x20
 
+/** Flag to let the table grow when it runs out of key slots.
+ * The keys are moved to a table twice as large incrementally by the
+ * writers, while the lock free readers look up both tables.
+ * It implies RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF and
+ * RTE_HASH_EXTRA_FLAGS_EXT_TABLE, and cannot be used together with
+ * RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY or RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL.
+ * Key positions change when the table grows, so data should be stored
+ * with the rte_hash_xxx_data APIs, and rte_hash_get_key_with_position and
+ * rte_hash_free_key_with_position are not supported.
+ * Deleted key indexes and old tables are reclaimed through the RCU QSBR
+ * variable attached with rte_hash_rcu_qsbr_add, the key indexes always
+ * through a defer queue whatever its mode. Without it, deleted key
+ * indexes are freed on delete, as if lock free concurrency was disabled,
+ * and old tables are only freed by rte_hash_free.
+ * An add fails with -ENOSPC if the table is full again before all the keys
+ * of the previous resize are moved, until rte_hash_resize_step or the
+ * following writes complete the move.
+ */
+#define RTE_HASH_EXTRA_FLAGS_RESIZABLE 0x40
+
+/** @internal Default RCU defer queue entries to reclaim in one go. */
+#define RTE_HASH_RCU_DQ_RECLAIM_MAX	16
+
 /**
  * The type of hash value of a key.
  * It should be a value of at least 32bit with fully random pattern.
@@ -81,6 +105,32 @@ struct rte_hash_parameters {
 	uint8_t extra_flag;		/**< Indicate if additional parameters are present. */
 };
 
+/** RCU reclamation modes */
+enum rte_hash_qsbr_mode {
+	/** Create defer queue for reclaim. */
+	RTE_HASH_QSBR_MODE_DQ = 0,
+	/** Use blocking mode reclaim. No defer queue created. */
+	RTE_HASH_QSBR_MODE_SYNC
+};
+
+/** HASH RCU QSBR configuration structure. */
+struct rte_hash_rcu_config {
+	struct rte_rcu_qsbr *v;		/**< RCU QSBR variable. */
+	enum rte_hash_qsbr_mode mode;
+	/**< Mode of RCU QSBR. RTE_HASH_QSBR_MODE_xxx
+	 * '0' for default: create defer queue for reclaim.
+	 */
+	uint32_t dq_size;
+	/**< RCU defer queue size.
+	 * default: total hash table entries.
+	 */
+	uint32_t reclaim_thd;	/**< Threshold to trigger auto reclaim. */
+	uint32_t reclaim_max;
+	/**< Max entries to reclaim in one go.
+	 * default: RTE_HASH_RCU_DQ_RECLAIM_MAX.
+	 */
+};
+
 /** @internal A hash table structure. */
 struct rte_hash;
 
@@ -153,6 +203,12 @@ rte_hash_reset(struct rte_hash *h);
 
 /**
  * Return the number of keys in the hash table
+ *
+ * With RTE_HASH_EXTRA_FLAGS_RESIZABLE, while keys of the previous table
+ * are left to be moved, the whole previous table is walked under the
+ * writer lock to count them, which is O(n) in the number of entries.
+ * Deleted keys waiting in the RCU defer queue of a table are counted.
+ *
  * @param h
  *  Hash table to query from
  * @return
@@ -179,6 +235,63 @@ __rte_experimental
 int32_t
 rte_hash_max_key_id(const struct rte_hash *h);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Associate RCU QSBR variable with a hash table.
+ * Once associated, the key indexes of deleted keys are freed when the
+ * readers stopped referencing them, for tables that do not free them on
+ * delete (RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF or
+ * RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL), so that
+ * rte_hash_free_key_with_position must not be called for them.
+ * With RTE_HASH_EXTRA_FLAGS_RESIZABLE, the tables left by a resize are
+ * reclaimed the same way.
+ *
+ * @param h
+ *   the hash table to add RCU QSBR
+ * @param cfg
+ *   RCU QSBR configuration
+ * @return
+ *   On success - 0
+ *   On error - 1 with error code set in rte_errno.
+ *   Possible rte_errno codes are:
+ *   - EINVAL - invalid pointer
+ *   - EEXIST - already added QSBR
+ *   - ENOMEM - memory allocation failure
+ */
+__rte_experimental
+int rte_hash_rcu_qsbr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Move keys of a table created with RTE_HASH_EXTRA_FLAGS_RESIZABLE from
+ * the table it outgrew to the current one.
+ * Every add and delete moves a few keys already, this allows a service
+ * core to complete the move while the table is not updated, so that
+ * lookup misses do not have to search both tables anymore.
+ * Once no key is left to be moved and the current table is three quarters
+ * full, it also creates the next table, so that the add which grows the
+ * table does not have to allocate and initialize it.
+ * This operation is multi-thread safe with regarding to the writers.
+ *
+ * @param h
+ *   Hash table to move the keys of.
+ * @param n
+ *   Maximum number of keys to move.
+ * @return
+ *   - -EINVAL if the parameters are invalid.
+ *   - -ENOSPC if a key could not be added to the current table.
+ *   - -ENOMEM if the old table could not be retired.
+ *   - 0 if no key is left to be moved.
+ *   - 1 if keys are left to be moved.
+ */
+__rte_experimental
+int
+rte_hash_resize_step(struct rte_hash *h, uint32_t n);
+
 /**
  * Add a key-value pair to an existing hash table.
  * This operation is not multi-thread safe
@@ -280,6 +393,73 @@ rte_hash_add_key(const struct rte_hash *h, const void *key);
 int32_t
 rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key, hash_sig_t sig);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Add multiple keys to an existing hash table.
+ * This operation has the same thread safety as rte_hash_add_key(), but
+ * takes the writer lock and gets the free key indexes once for the whole
+ * burst instead of once per key.
+ * The keys are added in order, so that a key given twice in the burst
+ * ends up at the position of its first occurrence.
+ *
+ * @param h
+ *   Hash table to add the keys to.
+ * @param keys
+ *   A pointer to a list of keys to add.
+ * @param num_keys
+ *   How many keys are in the keys list (less than or equal to
+ *   RTE_HASH_LOOKUP_BULK_MAX).
+ * @param positions
+ *   Output containing, for each key, the value rte_hash_add_key() would
+ *   return for it: its position in the hash table or a negative errno
+ *   value (-ENOSPC if there is no space in the hash for this key).
+ * @return
+ *   - -EINVAL if the parameters are invalid.
+ *   - Number of keys added or already in the hash table.
+ */
+__rte_experimental
+int
+rte_hash_add_key_bulk(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, int32_t *positions);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Add multiple key-value pairs with pre-computed hash values
+ * to an existing hash table.
+ * This operation has the same thread safety as
+ * rte_hash_add_key_with_hash_data(), but takes the writer lock and gets
+ * the free key indexes once for the whole burst instead of once per key.
+ * If a key exists already in the table, its value is updated as with
+ * rte_hash_add_key_with_hash_data().
+ *
+ * @param h
+ *   Hash table to add the keys to.
+ * @param keys
+ *   A pointer to a list of keys to add.
+ * @param sig
+ *   A pointer to a list of precomputed hash values for keys.
+ * @param data
+ *   A pointer to a list of data to add with the keys.
+ * @param num_keys
+ *   How many keys are in the keys list (less than or equal to
+ *   RTE_HASH_LOOKUP_BULK_MAX).
+ * @param positions
+ *   Output containing, for each key, its position in the hash table or
+ *   a negative errno value. Can be NULL.
+ * @return
+ *   - -EINVAL if the parameters are invalid.
+ *   - Number of keys added or updated.
+ */
+__rte_experimental
+int
+rte_hash_add_key_with_hash_bulk_data(const struct rte_hash *h,
+		const void **keys, hash_sig_t *sig, void *data[],
+		uint32_t num_keys, int32_t *positions);
+
 /**
  * Remove a key from an existing hash table.
  * This operation is not multi-thread safe
@@ -356,6 +536,7 @@ rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key, hash_sig_t
  *   - 0 if retrieved successfully
  *   - -EINVAL if the parameters are invalid.
  *   - -ENOENT if no valid key is found in the given position.
+ *   - -ENOTSUP if the table is resizable.
  */
 int
 rte_hash_get_key_with_position(const struct rte_hash *h, const int32_t position,
@@ -384,6 +565,7 @@ rte_hash_get_key_with_position(const struct rte_hash *h, const int32_t position,
  * @return
  *   - 0 if freed successfully
  *   - -EINVAL if the parameters are invalid.
+ *   - -ENOTSUP if the table is resizable.
  */
 __rte_experimental
 int
@@ -606,6 +788,9 @@ rte_hash_lookup_bulk(const struct rte_hash *h, const void **keys,
 
 /**
  * Iterate through the hash table, returning key-value pairs.
+ * With RTE_HASH_EXTRA_FLAGS_RESIZABLE, the keys are walked in the current
+ * table and then in the one it outgrew, without moving them, and keys may
+ * be missed or returned twice if the table grows during the iteration.
  *
  * @param h
  *   Hash table to iterate
@@ -23,8 +23,12 @@
 #include <rte_rwlock.h>
 #include <rte_spinlock.h>
 #include <rte_tailq.h>
+#include <rte_cpuflags.h>
 
 #include "rte_lpm.h"
+#ifdef CC_AVX512_SUPPORT
+#include "rte_lpm_avx512.h"
+#endif
 
 TAILQ_HEAD(rte_lpm_list, rte_tailq_entry);
 
@@ -40,6 +44,9 @@ enum valid_flag {
 	VALID
 };
 
+typedef void (*rte_lpm_lookup_bulk_vec_t)(const struct rte_lpm *lpm,
+	const uint32_t *ips, uint32_t *hop, unsigned int n, uint32_t defv);
+
 /** @internal LPM structure. */
 struct __rte_lpm {
 	/* LPM metadata. */
@@ -49,6 +56,9 @@ struct __rte_lpm {
 	struct rte_rcu_qsbr *v;		/* RCU QSBR variable. */
 	enum rte_lpm_qsbr_mode rcu_mode;/* Blocking, defer queue. */
 	struct rte_rcu_qsbr_dq *dq;	/* RCU QSBR defer queue. */
+
+	/* Bulk lookup implementation, see rte_lpm_set_lookup_type(). */
+	rte_lpm_lookup_bulk_vec_t lookup_bulk_vec;
 };
 
 /* Macro to enable/disable run-time checks. */
@@ -98,6 +108,58 @@ depth_to_range(uint8_t depth)
 	return 1 << (RTE_LPM_MAX_DEPTH - depth);
 }
 
+static void
+lpm_lookup_bulk_scalar(const struct rte_lpm *lpm, const uint32_t *ips,
+	uint32_t *hop, unsigned int n, uint32_t defv)
+{
+	const uint32_t *ptbl;
+	uint32_t tbl_entry;
+	unsigned int i;
+
+	for (i = 0; i < n; i++) {
+		ptbl = (const uint32_t *)&lpm->tbl24[ips[i] >> 8];
+		tbl_entry = *ptbl;
+		if (unlikely((tbl_entry & RTE_LPM_VALID_EXT_ENTRY_BITMASK) ==
+				RTE_LPM_VALID_EXT_ENTRY_BITMASK)) {
+			unsigned int tbl8_index = (uint8_t)ips[i] +
+				((tbl_entry & 0x00FFFFFF) *
+				RTE_LPM_TBL8_GROUP_NUM_ENTRIES);
+
+			ptbl = (const uint32_t *)&lpm->tbl8[tbl8_index];
+			tbl_entry = *ptbl;
+		}
+		hop[i] = (tbl_entry & RTE_LPM_LOOKUP_SUCCESS) ?
+			tbl_entry & 0x00FFFFFF : defv;
+	}
+}
+
+/*
+ * Returns the bulk lookup function for the requested type,
+ * or NULL if it is not supported by the build or the running CPU.
+ */
+static rte_lpm_lookup_bulk_vec_t
+lpm_get_lookup_bulk_vec(enum rte_lpm_lookup_type type)
+{
+	switch (type) {
+	case RTE_LPM_LOOKUP_SCALAR:
+		return lpm_lookup_bulk_scalar;
+	case RTE_LPM_LOOKUP_VECTOR_AVX512:
+#ifdef CC_AVX512_SUPPORT
+		if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) > 0)
+			return rte_lpm_lookup_bulk_avx512;
+#endif
+		return NULL;
+	case RTE_LPM_LOOKUP_DEFAULT:
+#ifdef CC_AVX512_SUPPORT
+		if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) > 0)
+			return rte_lpm_lookup_bulk_avx512;
+#endif
+		return lpm_lookup_bulk_scalar;
+	default:
+		return NULL;
+	}
+}
+
 /*
  * Find an existing lpm table and return a pointer to it.
  */
@@ -224,6 +286,8 @@ rte_lpm_create(const char *name, int socket_id,
 	lpm->max_rules = config->max_rules;
 	lpm->number_tbl8s = config->number_tbl8s;
 	strlcpy(lpm->name, name, sizeof(lpm->name));
+	internal_lpm->lookup_bulk_vec =
+		lpm_get_lookup_bulk_vec(RTE_LPM_LOOKUP_DEFAULT);
 
 	te->data = lpm;
 
@@ -1201,3 +1265,43 @@ rte_lpm_delete_all(struct rte_lpm *lpm)
 	/* Delete all rules form the rules table. */
 	memset(lpm->rules_tbl, 0, sizeof(lpm->rules_tbl[0]) * lpm->max_rules);
 }
+
+int
+rte_lpm_set_lookup_type(struct rte_lpm *lpm, enum rte_lpm_lookup_type type)
+{
+	struct __rte_lpm *internal_lpm;
+	rte_lpm_lookup_bulk_vec_t fn;
+
+	if (lpm == NULL)
+		return -EINVAL;
+
+	fn = lpm_get_lookup_bulk_vec(type);
+	if (fn == NULL)
+		return -ENOTSUP;
+
+	internal_lpm = container_of(lpm, struct __rte_lpm, lpm);
+	internal_lpm->lookup_bulk_vec = fn;
+	return 0;
+}
+
+void
+rte_lpm_lookup_bulk_vec(const struct rte_lpm *lpm, const uint32_t *ips,
+	uint32_t *hop, unsigned int n, uint32_t defv)
+{
+	const struct __rte_lpm *internal_lpm;
+
+	internal_lpm = container_of(lpm, const struct __rte_lpm, lpm);
+	internal_lpm->lookup_bulk_vec(lpm, ips, hop, n, defv);
+}
+
+void
+rte_lpm_lookupx16(const struct rte_lpm *lpm,
+	const uint32_t ips[RTE_LPM_LOOKUPX16_NUM],
+	uint32_t hop[RTE_LPM_LOOKUPX16_NUM], uint32_t defv)
+{
+	const struct __rte_lpm *internal_lpm;
+
+	internal_lpm = container_of(lpm, const struct __rte_lpm, lpm);
+	internal_lpm->lookup_bulk_vec(lpm, ips, hop, RTE_LPM_LOOKUPX16_NUM,
+		defv);
+}
@@ -420,6 +420,92 @@ static inline void
 rte_lpm_lookupx4(const struct rte_lpm *lpm, xmm_t ip, uint32_t hop[4],
 	uint32_t defv);
 
+/** Number of IPs resolved by one rte_lpm_lookupx16() call. */
+#define RTE_LPM_LOOKUPX16_NUM	16
+
+/** LPM bulk lookup implementations, see rte_lpm_set_lookup_type(). */
+enum rte_lpm_lookup_type {
+	/** Widest implementation supported by the build and the CPU. */
+	RTE_LPM_LOOKUP_DEFAULT = 0,
+	/** Portable scalar implementation. */
+	RTE_LPM_LOOKUP_SCALAR,
+	/** AVX-512 gather based implementation, 16 IPs per iteration. */
+	RTE_LPM_LOOKUP_VECTOR_AVX512,
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Select the implementation used by rte_lpm_lookupx16() and
+ * rte_lpm_lookup_bulk_vec() for the given LPM object.
+ * On creation every LPM object uses RTE_LPM_LOOKUP_DEFAULT.
+ *
+ * @param lpm
+ *   LPM object handle
+ * @param type
+ *   Lookup implementation to use
+ * @return
+ *   0 on success
+ *   -EINVAL for incorrect arguments
+ *   -ENOTSUP if the implementation is not supported by the build or the CPU
+ */
+__rte_experimental
+int
+rte_lpm_set_lookup_type(struct rte_lpm *lpm, enum rte_lpm_lookup_type type);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Lookup an arbitrary number of IP addresses in an LPM table using the
+ * implementation selected for the LPM object (see rte_lpm_set_lookup_type()).
+ * On CPUs with AVX-512 the tbl24 and tbl8 entries of 16 IPs are fetched
+ * with a single gather each.
+ *
+ * @param lpm
+ *   LPM object handle
+ * @param ips
+ *   Array of IPs to be looked up in the LPM table
+ * @param hop
+ *   Next hop of the most specific rule found for IP, same format as for
+ *   rte_lpm_lookupx4(): the next hop on lookup hit, defv on lookup miss.
+ * @param n
+ *   Number of elements in ips (and hop) array to lookup.
+ *   Multiples of RTE_LPM_LOOKUPX16_NUM give the best performance.
+ * @param defv
+ *   Default value to populate into corresponding element of hop[] array,
+ *   if lookup would fail.
+ */
+__rte_experimental
+void
+rte_lpm_lookup_bulk_vec(const struct rte_lpm *lpm, const uint32_t *ips,
+	uint32_t *hop, unsigned int n, uint32_t defv);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Lookup sixteen IP addresses in an LPM table.
+ * Equivalent to rte_lpm_lookup_bulk_vec() with n set to
+ * RTE_LPM_LOOKUPX16_NUM.
+ *
+ * @param lpm
+ *   LPM object handle
+ * @param ips
+ *   Sixteen IPs to be looked up in the LPM table
+ * @param hop
+ *   Next hop of the most specific rule found for IP, or defv on lookup miss.
+ * @param defv
+ *   Default value to populate into corresponding element of hop[] array,
+ *   if lookup would fail.
+ */
+__rte_experimental
+void
+rte_lpm_lookupx16(const struct rte_lpm *lpm,
+	const uint32_t ips[RTE_LPM_LOOKUPX16_NUM],
+	uint32_t hop[RTE_LPM_LOOKUPX16_NUM], uint32_t defv);
+
 #if defined(RTE_ARCH_ARM) || defined(RTE_ARCH_ARM64)
 #include "rte_lpm_neon.h"
 #elif defined(RTE_ARCH_PPC_64)
@@ -0,0 +1,102 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2020 Intel Corporation
+ */
+
+#include <string.h>
+
+#include <rte_vect.h>
+
+#include "rte_lpm.h"
+#include "rte_lpm_avx512.h"
+
+/*
+ * Gather indexes are signed 32-bit values, so tbl8 can only be reached
+ * with 32-bit indexes while (number_tbl8s * 256) stays below 2^31.
+ */
+#define LPM_AVX512_TBL8_IDX32_MAX_GROUPS	(1 << 23)
+
+static __rte_always_inline void
+lpm_lookupx16_avx512(const struct rte_lpm *lpm, const uint32_t *ips,
+	uint32_t *hop, uint32_t defv, int tbl8_idx64)
+{
+	const __m512i lsb = _mm512_set1_epi32(UINT8_MAX);
+	const __m512i nh_mask = _mm512_set1_epi32(0x00FFFFFF);
+	const __m512i valid_ext =
+		_mm512_set1_epi32(RTE_LPM_VALID_EXT_ENTRY_BITMASK);
+	const __m512i success = _mm512_set1_epi32(RTE_LPM_LOOKUP_SUCCESS);
+	__m512i ip, idx, res, i8;
+	__m256i res_lo, res_hi;
+	__mmask16 msk_ext, msk_hit;
+
+	ip = _mm512_loadu_si512(ips);
+
+	/* gather 16 tbl24[] entries at once. */
+	idx = _mm512_srli_epi32(ip, CHAR_BIT);
+	res = _mm512_i32gather_epi32(idx, (const int *)lpm->tbl24,
+		sizeof(struct rte_lpm_tbl_entry));
+
+	/* entries pointing to a tbl8 group need a second level lookup. */
+	msk_ext = _mm512_cmpeq_epi32_mask(_mm512_and_epi32(res, valid_ext),
+		valid_ext);
+	if (unlikely(msk_ext != 0)) {
+		i8 = _mm512_slli_epi32(_mm512_and_epi32(res, nh_mask),
+			CHAR_BIT);
+		i8 = _mm512_add_epi32(i8, _mm512_and_epi32(ip, lsb));
+
+		if (likely(tbl8_idx64 == 0)) {
+			res = _mm512_mask_i32gather_epi32(res, msk_ext, i8,
+				(const int *)lpm->tbl8,
+				sizeof(struct rte_lpm_tbl_entry));
+		} else {
+			/* unsigned 32-bit indexes widened to 64-bit lanes. */
+			res_lo = _mm512_mask_i64gather_epi32(
+				_mm512_castsi512_si256(res), (__mmask8)msk_ext,
+				_mm512_cvtepu32_epi64(
+					_mm512_castsi512_si256(i8)),
+				(const int *)lpm->tbl8,
+				sizeof(struct rte_lpm_tbl_entry));
+			res_hi = _mm512_mask_i64gather_epi32(
+				_mm512_extracti64x4_epi64(res, 1),
+				(__mmask8)(msk_ext >> 8),
+				_mm512_cvtepu32_epi64(
+					_mm512_extracti64x4_epi64(i8, 1)),
+				(const int *)lpm->tbl8,
+				sizeof(struct rte_lpm_tbl_entry));
+			res = _mm512_inserti64x4(_mm512_castsi256_si512(res_lo),
+				res_hi, 1);
+		}
+	}
+
+	/* keep the next hop on hit, replace it with defv on miss. */
+	msk_hit = _mm512_test_epi32_mask(res, success);
+	res = _mm512_mask_and_epi32(_mm512_set1_epi32(defv), msk_hit,
+		res, nh_mask);
+	_mm512_storeu_si512(hop, res);
+}
+
+void
+rte_lpm_lookup_bulk_avx512(const struct rte_lpm *lpm, const uint32_t *ips,
+	uint32_t *hop, unsigned int n, uint32_t defv)
+{
+	uint32_t ips_tail[RTE_LPM_LOOKUPX16_NUM];
+	uint32_t hop_tail[RTE_LPM_LOOKUPX16_NUM];
+	unsigned int i, tail;
+	int tbl8_idx64;
+
+	tbl8_idx64 = lpm->number_tbl8s >= LPM_AVX512_TBL8_IDX32_MAX_GROUPS;
+
+	for (i = 0; i + RTE_LPM_LOOKUPX16_NUM <= n;
+			i += RTE_LPM_LOOKUPX16_NUM)
+		lpm_lookupx16_avx512(lpm, ips + i, hop + i, defv, tbl8_idx64);
+
+	tail = n - i;
+	if (tail == 0)
+		return;
+
+	/* pad the remainder with a copy of the last IP. */
+	memcpy(ips_tail, ips + i, tail * sizeof(ips_tail[0]));
+	for (; tail < RTE_LPM_LOOKUPX16_NUM; tail++)
+		ips_tail[tail] = ips[n - 1];
+	lpm_lookupx16_avx512(lpm, ips_tail, hop_tail, defv, tbl8_idx64);
+	memcpy(hop + i, hop_tail, (n - i) * sizeof(hop_tail[0]));
+}
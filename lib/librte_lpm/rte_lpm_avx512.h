@@ -0,0 +1,25 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2020 Intel Corporation
+ */
+
+#ifndef _RTE_LPM_AVX512_H_
+#define _RTE_LPM_AVX512_H_
+
+/**
+ * @file
+ * Internal AVX-512 bulk lookup for the LPM library, not installed.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void
+rte_lpm_lookup_bulk_avx512(const struct rte_lpm *lpm, const uint32_t *ips,
+	uint32_t *hop, unsigned int n, uint32_t defv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_LPM_AVX512_H_ */
@@ -30,6 +30,7 @@
 #include <rte_hexdump.h>
 #include <rte_errno.h>
 #include <rte_memcpy.h>
+#include <rte_vect.h>
 
 /*
  * pktmbuf pool constructor, given as a callback function to
@@ -513,6 +514,59 @@ void rte_pktmbuf_free_bulk(struct rte_mbuf **mbufs, unsigned int count)
 		rte_mempool_put_bulk(pending[0]->pool, (void **)pending, nb_pending);
 }
 
+/*
+ * Return the number of mbufs at the beginning of the array coming from
+ * the given mempool.
+ */
+static inline unsigned int
+pktmbuf_pool_run(struct rte_mbuf * const *mbufs, unsigned int count,
+	const struct rte_mempool *mp)
+{
+	unsigned int i = 0;
+
+#if defined(RTE_ARCH_X86) && defined(RTE_MACHINE_CPUFLAG_AVX2)
+	const __m256i pool_off =
+		_mm256_set1_epi64x(offsetof(struct rte_mbuf, pool));
+	const __m256i pool = _mm256_set1_epi64x((uintptr_t)mp);
+	__m256i addr, pools;
+	uint32_t diff;
+
+	/* gather the pool pointers of 4 mbufs and compare them at once */
+	for (; i + 4 <= count; i += 4) {
+		addr = _mm256_add_epi64(pool_off,
+			_mm256_loadu_si256((const __m256i *)&mbufs[i]));
+		pools = _mm256_i64gather_epi64(NULL, addr, 1);
+		diff = ~_mm256_movemask_pd(_mm256_castsi256_pd(
+			_mm256_cmpeq_epi64(pools, pool))) & 0xf;
+		if (diff != 0)
+			return i + __builtin_ctz(diff);
+	}
+#endif
+
+	for (; i < count; i++) {
+		if (mbufs[i]->pool != mp)
+			break;
+	}
+	return i;
+}
+
+/* Free a bulk of trivially freeable packet mbufs from any mempools. */
+void
+rte_pktmbuf_free_bulk_fast_mixed(struct rte_mbuf **mbufs, unsigned int count)
+{
+	struct rte_mempool *mp;
+	unsigned int i, n;
+
+	for (i = 0; i < count; i++)
+		__rte_pktmbuf_fast_free_check(mbufs[i]);
+
+	for (i = 0; i < count; i += n) {
+		mp = mbufs[i]->pool;
+		n = 1 + pktmbuf_pool_run(&mbufs[i + 1], count - i - 1, mp);
+		rte_mempool_put_bulk(mp, (void **)&mbufs[i], n);
+	}
+}
+
 /* Creates a shallow copy of mbuf */
 struct rte_mbuf *
 rte_pktmbuf_clone(struct rte_mbuf *md, struct rte_mempool *mp)
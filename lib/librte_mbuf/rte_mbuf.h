@@ -1426,6 +1426,82 @@ static inline void rte_pktmbuf_free(struct rte_mbuf *m)
 __rte_experimental
 void rte_pktmbuf_free_bulk(struct rte_mbuf **mbufs, unsigned int count);
 
+/**
+ * @internal Check that a packet mbuf satisfies the preconditions of the
+ * fast free functions. Only enabled when RTE_ENABLE_ASSERT is set.
+ */
+static inline void
+__rte_pktmbuf_fast_free_check(struct rte_mbuf *m)
+{
+	__rte_mbuf_sanity_check(m, 1);
+	RTE_ASSERT(rte_mbuf_refcnt_read(m) == 1);
+	RTE_ASSERT(RTE_MBUF_DIRECT(m));
+	RTE_ASSERT(m->next == NULL && m->nb_segs == 1);
+	RTE_SET_USED(m);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: This API may change without prior notice.
+ *
+ * Free a bulk of packet mbufs from the same mempool, without any check.
+ *
+ * All the mbufs are put back into their mempool with a single
+ * rte_mempool_put_bulk() call; their reference counters and segments are
+ * neither read nor reset. This is the free path matching the
+ * DEV_TX_OFFLOAD_MBUF_FAST_FREE Tx offload.
+ *
+ * The caller must guarantee that each mbuf:
+ * - has a reference counter equal to 1,
+ * - is direct and has no external buffer attached,
+ * - has a single segment,
+ * - comes from the same mempool as the other mbufs.
+ *
+ *  @param mbufs
+ *    Array of pointers to packet mbufs. The array must not contain NULL
+ *    pointers.
+ *  @param count
+ *    Array size.
+ */
+__rte_experimental
+static inline void
+rte_pktmbuf_free_bulk_fast(struct rte_mbuf **mbufs, unsigned int count)
+{
+	unsigned int i;
+
+	if (unlikely(count == 0))
+		return;
+
+	for (i = 0; i < count; i++) {
+		__rte_pktmbuf_fast_free_check(mbufs[i]);
+		RTE_ASSERT(mbufs[i]->pool == mbufs[0]->pool);
+	}
+
+	rte_mempool_put_bulk(mbufs[0]->pool, (void **)mbufs, count);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: This API may change without prior notice.
+ *
+ * Free a bulk of packet mbufs from any mempools, without any check.
+ *
+ * Same as rte_pktmbuf_free_bulk_fast(), except that the mbufs may come
+ * from different mempools. Consecutive mbufs from the same mempool are
+ * detected with vector instructions when available, and put back into
+ * their mempool with a single rte_mempool_put_bulk() call. The function
+ * is most efficient when mbufs from the same mempool are grouped.
+ *
+ *  @param mbufs
+ *    Array of pointers to packet mbufs. The array must not contain NULL
+ *    pointers.
+ *  @param count
+ *    Array size.
+ */
+__rte_experimental
+void rte_pktmbuf_free_bulk_fast_mixed(struct rte_mbuf **mbufs,
+		unsigned int count);
+
 /**
  * Create a "clone" of the given packet mbuf.
  *
@@ -32,6 +32,7 @@
 #include <rte_tailq.h>
 #include <rte_function_versioning.h>
 #include <rte_eal_paging.h>
+#include <rte_telemetry.h>
 
 
 #include "rte_mempool.h"
@@ -44,10 +45,6 @@ static struct rte_tailq_elem rte_mempool_tailq = {
 };
 EAL_REGISTER_TAILQ(rte_mempool_tailq)
 
-#define CACHE_FLUSHTHRESH_MULTIPLIER 1.5
-#define CALC_CACHE_FLUSHTHRESH(c)	\
-	((typeof(c))((c) * CACHE_FLUSHTHRESH_MULTIPLIER))
-
 #if defined(RTE_ARCH_X86)
 /*
  * return the greatest common divisor between a and b (fast algorithm)
@@ -804,6 +801,12 @@ mempool_cache_init(struct rte_mempool_cache *cache, uint32_t size)
 	cache->size = size;
 	cache->flushthresh = CALC_CACHE_FLUSHTHRESH(size);
 	cache->len = 0;
+	cache->min_size = size;
+	cache->max_size = 0;
+	cache->ops = 0;
+	cache->misses = 0;
+	cache->get_miss = 0;
+	cache->put_flush = 0;
 }
 
 /*
@@ -847,6 +850,76 @@ rte_mempool_cache_free(struct rte_mempool_cache *cache)
 	rte_free(cache);
 }
 
+static int
+mempool_cache_check_bounds(uint32_t min_size, uint32_t max_size)
+{
+	if (max_size == 0)
+		return 0;
+	if (min_size == 0 || min_size > max_size ||
+			max_size > RTE_MEMPOOL_CACHE_MAX_SIZE)
+		return -EINVAL;
+	return 0;
+}
+
+static void
+mempool_cache_set_adaptive(struct rte_mempool_cache *cache,
+	uint32_t min_size, uint32_t max_size)
+{
+	uint32_t size = cache->size;
+
+	if (max_size != 0) {
+		size = RTE_MAX(size, min_size);
+		size = RTE_MIN(size, max_size);
+	} else {
+		min_size = size;
+	}
+
+	cache->size = size;
+	cache->flushthresh = CALC_CACHE_FLUSHTHRESH(size);
+	cache->min_size = min_size;
+	cache->max_size = max_size;
+	cache->ops = 0;
+	cache->misses = 0;
+}
+
+/* make a cache resize itself between bounds */
+int
+rte_mempool_cache_set_adaptive(struct rte_mempool_cache *cache,
+	uint32_t min_size, uint32_t max_size)
+{
+	if (cache == NULL || mempool_cache_check_bounds(min_size, max_size))
+		return -EINVAL;
+
+	mempool_cache_set_adaptive(cache, min_size, max_size);
+	return 0;
+}
+
+/* make the default caches of a mempool resize themselves between bounds */
+int
+rte_mempool_set_adaptive_cache(struct rte_mempool *mp, uint32_t min_size,
+	uint32_t max_size)
+{
+	struct rte_mempool_cache *cache;
+	unsigned int lcore_id;
+
+	if (mp == NULL || mp->cache_size == 0 ||
+			mempool_cache_check_bounds(min_size, max_size) ||
+			CALC_CACHE_FLUSHTHRESH(max_size) > mp->size)
+		return -EINVAL;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		cache = &mp->local_cache[lcore_id];
+		mempool_cache_set_adaptive(cache, min_size, max_size);
+		if (cache->len > cache->flushthresh) {
+			rte_mempool_ops_enqueue_bulk(mp,
+				&cache->objs[cache->size],
+				cache->len - cache->size);
+			cache->len = cache->size;
+		}
+	}
+	return 0;
+}
+
 /* create an empty mempool */
 struct rte_mempool *
 rte_mempool_create_empty(const char *name, unsigned n, unsigned elt_size,
@@ -1076,6 +1149,9 @@ rte_mempool_dump_cache(FILE *f, const struct rte_mempool *mp)
 	unsigned lcore_id;
 	unsigned count = 0;
 	unsigned cache_count;
+	const struct rte_mempool_cache *cache;
+	uint64_t get_miss = 0;
+	uint64_t put_flush = 0;
 
 	fprintf(f, "  internal cache infos:\n");
 	fprintf(f, "    cache_size=%"PRIu32"\n", mp->cache_size);
@@ -1083,13 +1159,29 @@ rte_mempool_dump_cache(FILE *f, const struct rte_mempool *mp)
 	if (mp->cache_size == 0)
 		return count;
 
+	cache = &mp->local_cache[rte_get_master_lcore()];
+	if (cache->max_size != 0)
+		fprintf(f, "    adaptive cache_min_size=%"PRIu32
+			" cache_max_size=%"PRIu32"\n",
+			cache->min_size, cache->max_size);
+
 	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
-		cache_count = mp->local_cache[lcore_id].len;
+		cache = &mp->local_cache[lcore_id];
+		cache_count = cache->len;
 		fprintf(f, "    cache_count[%u]=%"PRIu32"\n",
 			lcore_id, cache_count);
+		if (cache->get_miss != 0 || cache->put_flush != 0)
+			fprintf(f, "    cache_stats[%u]: size=%"PRIu32
+				" get_miss=%"PRIu64" put_flush=%"PRIu64"\n",
+				lcore_id, cache->size, cache->get_miss,
+				cache->put_flush);
+		get_miss += cache->get_miss;
+		put_flush += cache->put_flush;
 		count += cache_count;
 	}
 	fprintf(f, "    total_cache_count=%u\n", count);
+	fprintf(f, "    total_get_miss=%"PRIu64"\n", get_miss);
+	fprintf(f, "    total_put_flush=%"PRIu64"\n", put_flush);
 	return count;
 }
 
@@ -1399,3 +1491,80 @@ void rte_mempool_walk(void (*func)(struct rte_mempool *, void *),
 
 	rte_mcfg_mempool_read_unlock();
 }
+
+static void
+mempool_list_cb(struct rte_mempool *mp, void *arg)
+{
+	struct rte_tel_data *d = arg;
+
+	rte_tel_data_add_array_string(d, mp->name);
+}
+
+static int
+mempool_handle_list(const char *cmd __rte_unused,
+		const char *params __rte_unused, struct rte_tel_data *d)
+{
+	rte_tel_data_start_array(d, RTE_TEL_STRING_VAL);
+	rte_mempool_walk(mempool_list_cb, d);
+	return 0;
+}
+
+static int
+mempool_handle_info(const char *cmd __rte_unused, const char *params,
+		struct rte_tel_data *d)
+{
+	const struct rte_mempool_cache *cache;
+	char name[RTE_TEL_MAX_STRING_LEN];
+	struct rte_mempool *mp;
+	uint64_t get_miss = 0;
+	uint64_t put_flush = 0;
+	unsigned int lcore_id;
+
+	if (params == NULL || strlen(params) == 0)
+		return -EINVAL;
+
+	mp = rte_mempool_lookup(params);
+	if (mp == NULL)
+		return -EINVAL;
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_string(d, "name", mp->name);
+	rte_tel_data_add_dict_string(d, "ops",
+		rte_mempool_get_ops(mp->ops_index)->name);
+	rte_tel_data_add_dict_u64(d, "size", mp->size);
+	rte_tel_data_add_dict_u64(d, "elt_size", mp->elt_size);
+	rte_tel_data_add_dict_u64(d, "avail_count",
+		rte_mempool_avail_count(mp));
+	rte_tel_data_add_dict_u64(d, "in_use_count",
+		rte_mempool_in_use_count(mp));
+	rte_tel_data_add_dict_u64(d, "cache_size", mp->cache_size);
+	if (mp->cache_size == 0)
+		return 0;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		cache = &mp->local_cache[lcore_id];
+		get_miss += cache->get_miss;
+		put_flush += cache->put_flush;
+	}
+	rte_tel_data_add_dict_u64(d, "cache_get_miss", get_miss);
+	rte_tel_data_add_dict_u64(d, "cache_put_flush", put_flush);
+
+	cache = &mp->local_cache[rte_get_master_lcore()];
+	rte_tel_data_add_dict_u64(d, "cache_min_size", cache->min_size);
+	rte_tel_data_add_dict_u64(d, "cache_max_size", cache->max_size);
+
+	RTE_LCORE_FOREACH(lcore_id) {
+		cache = &mp->local_cache[lcore_id];
+		snprintf(name, sizeof(name), "lcore_%u_cache_size", lcore_id);
+		rte_tel_data_add_dict_u64(d, name, cache->size);
+	}
+	return 0;
+}
+
+RTE_INIT(mempool_init_telemetry)
+{
+	rte_telemetry_register_cmd("/mempool/list", mempool_handle_list,
+		"Returns list of available mempools. Takes no parameters");
+	rte_telemetry_register_cmd("/mempool/info", mempool_handle_info,
+		"Returns mempool info and cache statistics. Parameters: mempool name");
+}
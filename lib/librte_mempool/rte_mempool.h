@@ -86,6 +86,14 @@ struct rte_mempool_cache {
 	uint32_t size;	      /**< Size of the cache */
 	uint32_t flushthresh; /**< Threshold before we flush excess elements */
 	uint32_t len;	      /**< Current cache count */
+	uint32_t min_size;    /**< Lower size bound of an adaptive cache */
+	uint32_t max_size;    /**< Upper size bound, 0 if the size is fixed */
+	uint32_t ops;	      /**< Gets and puts in the current window */
+	uint32_t misses;      /**< Backend accesses in the current window */
+	/** Gets that had to access the backend, adaptive caches only */
+	uint64_t get_miss;
+	/** Puts that flushed objects to the backend, adaptive caches only */
+	uint64_t put_flush;
 	/*
 	 * Cache is allocated to this size to allow it to overflow in certain
 	 * cases to avoid needless emptying of cache.
@@ -301,6 +309,11 @@ struct rte_mempool {
 #define __MEMPOOL_CONTIG_BLOCKS_STAT_ADD(mp, name, n) do {} while (0)
 #endif
 
+/** @internal Flush threshold of a cache of the given size. */
+#define CACHE_FLUSHTHRESH_MULTIPLIER 1.5
+#define CALC_CACHE_FLUSHTHRESH(c)	\
+	((typeof(c))((c) * CACHE_FLUSHTHRESH_MULTIPLIER))
+
 /**
  * Calculate the size of the mempool header.
  *
@@ -1256,6 +1269,66 @@ rte_mempool_cache_create(uint32_t size, int socket_id);
 void
 rte_mempool_cache_free(struct rte_mempool_cache *cache);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Make a mempool cache adaptive.
+ *
+ * An adaptive cache periodically compares the number of gets and puts
+ * that had to access the mempool backend to the total number of gets and
+ * puts, and doubles or halves its size within the given bounds. Its
+ * current size is clamped to the bounds immediately; objects exceeding a
+ * shrunk cache are flushed by the next put into the cache.
+ *
+ * This function is not thread-safe with respect to the cache: it must be
+ * called by the lcore owning the cache, or while the cache is not in use.
+ *
+ * @param cache
+ *   A pointer to the mempool cache.
+ * @param min_size
+ *   The minimum size of the cache, must be strictly positive.
+ * @param max_size
+ *   The maximum size of the cache, at least min_size and at most
+ *   RTE_MEMPOOL_CACHE_MAX_SIZE. If 0, the cache is reverted to a fixed
+ *   size cache keeping its current size, and min_size is ignored.
+ * @return
+ *   0 on success, -EINVAL if the bounds are invalid.
+ */
+__rte_experimental
+int
+rte_mempool_cache_set_adaptive(struct rte_mempool_cache *cache,
+		uint32_t min_size, uint32_t max_size);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Make all per-lcore default caches of a mempool adaptive.
+ *
+ * See rte_mempool_cache_set_adaptive(). Objects exceeding a shrunk cache are
+ * flushed immediately. The same thread-safety restrictions apply to every
+ * per-lcore cache: the mempool must not be in use by any lcore while this
+ * function is called.
+ *
+ * @param mp
+ *   A pointer to the mempool structure, created with a non-zero cache size.
+ * @param min_size
+ *   The minimum size of the caches, must be strictly positive.
+ * @param max_size
+ *   The maximum size of the caches, or 0 to fix the caches at their current
+ *   size. Like the cache_size parameter of rte_mempool_create(), it must
+ *   not exceed RTE_MEMPOOL_CACHE_MAX_SIZE and its flush threshold must not
+ *   exceed the number of elements in the mempool.
+ * @return
+ *   0 on success, -EINVAL if the mempool has no cache or the bounds are
+ *   invalid.
+ */
+__rte_experimental
+int
+rte_mempool_set_adaptive_cache(struct rte_mempool *mp, uint32_t min_size,
+		uint32_t max_size);
+
 /**
  * Get a pointer to the per-lcore default mempool cache.
  *
@@ -1302,6 +1375,62 @@ rte_mempool_cache_flush(struct rte_mempool_cache *cache,
 	cache->len = 0;
 }
 
+/**
+ * Number of cache operations after which an adaptive cache re-evaluates
+ * its size.
+ */
+#define RTE_MEMPOOL_CACHE_ADAPT_PERIOD 256
+
+/**
+ * An adaptive cache doubles its size when more than one operation out of
+ * RTE_MEMPOOL_CACHE_ADAPT_GROW had to access the backend, and halves it
+ * when fewer than one out of RTE_MEMPOOL_CACHE_ADAPT_SHRINK did.
+ */
+#define RTE_MEMPOOL_CACHE_ADAPT_GROW 8
+#define RTE_MEMPOOL_CACHE_ADAPT_SHRINK 64
+
+/**
+ * @internal Account a get or put of an adaptive cache and resize the cache
+ * once a full window of operations has been observed, whether or not they
+ * accessed the backend. Objects exceeding a shrunk cache are flushed to the
+ * mempool.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param cache
+ *   A pointer to an adaptive mempool cache structure.
+ * @param miss
+ *   1 if the operation had to access the mempool backend, 0 otherwise.
+ */
+static __rte_always_inline void
+__mempool_cache_adapt(struct rte_mempool *mp, struct rte_mempool_cache *cache,
+		uint32_t miss)
+{
+	uint32_t size;
+
+	cache->ops++;
+	cache->misses += miss;
+	if (likely(cache->ops < RTE_MEMPOOL_CACHE_ADAPT_PERIOD))
+		return;
+
+	size = cache->size;
+	if (cache->misses * RTE_MEMPOOL_CACHE_ADAPT_GROW > cache->ops)
+		size = RTE_MIN(size * 2, cache->max_size);
+	else if (cache->misses * RTE_MEMPOOL_CACHE_ADAPT_SHRINK < cache->ops)
+		size = RTE_MAX(size / 2, cache->min_size);
+
+	cache->size = size;
+	cache->flushthresh = CALC_CACHE_FLUSHTHRESH(size);
+	cache->ops = 0;
+	cache->misses = 0;
+
+	if (cache->len > cache->flushthresh) {
+		rte_mempool_ops_enqueue_bulk(mp, &cache->objs[size],
+				cache->len - size);
+		cache->len = size;
+	}
+}
+
 /**
  * @internal Put several objects back in the mempool; used internally.
  * @param mp
@@ -1319,6 +1448,7 @@ __mempool_generic_put(struct rte_mempool *mp, void * const *obj_table,
 		      unsigned int n, struct rte_mempool_cache *cache)
 {
 	void **cache_objs;
+	uint32_t flush = 0;
 
 	/* increment stat now, adding in mempool always success */
 	__MEMPOOL_STAT_ADD(mp, put, n);
@@ -1345,6 +1475,12 @@ __mempool_generic_put(struct rte_mempool *mp, void * const *obj_table,
 		rte_mempool_ops_enqueue_bulk(mp, &cache->objs[cache->size],
 				cache->len - cache->size);
 		cache->len = cache->size;
+		flush = 1;
+	}
+
+	if (unlikely(cache->max_size != 0)) {
+		cache->put_flush += flush;
+		__mempool_cache_adapt(mp, cache, flush);
 	}
 
 	return;
@@ -1442,14 +1578,23 @@ static __rte_always_inline int
 __mempool_generic_get(struct rte_mempool *mp, void **obj_table,
 		      unsigned int n, struct rte_mempool_cache *cache)
 {
-	int ret;
+	int ret, miss = 0;
 	uint32_t index, len;
 	void **cache_objs;
 
-	/* No cache provided or cannot be satisfied from cache */
-	if (unlikely(cache == NULL || n >= cache->size))
+	/* No cache provided */
+	if (unlikely(cache == NULL))
 		goto ring_dequeue;
 
+	/* Cannot be satisfied from cache */
+	if (unlikely(n >= cache->size)) {
+		if (unlikely(cache->max_size != 0)) {
+			cache->get_miss++;
+			__mempool_cache_adapt(mp, cache, 1);
+		}
+		goto ring_dequeue;
+	}
+
 	cache_objs = cache->objs;
 
 	/* Can this be satisfied from the cache? */
@@ -1471,6 +1616,7 @@ __mempool_generic_get(struct rte_mempool *mp, void **obj_table,
 		}
 
 		cache->len += req;
+		miss = 1;
 	}
 
 	/* Now fill in the response ... */
@@ -1479,6 +1625,11 @@ __mempool_generic_get(struct rte_mempool *mp, void **obj_table,
 
 	cache->len -= n;
 
+	if (unlikely(cache->max_size != 0)) {
+		cache->get_miss += miss;
+		__mempool_cache_adapt(mp, cache, miss);
+	}
+
 	__MEMPOOL_STAT_ADD(mp, get_success, n);
 
 	return 0;
@@ -25,12 +25,32 @@ ethdev_rx_node_process_inline(struct rte_graph *graph, struct rte_node *node,
 	queue = ctx->queue_id;
 	next_index = ctx->cls_next;
 
+	/* Skip the queue while backing off from an idle poll */
+	if (unlikely(ctx->skip)) {
+		ctx->skip--;
+		return 0;
+	}
+
 	/* Get pkts from port */
 	count = rte_eth_rx_burst(port, queue, (struct rte_mbuf **)node->objs,
-				 RTE_GRAPH_BURST_SIZE);
-
-	if (!count)
+				 ctx->burst);
+
+	if (!count) {
+		/* Back off exponentially while the queue stays idle */
+		ctx->backoff = RTE_MIN(ctx->backoff ? ctx->backoff * 2 : 1,
+				       ETHDEV_RX_BACKOFF_MAX);
+		ctx->skip = ctx->backoff;
+		ctx->burst = RTE_MAX(ctx->burst / 2, ETHDEV_RX_BURST_MIN);
 		return 0;
+	}
+	ctx->backoff = 0;
+
+	/* Follow the queue occupancy seen by the burst */
+	if (count == ctx->burst)
+		ctx->burst = RTE_MIN(ctx->burst * 2, RTE_GRAPH_BURST_SIZE);
+	else if (count < ctx->burst / 4)
+		ctx->burst = RTE_MAX(ctx->burst / 2, ETHDEV_RX_BURST_MIN);
+
 	node->idx = count;
 	/* Enqueue to next node */
 	rte_node_next_stream_move(graph, node, next_index);
@@ -49,6 +69,9 @@ ethdev_rx_node_process(struct rte_graph *graph, struct rte_node *node,
 	RTE_SET_USED(cnt);
 
 	n_pkts = ethdev_rx_node_process_inline(graph, node, ctx);
+	if (ethdev_rx_main.poll_cb)
+		ethdev_rx_main.poll_cb(ctx->port_id, ctx->queue_id, n_pkts,
+				       ethdev_rx_main.poll_cb_arg);
 	return n_pkts;
 }
 
@@ -183,6 +206,7 @@ ethdev_rx_node_init(const struct rte_graph *graph, struct rte_node *node)
 	ethdev_rx_node_elem_t *elem = ethdev_rx_main.head;
 
 	RTE_SET_USED(graph);
+	RTE_BUILD_BUG_ON(sizeof(ethdev_rx_node_ctx_t) > RTE_NODE_CTX_SZ);
 
 	while (elem) {
 		if (elem->nid == node->id) {
@@ -196,11 +220,23 @@ ethdev_rx_node_init(const struct rte_graph *graph, struct rte_node *node)
 	RTE_VERIFY(elem != NULL);
 
 	ctx->cls_next = ETHDEV_RX_NEXT_PKT_CLS;
+	ctx->burst = RTE_GRAPH_BURST_SIZE;
+	ctx->backoff = 0;
+	ctx->skip = 0;
 
 	/* Check and setup ptype */
 	return ethdev_ptype_setup(ctx->port_id, ctx->queue_id);
 }
 
+int
+rte_node_eth_rx_poll_cb_set(rte_node_eth_rx_poll_cb_t cb, void *arg)
+{
+	ethdev_rx_main.poll_cb = cb;
+	ethdev_rx_main.poll_cb_arg = arg;
+
+	return 0;
+}
+
 struct ethdev_rx_node_main *
 ethdev_rx_get_node_data_get(void)
 {
@@ -10,6 +10,13 @@ extern "C" {
 
 #include <rte_common.h>
 
+#include "rte_node_eth_api.h"
+
+/* Smallest adaptive Rx burst size */
+#define ETHDEV_RX_BURST_MIN 4
+/* Largest number of walks an idle queue is skipped for */
+#define ETHDEV_RX_BACKOFF_MAX 32
+
 struct ethdev_rx_node_elem;
 struct ethdev_rx_node_ctx;
 typedef struct ethdev_rx_node_elem ethdev_rx_node_elem_t;
@@ -24,6 +31,9 @@ struct ethdev_rx_node_ctx {
 	uint16_t port_id;  /**< Port identifier of the Rx node. */
 	uint16_t queue_id; /**< Queue identifier of the Rx node. */
 	uint16_t cls_next;
+	uint16_t burst;	   /**< Current Rx burst size. */
+	uint16_t backoff;  /**< Walks skipped after the last idle poll. */
+	uint16_t skip;	   /**< Walks left before the next poll. */
 };
 
 /**
@@ -54,6 +64,10 @@ enum ethdev_rx_next_nodes {
 struct ethdev_rx_node_main {
 	ethdev_rx_node_elem_t *head;
 	/**< Pointer to the head Rx node element. */
+	rte_node_eth_rx_poll_cb_t poll_cb;
+	/**< Rx poll callback. */
+	void *poll_cb_arg;
+	/**< Rx poll callback argument. */
 };
 
 /**
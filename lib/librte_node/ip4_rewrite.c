@@ -21,6 +21,125 @@
 
 static struct ip4_rewrite_node_main *ip4_rewrite_nm;
 
+/* Edge '0' of ip4_rewrite is pkt_drop */
+#define IP4_REWRITE_NEXT_PKT_DROP 0
+
+/* Rewrite data of at most this size is written with a single vector store */
+#define IP4_REWRITE_VEC_LEN 16
+
+/* Loading 16 bytes at offset (16 - len) gives a mask of the first len bytes */
+static const uint8_t ip4_rewrite_mask[2 * IP4_REWRITE_VEC_LEN] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+#if defined(RTE_ARCH_X86)
+static __rte_always_inline xmm_t
+ip4_rewrite_blend(void *d, xmm_t rw, xmm_t mask)
+{
+	xmm_t p = _mm_loadu_si128((xmm_t *)d);
+
+	return _mm_or_si128(_mm_and_si128(mask, rw),
+			    _mm_andnot_si128(mask, p));
+}
+
+static __rte_always_inline void
+ip4_rewrite_l2_x4(void *d0, void *d1, void *d2, void *d3,
+		  const struct ip4_rewrite_nh_header *nh)
+{
+	xmm_t rw, mask;
+
+	if (unlikely(nh->rewrite_len > IP4_REWRITE_VEC_LEN)) {
+		rte_memcpy(d0, nh->rewrite_data, nh->rewrite_len);
+		rte_memcpy(d1, nh->rewrite_data, nh->rewrite_len);
+		rte_memcpy(d2, nh->rewrite_data, nh->rewrite_len);
+		rte_memcpy(d3, nh->rewrite_data, nh->rewrite_len);
+		return;
+	}
+
+	/* Load the next hop rewrite data once for all four packets */
+	rw = _mm_loadu_si128((const xmm_t *)nh->rewrite_data);
+	mask = _mm_loadu_si128((const xmm_t *)(ip4_rewrite_mask +
+				IP4_REWRITE_VEC_LEN - nh->rewrite_len));
+	_mm_storeu_si128((xmm_t *)d0, ip4_rewrite_blend(d0, rw, mask));
+	_mm_storeu_si128((xmm_t *)d1, ip4_rewrite_blend(d1, rw, mask));
+	_mm_storeu_si128((xmm_t *)d2, ip4_rewrite_blend(d2, rw, mask));
+	_mm_storeu_si128((xmm_t *)d3, ip4_rewrite_blend(d3, rw, mask));
+}
+
+static __rte_always_inline void
+ip4_rewrite_l2(void *d, const struct ip4_rewrite_nh_header *nh)
+{
+	xmm_t rw, mask;
+
+	if (unlikely(nh->rewrite_len > IP4_REWRITE_VEC_LEN)) {
+		rte_memcpy(d, nh->rewrite_data, nh->rewrite_len);
+		return;
+	}
+
+	rw = _mm_loadu_si128((const xmm_t *)nh->rewrite_data);
+	mask = _mm_loadu_si128((const xmm_t *)(ip4_rewrite_mask +
+				IP4_REWRITE_VEC_LEN - nh->rewrite_len));
+	_mm_storeu_si128((xmm_t *)d, ip4_rewrite_blend(d, rw, mask));
+}
+#elif defined(RTE_MACHINE_CPUFLAG_NEON)
+static __rte_always_inline void
+ip4_rewrite_l2_x4(void *d0, void *d1, void *d2, void *d3,
+		  const struct ip4_rewrite_nh_header *nh)
+{
+	uint8x16_t rw, mask;
+
+	if (unlikely(nh->rewrite_len > IP4_REWRITE_VEC_LEN)) {
+		rte_memcpy(d0, nh->rewrite_data, nh->rewrite_len);
+		rte_memcpy(d1, nh->rewrite_data, nh->rewrite_len);
+		rte_memcpy(d2, nh->rewrite_data, nh->rewrite_len);
+		rte_memcpy(d3, nh->rewrite_data, nh->rewrite_len);
+		return;
+	}
+
+	/* Load the next hop rewrite data once for all four packets */
+	rw = vld1q_u8(nh->rewrite_data);
+	mask = vld1q_u8(ip4_rewrite_mask + IP4_REWRITE_VEC_LEN -
+			nh->rewrite_len);
+	vst1q_u8(d0, vbslq_u8(mask, rw, vld1q_u8(d0)));
+	vst1q_u8(d1, vbslq_u8(mask, rw, vld1q_u8(d1)));
+	vst1q_u8(d2, vbslq_u8(mask, rw, vld1q_u8(d2)));
+	vst1q_u8(d3, vbslq_u8(mask, rw, vld1q_u8(d3)));
+}
+
+static __rte_always_inline void
+ip4_rewrite_l2(void *d, const struct ip4_rewrite_nh_header *nh)
+{
+	uint8x16_t rw, mask;
+
+	if (unlikely(nh->rewrite_len > IP4_REWRITE_VEC_LEN)) {
+		rte_memcpy(d, nh->rewrite_data, nh->rewrite_len);
+		return;
+	}
+
+	rw = vld1q_u8(nh->rewrite_data);
+	mask = vld1q_u8(ip4_rewrite_mask + IP4_REWRITE_VEC_LEN -
+			nh->rewrite_len);
+	vst1q_u8(d, vbslq_u8(mask, rw, vld1q_u8(d)));
+}
+#else
+static __rte_always_inline void
+ip4_rewrite_l2(void *d, const struct ip4_rewrite_nh_header *nh)
+{
+	rte_memcpy(d, nh->rewrite_data, nh->rewrite_len);
+}
+
+static __rte_always_inline void
+ip4_rewrite_l2_x4(void *d0, void *d1, void *d2, void *d3,
+		  const struct ip4_rewrite_nh_header *nh)
+{
+	ip4_rewrite_l2(d0, nh);
+	ip4_rewrite_l2(d1, nh);
+	ip4_rewrite_l2(d2, nh);
+	ip4_rewrite_l2(d3, nh);
+}
+#endif
+
 static uint16_t
 ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 			 void **objs, uint16_t nb_objs)
@@ -30,6 +149,7 @@ ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 	uint16_t next0, next1, next2, next3, next_index;
 	struct rte_ipv4_hdr *ip0, *ip1, *ip2, *ip3;
 	uint16_t n_left_from, held = 0, last_spec = 0;
+	uint16_t nh0, nh1, nh2, nh3;
 	void *d0, *d1, *d2, *d3;
 	void **to_next, **from;
 	rte_xmm_t priv01;
@@ -79,44 +199,59 @@ ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		priv23.u32[1] += rte_cpu_to_be_16(0x0100);
 		priv23.u32[3] += rte_cpu_to_be_16(0x0100);
 
-		/* Update ttl,cksum rewrite ethernet hdr on mbuf0 */
+		nh0 = priv01.u16[0];
+		nh1 = priv01.u16[4];
+		nh2 = priv23.u16[0];
+		nh3 = priv23.u16[4];
+
 		d0 = rte_pktmbuf_mtod(mbuf0, void *);
-		rte_memcpy(d0, nh[priv01.u16[0]].rewrite_data,
-			   nh[priv01.u16[0]].rewrite_len);
+		d1 = rte_pktmbuf_mtod(mbuf1, void *);
+		d2 = rte_pktmbuf_mtod(mbuf2, void *);
+		d3 = rte_pktmbuf_mtod(mbuf3, void *);
+
+		/* Rewrite ethernet hdr, all four share a next hop mostly */
+		if (likely((nh0 == nh1) & (nh1 == nh2) & (nh2 == nh3))) {
+			ip4_rewrite_l2_x4(d0, d1, d2, d3, &nh[nh0]);
+			next0 = nh[nh0].tx_node;
+			next1 = next0;
+			next2 = next0;
+			next3 = next0;
+		} else {
+			ip4_rewrite_l2(d0, &nh[nh0]);
+			ip4_rewrite_l2(d1, &nh[nh1]);
+			ip4_rewrite_l2(d2, &nh[nh2]);
+			ip4_rewrite_l2(d3, &nh[nh3]);
+			next0 = nh[nh0].tx_node;
+			next1 = nh[nh1].tx_node;
+			next2 = nh[nh2].tx_node;
+			next3 = nh[nh3].tx_node;
+		}
+
+		/* Drop the packets whose ttl expires on this hop */
+		next0 = (priv01.u16[1] > 1) ? next0 : IP4_REWRITE_NEXT_PKT_DROP;
+		next1 = (priv01.u16[5] > 1) ? next1 : IP4_REWRITE_NEXT_PKT_DROP;
+		next2 = (priv23.u16[1] > 1) ? next2 : IP4_REWRITE_NEXT_PKT_DROP;
+		next3 = (priv23.u16[5] > 1) ? next3 : IP4_REWRITE_NEXT_PKT_DROP;
 
-		next0 = nh[priv01.u16[0]].tx_node;
+		/* Update ttl,cksum of mbuf0 */
 		ip0 = (struct rte_ipv4_hdr *)((uint8_t *)d0 +
 					      sizeof(struct rte_ether_hdr));
 		ip0->time_to_live = priv01.u16[1] - 1;
 		ip0->hdr_checksum = priv01.u16[2] + priv01.u16[3];
 
-		/* Update ttl,cksum rewrite ethernet hdr on mbuf1 */
-		d1 = rte_pktmbuf_mtod(mbuf1, void *);
-		rte_memcpy(d1, nh[priv01.u16[4]].rewrite_data,
-			   nh[priv01.u16[4]].rewrite_len);
-
-		next1 = nh[priv01.u16[4]].tx_node;
+		/* Update ttl,cksum of mbuf1 */
 		ip1 = (struct rte_ipv4_hdr *)((uint8_t *)d1 +
 					      sizeof(struct rte_ether_hdr));
 		ip1->time_to_live = priv01.u16[5] - 1;
 		ip1->hdr_checksum = priv01.u16[6] + priv01.u16[7];
 
-		/* Update ttl,cksum rewrite ethernet hdr on mbuf2 */
-		d2 = rte_pktmbuf_mtod(mbuf2, void *);
-		rte_memcpy(d2, nh[priv23.u16[0]].rewrite_data,
-			   nh[priv23.u16[0]].rewrite_len);
-		next2 = nh[priv23.u16[0]].tx_node;
+		/* Update ttl,cksum of mbuf2 */
 		ip2 = (struct rte_ipv4_hdr *)((uint8_t *)d2 +
 					      sizeof(struct rte_ether_hdr));
 		ip2->time_to_live = priv23.u16[1] - 1;
 		ip2->hdr_checksum = priv23.u16[2] + priv23.u16[3];
 
-		/* Update ttl,cksum rewrite ethernet hdr on mbuf3 */
-		d3 = rte_pktmbuf_mtod(mbuf3, void *);
-		rte_memcpy(d3, nh[priv23.u16[4]].rewrite_data,
-			   nh[priv23.u16[4]].rewrite_len);
-
-		next3 = nh[priv23.u16[4]].tx_node;
+		/* Update ttl,cksum of mbuf3 */
 		ip3 = (struct rte_ipv4_hdr *)((uint8_t *)d3 +
 					      sizeof(struct rte_ether_hdr));
 		ip3->time_to_live = priv23.u16[5] - 1;
@@ -203,10 +338,12 @@ ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		n_left_from -= 1;
 
 		d0 = rte_pktmbuf_mtod(mbuf0, void *);
-		rte_memcpy(d0, nh[node_mbuf_priv1(mbuf0)->nh].rewrite_data,
-			   nh[node_mbuf_priv1(mbuf0)->nh].rewrite_len);
+		nh0 = node_mbuf_priv1(mbuf0)->nh;
+		ip4_rewrite_l2(d0, &nh[nh0]);
 
-		next0 = nh[node_mbuf_priv1(mbuf0)->nh].tx_node;
+		next0 = nh[nh0].tx_node;
+		if (unlikely(node_mbuf_priv1(mbuf0)->ttl <= 1))
+			next0 = IP4_REWRITE_NEXT_PKT_DROP;
 		ip0 = (struct rte_ipv4_hdr *)((uint8_t *)d0 +
 					      sizeof(struct rte_ether_hdr));
 		chksum = node_mbuf_priv1(mbuf0)->cksum +
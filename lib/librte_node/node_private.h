@@ -22,11 +22,11 @@ extern int rte_node_logtype;
 
 /**
  *
- * Node mbuf private data to store next hop, ttl and checksum.
+ * Node mbuf private data to store next hop, ttl/hop limit and checksum.
  */
 struct node_mbuf_priv1 {
 	union {
-		/* IP4 rewrite */
+		/* IP4/IP6 rewrite */
 		struct {
 			uint16_t nh;
 			uint16_t ttl;
@@ -58,6 +58,49 @@ struct rte_node_ethdev_config {
 __rte_experimental
 int rte_node_eth_config(struct rte_node_ethdev_config *cfg,
 			uint16_t cnt, uint16_t nb_graphs);
+
+/**
+ * Rx poll callback of ethdev_rx nodes.
+ *
+ * Invoked on every walk of an ethdev_rx node, including the walks on which
+ * an idle queue is not polled because of the Rx backoff, so that it can
+ * feed an idle detection such as the rte_power empty poll API:
+ *
+ * @code{.c}
+ * if (nb_rx)
+ *	rte_power_poll_stat_update(rte_lcore_id(), nb_rx);
+ * else
+ *	rte_power_empty_poll_stat_update(rte_lcore_id());
+ * @endcode
+ *
+ * @param port_id
+ *   Port identifier of the Rx node.
+ * @param queue_id
+ *   Queue identifier of the Rx node.
+ * @param nb_rx
+ *   Number of packets received, 0 when the queue was idle or skipped.
+ * @param arg
+ *   Argument passed to rte_node_eth_rx_poll_cb_set().
+ */
+typedef void (*rte_node_eth_rx_poll_cb_t)(uint16_t port_id,
+					  uint16_t queue_id, uint16_t nb_rx,
+					  void *arg);
+
+/**
+ * Set the Rx poll callback of ethdev_rx nodes.
+ *
+ * Must be called before the graphs are walked.
+ *
+ * @param cb
+ *   Callback function, NULL to remove it.
+ * @param arg
+ *   Argument passed to the callback.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_eth_rx_poll_cb_set(rte_node_eth_rx_poll_cb_t cb, void *arg);
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,7 @@
 #include <rte_eal_memconfig.h>
 #include <rte_errno.h>
 #include <rte_malloc.h>
+#include <rte_pause.h>
 #include <rte_tailq.h>
 
 #include "rte_reorder.h"
@@ -46,8 +47,32 @@ struct rte_reorder_buffer {
 	struct cir_buffer ready_buf; /**< temp buffer for dequeued entries */
 	struct cir_buffer order_buf; /**< buffer used to reorder entries */
 	int is_initialized;
+	uint32_t seqn_base; /**< seq. number stored at order_buf position 0 */
+	uint32_t skip_seqn; /**< min_seqn requested by early MP inserts */
+	int mp_tagged; /**< Empty order_buf entries hold REORDER_FREE_TAG */
 } __rte_cache_aligned;
 
+/* States of rte_reorder_buffer::is_initialized */
+#define REORDER_UNINITIALIZED  0
+#define REORDER_INITIALIZED    1
+#define REORDER_INITIALIZING   2
+
+/*
+ * With multi-producer inserts, an empty order_buf entry holds a tag made of
+ * the only sequence number it can take instead of NULL. The drain side tags
+ * each entry it drains or skips for the next window, so that a producer
+ * which checked the window before it moved fails instead of landing in the
+ * next one. mbuf pointers are aligned, so tags are told apart by their low
+ * bit.
+ */
+#define REORDER_FREE_TAG(seqn) \
+	((struct rte_mbuf *)(((uintptr_t)(seqn) << 1) | 1))
+#define REORDER_IS_MBUF(entry) \
+	((entry) != NULL && ((uintptr_t)(entry) & 1) == 0)
+
+/* Drain side refreshes a stale skip_seqn before it wraps around */
+#define REORDER_SKIP_STALE     (1u << 30)
+
 static void
 rte_reorder_free_mbufs(struct rte_reorder_buffer *b);
 
@@ -175,7 +200,7 @@ rte_reorder_free_mbufs(struct rte_reorder_buffer *b)
 
 	/* Free up the mbufs of order buffer & ready buffer */
 	for (i = 0; i < b->order_buf.size; i++) {
-		if (b->order_buf.entries[i])
+		if (REORDER_IS_MBUF(b->order_buf.entries[i]))
 			rte_pktmbuf_free(b->order_buf.entries[i]);
 		if (b->ready_buf.entries[i])
 			rte_pktmbuf_free(b->ready_buf.entries[i]);
@@ -277,6 +302,9 @@ rte_reorder_fill_overflow(struct rte_reorder_buffer *b, unsigned n)
 
 		/* Move all ready entries that fit to the ready_buf */
 		while (order_buf->entries[order_buf->head] != NULL) {
+			if (((ready_buf->head + 1) & ready_buf->mask) == ready_buf->tail)
+				break;
+
 			ready_buf->entries[ready_buf->head] =
 					order_buf->entries[order_buf->head];
 
@@ -285,9 +313,6 @@ rte_reorder_fill_overflow(struct rte_reorder_buffer *b, unsigned n)
 
 			order_buf->head = (order_buf->head + 1) & order_buf->mask;
 
-			if (((ready_buf->head + 1) & ready_buf->mask) == ready_buf->tail)
-				break;
-
 			ready_buf->head = (ready_buf->head + 1) & ready_buf->mask;
 		}
 	}
@@ -297,21 +322,17 @@ rte_reorder_fill_overflow(struct rte_reorder_buffer *b, unsigned n)
 	return order_head_adv;
 }
 
-int
-rte_reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf)
+static inline int
+reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf)
 {
+	struct cir_buffer *order_buf = &b->order_buf;
 	uint32_t offset, position;
-	struct cir_buffer *order_buf;
-
-	if (b == NULL || mbuf == NULL) {
-		rte_errno = EINVAL;
-		return -1;
-	}
 
-	order_buf = &b->order_buf;
 	if (!b->is_initialized) {
 		b->min_seqn = mbuf->seqn;
-		b->is_initialized = 1;
+		b->seqn_base = mbuf->seqn - order_buf->head;
+		b->skip_seqn = mbuf->seqn;
+		b->is_initialized = REORDER_INITIALIZED;
 	}
 
 	/*
@@ -363,11 +384,151 @@ rte_reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf)
 	return 0;
 }
 
+int
+rte_reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf)
+{
+	if (b == NULL || mbuf == NULL) {
+		rte_errno = EINVAL;
+		return -1;
+	}
+
+	return reorder_insert(b, mbuf);
+}
+
+unsigned int
+rte_reorder_insert_bulk(struct rte_reorder_buffer *b, struct rte_mbuf **mbufs,
+		unsigned int n)
+{
+	struct cir_buffer *order_buf;
+	unsigned int i = 0;
+	uint32_t offset;
+
+	if (b == NULL || mbufs == NULL) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+
+	if (n == 0)
+		return 0;
+
+	if (!b->is_initialized && reorder_insert(b, mbufs[i++]) != 0)
+		return 0;
+
+	/* Fast path for mbufs within the current window */
+	order_buf = &b->order_buf;
+	for (; i < n; i++) {
+		offset = mbufs[i]->seqn - b->min_seqn;
+		if (likely(offset < order_buf->size))
+			order_buf->entries[(order_buf->head + offset) &
+					order_buf->mask] = mbufs[i];
+		else if (reorder_insert(b, mbufs[i]) != 0)
+			break;
+	}
+
+	return i;
+}
+
+static void
+reorder_mp_init(struct rte_reorder_buffer *b, uint32_t seqn)
+{
+	int state = REORDER_UNINITIALIZED;
+	unsigned int i;
+
+	if (__atomic_compare_exchange_n(&b->is_initialized, &state,
+			REORDER_INITIALIZING, 0, __ATOMIC_ACQUIRE,
+			__ATOMIC_ACQUIRE)) {
+		b->min_seqn = seqn;
+		b->seqn_base = seqn - b->order_buf.head;
+		b->skip_seqn = seqn;
+		for (i = 0; i < b->order_buf.size; i++)
+			b->order_buf.entries[(b->order_buf.head + i) &
+					b->order_buf.mask] =
+				REORDER_FREE_TAG(seqn + i);
+		b->mp_tagged = 1;
+		__atomic_store_n(&b->is_initialized, REORDER_INITIALIZED,
+				__ATOMIC_RELEASE);
+		return;
+	}
+
+	/* Another producer won the race, wait for its initialization */
+	while (__atomic_load_n(&b->is_initialized, __ATOMIC_ACQUIRE) !=
+			REORDER_INITIALIZED)
+		rte_pause();
+}
+
+static inline int
+reorder_mp_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf)
+{
+	struct cir_buffer *order_buf = &b->order_buf;
+	struct rte_mbuf **entry, *expected;
+	uint32_t seqn = mbuf->seqn;
+	uint32_t offset, skip, cur;
+
+	offset = seqn - __atomic_load_n(&b->min_seqn, __ATOMIC_ACQUIRE);
+	if (unlikely(offset >= order_buf->size)) {
+		if (offset >= 2 * order_buf->size) {
+			rte_errno = ERANGE;
+			return -1;
+		}
+
+		/*
+		 * Early mbuf: only the drain side moves the window, so ask it
+		 * to skip the missing entries that keep this mbuf out.
+		 */
+		skip = seqn + 1 - order_buf->size;
+		cur = __atomic_load_n(&b->skip_seqn, __ATOMIC_RELAXED);
+		while ((int32_t)(skip - cur) > 0 &&
+				!__atomic_compare_exchange_n(&b->skip_seqn, &cur,
+					skip, 1, __ATOMIC_RELAXED,
+					__ATOMIC_RELAXED))
+			;
+		rte_errno = ENOSPC;
+		return -1;
+	}
+
+	entry = &order_buf->entries[(seqn - b->seqn_base) & order_buf->mask];
+	expected = REORDER_FREE_TAG(seqn);
+	if (!__atomic_compare_exchange_n(entry, &expected, mbuf, 0,
+			__ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+		/* Duplicate, or drained or skipped since min_seqn was read */
+		rte_errno = REORDER_IS_MBUF(expected) ? EEXIST : ERANGE;
+		return -1;
+	}
+
+	return 0;
+}
+
+unsigned int
+rte_reorder_mp_insert_bulk(struct rte_reorder_buffer *b,
+		struct rte_mbuf **mbufs, unsigned int n)
+{
+	unsigned int i;
+
+	if (b == NULL || mbufs == NULL) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+
+	if (n == 0)
+		return 0;
+
+	if (unlikely(__atomic_load_n(&b->is_initialized, __ATOMIC_ACQUIRE) !=
+			REORDER_INITIALIZED))
+		reorder_mp_init(b, mbufs[0]->seqn);
+
+	for (i = 0; i < n; i++)
+		if (reorder_mp_insert(b, mbufs[i]) != 0)
+			break;
+
+	return i;
+}
+
 unsigned int
 rte_reorder_drain(struct rte_reorder_buffer *b, struct rte_mbuf **mbufs,
 		unsigned max_mbufs)
 {
 	unsigned int drain_cnt = 0;
+	uint32_t min_seqn, skip_seqn, head;
 
 	struct cir_buffer *order_buf = &b->order_buf,
 			*ready_buf = &b->ready_buf;
@@ -375,20 +536,63 @@ rte_reorder_drain(struct rte_reorder_buffer *b, struct rte_mbuf **mbufs,
 	/* Try to fetch requested number of mbufs from ready buffer */
 	while ((drain_cnt < max_mbufs) && (ready_buf->tail != ready_buf->head)) {
 		mbufs[drain_cnt++] = ready_buf->entries[ready_buf->tail];
+		ready_buf->entries[ready_buf->tail] = NULL;
 		ready_buf->tail = (ready_buf->tail + 1) & ready_buf->mask;
 	}
 
+	/* Nothing can be in the order buffer before the first insert */
+	if (__atomic_load_n(&b->is_initialized, __ATOMIC_ACQUIRE) !=
+			REORDER_INITIALIZED)
+		return drain_cnt;
+
 	/*
 	 * If requested number of buffers not fetched from ready buffer, fetch
 	 * remaining buffers from order buffer
 	 */
-	while ((drain_cnt < max_mbufs) &&
-			(order_buf->entries[order_buf->head] != NULL)) {
-		mbufs[drain_cnt++] = order_buf->entries[order_buf->head];
-		order_buf->entries[order_buf->head] = NULL;
-		b->min_seqn++;
-		order_buf->head = (order_buf->head + 1) & order_buf->mask;
+	min_seqn = b->min_seqn;
+	head = order_buf->head;
+	while (drain_cnt < max_mbufs) {
+		struct rte_mbuf **entry = &order_buf->entries[head];
+		struct rte_mbuf *mbuf;
+
+		mbuf = __atomic_load_n(entry, __ATOMIC_ACQUIRE);
+		if (!REORDER_IS_MBUF(mbuf)) {
+			/* Skip a missing entry only if an early mbuf waits */
+			skip_seqn = __atomic_load_n(&b->skip_seqn,
+					__ATOMIC_RELAXED);
+			if ((int32_t)(skip_seqn - min_seqn) <= 0)
+				break;
+
+			/* Free it for the next window, unless stored meanwhile */
+			if (!__atomic_compare_exchange_n(entry, &mbuf,
+					REORDER_FREE_TAG(min_seqn +
+						order_buf->size), 0,
+					__ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+				continue;
+		} else {
+			mbufs[drain_cnt++] = mbuf;
+			/* Single-producer inserts expect NULL in empty entries */
+			__atomic_store_n(entry, b->mp_tagged ?
+					REORDER_FREE_TAG(min_seqn +
+						order_buf->size) : NULL,
+					__ATOMIC_RELAXED);
+		}
+
+		min_seqn++;
+		head = (head + 1) & order_buf->mask;
 	}
 
+	if (min_seqn != b->min_seqn) {
+		order_buf->head = head;
+		__atomic_store_n(&b->min_seqn, min_seqn, __ATOMIC_RELEASE);
+	}
+
+	/* Keep the skip request from wrapping around ahead of the window */
+	skip_seqn = __atomic_load_n(&b->skip_seqn, __ATOMIC_RELAXED);
+	if (unlikely(min_seqn - skip_seqn > REORDER_SKIP_STALE &&
+			(int32_t)(min_seqn - skip_seqn) > 0))
+		__atomic_compare_exchange_n(&b->skip_seqn, &skip_seqn,
+				min_seqn, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+
 	return drain_cnt;
 }
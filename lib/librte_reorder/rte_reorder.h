@@ -15,6 +15,7 @@
  *
  */
 
+#include <rte_compat.h>
 #include <rte_mbuf.h>
 
 #ifdef __cplusplus
@@ -125,6 +126,70 @@ rte_reorder_free(struct rte_reorder_buffer *b);
 int
 rte_reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Insert a burst of mbufs in reorder buffer in their correct positions
+ *
+ * Same as calling rte_reorder_insert() for each mbuf, with a single check
+ * of the arguments and a fast path for the mbufs falling within the current
+ * sequence window. Insertion stops at the first mbuf that cannot be
+ * inserted.
+ *
+ * @param b
+ *   Reorder buffer where the mbufs have to be inserted.
+ * @param mbufs
+ *   Array of mbufs of packets that need to be inserted in reorder buffer.
+ * @param n
+ *   Number of mbufs in the array.
+ * @return
+ *   Number of mbufs inserted, from the start of the array. When lower
+ *   than n, rte_errno is set as for rte_reorder_insert() for mbufs[ret].
+ */
+__rte_experimental
+unsigned int
+rte_reorder_insert_bulk(struct rte_reorder_buffer *b, struct rte_mbuf **mbufs,
+		unsigned int n);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Insert a burst of mbufs in reorder buffer, multi-producer safe
+ *
+ * Several lcores may call this function concurrently on the same reorder
+ * buffer, while a single lcore calls rte_reorder_drain(). Each mbuf is
+ * stored directly in the slot of its sequence number with an atomic
+ * operation. It must not be mixed with rte_reorder_insert() or
+ * rte_reorder_insert_bulk() on the same reorder buffer.
+ *
+ * Unlike rte_reorder_insert(), an early mbuf does not move the sequence
+ * window itself: it fails with ENOSPC and makes the next
+ * rte_reorder_drain() skip the missing mbufs that keep it out of the
+ * window, after which it can be inserted again.
+ *
+ * @param b
+ *   Reorder buffer where the mbufs have to be inserted.
+ * @param mbufs
+ *   Array of mbufs of packets that need to be inserted in reorder buffer.
+ * @param n
+ *   Number of mbufs in the array.
+ * @return
+ *   Number of mbufs inserted, from the start of the array. When lower
+ *   than n, rte_errno is set for mbufs[ret]:
+ *    - ENOSPC - Early mbuf, retry after draining.
+ *    - ERANGE - Too early or late mbuf, including an mbuf whose position
+ *      has already been drained or skipped, should be ignored without any
+ *      handling.
+ *    - EEXIST - Another mbuf with the same sequence number is waiting in
+ *      the reorder buffer.
+ */
+__rte_experimental
+unsigned int
+rte_reorder_mp_insert_bulk(struct rte_reorder_buffer *b,
+		struct rte_mbuf **mbufs, unsigned int n);
+
 /**
  * Fetch reordered buffers
  *
@@ -15,6 +15,8 @@
 #include <rte_mbuf.h>
 #include <rte_bitmap.h>
 #include <rte_reciprocal.h>
+#include <rte_ring.h>
+#include <rte_ring_peek_zc.h>
 
 #include "rte_sched.h"
 #include "rte_sched_common.h"
@@ -41,6 +43,8 @@
 #define RTE_SCHED_GRINDER_PCACHE_SIZE         (64 / RTE_SCHED_QUEUES_PER_PIPE)
 #define RTE_SCHED_PIPE_INVALID                UINT32_MAX
 #define RTE_SCHED_BMP_POS_INVALID             UINT32_MAX
+#define RTE_SCHED_ARBITER_WINDOW              32
+#define RTE_SCHED_ARBITER_QUANTUM_RATIO_MAX   256
 
 /* Scaling for cycles_per_byte calculation
  * Chosen so that minimum rate is 480 bit/sec
@@ -229,10 +233,24 @@ struct rte_sched_port {
 	uint32_t n_pkts_out;
 	uint32_t subport_id;
 
+	/* Shards (multi-core mode) */
+	uint32_t n_shards;
+	uint32_t shard_id;            /* Next shard polled by the arbiter */
+	uint64_t arbiter_window;      /* Max NIC TX time ahead of CPU time */
+	struct rte_sched_port **shard_ports; /* Per shard view of the port */
+	struct rte_sched_shard *shards;      /* Arbiter state of each shard */
+	struct rte_ring *shard_ring;  /* Shard view only: output to arbiter */
+
 	/* Large data structures */
 	struct rte_sched_subport *subports[0] __rte_cache_aligned;
 } __rte_cache_aligned;
 
+struct rte_sched_shard {
+	struct rte_ring *ring;
+	int64_t deficit;
+	uint32_t quantum;
+};
+
 enum rte_sched_subport_array {
 	e_RTE_SCHED_SUBPORT_ARRAY_PIPE = 0,
 	e_RTE_SCHED_SUBPORT_ARRAY_QUEUE,
@@ -893,6 +911,25 @@ rte_sched_subport_free(struct rte_sched_port *port,
 	rte_free(subport);
 }
 
+static void
+rte_sched_port_shard_free(struct rte_sched_port *port)
+{
+	uint32_t i;
+
+	for (i = 0; i < port->n_shards; i++) {
+		if (port->shards != NULL)
+			rte_ring_free(port->shards[i].ring);
+		if (port->shard_ports != NULL)
+			rte_free(port->shard_ports[i]);
+	}
+
+	rte_free(port->shards);
+	rte_free(port->shard_ports);
+	port->shards = NULL;
+	port->shard_ports = NULL;
+	port->n_shards = 0;
+}
+
 void
 rte_sched_port_free(struct rte_sched_port *port)
 {
@@ -902,6 +939,8 @@ rte_sched_port_free(struct rte_sched_port *port)
 	if (port == NULL)
 		return;
 
+	rte_sched_port_shard_free(port);
+
 	for (i = 0; i < port->n_subports_per_port; i++)
 		rte_sched_subport_free(port, port->subports[i]);
 
@@ -2445,6 +2484,144 @@ grinder_next_pipe(struct rte_sched_port *port,
 }
 
 
+#ifdef SCHED_VECTOR_SSE4
+
+static inline void
+grinder_wrr_load(struct rte_sched_subport *subport, uint32_t pos)
+{
+	struct rte_sched_grinder *grinder = subport->grinder + pos;
+	struct rte_sched_pipe *pipe = grinder->pipe;
+	struct rte_sched_pipe_profile *pipe_params = grinder->pipe_params;
+	const __m128i qbits = _mm_set_epi16(0, 0, 0, 0, 8, 4, 2, 1);
+	__m128i tokens, mask;
+	uint32_t w;
+
+	/* Widen the four 8-bit pipe tokens to 16 bits and scale them */
+	memcpy(&w, pipe->wrr_tokens, sizeof(w));
+	tokens = _mm_cvtepu8_epi16(_mm_cvtsi32_si128(w));
+	tokens = _mm_slli_epi16(tokens, RTE_SCHED_WRR_SHIFT);
+	_mm_storel_epi64((__m128i *)grinder->wrr_tokens, tokens);
+
+	/* Expand each qmask bit into a 16-bit all-ones/all-zeros lane */
+	mask = _mm_and_si128(_mm_set1_epi16(grinder->qmask), qbits);
+	mask = _mm_cmpeq_epi16(mask, qbits);
+	_mm_storel_epi64((__m128i *)grinder->wrr_mask, mask);
+
+	memcpy(grinder->wrr_cost, pipe_params->wrr_cost,
+		sizeof(grinder->wrr_cost));
+}
+
+static inline void
+grinder_wrr_store(struct rte_sched_subport *subport, uint32_t pos)
+{
+	struct rte_sched_grinder *grinder = subport->grinder + pos;
+	struct rte_sched_pipe *pipe = grinder->pipe;
+	__m128i tokens, mask;
+	uint32_t w;
+
+	tokens = _mm_loadl_epi64((__m128i *)grinder->wrr_tokens);
+	mask = _mm_loadl_epi64((__m128i *)grinder->wrr_mask);
+	tokens = _mm_srli_epi16(_mm_and_si128(tokens, mask),
+		RTE_SCHED_WRR_SHIFT);
+
+	/* Truncate to 8 bits like the scalar store, then narrow */
+	tokens = _mm_and_si128(tokens, _mm_set1_epi16(0xFF));
+	tokens = _mm_packus_epi16(tokens, tokens);
+	w = (uint32_t)_mm_cvtsi128_si32(tokens);
+	memcpy(pipe->wrr_tokens, &w, sizeof(w));
+}
+
+static inline void
+grinder_wrr(struct rte_sched_subport *subport, uint32_t pos)
+{
+	struct rte_sched_grinder *grinder = subport->grinder + pos;
+	__m128i tokens, mask, min;
+
+	tokens = _mm_loadl_epi64((__m128i *)grinder->wrr_tokens);
+	mask = _mm_loadl_epi64((__m128i *)grinder->wrr_mask);
+	tokens = _mm_or_si128(tokens,
+		_mm_andnot_si128(mask, _mm_set1_epi16(-1)));
+
+	/*
+	 * PHMINPOSUW returns the lowest index holding the minimum, while
+	 * rte_min_pos_4_u16() picks the highest one. Search the reversed
+	 * lanes so both agree on ties; the unused upper lanes are 0xFFFF
+	 * and never win over the lower ones.
+	 */
+	min = _mm_shufflelo_epi16(tokens, _MM_SHUFFLE(0, 1, 2, 3));
+	min = _mm_minpos_epu16(min);
+	grinder->qpos = 3 - _mm_extract_epi16(min, 1);
+
+	tokens = _mm_sub_epi16(tokens, _mm_shufflelo_epi16(min, 0));
+	_mm_storel_epi64((__m128i *)grinder->wrr_tokens, tokens);
+}
+
+#elif defined(SCHED_VECTOR_NEON)
+
+static inline void
+grinder_wrr_load(struct rte_sched_subport *subport, uint32_t pos)
+{
+	struct rte_sched_grinder *grinder = subport->grinder + pos;
+	struct rte_sched_pipe *pipe = grinder->pipe;
+	struct rte_sched_pipe_profile *pipe_params = grinder->pipe_params;
+	static const uint16_t qbits[RTE_SCHED_BE_QUEUES_PER_PIPE] = {
+		1, 2, 4, 8};
+	uint16x4_t tokens, mask;
+	uint32_t w;
+
+	/* Widen the four 8-bit pipe tokens to 16 bits and scale them */
+	memcpy(&w, pipe->wrr_tokens, sizeof(w));
+	tokens = vget_low_u16(vmovl_u8(vcreate_u8(w)));
+	tokens = vshl_n_u16(tokens, RTE_SCHED_WRR_SHIFT);
+	vst1_u16(grinder->wrr_tokens, tokens);
+
+	/* Expand each qmask bit into a 16-bit all-ones/all-zeros lane */
+	mask = vtst_u16(vdup_n_u16(grinder->qmask), vld1_u16(qbits));
+	vst1_u16(grinder->wrr_mask, mask);
+
+	memcpy(grinder->wrr_cost, pipe_params->wrr_cost,
+		sizeof(grinder->wrr_cost));
+}
+
+static inline void
+grinder_wrr_store(struct rte_sched_subport *subport, uint32_t pos)
+{
+	struct rte_sched_grinder *grinder = subport->grinder + pos;
+	struct rte_sched_pipe *pipe = grinder->pipe;
+	uint16x4_t tokens;
+	uint8x8_t narrow;
+	uint32_t w;
+
+	tokens = vand_u16(vld1_u16(grinder->wrr_tokens),
+		vld1_u16(grinder->wrr_mask));
+	tokens = vshr_n_u16(tokens, RTE_SCHED_WRR_SHIFT);
+
+	/* VMOVN truncates to 8 bits like the scalar store */
+	narrow = vmovn_u16(vcombine_u16(tokens, tokens));
+	w = vget_lane_u32(vreinterpret_u32_u8(narrow), 0);
+	memcpy(pipe->wrr_tokens, &w, sizeof(w));
+}
+
+static inline void
+grinder_wrr(struct rte_sched_subport *subport, uint32_t pos)
+{
+	struct rte_sched_grinder *grinder = subport->grinder + pos;
+	uint16x4_t tokens, min;
+	uint64_t eq;
+
+	tokens = vorn_u16(vld1_u16(grinder->wrr_tokens),
+		vld1_u16(grinder->wrr_mask));
+
+	/* Highest lane holding the minimum, as rte_min_pos_4_u16() */
+	min = vdup_n_u16(vminv_u16(tokens));
+	eq = vget_lane_u64(vreinterpret_u64_u16(vceq_u16(tokens, min)), 0);
+	grinder->qpos = (rte_fls_u64(eq) - 1) >> 4;
+
+	vst1_u16(grinder->wrr_tokens, vsub_u16(tokens, min));
+}
+
+#else
+
 static inline void
 grinder_wrr_load(struct rte_sched_subport *subport, uint32_t pos)
 {
@@ -2513,6 +2690,7 @@ grinder_wrr(struct rte_sched_subport *subport, uint32_t pos)
 	grinder->wrr_tokens[3] -= wrr_tokens_min;
 }
 
+#endif /* SCHED_VECTOR_SSE4 / SCHED_VECTOR_NEON */
 
 #define grinder_evict(subport, pos)
 
@@ -2672,12 +2850,11 @@ grinder_handle(struct rte_sched_port *port,
 }
 
 static inline void
-rte_sched_port_time_resync(struct rte_sched_port *port)
+rte_sched_port_time_update(struct rte_sched_port *port)
 {
 	uint64_t cycles = rte_get_tsc_cycles();
 	uint64_t cycles_diff;
 	uint64_t bytes_diff;
-	uint32_t i;
 
 	if (cycles < port->time_cpu_cycles)
 		port->time_cpu_cycles = 0;
@@ -2693,6 +2870,14 @@ rte_sched_port_time_resync(struct rte_sched_port *port)
 	port->time_cpu_bytes += bytes_diff;
 	if (port->time < port->time_cpu_bytes)
 		port->time = port->time_cpu_bytes;
+}
+
+static inline void
+rte_sched_port_time_resync(struct rte_sched_port *port)
+{
+	uint32_t i;
+
+	rte_sched_port_time_update(port);
 
 	/* Reset pipe loop detection */
 	for (i = 0; i < port->n_subports_per_port; i++)
@@ -2760,3 +2945,262 @@ rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint
 
 	return count;
 }
+
+static int
+rte_sched_port_shard_check_params(struct rte_sched_port *port,
+	struct rte_sched_port_shard_params *params)
+{
+	uint32_t i;
+
+	if (port == NULL) {
+		RTE_LOG(ERR, SCHED,
+			"%s: Incorrect value for parameter port\n", __func__);
+		return -EINVAL;
+	}
+
+	if (port->n_shards != 0) {
+		RTE_LOG(ERR, SCHED,
+			"%s: Port is already sharded\n", __func__);
+		return -EEXIST;
+	}
+
+	if (params == NULL) {
+		RTE_LOG(ERR, SCHED,
+			"%s: Incorrect value for parameter params\n", __func__);
+		return -EINVAL;
+	}
+
+	/* n_shards: non-zero, not more than the number of subports */
+	if (params->n_shards == 0 ||
+	    params->n_shards > port->n_subports_per_port) {
+		RTE_LOG(ERR, SCHED,
+			"%s: Incorrect value for n_shards\n", __func__);
+		return -EINVAL;
+	}
+
+	/* ring_size: non-zero, power of 2 */
+	if (params->ring_size == 0 ||
+	    !rte_is_power_of_2(params->ring_size)) {
+		RTE_LOG(ERR, SCHED,
+			"%s: Incorrect value for ring_size\n", __func__);
+		return -EINVAL;
+	}
+
+	if (params->subport_shard == NULL) {
+		RTE_LOG(ERR, SCHED,
+			"%s: Incorrect value for subport_shard\n", __func__);
+		return -EINVAL;
+	}
+
+	/* Each subport: configured, mapped to a valid shard */
+	for (i = 0; i < port->n_subports_per_port; i++) {
+		if (port->subports[i] == NULL) {
+			RTE_LOG(ERR, SCHED,
+				"%s: Subport %u is not configured\n",
+				__func__, i);
+			return -EINVAL;
+		}
+
+		if (params->subport_shard[i] >= params->n_shards) {
+			RTE_LOG(ERR, SCHED,
+				"%s: Incorrect shard for subport %u\n",
+				__func__, i);
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+static double
+rte_sched_port_shard_rate(struct rte_sched_port *port,
+	struct rte_sched_port_shard_params *params, uint32_t shard_id)
+{
+	double rate = 0;
+	uint32_t i;
+
+	for (i = 0; i < port->n_subports_per_port; i++) {
+		struct rte_sched_subport *s = port->subports[i];
+
+		if (params->subport_shard[i] == shard_id)
+			rate += (double)s->tb_credits_per_period / s->tb_period;
+	}
+
+	return rate;
+}
+
+int
+rte_sched_port_shard_config(struct rte_sched_port *port,
+	struct rte_sched_port_shard_params *params)
+{
+	char ring_name[RTE_RING_NAMESIZE];
+	double rate, rate_min = 0;
+	uint32_t i, j;
+	int status;
+
+	status = rte_sched_port_shard_check_params(port, params);
+	if (status != 0)
+		return status;
+
+	port->shard_ports = rte_zmalloc_socket("qos_shard_ports",
+		params->n_shards * sizeof(struct rte_sched_port *),
+		RTE_CACHE_LINE_SIZE, port->socket);
+	port->shards = rte_zmalloc_socket("qos_shards",
+		params->n_shards * sizeof(struct rte_sched_shard),
+		RTE_CACHE_LINE_SIZE, port->socket);
+	port->n_shards = params->n_shards;
+	if (port->shard_ports == NULL || port->shards == NULL) {
+		RTE_LOG(ERR, SCHED, "%s: Memory allocation fails\n", __func__);
+		rte_sched_port_shard_free(port);
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < params->n_shards; i++) {
+		struct rte_sched_port *shard;
+		uint32_t n_subports = 0;
+
+		for (j = 0; j < port->n_subports_per_port; j++)
+			if (params->subport_shard[j] == i)
+				n_subports++;
+
+		if (n_subports == 0) {
+			RTE_LOG(ERR, SCHED,
+				"%s: Shard %u has no subport\n", __func__, i);
+			rte_sched_port_shard_free(port);
+			return -EINVAL;
+		}
+
+		/*
+		 * The shard is a view of the port restricted to its subports,
+		 * with its own timing and grinder state, so that the regular
+		 * dequeue path runs on it unchanged.
+		 */
+		shard = rte_zmalloc_socket("qos_shard", sizeof(*shard) +
+			n_subports * sizeof(struct rte_sched_subport *),
+			RTE_CACHE_LINE_SIZE, port->socket);
+		if (shard == NULL) {
+			RTE_LOG(ERR, SCHED,
+				"%s: Memory allocation fails\n", __func__);
+			rte_sched_port_shard_free(port);
+			return -ENOMEM;
+		}
+		port->shard_ports[i] = shard;
+
+		memcpy(shard, port, sizeof(*shard));
+		shard->n_subports_per_port = n_subports;
+		shard->subport_id = 0;
+		shard->n_shards = 0;
+		shard->shard_ports = NULL;
+		shard->shards = NULL;
+
+		for (j = 0, n_subports = 0; j < port->n_subports_per_port; j++)
+			if (params->subport_shard[j] == i)
+				shard->subports[n_subports++] = port->subports[j];
+
+		snprintf(ring_name, sizeof(ring_name), "SCHED_%" PRIxPTR "_%u",
+			(uintptr_t)port, i);
+		shard->shard_ring = rte_ring_create(ring_name,
+			params->ring_size, port->socket,
+			RING_F_SP_ENQ | RING_F_SC_DEQ);
+		if (shard->shard_ring == NULL) {
+			RTE_LOG(ERR, SCHED,
+				"%s: Cannot create ring for shard %u\n",
+				__func__, i);
+			rte_sched_port_shard_free(port);
+			return -ENOMEM;
+		}
+		port->shards[i].ring = shard->shard_ring;
+
+		rate = rte_sched_port_shard_rate(port, params, i);
+		if (rate_min == 0 || rate < rate_min)
+			rate_min = rate;
+	}
+
+	/* Arbiter quantum of each shard proportional to its subports rate */
+	for (i = 0; i < params->n_shards; i++) {
+		double ratio = rte_sched_port_shard_rate(port, params, i) /
+			rate_min;
+
+		if (ratio > RTE_SCHED_ARBITER_QUANTUM_RATIO_MAX)
+			ratio = RTE_SCHED_ARBITER_QUANTUM_RATIO_MAX;
+
+		port->shards[i].quantum = (uint32_t)(port->mtu * ratio);
+		port->shards[i].deficit = 0;
+	}
+
+	port->shard_id = 0;
+	port->arbiter_window = (uint64_t)port->mtu * RTE_SCHED_ARBITER_WINDOW;
+
+	return 0;
+}
+
+int
+rte_sched_port_shard_dequeue(struct rte_sched_port *port, uint32_t shard_id,
+	uint32_t n_pkts)
+{
+	struct rte_sched_port *shard = port->shard_ports[shard_id];
+	struct rte_ring_zc_data zcd;
+	uint32_t n, count;
+
+	/* Dequeue straight into the free space of the arbiter ring */
+	n = rte_ring_enqueue_zc_burst_start(shard->shard_ring, n_pkts,
+		&zcd, NULL);
+	if (n == 0)
+		return 0;
+
+	count = rte_sched_port_dequeue(shard, zcd.ptr1, zcd.n1);
+	if (count == zcd.n1 && n != zcd.n1)
+		count += rte_sched_port_dequeue(shard, zcd.ptr2, n - zcd.n1);
+
+	rte_ring_enqueue_zc_finish(shard->shard_ring, count);
+
+	return count;
+}
+
+int
+rte_sched_port_arbiter_dequeue(struct rte_sched_port *port,
+	struct rte_mbuf **pkts, uint32_t n_pkts)
+{
+	uint32_t shard_id = port->shard_id;
+	uint32_t count = 0, n_idle = 0;
+	uint64_t time_max;
+
+	rte_sched_port_time_update(port);
+	time_max = port->time_cpu_bytes + port->arbiter_window;
+
+	/* Deficit round robin across the shards, under the port rate */
+	while (count < n_pkts && port->time < time_max) {
+		struct rte_sched_shard *shard = port->shards + shard_id;
+		struct rte_mbuf *pkt;
+
+		if (shard->deficit <= 0)
+			shard->deficit += shard->quantum;
+
+		if (shard->deficit > 0 &&
+		    rte_ring_sc_dequeue(shard->ring, (void **)&pkt) == 0) {
+			uint32_t pkt_len = pkt->pkt_len + port->frame_overhead;
+
+			pkts[count++] = pkt;
+			port->time += pkt_len;
+			shard->deficit -= pkt_len;
+			n_idle = 0;
+
+			/* Stay on the same shard while it has credit left */
+			if (shard->deficit > 0)
+				continue;
+		} else if (shard->deficit > 0) {
+			/* Empty shard does not bank its credit */
+			shard->deficit = 0;
+			if (++n_idle == port->n_shards)
+				break;
+		}
+
+		shard_id++;
+		if (shard_id == port->n_shards)
+			shard_id = 0;
+	}
+
+	port->shard_id = shard_id;
+
+	return count;
+}
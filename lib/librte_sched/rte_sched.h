@@ -507,6 +507,102 @@ rte_sched_port_enqueue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint
 int
 rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint32_t n_pkts);
 
+/** Multi-core (sharded) port configuration parameters. */
+struct rte_sched_port_shard_params {
+	/** Number of shards. Each shard is driven by a single worker lcore.
+	 * Must not exceed the number of subports of the port.
+	 */
+	uint32_t n_shards;
+
+	/** Shard of each subport, array of n_subports_per_port entries.
+	 * Every shard must own at least one subport.
+	 */
+	const uint32_t *subport_shard;
+
+	/** Size of the ring carrying the output of each shard to the
+	 * arbiter (power of 2).
+	 */
+	uint32_t ring_size;
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Hierarchical scheduler port sharding
+ *
+ * Partitions the subports of the port across several shards, so that the
+ * port can be shaped by several lcores. Each shard is driven by its own
+ * worker lcore, which enqueues the packets of its subports with
+ * rte_sched_port_enqueue() and schedules them with
+ * rte_sched_port_shard_dequeue(). A single arbiter lcore merges the shard
+ * output under the port rate with rte_sched_port_arbiter_dequeue().
+ *
+ * Once sharded, rte_sched_port_dequeue() must no longer be called on the
+ * port, and rte_sched_port_enqueue() must only be given packets of
+ * subports owned by the calling worker. All subports must be configured
+ * before the port is sharded.
+ *
+ * @param port
+ *   Handle to port scheduler instance
+ * @param params
+ *   Sharding parameters
+ * @return
+ *   0 upon success, error code otherwise
+ */
+__rte_experimental
+int
+rte_sched_port_shard_config(struct rte_sched_port *port,
+	struct rte_sched_port_shard_params *params);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Hierarchical scheduler shard dequeue. Schedules up to n_pkts from the
+ * subports of the shard and passes them to the arbiter. Must be called by
+ * the worker lcore driving the shard. Scheduling stops when the shard
+ * output ring is full, i.e. when the arbiter is limited by the port rate.
+ *
+ * @param port
+ *   Handle to port scheduler instance
+ * @param shard_id
+ *   Shard ID
+ * @param n_pkts
+ *   Number of packets to dequeue from the shard
+ * @return
+ *   Number of packets passed to the arbiter
+ */
+__rte_experimental
+int
+rte_sched_port_shard_dequeue(struct rte_sched_port *port, uint32_t shard_id,
+	uint32_t n_pkts);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Hierarchical scheduler arbiter dequeue. Reads up to n_pkts scheduled
+ * by the shards of the port and stores them in the pkts array. Shards are
+ * served in deficit round robin order, weighted by the rate of their
+ * subports, and the output is paced to the port rate. Must be called by a
+ * single lcore.
+ *
+ * @param port
+ *   Handle to port scheduler instance
+ * @param pkts
+ *   Pre-allocated packet descriptor array where the packets dequeued
+ *   from the port scheduler should be stored
+ * @param n_pkts
+ *   Number of packets to dequeue from the port scheduler
+ * @return
+ *   Number of packets successfully dequeued and placed in the pkts array
+ */
+__rte_experimental
+int
+rte_sched_port_arbiter_dequeue(struct rte_sched_port *port,
+	struct rte_mbuf **pkts, uint32_t n_pkts);
+
 #ifdef __cplusplus
 }
 #endif
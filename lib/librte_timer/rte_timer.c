@@ -47,15 +47,43 @@ struct priv_timer {
 	/** running timer on this lcore now */
 	struct rte_timer *running_tim;
 
+	/** timers armed on this lcore by other lcores, not yet in the list */
+	struct rte_timer *handoff_head;
+
 #ifdef RTE_LIBRTE_TIMER_DEBUG
 	/** per-lcore statistics */
 	struct rte_timer_debug_stats stats;
 #endif
 } __rte_cache_aligned;
 
+/* Timer wheel geometry: each level has 64 slots and covers 64 times the
+ * span of the level below it, so that 5 levels cover 2^30 ticks.
+ */
+#define TIMER_WHEEL_LEVELS	5
+#define TIMER_WHEEL_BITS	6
+#define TIMER_WHEEL_SLOTS	(1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK	(TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_SPAN	(1ULL << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_BITS))
+
+/**
+ * Per-lcore hierarchical timer wheel.
+ *
+ * Timers are chained in the slots using sl_next[0] as next pointer and
+ * sl_next[1] as the address of the pointer referencing them, so that they
+ * can be unlinked without walking the slot.
+ */
+struct timer_wheel {
+	uint64_t tick;  /**< next tick to be processed */
+	uint64_t bitmap[TIMER_WHEEL_LEVELS]; /**< non empty slots per level */
+	struct rte_timer *slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+} __rte_cache_aligned;
+
 #define FL_ALLOCATED	(1 << 0)
 struct rte_timer_data {
 	struct priv_timer priv_timer[RTE_MAX_LCORE];
+	/** per-lcore timer wheels, NULL when the skiplist backend is used */
+	struct timer_wheel *wheel;
+	uint8_t wheel_shift;   /**< log2 of the timer cycles per wheel tick */
 	uint8_t internal_flags;
 };
 
@@ -93,16 +121,47 @@ timer_data_valid(uint32_t id)
 
 int
 rte_timer_data_alloc(uint32_t *id_ptr)
+{
+	return rte_timer_data_alloc_backend(id_ptr, RTE_TIMER_BACKEND_SKIPLIST);
+}
+
+int
+rte_timer_data_alloc_backend(uint32_t *id_ptr,
+			     enum rte_timer_backend backend)
 {
 	int i;
+	unsigned int lcore_id;
 	struct rte_timer_data *data;
+	struct timer_wheel *wheel = NULL;
+	uint64_t cycles_per_tick;
+	uint8_t wheel_shift = 0;
 
 	if (!rte_timer_subsystem_initialized)
 		return -ENOMEM;
 
+	if (backend == RTE_TIMER_BACKEND_WHEEL) {
+		wheel = rte_zmalloc("rte_timer_wheel",
+				    sizeof(*wheel) * RTE_MAX_LCORE,
+				    RTE_CACHE_LINE_SIZE);
+		if (wheel == NULL)
+			return -ENOMEM;
+
+		/* a wheel tick lasts about one microsecond */
+		cycles_per_tick = rte_get_timer_hz() / US_PER_S;
+		if (cycles_per_tick > 1)
+			wheel_shift = rte_fls_u64(cycles_per_tick) - 1;
+
+		for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+			wheel[lcore_id].tick =
+				rte_get_timer_cycles() >> wheel_shift;
+	} else if (backend != RTE_TIMER_BACKEND_SKIPLIST)
+		return -EINVAL;
+
 	for (i = 0; i < RTE_MAX_DATA_ELS; i++) {
 		data = &rte_timer_data_arr[i];
 		if (!(data->internal_flags & FL_ALLOCATED)) {
+			data->wheel = wheel;
+			data->wheel_shift = wheel_shift;
 			data->internal_flags |= FL_ALLOCATED;
 
 			if (id_ptr)
@@ -112,6 +171,7 @@ rte_timer_data_alloc(uint32_t *id_ptr)
 		}
 	}
 
+	rte_free(wheel);
 	return -ENOSPC;
 }
 
@@ -122,6 +182,8 @@ rte_timer_data_dealloc(uint32_t id)
 	TIMER_DATA_VALID_GET_OR_ERR_RET(id, timer_data, -EINVAL);
 
 	timer_data->internal_flags &= ~(FL_ALLOCATED);
+	rte_free(timer_data->wheel);
+	timer_data->wheel = NULL;
 
 	return 0;
 }
@@ -194,6 +256,8 @@ rte_timer_subsystem_init(void)
 void
 rte_timer_subsystem_finalize(void)
 {
+	int i;
+
 	rte_mcfg_timer_lock();
 
 	if (!rte_timer_subsystem_initialized) {
@@ -201,8 +265,11 @@ rte_timer_subsystem_finalize(void)
 		return;
 	}
 
-	if (--(*rte_timer_mz_refcnt) == 0)
+	if (--(*rte_timer_mz_refcnt) == 0) {
+		for (i = 0; i < RTE_MAX_DATA_ELS; i++)
+			rte_free(rte_timer_data_arr[i].wheel);
 		rte_memzone_free(rte_timer_data_mz);
+	}
 
 	rte_timer_subsystem_initialized = 0;
 
@@ -215,6 +282,9 @@ rte_timer_init(struct rte_timer *tim)
 {
 	union rte_timer_status status;
 
+	tim->handoff_next = NULL;
+	tim->handoff_expire = 0;
+	tim->handoff_lcore = RTE_TIMER_NO_OWNER;
 	status.state = RTE_TIMER_STOP;
 	status.owner = RTE_TIMER_NO_OWNER;
 	__atomic_store_n(&tim->status.u32, status.u32, __ATOMIC_RELAXED);
@@ -389,6 +459,80 @@ timer_get_prev_entries_for_node(struct rte_timer *tim, unsigned tim_lcore,
 	}
 }
 
+/* Convert a time in timer cycles to a wheel tick, rounding up so that a
+ * timer never expires before its expire time.
+ */
+static inline uint64_t
+timer_wheel_tick(const struct rte_timer_data *timer_data, uint64_t cycles)
+{
+	return (cycles + (1ULL << timer_data->wheel_shift) - 1) >>
+		timer_data->wheel_shift;
+}
+
+/* Add a timer in a wheel, in the slot of the lowest level covering its
+ * distance to the current tick. Call with lock held.
+ */
+static void
+timer_wheel_add(struct timer_wheel *wheel, struct rte_timer *tim,
+		uint64_t expire_tick)
+{
+	struct rte_timer **head;
+	unsigned int level, slot;
+	uint64_t delta;
+
+	/* an already expired timer goes in the slot processed next */
+	if ((int64_t)(expire_tick - wheel->tick) < 0)
+		expire_tick = wheel->tick;
+
+	/* timers beyond the wheel span are parked in the last level, they
+	 * are cascaded again when their slot is reached
+	 */
+	delta = expire_tick - wheel->tick;
+	if (delta >= TIMER_WHEEL_SPAN) {
+		delta = TIMER_WHEEL_SPAN - 1;
+		expire_tick = wheel->tick + delta;
+	}
+
+	level = delta < TIMER_WHEEL_SLOTS ? 0 :
+		(rte_fls_u64(delta) - 1) / TIMER_WHEEL_BITS;
+	slot = (expire_tick >> (level * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK;
+
+	head = &wheel->slots[level][slot];
+	tim->sl_next[0] = *head;
+	if (*head != NULL)
+		(*head)->sl_next[1] = (struct rte_timer *)&tim->sl_next[0];
+	tim->sl_next[1] = (struct rte_timer *)head;
+	*head = tim;
+	wheel->bitmap[level] |= 1ULL << slot;
+}
+
+/* Unlink a timer from a wheel. Call with lock held. */
+static void
+timer_wheel_del(struct timer_wheel *wheel, struct rte_timer *tim)
+{
+	struct rte_timer **pprev = (struct rte_timer **)tim->sl_next[1];
+	struct rte_timer *next = tim->sl_next[0];
+	uintptr_t idx;
+
+	/* already detached by the expiry of its slot */
+	if (pprev == NULL)
+		return;
+
+	*pprev = next;
+	if (next != NULL) {
+		next->sl_next[1] = (struct rte_timer *)pprev;
+	} else {
+		/* last entry unlinked from the slot head, clear its bit */
+		idx = (uintptr_t)pprev - (uintptr_t)&wheel->slots[0][0];
+		if (idx < sizeof(wheel->slots)) {
+			idx /= sizeof(wheel->slots[0][0]);
+			wheel->bitmap[idx / TIMER_WHEEL_SLOTS] &=
+				~(1ULL << (idx & TIMER_WHEEL_MASK));
+		}
+	}
+	tim->sl_next[1] = NULL;
+}
+
 /* call with lock held as necessary
  * add in list
  * timer must be in config state
@@ -396,10 +540,17 @@ timer_get_prev_entries_for_node(struct rte_timer *tim, unsigned tim_lcore,
  */
 static void
 timer_add(struct rte_timer *tim, unsigned int tim_lcore,
-	  struct priv_timer *priv_timer)
+	  struct rte_timer_data *timer_data)
 {
 	unsigned lvl;
 	struct rte_timer *prev[MAX_SKIPLIST_DEPTH+1];
+	struct priv_timer *priv_timer = timer_data->priv_timer;
+
+	if (timer_data->wheel != NULL) {
+		timer_wheel_add(&timer_data->wheel[tim_lcore], tim,
+				timer_wheel_tick(timer_data, tim->expire));
+		return;
+	}
 
 	/* find where exactly this element goes in the list of elements
 	 * for each depth. */
@@ -427,24 +578,22 @@ timer_add(struct rte_timer *tim, unsigned int tim_lcore,
 }
 
 /*
- * del from list, lock if needed
+ * del from list of prev_owner, with its lock held
  * timer must be in config state
  * timer must be in a list
  */
 static void
-timer_del(struct rte_timer *tim, union rte_timer_status prev_status,
-	  int local_is_locked, struct priv_timer *priv_timer)
+timer_unlink(struct rte_timer *tim, unsigned int prev_owner,
+	     struct rte_timer_data *timer_data)
 {
-	unsigned lcore_id = rte_lcore_id();
-	unsigned prev_owner = prev_status.owner;
 	int i;
 	struct rte_timer *prev[MAX_SKIPLIST_DEPTH+1];
+	struct priv_timer *priv_timer = timer_data->priv_timer;
 
-	/* if timer needs is pending another core, we need to lock the
-	 * list; if it is on local core, we need to lock if we are not
-	 * called from rte_timer_manage() */
-	if (prev_owner != lcore_id || !local_is_locked)
-		rte_spinlock_lock(&priv_timer[prev_owner].list_lock);
+	if (timer_data->wheel != NULL) {
+		timer_wheel_del(&timer_data->wheel[prev_owner], tim);
+		return;
+	}
 
 	/* save the lowest list entry into the expire field of the dummy hdr.
 	 * NOTE: this is not atomic on 32-bit */
@@ -465,23 +614,132 @@ timer_del(struct rte_timer *tim, union rte_timer_status prev_status,
 			priv_timer[prev_owner].curr_skiplist_depth --;
 		else
 			break;
+}
+
+/*
+ * del from list, lock if needed
+ * timer must be in config state
+ * timer must be in a list
+ */
+static void
+timer_del(struct rte_timer *tim, union rte_timer_status prev_status,
+	  int local_is_locked, struct rte_timer_data *timer_data)
+{
+	unsigned lcore_id = rte_lcore_id();
+	unsigned prev_owner = prev_status.owner;
+	struct priv_timer *priv_timer = timer_data->priv_timer;
+
+	/* if timer needs is pending another core, we need to lock the
+	 * list; if it is on local core, we need to lock if we are not
+	 * called from rte_timer_manage() */
+	if (prev_owner != lcore_id || !local_is_locked)
+		rte_spinlock_lock(&priv_timer[prev_owner].list_lock);
+
+	timer_unlink(tim, prev_owner, timer_data);
 
 	if (prev_owner != lcore_id || !local_is_locked)
 		rte_spinlock_unlock(&priv_timer[prev_owner].list_lock);
 }
 
-/* Reset and start the timer associated with the timer handle (private func) */
-static int
-__rte_timer_reset(struct rte_timer *tim, uint64_t expire,
-		  uint64_t period, unsigned tim_lcore,
-		  rte_timer_cb_t fct, void *arg,
-		  int local_is_locked,
-		  struct rte_timer_data *timer_data)
+/*
+ * Push a chain of timers, linked by handoff_next from first to last, in the
+ * handoff queue of an lcore. The queue is a lock-free stack that is only
+ * emptied as a whole, so it is not subject to ABA. The handoff link is not
+ * used by the lists, so a timer pending on the lcore can be queued without
+ * being removed from its list first.
+ * timers must be in config state
+ */
+static void
+timer_handoff_push(struct priv_timer *privp, struct rte_timer *first,
+		   struct rte_timer *last)
+{
+	struct rte_timer *head;
+
+	head = __atomic_load_n(&privp->handoff_head, __ATOMIC_RELAXED);
+	do {
+		last->handoff_next = head;
+		/* The "RELEASE" ordering guarantees the timer updates are
+		 * observed by the lcore draining the queue
+		 */
+	} while (!__atomic_compare_exchange_n(&privp->handoff_head, &head,
+					      first, 1, __ATOMIC_RELEASE,
+					      __ATOMIC_RELAXED));
+}
+
+/*
+ * Add the timers handed off to an lcore in its list, with its lock held.
+ * Timers reset by another lcore while pending on this one are removed from
+ * the list first, and forwarded to the handoff queue of their new lcore if
+ * it is not this one.
+ */
+static void
+timer_handoff_drain(struct rte_timer_data *timer_data, unsigned int lcore_id)
 {
-	union rte_timer_status prev_status, status;
-	int ret;
-	unsigned lcore_id = rte_lcore_id();
 	struct priv_timer *priv_timer = timer_data->priv_timer;
+	union rte_timer_status status;
+	struct rte_timer *tim, *next_tim;
+	unsigned int tim_lcore;
+
+	tim = __atomic_exchange_n(&priv_timer[lcore_id].handoff_head, NULL,
+				  __ATOMIC_ACQUIRE);
+
+	for ( ; tim != NULL; tim = next_tim) {
+		next_tim = tim->handoff_next;
+
+		if (tim->handoff_lcore != RTE_TIMER_NO_OWNER) {
+			/* a no-op if its list slot expired meanwhile */
+			timer_unlink(tim, lcore_id, timer_data);
+			__TIMER_STAT_ADD(priv_timer, pending, -1);
+			tim->expire = tim->handoff_expire;
+			tim_lcore = tim->handoff_lcore;
+			tim->handoff_lcore = RTE_TIMER_NO_OWNER;
+			if (tim_lcore != lcore_id) {
+				timer_handoff_push(&priv_timer[tim_lcore],
+						   tim, tim);
+				continue;
+			}
+		}
+
+		__TIMER_STAT_ADD(priv_timer, pending, 1);
+		timer_add(tim, lcore_id, timer_data);
+
+		status.state = RTE_TIMER_PENDING;
+		status.owner = (int16_t)lcore_id;
+		/* The "RELEASE" ordering guarantees the memory operations above
+		 * the status update are observed before the update by all threads
+		 */
+		__atomic_store_n(&tim->status.u32, status.u32, __ATOMIC_RELEASE);
+	}
+}
+
+/*
+ * Drain the handoff queue of the calling lcore if not empty. Timers in the
+ * queue are in config state, so this is done when failing to configure a
+ * timer, in case it is waiting there.
+ */
+static void
+timer_handoff_flush(struct rte_timer_data *timer_data)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	struct priv_timer *privp;
+
+	if (lcore_id >= RTE_MAX_LCORE)
+		return;
+
+	privp = &timer_data->priv_timer[lcore_id];
+	if (__atomic_load_n(&privp->handoff_head, __ATOMIC_RELAXED) == NULL)
+		return;
+
+	rte_spinlock_lock(&privp->list_lock);
+	timer_handoff_drain(timer_data, lcore_id);
+	rte_spinlock_unlock(&privp->list_lock);
+}
+
+/* Get the lcore that runs a timer armed for tim_lcore */
+static unsigned int
+timer_get_target_lcore(unsigned int tim_lcore, struct priv_timer *priv_timer)
+{
+	unsigned int lcore_id = rte_lcore_id();
 
 	/* round robin for tim_lcore */
 	if (tim_lcore == (unsigned)LCORE_ID_ANY) {
@@ -497,11 +755,32 @@ __rte_timer_reset(struct rte_timer *tim, uint64_t expire,
 			tim_lcore = rte_get_next_lcore(LCORE_ID_ANY, 0, 1);
 	}
 
+	return tim_lcore;
+}
+
+/* Reset and start the timer associated with the timer handle (private func) */
+static int
+__rte_timer_reset(struct rte_timer *tim, uint64_t expire,
+		  uint64_t period, unsigned tim_lcore,
+		  rte_timer_cb_t fct, void *arg,
+		  int local_is_locked,
+		  struct rte_timer_data *timer_data)
+{
+	union rte_timer_status prev_status, status;
+	int ret;
+	unsigned lcore_id = rte_lcore_id();
+	struct priv_timer *priv_timer = timer_data->priv_timer;
+
+	tim_lcore = timer_get_target_lcore(tim_lcore, priv_timer);
+
 	/* wait that the timer is in correct status before update,
 	 * and mark it as being configured */
 	ret = timer_set_config_state(tim, &prev_status, priv_timer);
-	if (ret < 0)
+	if (ret < 0) {
+		if (!local_is_locked)
+			timer_handoff_flush(timer_data);
 		return -1;
+	}
 
 	__TIMER_STAT_ADD(priv_timer, reset, 1);
 	if (prev_status.state == RTE_TIMER_RUNNING &&
@@ -511,7 +790,7 @@ __rte_timer_reset(struct rte_timer *tim, uint64_t expire,
 
 	/* remove it from list */
 	if (prev_status.state == RTE_TIMER_PENDING) {
-		timer_del(tim, prev_status, local_is_locked, priv_timer);
+		timer_del(tim, prev_status, local_is_locked, timer_data);
 		__TIMER_STAT_ADD(priv_timer, pending, -1);
 	}
 
@@ -528,7 +807,7 @@ __rte_timer_reset(struct rte_timer *tim, uint64_t expire,
 		rte_spinlock_lock(&priv_timer[tim_lcore].list_lock);
 
 	__TIMER_STAT_ADD(priv_timer, pending, 1);
-	timer_add(tim, tim_lcore, priv_timer);
+	timer_add(tim, tim_lcore, timer_data);
 
 	/* update state: as we are in CONFIG state, only us can modify
 	 * the state so we don't need to use cmpset() here */
@@ -586,6 +865,180 @@ rte_timer_reset_sync(struct rte_timer *tim, uint64_t ticks,
 		rte_pause();
 }
 
+/* Switch the list lock held from *locked to lcore_id, RTE_MAX_LCORE
+ * meaning that no lock is held.
+ */
+static inline void
+timer_switch_lock(struct priv_timer *priv_timer, unsigned int *locked,
+		  unsigned int lcore_id)
+{
+	if (*locked == lcore_id)
+		return;
+	if (*locked != RTE_MAX_LCORE)
+		rte_spinlock_unlock(&priv_timer[*locked].list_lock);
+	if (lcore_id != RTE_MAX_LCORE)
+		rte_spinlock_lock(&priv_timer[lcore_id].list_lock);
+	*locked = lcore_id;
+}
+
+/* A chain of timers to be pushed to the handoff queue of an lcore */
+struct timer_chain {
+	struct rte_timer *first;
+	struct rte_timer *last;
+	unsigned int lcore_id;
+};
+
+/* Push a chain of timers to the handoff queue of its lcore, if not empty */
+static inline void
+timer_chain_push(struct priv_timer *priv_timer, struct timer_chain *chain)
+{
+	if (chain->first == NULL)
+		return;
+	timer_handoff_push(&priv_timer[chain->lcore_id], chain->first,
+			   chain->last);
+	chain->first = NULL;
+}
+
+/* Append a timer to a chain, pushing the chain first if it is for another
+ * lcore, so that consecutive timers for the same lcore are pushed at once.
+ */
+static inline void
+timer_chain_add(struct priv_timer *priv_timer, struct timer_chain *chain,
+		struct rte_timer *tim, unsigned int lcore_id)
+{
+	if (chain->first != NULL && chain->lcore_id != lcore_id)
+		timer_chain_push(priv_timer, chain);
+
+	if (chain->first == NULL) {
+		chain->first = tim;
+		chain->lcore_id = lcore_id;
+	} else {
+		chain->last->handoff_next = tim;
+	}
+	chain->last = tim;
+}
+
+/*
+ * Reset a burst of timers, without taking the list lock of another lcore.
+ * The lock of the calling lcore is taken once for consecutive timers pending
+ * on it or armed on it. Timers armed on another lcore are handed off to it,
+ * and timers still pending on another lcore are handed off to that lcore,
+ * which removes them from its list before arming them. Stop at the first
+ * timer that cannot be configured, and return the number of timers reset.
+ */
+static int
+__rte_timer_reset_bulk(struct rte_timer **tims, unsigned int nb_tims,
+		       uint64_t expire, uint64_t period, unsigned int tim_lcore,
+		       rte_timer_cb_t fct, void **args,
+		       struct rte_timer_data *timer_data)
+{
+	union rte_timer_status prev_status, status;
+	struct timer_chain armed = { .first = NULL };
+	struct timer_chain pending = { .first = NULL };
+	struct rte_timer *tim;
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int locked = RTE_MAX_LCORE;
+	struct priv_timer *priv_timer = timer_data->priv_timer;
+	unsigned int i;
+	int handoff;
+
+	tim_lcore = timer_get_target_lcore(tim_lcore, priv_timer);
+	handoff = tim_lcore != lcore_id;
+
+	for (i = 0; i < nb_tims; i++) {
+		tim = tims[i];
+
+		if (timer_set_config_state(tim, &prev_status, priv_timer) < 0)
+			break;
+
+		__TIMER_STAT_ADD(priv_timer, reset, 1);
+		if (prev_status.state == RTE_TIMER_RUNNING &&
+		    lcore_id < RTE_MAX_LCORE) {
+			priv_timer[lcore_id].updated = 1;
+		}
+
+		tim->period = period;
+		tim->f = fct;
+		tim->arg = args != NULL ? args[i] : NULL;
+
+		/* pending on another lcore: its list is ordered by expiry,
+		 * so leave the expiry to the lcore removing it from the list
+		 */
+		if (prev_status.state == RTE_TIMER_PENDING &&
+		    prev_status.owner != (int16_t)lcore_id) {
+			tim->handoff_expire = expire;
+			tim->handoff_lcore = (int16_t)tim_lcore;
+			timer_chain_add(priv_timer, &pending, tim,
+					prev_status.owner);
+			continue;
+		}
+
+		/* remove it from the list of the calling lcore */
+		if (prev_status.state == RTE_TIMER_PENDING) {
+			timer_switch_lock(priv_timer, &locked, lcore_id);
+			timer_unlink(tim, lcore_id, timer_data);
+			__TIMER_STAT_ADD(priv_timer, pending, -1);
+		}
+
+		tim->expire = expire;
+
+		if (handoff) {
+			/* chain it, it stays in config state until the
+			 * target lcore adds it in its list
+			 */
+			tim->handoff_lcore = RTE_TIMER_NO_OWNER;
+			timer_chain_add(priv_timer, &armed, tim, tim_lcore);
+			continue;
+		}
+
+		timer_switch_lock(priv_timer, &locked, tim_lcore);
+		__TIMER_STAT_ADD(priv_timer, pending, 1);
+		timer_add(tim, tim_lcore, timer_data);
+
+		status.state = RTE_TIMER_PENDING;
+		status.owner = (int16_t)tim_lcore;
+		/* The "RELEASE" ordering guarantees the memory operations above
+		 * the status update are observed before the update by all threads
+		 */
+		__atomic_store_n(&tim->status.u32, status.u32, __ATOMIC_RELEASE);
+	}
+
+	timer_switch_lock(priv_timer, &locked, RTE_MAX_LCORE);
+
+	timer_chain_push(priv_timer, &armed);
+	timer_chain_push(priv_timer, &pending);
+
+	if (i < nb_tims)
+		timer_handoff_flush(timer_data);
+
+	return i;
+}
+
+int
+rte_timer_reset_bulk(struct rte_timer **tims, unsigned int nb_tims,
+		     uint64_t ticks, enum rte_timer_type type,
+		     unsigned int tim_lcore, rte_timer_cb_t fct, void **args)
+{
+	return rte_timer_alt_reset_bulk(default_data_id, tims, nb_tims, ticks,
+					type, tim_lcore, fct, args);
+}
+
+int
+rte_timer_alt_reset_bulk(uint32_t timer_data_id, struct rte_timer **tims,
+			 unsigned int nb_tims, uint64_t ticks,
+			 enum rte_timer_type type, unsigned int tim_lcore,
+			 rte_timer_cb_t fct, void **args)
+{
+	uint64_t cur_time = rte_get_timer_cycles();
+	struct rte_timer_data *timer_data;
+
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
+
+	return __rte_timer_reset_bulk(tims, nb_tims, cur_time + ticks,
+				      type == PERIODICAL ? ticks : 0,
+				      tim_lcore, fct, args, timer_data);
+}
+
 static int
 __rte_timer_stop(struct rte_timer *tim, int local_is_locked,
 		 struct rte_timer_data *timer_data)
@@ -598,8 +1051,11 @@ __rte_timer_stop(struct rte_timer *tim, int local_is_locked,
 	/* wait that the timer is in correct status before update,
 	 * and mark it as being configured */
 	ret = timer_set_config_state(tim, &prev_status, priv_timer);
-	if (ret < 0)
+	if (ret < 0) {
+		if (!local_is_locked)
+			timer_handoff_flush(timer_data);
 		return -1;
+	}
 
 	__TIMER_STAT_ADD(priv_timer, stop, 1);
 	if (prev_status.state == RTE_TIMER_RUNNING &&
@@ -609,7 +1065,7 @@ __rte_timer_stop(struct rte_timer *tim, int local_is_locked,
 
 	/* remove it from list */
 	if (prev_status.state == RTE_TIMER_PENDING) {
-		timer_del(tim, prev_status, local_is_locked, priv_timer);
+		timer_del(tim, prev_status, local_is_locked, timer_data);
 		__TIMER_STAT_ADD(priv_timer, pending, -1);
 	}
 
@@ -649,6 +1105,76 @@ rte_timer_stop_sync(struct rte_timer *tim)
 		rte_pause();
 }
 
+/*
+ * Stop a burst of timers, taking a list lock once for consecutive timers
+ * pending on the same lcore. Stop at the first timer that cannot be
+ * configured, and return the number of timers stopped.
+ */
+static int
+__rte_timer_stop_bulk(struct rte_timer **tims, unsigned int nb_tims,
+		      struct rte_timer_data *timer_data)
+{
+	union rte_timer_status prev_status, status;
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int locked = RTE_MAX_LCORE;
+	struct priv_timer *priv_timer = timer_data->priv_timer;
+	struct rte_timer *tim;
+	unsigned int i;
+
+	for (i = 0; i < nb_tims; i++) {
+		tim = tims[i];
+
+		if (timer_set_config_state(tim, &prev_status, priv_timer) < 0)
+			break;
+
+		__TIMER_STAT_ADD(priv_timer, stop, 1);
+		if (prev_status.state == RTE_TIMER_RUNNING &&
+		    lcore_id < RTE_MAX_LCORE) {
+			priv_timer[lcore_id].updated = 1;
+		}
+
+		/* remove it from list */
+		if (prev_status.state == RTE_TIMER_PENDING) {
+			timer_switch_lock(priv_timer, &locked,
+					  prev_status.owner);
+			timer_unlink(tim, prev_status.owner, timer_data);
+			__TIMER_STAT_ADD(priv_timer, pending, -1);
+		}
+
+		/* mark timer as stopped */
+		status.state = RTE_TIMER_STOP;
+		status.owner = RTE_TIMER_NO_OWNER;
+		/* The "RELEASE" ordering guarantees the memory operations above
+		 * the status update are observed before the update by all threads
+		 */
+		__atomic_store_n(&tim->status.u32, status.u32, __ATOMIC_RELEASE);
+	}
+
+	timer_switch_lock(priv_timer, &locked, RTE_MAX_LCORE);
+
+	if (i < nb_tims)
+		timer_handoff_flush(timer_data);
+
+	return i;
+}
+
+int
+rte_timer_stop_bulk(struct rte_timer **tims, unsigned int nb_tims)
+{
+	return rte_timer_alt_stop_bulk(default_data_id, tims, nb_tims);
+}
+
+int
+rte_timer_alt_stop_bulk(uint32_t timer_data_id, struct rte_timer **tims,
+			unsigned int nb_tims)
+{
+	struct rte_timer_data *timer_data;
+
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
+
+	return __rte_timer_stop_bulk(tims, nb_tims, timer_data);
+}
+
 /* Test the PENDING status of the timer handle tim */
 int
 rte_timer_pending(struct rte_timer *tim)
@@ -657,61 +1183,206 @@ rte_timer_pending(struct rte_timer *tim)
 				__ATOMIC_RELAXED) == RTE_TIMER_PENDING;
 }
 
-/* must be called periodically, run all timer that expired */
-static void
-__rte_timer_manage(struct rte_timer_data *timer_data)
+/* Get the first tick, not beyond limit, at which a non empty slot of the
+ * wheel is due. Slots of level n are due at multiples of 64^n ticks.
+ */
+static uint64_t
+timer_wheel_next_tick(const struct timer_wheel *wheel, uint64_t limit)
+{
+	uint64_t next = limit, base, bitmap, t;
+	unsigned int level, shift, idx;
+
+	for (level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+		bitmap = wheel->bitmap[level];
+		if (bitmap == 0)
+			continue;
+
+		shift = level * TIMER_WHEEL_BITS;
+		base = RTE_ALIGN_CEIL(wheel->tick, 1ULL << shift);
+		idx = (base >> shift) & TIMER_WHEEL_MASK;
+		/* rotate so that bit 0 is the slot due at base */
+		if (idx != 0)
+			bitmap = (bitmap >> idx) |
+				(bitmap << (TIMER_WHEEL_SLOTS - idx));
+		t = base + ((uint64_t)rte_bsf64(bitmap) << shift);
+		if (t < next)
+			next = t;
+	}
+
+	return next;
+}
+
+/* Move the timers of an upper level slot to the lower levels. The ones
+ * already due at cur_tick are directly appended to the expired list ending
+ * at *tail, which saves walking them again when catching up.
+ */
+static struct rte_timer **
+timer_wheel_cascade(struct rte_timer_data *timer_data,
+		    struct timer_wheel *wheel, unsigned int level,
+		    unsigned int slot, uint64_t cur_tick,
+		    struct rte_timer **tail)
+{
+	struct rte_timer *tim, *next_tim;
+	uint64_t expire_tick;
+
+	tim = wheel->slots[level][slot];
+	wheel->slots[level][slot] = NULL;
+	wheel->bitmap[level] &= ~(1ULL << slot);
+
+	for ( ; tim != NULL; tim = next_tim) {
+		next_tim = tim->sl_next[0];
+		expire_tick = timer_wheel_tick(timer_data, tim->expire);
+		if (expire_tick <= cur_tick) {
+			tim->sl_next[0] = NULL;
+			tim->sl_next[1] = NULL;
+			*tail = tim;
+			tail = &tim->sl_next[0];
+		} else {
+			timer_wheel_add(wheel, tim, expire_tick);
+		}
+	}
+
+	return tail;
+}
+
+/* Advance the wheel up to cur_tick, and detach all the timers due on the
+ * way in a list chained by sl_next[0]. Empty slots are skipped using the
+ * per-level bitmaps. Call with lock held.
+ */
+static struct rte_timer *
+timer_wheel_expire(struct rte_timer_data *timer_data,
+		   struct timer_wheel *wheel, uint64_t cur_tick)
+{
+	struct rte_timer *expired = NULL, **tail = &expired, *tim;
+	unsigned int level, shift, slot;
+	uint64_t t;
+
+	while (wheel->tick <= cur_tick) {
+		t = timer_wheel_next_tick(wheel, cur_tick + 1);
+		if (t > cur_tick)
+			break;
+		wheel->tick = t;
+
+		/* entering a new rotation of the lower levels, bring
+		 * down the timers of the upper level slots due now
+		 */
+		for (level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+			shift = level * TIMER_WHEEL_BITS;
+			if ((t & ((1ULL << shift) - 1)) != 0)
+				break;
+			slot = (t >> shift) & TIMER_WHEEL_MASK;
+			if (wheel->bitmap[level] & (1ULL << slot))
+				tail = timer_wheel_cascade(timer_data, wheel,
+							   level, slot,
+							   cur_tick, tail);
+		}
+
+		slot = t & TIMER_WHEEL_MASK;
+		if (wheel->bitmap[0] & (1ULL << slot)) {
+			*tail = wheel->slots[0][slot];
+			wheel->slots[0][slot] = NULL;
+			wheel->bitmap[0] &= ~(1ULL << slot);
+			for (tim = *tail; tim != NULL; tim = tim->sl_next[0]) {
+				tim->sl_next[1] = NULL;
+				tail = &tim->sl_next[0];
+			}
+		}
+
+		wheel->tick = t + 1;
+	}
+
+	if (wheel->tick <= cur_tick)
+		wheel->tick = cur_tick + 1;
+
+	return expired;
+}
+
+/*
+ * Detach the timers of an lcore list that are expired, and transition them
+ * from PENDING to RUNNING. Return them in a list chained by sl_next[0].
+ */
+static struct rte_timer *
+timer_get_expired(struct rte_timer_data *timer_data, unsigned int lcore_id)
 {
-	union rte_timer_status status;
 	struct rte_timer *tim, *next_tim;
 	struct rte_timer *run_first_tim, **pprev;
-	unsigned lcore_id = rte_lcore_id();
 	struct rte_timer *prev[MAX_SKIPLIST_DEPTH + 1];
-	uint64_t cur_time;
+	struct priv_timer *privp = &timer_data->priv_timer[lcore_id];
+	struct timer_wheel *wheel;
+	uint64_t cur_time, cur_tick;
+	bool handoff;
 	int i, ret;
-	struct priv_timer *priv_timer = timer_data->priv_timer;
 
-	/* timer manager only runs on EAL thread with valid lcore_id */
-	assert(lcore_id < RTE_MAX_LCORE);
+	/* timers handed off by other lcores must be added first */
+	handoff = __atomic_load_n(&privp->handoff_head,
+				  __ATOMIC_RELAXED) != NULL;
+
+	if (timer_data->wheel != NULL) {
+		wheel = &timer_data->wheel[lcore_id];
+		cur_tick = rte_get_timer_cycles() >> timer_data->wheel_shift;
+
+#ifdef RTE_ARCH_64
+		/* the wheel tick only increases, so it can be checked
+		 * outside the lock to skip calls within the same tick
+		 */
+		if (likely(wheel->tick > cur_tick) && !handoff)
+			return NULL;
+#endif
+
+		rte_spinlock_lock(&privp->list_lock);
+		if (handoff)
+			timer_handoff_drain(timer_data, lcore_id);
+		tim = timer_wheel_expire(timer_data, wheel, cur_tick);
+		goto set_running;
+	}
 
-	__TIMER_STAT_ADD(priv_timer, manage, 1);
 	/* optimize for the case where per-cpu list is empty */
-	if (priv_timer[lcore_id].pending_head.sl_next[0] == NULL)
-		return;
+	if (privp->pending_head.sl_next[0] == NULL && !handoff)
+		return NULL;
 	cur_time = rte_get_timer_cycles();
 
 #ifdef RTE_ARCH_64
 	/* on 64-bit the value cached in the pending_head.expired will be
 	 * updated atomically, so we can consult that for a quick check here
 	 * outside the lock */
-	if (likely(priv_timer[lcore_id].pending_head.expire > cur_time))
-		return;
+	if (likely(privp->pending_head.expire > cur_time) && !handoff)
+		return NULL;
 #endif
 
 	/* browse ordered list, add expired timers in 'expired' list */
-	rte_spinlock_lock(&priv_timer[lcore_id].list_lock);
+	rte_spinlock_lock(&privp->list_lock);
+
+	if (handoff)
+		timer_handoff_drain(timer_data, lcore_id);
 
 	/* if nothing to do just unlock and return */
-	if (priv_timer[lcore_id].pending_head.sl_next[0] == NULL ||
-	    priv_timer[lcore_id].pending_head.sl_next[0]->expire > cur_time) {
-		rte_spinlock_unlock(&priv_timer[lcore_id].list_lock);
-		return;
+	if (privp->pending_head.sl_next[0] == NULL ||
+	    privp->pending_head.sl_next[0]->expire > cur_time) {
+		rte_spinlock_unlock(&privp->list_lock);
+		return NULL;
 	}
 
 	/* save start of list of expired timers */
-	tim = priv_timer[lcore_id].pending_head.sl_next[0];
+	tim = privp->pending_head.sl_next[0];
 
 	/* break the existing list at current time point */
-	timer_get_prev_entries(cur_time, lcore_id, prev, priv_timer);
-	for (i = priv_timer[lcore_id].curr_skiplist_depth -1; i >= 0; i--) {
-		if (prev[i] == &priv_timer[lcore_id].pending_head)
+	timer_get_prev_entries(cur_time, lcore_id, prev,
+			       timer_data->priv_timer);
+	for (i = privp->curr_skiplist_depth - 1; i >= 0; i--) {
+		if (prev[i] == &privp->pending_head)
 			continue;
-		priv_timer[lcore_id].pending_head.sl_next[i] =
-		    prev[i]->sl_next[i];
+		privp->pending_head.sl_next[i] = prev[i]->sl_next[i];
 		if (prev[i]->sl_next[i] == NULL)
-			priv_timer[lcore_id].curr_skiplist_depth--;
-		prev[i] ->sl_next[i] = NULL;
+			privp->curr_skiplist_depth--;
+		prev[i]->sl_next[i] = NULL;
 	}
 
+	/* update the next to expire timer value */
+	privp->pending_head.expire =
+	    (privp->pending_head.sl_next[0] == NULL) ? 0 :
+		privp->pending_head.sl_next[0]->expire;
+
+set_running:
 	/* transition run-list from PENDING to RUNNING */
 	run_first_tim = tim;
 	pprev = &run_first_tim;
@@ -730,12 +1401,29 @@ __rte_timer_manage(struct rte_timer_data *timer_data)
 		}
 	}
 
-	/* update the next to expire timer value */
-	priv_timer[lcore_id].pending_head.expire =
-	    (priv_timer[lcore_id].pending_head.sl_next[0] == NULL) ? 0 :
-		priv_timer[lcore_id].pending_head.sl_next[0]->expire;
+	rte_spinlock_unlock(&privp->list_lock);
 
-	rte_spinlock_unlock(&priv_timer[lcore_id].list_lock);
+	return run_first_tim;
+}
+
+/* must be called periodically, run all timer that expired */
+static void
+__rte_timer_manage(struct rte_timer_data *timer_data)
+{
+	union rte_timer_status status;
+	struct rte_timer *tim, *next_tim;
+	struct rte_timer *run_first_tim;
+	unsigned lcore_id = rte_lcore_id();
+	struct priv_timer *priv_timer = timer_data->priv_timer;
+
+	/* timer manager only runs on EAL thread with valid lcore_id */
+	assert(lcore_id < RTE_MAX_LCORE);
+
+	__TIMER_STAT_ADD(priv_timer, manage, 1);
+
+	run_first_tim = timer_get_expired(timer_data, lcore_id);
+	if (run_first_tim == NULL)
+		return;
 
 	/* now scan expired list and call callbacks */
 	for (tim = run_first_tim; tim != NULL; tim = next_tim) {
@@ -804,15 +1492,12 @@ rte_timer_alt_manage(uint32_t timer_data_id,
 {
 	unsigned int default_poll_lcores[] = {rte_lcore_id()};
 	union rte_timer_status status;
-	struct rte_timer *tim, *next_tim, **pprev;
+	struct rte_timer *tim;
 	struct rte_timer *run_first_tims[RTE_MAX_LCORE];
 	unsigned int this_lcore = rte_lcore_id();
-	struct rte_timer *prev[MAX_SKIPLIST_DEPTH + 1];
-	uint64_t cur_time;
-	int i, j, ret;
+	int i;
 	int nb_runlists = 0;
 	struct rte_timer_data *data;
-	struct priv_timer *privp;
 	uint32_t poll_lcore;
 
 	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, data, -EINVAL);
@@ -829,74 +1514,10 @@ rte_timer_alt_manage(uint32_t timer_data_id,
 
 	for (i = 0; i < nb_poll_lcores; i++) {
 		poll_lcore = poll_lcores[i];
-		privp = &data->priv_timer[poll_lcore];
-
-		/* optimize for the case where per-cpu list is empty */
-		if (privp->pending_head.sl_next[0] == NULL)
-			continue;
-		cur_time = rte_get_timer_cycles();
-
-#ifdef RTE_ARCH_64
-		/* on 64-bit the value cached in the pending_head.expired will
-		 * be updated atomically, so we can consult that for a quick
-		 * check here outside the lock
-		 */
-		if (likely(privp->pending_head.expire > cur_time))
-			continue;
-#endif
-
-		/* browse ordered list, add expired timers in 'expired' list */
-		rte_spinlock_lock(&privp->list_lock);
-
-		/* if nothing to do just unlock and return */
-		if (privp->pending_head.sl_next[0] == NULL ||
-		    privp->pending_head.sl_next[0]->expire > cur_time) {
-			rte_spinlock_unlock(&privp->list_lock);
-			continue;
-		}
-
-		/* save start of list of expired timers */
-		tim = privp->pending_head.sl_next[0];
-
-		/* break the existing list at current time point */
-		timer_get_prev_entries(cur_time, poll_lcore, prev,
-				       data->priv_timer);
-		for (j = privp->curr_skiplist_depth - 1; j >= 0; j--) {
-			if (prev[j] == &privp->pending_head)
-				continue;
-			privp->pending_head.sl_next[j] =
-				prev[j]->sl_next[j];
-			if (prev[j]->sl_next[j] == NULL)
-				privp->curr_skiplist_depth--;
-
-			prev[j]->sl_next[j] = NULL;
-		}
-
-		/* transition run-list from PENDING to RUNNING */
-		run_first_tims[nb_runlists] = tim;
-		pprev = &run_first_tims[nb_runlists];
-		nb_runlists++;
-
-		for ( ; tim != NULL; tim = next_tim) {
-			next_tim = tim->sl_next[0];
-
-			ret = timer_set_running_state(tim);
-			if (likely(ret == 0)) {
-				pprev = &tim->sl_next[0];
-			} else {
-				/* another core is trying to re-config this one,
-				 * remove it from local expired list
-				 */
-				*pprev = next_tim;
-			}
-		}
-
-		/* update the next to expire timer value */
-		privp->pending_head.expire =
-		    (privp->pending_head.sl_next[0] == NULL) ? 0 :
-			privp->pending_head.sl_next[0]->expire;
-
-		rte_spinlock_unlock(&privp->list_lock);
+		run_first_tims[nb_runlists] = timer_get_expired(data,
+								poll_lcore);
+		if (run_first_tims[nb_runlists] != NULL)
+			nb_runlists++;
 	}
 
 	/* Now process the run lists */
@@ -976,6 +1597,24 @@ rte_timer_alt_manage(uint32_t timer_data_id,
 	return 0;
 }
 
+/* Stop the timers of a list chained by sl_next[0], with lock held */
+static void
+timer_stop_list(struct rte_timer *tim, struct rte_timer_data *timer_data,
+		rte_timer_stop_all_cb_t f, void *f_arg)
+{
+	struct rte_timer *next_tim;
+
+	for ( ; tim != NULL; tim = next_tim) {
+		next_tim = tim->sl_next[0];
+
+		/* Call timer_stop with lock held */
+		__rte_timer_stop(tim, 1, timer_data);
+
+		if (f)
+			f(tim, f_arg);
+	}
+}
+
 /* Walk pending lists, stopping timers and calling user-specified function */
 int
 rte_timer_stop_all(uint32_t timer_data_id, unsigned int *walk_lcores,
@@ -983,9 +1622,10 @@ rte_timer_stop_all(uint32_t timer_data_id, unsigned int *walk_lcores,
 		   rte_timer_stop_all_cb_t f, void *f_arg)
 {
 	int i;
+	unsigned int level, slot;
 	struct priv_timer *priv_timer;
+	struct timer_wheel *wheel;
 	uint32_t walk_lcore;
-	struct rte_timer *tim, *next_tim;
 	struct rte_timer_data *timer_data;
 
 	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
@@ -996,16 +1636,18 @@ rte_timer_stop_all(uint32_t timer_data_id, unsigned int *walk_lcores,
 
 		rte_spinlock_lock(&priv_timer->list_lock);
 
-		for (tim = priv_timer->pending_head.sl_next[0];
-		     tim != NULL;
-		     tim = next_tim) {
-			next_tim = tim->sl_next[0];
+		timer_handoff_drain(timer_data, walk_lcore);
 
-			/* Call timer_stop with lock held */
-			__rte_timer_stop(tim, 1, timer_data);
-
-			if (f)
-				f(tim, f_arg);
+		if (timer_data->wheel != NULL) {
+			wheel = &timer_data->wheel[walk_lcore];
+			for (level = 0; level < TIMER_WHEEL_LEVELS; level++)
+				for (slot = 0; slot < TIMER_WHEEL_SLOTS; slot++)
+					timer_stop_list(
+						wheel->slots[level][slot],
+						timer_data, f, f_arg);
+		} else {
+			timer_stop_list(priv_timer->pending_head.sl_next[0],
+					timer_data, f, f_arg);
 		}
 
 		rte_spinlock_unlock(&priv_timer->list_lock);
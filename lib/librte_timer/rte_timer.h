@@ -105,6 +105,12 @@ struct rte_timer
 	uint64_t period;       /**< Period of timer (0 if not periodic). */
 	rte_timer_cb_t f;      /**< Callback function. */
 	void *arg;             /**< Argument to callback function. */
+	/** Next timer in the handoff queue of an lcore. */
+	struct rte_timer *handoff_next;
+	/** Expiry of a reset handed off to the lcore the timer is pending on. */
+	uint64_t handoff_expire;
+	/** Target lcore of that reset, RTE_TIMER_NO_OWNER if none. */
+	int16_t handoff_lcore;
 };
 
 
@@ -119,6 +125,9 @@ struct rte_timer
 	0,                                      \
 	NULL,                                   \
 	NULL,                                   \
+	NULL,                                   \
+	0,                                      \
+	RTE_TIMER_NO_OWNER,                     \
 	}
 #else
 /**
@@ -129,6 +138,7 @@ struct rte_timer
 			.state = RTE_TIMER_STOP,     \
 			.owner = RTE_TIMER_NO_OWNER, \
 		}},                                  \
+		.handoff_lcore = RTE_TIMER_NO_OWNER, \
 	}
 #endif
 
@@ -150,6 +160,50 @@ struct rte_timer
 __rte_experimental
 int rte_timer_data_alloc(uint32_t *id_ptr);
 
+/**
+ * Data structure used by a timer data instance to track its pending timers.
+ */
+enum rte_timer_backend {
+	/** Per-lcore skiplist ordered by expiry: O(log n) arm and cancel,
+	 *  cycle accurate expiry.
+	 */
+	RTE_TIMER_BACKEND_SKIPLIST,
+	/** Per-lcore hierarchical timer wheel: O(1) arm and cancel, timers
+	 *  of a same tick (about one microsecond) are expired in batch.
+	 */
+	RTE_TIMER_BACKEND_WHEEL,
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Allocate a timer data instance in shared memory to track a set of pending
+ * timer lists, using the given backend.
+ *
+ * rte_timer_data_alloc() is equivalent to this function with the
+ * RTE_TIMER_BACKEND_SKIPLIST backend. The instance allocated with the
+ * RTE_TIMER_BACKEND_WHEEL backend is driven by the same rte_timer_alt_*()
+ * functions; its timers never expire early, but may expire up to one
+ * wheel tick late. rte_timer_next_ticks() is not supported by this
+ * backend.
+ *
+ * @param id_ptr
+ *   Pointer to variable into which to write the identifier of the allocated
+ *   timer data instance.
+ * @param backend
+ *   Data structure used to track the pending timers.
+ *
+ * @return
+ *   - 0: Success
+ *   - -EINVAL: invalid backend
+ *   - -ENOMEM: unable to allocate the backend memory
+ *   - -ENOSPC: maximum number of timer data instances already allocated
+ */
+__rte_experimental
+int rte_timer_data_alloc_backend(uint32_t *id_ptr,
+				 enum rte_timer_backend backend);
+
 /**
  * @warning
  * @b EXPERIMENTAL: this API may change without prior notice
@@ -443,6 +497,137 @@ __rte_experimental
 int
 rte_timer_alt_stop(uint32_t timer_data_id, struct rte_timer *tim);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Reset and start a burst of timers, with the same parameters as
+ * rte_timer_reset().
+ *
+ * The list lock of the calling lcore is taken once for consecutive timers
+ * pending on it. The list lock of another lcore is never taken: timers
+ * armed on another lcore are pushed to a lock-free handoff queue that
+ * rte_timer_manage() drains on that lcore, and timers still pending on
+ * another lcore are pushed to the handoff queue of that lcore, which
+ * removes them from its list before arming them. Until then, the timers are
+ * in the CONFIG state, and resetting or stopping them from another lcore
+ * fails.
+ * If tim_lcore is LCORE_ID_ANY, all the timers are armed on the same lcore.
+ *
+ * @param tims
+ *   Array of timer handles.
+ * @param nb_tims
+ *   Number of timers in the array.
+ * @param ticks
+ *   The number of cycles (see rte_get_hpet_hz()) before the callback
+ *   function is called.
+ * @param type
+ *   The type can be either PERIODICAL or SINGLE, see rte_timer_reset().
+ * @param tim_lcore
+ *   The ID of the lcore where the timer callback functions have to be
+ *   executed.
+ * @param fct
+ *   The callback function of the timers.
+ * @param args
+ *   Array of nb_tims user arguments of the callback function, or NULL to
+ *   pass NULL to all of them.
+ * @return
+ *   The number of timers reset, from the start of the array. Resetting
+ *   stops at the first timer in the RUNNING or CONFIG state.
+ */
+__rte_experimental
+int
+rte_timer_reset_bulk(struct rte_timer **tims, unsigned int nb_tims,
+		     uint64_t ticks, enum rte_timer_type type,
+		     unsigned int tim_lcore, rte_timer_cb_t fct, void **args);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Stop a burst of timers, see rte_timer_stop(). The list lock of an lcore
+ * is taken once for consecutive timers pending on it.
+ *
+ * @param tims
+ *   Array of timer handles.
+ * @param nb_tims
+ *   Number of timers in the array.
+ * @return
+ *   The number of timers stopped, from the start of the array. Stopping
+ *   stops at the first timer in the RUNNING or CONFIG state.
+ */
+__rte_experimental
+int
+rte_timer_stop_bulk(struct rte_timer **tims, unsigned int nb_tims);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * This function is the same as rte_timer_reset_bulk(), except that it
+ * allows a caller to specify the rte_timer_data instance containing the
+ * lists to which the timers should be added.
+ *
+ * @see rte_timer_reset_bulk()
+ *
+ * @param timer_data_id
+ *   An identifier indicating which instance of timer data should be used for
+ *   this operation.
+ * @param tims
+ *   Array of timer handles.
+ * @param nb_tims
+ *   Number of timers in the array.
+ * @param ticks
+ *   The number of cycles (see rte_get_hpet_hz()) before the callback
+ *   function is called.
+ * @param type
+ *   The type can be either PERIODICAL or SINGLE, see rte_timer_reset().
+ * @param tim_lcore
+ *   The ID of the lcore where the timer callback functions have to be
+ *   executed.
+ * @param fct
+ *   The callback function of the timers. This parameter can be NULL if
+ *   (and only if) rte_timer_alt_manage() will be used to manage them.
+ * @param args
+ *   Array of nb_tims user arguments of the callback function, or NULL to
+ *   pass NULL to all of them.
+ * @return
+ *   - The number of timers reset, from the start of the array.
+ *   - -EINVAL: invalid timer_data_id
+ */
+__rte_experimental
+int
+rte_timer_alt_reset_bulk(uint32_t timer_data_id, struct rte_timer **tims,
+			 unsigned int nb_tims, uint64_t ticks,
+			 enum rte_timer_type type, unsigned int tim_lcore,
+			 rte_timer_cb_t fct, void **args);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * This function is the same as rte_timer_stop_bulk(), except that it
+ * allows a caller to specify the rte_timer_data instance containing the
+ * lists from which the timers should be removed.
+ *
+ * @see rte_timer_stop_bulk()
+ *
+ * @param timer_data_id
+ *   An identifier indicating which instance of timer data should be used for
+ *   this operation.
+ * @param tims
+ *   Array of timer handles.
+ * @param nb_tims
+ *   Number of timers in the array.
+ * @return
+ *   - The number of timers stopped, from the start of the array.
+ *   - -EINVAL: invalid timer_data_id
+ */
+__rte_experimental
+int
+rte_timer_alt_stop_bulk(uint32_t timer_data_id, struct rte_timer **tims,
+			unsigned int nb_tims);
+
 /**
  * Callback function type for rte_timer_alt_manage().
  */